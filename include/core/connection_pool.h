@@ -0,0 +1 @@
+../../src/core/socket/connection_pool.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../src/crypto/fe25519/fe25519.h
\ No newline at end of file
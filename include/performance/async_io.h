@@ -0,0 +1 @@
+../../src/performance/parallel/async_io.h
\ No newline at end of file
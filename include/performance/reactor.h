@@ -0,0 +1 @@
+../../src/performance/parallel/reactor.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../src/performance/parallel/resolver.h
\ No newline at end of file
@@ -0,0 +1,911 @@
+/** !
+ * Connection pool implementation
+ *
+ * @file src/core/socket/connection_pool.c
+ *
+ * @author Jacob Smith
+ */
+
+// header file
+#include <core/connection_pool.h>
+
+// structure definitions
+struct connection_pool_host_s
+{
+    socket_ip_address              ip_address;
+    socket_port                    port_number;
+    size_t                         open, idle, waiting;
+    connection_pool_connection    *p_idle;
+    struct connection_pool_host_s *p_next;
+};
+
+struct connection_pool_s
+{
+    mutex                          _lock;
+    condition_variable             _checked_in;
+    size_t                         max_idle, max_per_host;
+    timestamp                      wait_timeout, idle_timeout;
+    size_t                         idle, active;
+    fn_connection_pool_open       *pfn_open;
+    fn_connection_pool_close      *pfn_close;
+    void                          *p_parameter;
+    struct connection_pool_host_s *p_hosts[CONNECTION_POOL_HOST_BUCKETS];
+};
+
+// function declarations
+/** !
+ * Open a plain TCP connection
+ *
+ * @param pp_connection result, always null
+ * @param p_socket_tcp  result
+ * @param ip_address    the IP address of the host
+ * @param port_number   the port number of the host
+ * @param p_parameter   unused
+ *
+ * @return 1 on success, 0 on error
+ */
+int connection_pool_tcp_open ( void **pp_connection, socket_tcp *p_socket_tcp, socket_ip_address ip_address, socket_port port_number, void *p_parameter );
+
+/** !
+ * Close a plain TCP connection
+ *
+ * @param p_connection unused
+ * @param _socket_tcp  the TCP socket
+ * @param p_parameter  unused
+ *
+ * @return 1 on success, 0 on error
+ */
+int connection_pool_tcp_close ( void *p_connection, socket_tcp _socket_tcp, void *p_parameter );
+
+/** !
+ * Get the bucket of an IP address and port
+ *
+ * @param p_connection_pool the connection pool
+ * @param ip_address        the IP address of the host
+ * @param port_number       the port number of the host
+ *
+ * @return the bucket
+ */
+struct connection_pool_host_s **connection_pool_host_bucket ( connection_pool *p_connection_pool, socket_ip_address ip_address, socket_port port_number );
+
+/** !
+ * Find the host of an IP address and port, adding it if there is none.
+ * The caller must hold the lock of the pool.
+ *
+ * @param p_connection_pool the connection pool
+ * @param ip_address        the IP address of the host
+ * @param port_number       the port number of the host
+ *
+ * @return the host on success, null on error
+ */
+struct connection_pool_host_s *connection_pool_host_find ( connection_pool *p_connection_pool, socket_ip_address ip_address, socket_port port_number );
+
+/** !
+ * Release a host that has no open connections, and no waiting callers.
+ * The caller must hold the lock of the pool.
+ *
+ * @param p_connection_pool the connection pool
+ * @param p_host            the host
+ *
+ * @return void
+ */
+void connection_pool_host_reclaim ( connection_pool *p_connection_pool, struct connection_pool_host_s *p_host );
+
+/** !
+ * Test if an idle connection can be reused. A connection that timed out,
+ * was closed by the peer, or has unsolicited data waiting is unhealthy.
+ *
+ * @param p_connection_pool the connection pool
+ * @param p_connection      the connection
+ * @param now               the current time
+ *
+ * @return true if the connection is healthy, else false
+ */
+bool connection_pool_healthy ( connection_pool *p_connection_pool, connection_pool_connection *p_connection, timestamp now );
+
+/** !
+ * Close a connection, and release it
+ *
+ * @param p_connection_pool the connection pool
+ * @param p_connection      the connection
+ *
+ * @return void
+ */
+void connection_pool_release ( connection_pool *p_connection_pool, connection_pool_connection *p_connection );
+
+// function definitions
+int connection_pool_construct ( connection_pool **pp_connection_pool, size_t max_idle, size_t max_per_host, size_t wait_timeout, size_t idle_timeout )
+{
+
+    // done
+    return connection_pool_construct_custom(pp_connection_pool, max_idle, max_per_host, wait_timeout, idle_timeout, connection_pool_tcp_open, connection_pool_tcp_close, (void *) 0);
+}
+
+int connection_pool_construct_custom
+(
+    connection_pool          **pp_connection_pool,
+    size_t                     max_idle,
+    size_t                     max_per_host,
+    size_t                     wait_timeout,
+    size_t                     idle_timeout,
+    fn_connection_pool_open   *pfn_open,
+    fn_connection_pool_close  *pfn_close,
+    void                      *p_parameter
+)
+{
+
+    // argument check
+    if ( pp_connection_pool == (void *) 0 ) goto no_connection_pool;
+    if ( pfn_open           == (void *) 0 ) goto no_open;
+    if ( pfn_close          == (void *) 0 ) goto no_close;
+
+    // initialized data
+    connection_pool *p_connection_pool = default_allocator(0, sizeof(connection_pool));
+
+    // error check
+    if ( p_connection_pool == (void *) 0 ) goto no_mem;
+
+    // populate the connection pool
+    *p_connection_pool = (connection_pool)
+    {
+        .max_idle     = max_idle,
+        .max_per_host = max_per_host,
+        .wait_timeout = (timestamp) wait_timeout * timer_seconds_divisor() / 1000,
+        .idle_timeout = (timestamp) idle_timeout * timer_seconds_divisor() / 1000,
+        .pfn_open     = pfn_open,
+        .pfn_close    = pfn_close,
+        .p_parameter  = p_parameter
+    };
+
+    // construct a lock
+    if ( 0 == mutex_create(&p_connection_pool->_lock) ) goto failed_to_create_mutex;
+
+    // construct a condition variable
+    if ( 0 == condition_variable_create(&p_connection_pool->_checked_in) ) goto failed_to_create_condition_variable;
+
+    // return a pointer to the caller
+    *pp_connection_pool = p_connection_pool;
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_connection_pool:
+                #ifndef NDEBUG
+                    log_error("[socket] [connection pool] Null pointer provided for parameter \"pp_connection_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_open:
+                #ifndef NDEBUG
+                    log_error("[socket] [connection pool] Null pointer provided for parameter \"pfn_open\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_close:
+                #ifndef NDEBUG
+                    log_error("[socket] [connection pool] Null pointer provided for parameter \"pfn_close\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // sync errors
+        {
+            failed_to_create_condition_variable:
+
+                // release the lock
+                mutex_destroy(&p_connection_pool->_lock);
+
+                // fall through
+
+            failed_to_create_mutex:
+                #ifndef NDEBUG
+                    log_error("[socket] [connection pool] Failed to construct synchronization primitives in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // release the connection pool
+                default_allocator(p_connection_pool, 0);
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int connection_pool_tcp_open ( void **pp_connection, socket_tcp *p_socket_tcp, socket_ip_address ip_address, socket_port port_number, void *p_parameter )
+{
+
+    // unused
+    (void) p_parameter;
+
+    // plain TCP connections have no layer
+    *pp_connection = (void *) 0;
+
+    // done
+    return socket_tcp_connect(p_socket_tcp, ip_address._type, ip_address, port_number);
+}
+
+int connection_pool_tcp_close ( void *p_connection, socket_tcp _socket_tcp, void *p_parameter )
+{
+
+    // unused
+    (void) p_connection;
+    (void) p_parameter;
+
+    // done
+    return socket_tcp_destroy(&_socket_tcp);
+}
+
+struct connection_pool_host_s **connection_pool_host_bucket ( connection_pool *p_connection_pool, socket_ip_address ip_address, socket_port port_number )
+{
+
+    // initialized data
+    unsigned long long h = port_number;
+
+    // hash the key
+    if ( ip_address._type == socket_address_family_ipv4 )
+        h ^= (unsigned long long) ip_address._address.ipv4 << 16;
+    else
+        for (size_t i = 0; i < 16; i++)
+            h = ( h ^ ip_address._address.ipv6[i] ) * 0x100000001b3ULL;
+
+    // mix the bits
+    h *= 0x9e3779b97f4a7c15ULL;
+
+    // done
+    return &p_connection_pool->p_hosts[( h >> 32 ) % CONNECTION_POOL_HOST_BUCKETS];
+}
+
+struct connection_pool_host_s *connection_pool_host_find ( connection_pool *p_connection_pool, socket_ip_address ip_address, socket_port port_number )
+{
+
+    // initialized data
+    struct connection_pool_host_s **pp_host = connection_pool_host_bucket(p_connection_pool, ip_address, port_number);
+    struct connection_pool_host_s  *p_host  = (void *) 0;
+
+    // search the bucket
+    for (p_host = *pp_host; p_host; p_host = p_host->p_next)
+    {
+
+        // different port or family
+        if ( p_host->port_number != port_number || p_host->ip_address._type != ip_address._type ) continue;
+
+        // same address
+        if ( ip_address._type == socket_address_family_ipv4 )
+        {
+            if ( p_host->ip_address._address.ipv4 == ip_address._address.ipv4 ) return p_host;
+        }
+        else if ( 0 == memcmp(p_host->ip_address._address.ipv6, ip_address._address.ipv6, 16) ) return p_host;
+    }
+
+    // allocate a host
+    p_host = default_allocator(0, sizeof(struct connection_pool_host_s));
+
+    // error check
+    if ( p_host == (void *) 0 ) goto no_mem;
+
+    // populate the host
+    *p_host = (struct connection_pool_host_s)
+    {
+        .ip_address  = ip_address,
+        .port_number = port_number,
+        .open        = 0,
+        .idle        = 0,
+        .waiting     = 0,
+        .p_idle      = (void *) 0,
+        .p_next      = *pp_host
+    };
+
+    // add the host to the bucket
+    *pp_host = p_host;
+
+    // success
+    return p_host;
+
+    // error handling
+    {
+
+        // standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return (void *) 0;
+        }
+    }
+}
+
+void connection_pool_host_reclaim ( connection_pool *p_connection_pool, struct connection_pool_host_s *p_host )
+{
+
+    // the host is in use
+    if ( p_host->open || p_host->waiting ) return;
+
+    // unlink the host from its bucket
+    for (struct connection_pool_host_s **pp_host = connection_pool_host_bucket(p_connection_pool, p_host->ip_address, p_host->port_number); *pp_host; pp_host = &(*pp_host)->p_next)
+        if ( *pp_host == p_host ) { *pp_host = p_host->p_next; break; }
+
+    // release the host
+    default_allocator(p_host, 0);
+
+    // done
+    return;
+}
+
+bool connection_pool_healthy ( connection_pool *p_connection_pool, connection_pool_connection *p_connection, timestamp now )
+{
+
+    // timed out
+    if ( p_connection_pool->idle_timeout && now - p_connection->last_used > p_connection_pool->idle_timeout ) return false;
+
+    // platform dependent implementation
+    #ifdef _WIN64
+    #else
+    {
+
+        // initialized data
+        char    c = 0;
+        ssize_t r = recv(p_connection->_socket_tcp, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+
+        // nothing to read, so the connection is open and quiet
+        if ( r == -1 && ( errno == EAGAIN || errno == EWOULDBLOCK ) ) return true;
+
+        // the peer closed, the connection failed, or unsolicited data arrived
+        return false;
+    }
+    #endif
+
+    // done
+    return true;
+}
+
+void connection_pool_release ( connection_pool *p_connection_pool, connection_pool_connection *p_connection )
+{
+
+    // close the connection
+    p_connection_pool->pfn_close(p_connection->p_connection, p_connection->_socket_tcp, p_connection_pool->p_parameter);
+
+    // release the connection
+    default_allocator(p_connection, 0);
+
+    // done
+    return;
+}
+
+int connection_pool_checkout ( connection_pool *p_connection_pool, connection_pool_connection **pp_connection, socket_ip_address ip_address, socket_port port_number )
+{
+
+    // argument check
+    if ( p_connection_pool == (void *) 0 ) goto no_connection_pool;
+    if ( pp_connection     == (void *) 0 ) goto no_connection;
+
+    // initialized data
+    struct connection_pool_host_s *p_host       = (void *) 0;
+    connection_pool_connection    *p_connection = (void *) 0;
+    timestamp                      divisor      = timer_seconds_divisor(),
+                                   deadline     = timer_high_precision() + p_connection_pool->wait_timeout,
+                                   remaining    = 0;
+
+    // lock
+    mutex_lock(&p_connection_pool->_lock);
+
+    // find the host
+    p_host = connection_pool_host_find(p_connection_pool, ip_address, port_number);
+
+    // error check
+    if ( p_host == (void *) 0 ) goto failed_to_find_host;
+
+    // wait for a connection
+    for (;;)
+    {
+
+        // reuse the most recent idle connection
+        while ( p_host->p_idle )
+        {
+
+            // pop the connection
+            p_connection   = p_host->p_idle,
+            p_host->p_idle = p_connection->p_next;
+
+            // update the counters
+            p_host->idle--,
+            p_connection_pool->idle--,
+            p_connection_pool->active++;
+
+            // unlock
+            mutex_unlock(&p_connection_pool->_lock);
+
+            // reuse a healthy connection
+            if ( connection_pool_healthy(p_connection_pool, p_connection, timer_high_precision()) ) goto done;
+
+            // close an unhealthy connection
+            connection_pool_release(p_connection_pool, p_connection);
+
+            // lock
+            mutex_lock(&p_connection_pool->_lock);
+
+            // update the counters
+            p_host->open--,
+            p_connection_pool->active--;
+
+            // wake a waiting caller
+            condition_variable_broadcast(&p_connection_pool->_checked_in);
+        }
+
+        // open a new connection
+        if ( p_connection_pool->max_per_host == 0 || p_host->open < p_connection_pool->max_per_host ) break;
+
+        // give up after wait_timeout
+        remaining = deadline - timer_high_precision();
+        if ( remaining <= 0 ) goto host_busy;
+
+        // wait for a checkin, or the deadline
+        p_host->waiting++;
+        condition_variable_wait_timeout(&p_connection_pool->_checked_in, &p_connection_pool->_lock, remaining / divisor * 1000000000 + remaining % divisor * 1000000000 / divisor);
+        p_host->waiting--;
+    }
+
+    // reserve a connection
+    p_host->open++,
+    p_connection_pool->active++;
+
+    // unlock
+    mutex_unlock(&p_connection_pool->_lock);
+
+    // allocate a connection
+    p_connection = default_allocator(0, sizeof(connection_pool_connection));
+
+    // error check
+    if ( p_connection == (void *) 0 ) goto no_mem;
+
+    // populate the connection
+    *p_connection = (connection_pool_connection)
+    {
+        ._socket_tcp  = -1,
+        .p_connection = (void *) 0,
+        .p_host       = p_host,
+        .p_next       = (void *) 0,
+        .last_used    = 0
+    };
+
+    // open the connection
+    if ( 0 == p_connection_pool->pfn_open(&p_connection->p_connection, &p_connection->_socket_tcp, ip_address, port_number, p_connection_pool->p_parameter) ) goto failed_to_open_connection;
+
+    // probe the connection while it idles. Best effort, since the health
+    // check on checkout catches dead connections anyway
+    #ifdef _WIN64
+    #else
+        setsockopt(p_connection->_socket_tcp, SOL_SOCKET, SO_KEEPALIVE, &(int){ 1 }, sizeof(int));
+    #endif
+
+    done:
+
+    // detach the connection from the idle list
+    p_connection->p_next = (void *) 0;
+
+    // return a pointer to the caller
+    *pp_connection = p_connection;
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_connection_pool:
+                #ifndef NDEBUG
+                    log_error("[socket] [connection pool] Null pointer provided for parameter \"p_connection_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_connection:
+                #ifndef NDEBUG
+                    log_error("[socket] [connection pool] Null pointer provided for parameter \"pp_connection\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // connection pool errors
+        {
+            failed_to_find_host:
+
+                // unlock
+                mutex_unlock(&p_connection_pool->_lock);
+
+                // error
+                return 0;
+
+            host_busy:
+                #ifndef NDEBUG
+                    log_error("[socket] [connection pool] Timed out waiting for a connection to the host in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // release the host if this caller added it
+                connection_pool_host_reclaim(p_connection_pool, p_host);
+
+                // unlock
+                mutex_unlock(&p_connection_pool->_lock);
+
+                // error
+                return 0;
+
+            failed_to_open_connection:
+                #ifndef NDEBUG
+                    log_error("[socket] [connection pool] Failed to open connection in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // release the connection
+                default_allocator(p_connection, 0);
+
+                // lock
+                mutex_lock(&p_connection_pool->_lock);
+
+                // give back the reservation
+                p_host->open--,
+                p_connection_pool->active--;
+
+                // wake a waiting caller
+                condition_variable_broadcast(&p_connection_pool->_checked_in);
+
+                // release the host if it is empty
+                connection_pool_host_reclaim(p_connection_pool, p_host);
+
+                // unlock
+                mutex_unlock(&p_connection_pool->_lock);
+
+                // error
+                return 0;
+        }
+
+        // standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // lock
+                mutex_lock(&p_connection_pool->_lock);
+
+                // give back the reservation
+                p_host->open--,
+                p_connection_pool->active--;
+
+                // wake a waiting caller
+                condition_variable_broadcast(&p_connection_pool->_checked_in);
+
+                // release the host if it is empty
+                connection_pool_host_reclaim(p_connection_pool, p_host);
+
+                // unlock
+                mutex_unlock(&p_connection_pool->_lock);
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int connection_pool_checkin ( connection_pool *p_connection_pool, connection_pool_connection **pp_connection, bool reusable )
+{
+
+    // argument check
+    if ( p_connection_pool == (void *) 0 ) goto no_connection_pool;
+    if ( pp_connection     == (void *) 0 ) goto no_connection;
+    if ( *pp_connection    == (void *) 0 ) goto no_connection;
+
+    // initialized data
+    connection_pool_connection    *p_connection = *pp_connection;
+    struct connection_pool_host_s *p_host       = p_connection->p_host;
+
+    // no more pointer for caller
+    *pp_connection = (void *) 0;
+
+    // store the time of the checkin
+    if ( reusable ) p_connection->last_used = timer_high_precision();
+
+    // lock
+    mutex_lock(&p_connection_pool->_lock);
+
+    // the connection is no longer checked out
+    p_connection_pool->active--;
+
+    // keep the connection idle
+    if ( reusable && p_host->idle < p_connection_pool->max_idle )
+    {
+
+        // push the connection
+        p_connection->p_next = p_host->p_idle,
+        p_host->p_idle       = p_connection;
+
+        // update the counters
+        p_host->idle++,
+        p_connection_pool->idle++;
+
+        // wake a waiting caller
+        condition_variable_broadcast(&p_connection_pool->_checked_in);
+
+        // unlock
+        mutex_unlock(&p_connection_pool->_lock);
+
+        // success
+        return 1;
+    }
+
+    // the connection is closing
+    p_host->open--;
+
+    // wake a waiting caller
+    condition_variable_broadcast(&p_connection_pool->_checked_in);
+
+    // release the host if it is empty
+    connection_pool_host_reclaim(p_connection_pool, p_host);
+
+    // unlock
+    mutex_unlock(&p_connection_pool->_lock);
+
+    // close the connection
+    connection_pool_release(p_connection_pool, p_connection);
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_connection_pool:
+                #ifndef NDEBUG
+                    log_error("[socket] [connection pool] Null pointer provided for parameter \"p_connection_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_connection:
+                #ifndef NDEBUG
+                    log_error("[socket] [connection pool] Null pointer provided for parameter \"pp_connection\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+size_t connection_pool_prune ( connection_pool *p_connection_pool )
+{
+
+    // argument check
+    if ( p_connection_pool == (void *) 0 ) goto no_connection_pool;
+
+    // initialized data
+    connection_pool_connection *p_closing = (void *) 0;
+    size_t                      result    = 0;
+    timestamp                   now       = timer_high_precision();
+
+    // lock
+    mutex_lock(&p_connection_pool->_lock);
+
+    // iterate through each host
+    for (size_t i = 0; i < CONNECTION_POOL_HOST_BUCKETS; i++)
+        for (struct connection_pool_host_s *p_host = p_connection_pool->p_hosts[i], *p_next = (void *) 0; p_host; p_host = p_next)
+        {
+
+            // initialized data
+            connection_pool_connection **pp_connection = &p_host->p_idle;
+
+            // store the next host, in case this one is released
+            p_next = p_host->p_next;
+
+            // iterate through each idle connection
+            while ( *pp_connection )
+            {
+
+                // initialized data
+                connection_pool_connection *p_connection = *pp_connection;
+
+                // keep a healthy connection
+                if ( connection_pool_healthy(p_connection_pool, p_connection, now) ) { pp_connection = &p_connection->p_next; continue; }
+
+                // unlink the connection
+                *pp_connection = p_connection->p_next;
+
+                // update the counters
+                p_host->idle--,
+                p_host->open--,
+                p_connection_pool->idle--;
+
+                // defer closing the connection
+                p_connection->p_next = p_closing,
+                p_closing            = p_connection;
+            }
+
+            // release the host if it is empty
+            connection_pool_host_reclaim(p_connection_pool, p_host);
+        }
+
+    // wake a waiting caller
+    if ( p_closing ) condition_variable_broadcast(&p_connection_pool->_checked_in);
+
+    // unlock
+    mutex_unlock(&p_connection_pool->_lock);
+
+    // close each unhealthy connection
+    while ( p_closing )
+    {
+
+        // initialized data
+        connection_pool_connection *p_connection = p_closing;
+
+        // next
+        p_closing = p_connection->p_next;
+
+        // close the connection
+        connection_pool_release(p_connection_pool, p_connection);
+
+        // increment the counter
+        result++;
+    }
+
+    // success
+    return result;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_connection_pool:
+                #ifndef NDEBUG
+                    log_error("[socket] [connection pool] Null pointer provided for parameter \"p_connection_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+size_t connection_pool_idle ( connection_pool *p_connection_pool )
+{
+
+    // argument check
+    if ( p_connection_pool == (void *) 0 ) return 0;
+
+    // initialized data
+    size_t result = 0;
+
+    // lock
+    mutex_lock(&p_connection_pool->_lock);
+
+    // store the quantity of idle connections
+    result = p_connection_pool->idle;
+
+    // unlock
+    mutex_unlock(&p_connection_pool->_lock);
+
+    // success
+    return result;
+}
+
+size_t connection_pool_active ( connection_pool *p_connection_pool )
+{
+
+    // argument check
+    if ( p_connection_pool == (void *) 0 ) return 0;
+
+    // initialized data
+    size_t result = 0;
+
+    // lock
+    mutex_lock(&p_connection_pool->_lock);
+
+    // store the quantity of checked out connections
+    result = p_connection_pool->active;
+
+    // unlock
+    mutex_unlock(&p_connection_pool->_lock);
+
+    // success
+    return result;
+}
+
+int connection_pool_destroy ( connection_pool **pp_connection_pool )
+{
+
+    // argument check
+    if ( pp_connection_pool  == (void *) 0 ) goto no_connection_pool;
+    if ( *pp_connection_pool == (void *) 0 ) goto no_connection_pool;
+
+    // initialized data
+    connection_pool *p_connection_pool = *pp_connection_pool;
+
+    // no more pointer for caller
+    *pp_connection_pool = (void *) 0;
+
+    // iterate through each host
+    for (size_t i = 0; i < CONNECTION_POOL_HOST_BUCKETS; i++)
+        while ( p_connection_pool->p_hosts[i] )
+        {
+
+            // initialized data
+            struct connection_pool_host_s *p_host = p_connection_pool->p_hosts[i];
+
+            // next
+            p_connection_pool->p_hosts[i] = p_host->p_next;
+
+            // close each idle connection
+            while ( p_host->p_idle )
+            {
+
+                // initialized data
+                connection_pool_connection *p_connection = p_host->p_idle;
+
+                // next
+                p_host->p_idle = p_connection->p_next;
+
+                // close the connection
+                connection_pool_release(p_connection_pool, p_connection);
+            }
+
+            // release the host
+            default_allocator(p_host, 0);
+        }
+
+    // release the synchronization primitives
+    condition_variable_destroy(&p_connection_pool->_checked_in),
+    mutex_destroy(&p_connection_pool->_lock);
+
+    // release the connection pool
+    default_allocator(p_connection_pool, 0);
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_connection_pool:
+                #ifndef NDEBUG
+                    log_error("[socket] [connection pool] Null pointer provided for parameter \"pp_connection_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
@@ -0,0 +1,187 @@
+/** !
+ * Connection pool interface
+ *
+ * @file src/core/socket/connection_pool.h
+ *
+ * @author Jacob Smith
+ */
+
+// header guard
+#pragma once
+
+// standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+
+// gsdk
+/// core
+#include <core/log.h>
+#include <core/sync.h>
+#include <core/interfaces.h>
+#include <core/socket.h>
+#include <core/tcp.h>
+
+// preprocessor definitions
+#define CONNECTION_POOL_HOST_BUCKETS 64
+
+// structure declarations
+struct connection_pool_s;
+struct connection_pool_host_s;
+struct connection_pool_connection_s;
+
+// type definitions
+typedef struct connection_pool_s            connection_pool;
+typedef struct connection_pool_connection_s connection_pool_connection;
+
+/** !
+ * Open a connection to a host
+ *
+ * @param pp_connection result, the layered connection IF ANY ELSE null
+ * @param p_socket_tcp  result, the connected TCP socket
+ * @param ip_address    the IP address of the host
+ * @param port_number   the port number of the host
+ * @param p_parameter   the parameter of the pool
+ *
+ * @return 1 on success, 0 on error
+ */
+typedef int (fn_connection_pool_open) ( void **pp_connection, socket_tcp *p_socket_tcp, socket_ip_address ip_address, socket_port port_number, void *p_parameter );
+
+/** !
+ * Close a connection that was opened by a fn_connection_pool_open
+ *
+ * @param p_connection the layered connection IF ANY ELSE null
+ * @param _socket_tcp  the TCP socket
+ * @param p_parameter  the parameter of the pool
+ *
+ * @return 1 on success, 0 on error
+ */
+typedef int (fn_connection_pool_close) ( void *p_connection, socket_tcp _socket_tcp, void *p_parameter );
+
+// structure definitions
+struct connection_pool_connection_s
+{
+    socket_tcp                           _socket_tcp;  // the TCP socket
+    void                                *p_connection; // the layered connection IF ANY ELSE null
+    struct connection_pool_host_s       *p_host;       // the host of the connection
+    struct connection_pool_connection_s *p_next;       // the next idle connection to the host
+    timestamp                            last_used;    // the time of the last checkin
+};
+
+// function declarations
+/// constructors
+/** !
+ * Construct a pool of TCP connections. Connections are keyed by IP
+ * address and port, and are reused until they go bad, or idle for
+ * longer than idle_timeout. Pooled sockets set SO_KEEPALIVE, and a host
+ * is forgotten once it has no open connections.
+ *
+ * @param pp_connection_pool result
+ * @param max_idle           the maximum quantity of idle connections kept for each host
+ * @param max_per_host       the maximum quantity of open connections to each host, or 0 for no limit
+ * @param wait_timeout       milliseconds that a checkout waits when max_per_host connections to the host are open, or 0 to fail at once
+ * @param idle_timeout       milliseconds that an idle connection may be reused for, or 0 for no limit
+ *
+ * @return 1 on success, 0 on error
+ */
+int connection_pool_construct ( connection_pool **pp_connection_pool, size_t max_idle, size_t max_per_host, size_t wait_timeout, size_t idle_timeout );
+
+/** !
+ * Construct a pool of layered connections, like secure sockets. The
+ * pool opens and closes connections with pfn_open and pfn_close, and
+ * checks their health on the underlying TCP socket.
+ *
+ * @param pp_connection_pool result
+ * @param max_idle           the maximum quantity of idle connections kept for each host
+ * @param max_per_host       the maximum quantity of open connections to each host, or 0 for no limit
+ * @param wait_timeout       milliseconds that a checkout waits when max_per_host connections to the host are open, or 0 to fail at once
+ * @param idle_timeout       milliseconds that an idle connection may be reused for, or 0 for no limit
+ * @param pfn_open           the function that opens a connection
+ * @param pfn_close          the function that closes a connection
+ * @param p_parameter        the parameter of pfn_open and pfn_close
+ *
+ * @return 1 on success, 0 on error
+ */
+int connection_pool_construct_custom
+(
+    connection_pool          **pp_connection_pool,
+    size_t                     max_idle,
+    size_t                     max_per_host,
+    size_t                     wait_timeout,
+    size_t                     idle_timeout,
+    fn_connection_pool_open   *pfn_open,
+    fn_connection_pool_close  *pfn_close,
+    void                      *p_parameter
+);
+
+/// checkout
+/** !
+ * Check out a connection to a host. A healthy idle connection is reused
+ * if there is one, else a new connection is opened. If max_per_host
+ * connections to the host are open, wait up to wait_timeout for one to
+ * be checked in, then fail.
+ *
+ * @param p_connection_pool the connection pool
+ * @param pp_connection     result
+ * @param ip_address        the IP address of the host
+ * @param port_number       the port number of the host
+ *
+ * @return 1 on success, 0 on error
+ */
+int connection_pool_checkout ( connection_pool *p_connection_pool, connection_pool_connection **pp_connection, socket_ip_address ip_address, socket_port port_number );
+
+/// checkin
+/** !
+ * Check in a connection. A reusable connection is kept idle for the next
+ * checkout, unless its host has max_idle idle connections. Otherwise, the
+ * connection is closed.
+ *
+ * @param p_connection_pool the connection pool
+ * @param pp_connection     pointer to the connection pointer
+ * @param reusable          false if the connection failed, or is in an unknown state, else true
+ *
+ * @return 1 on success, 0 on error
+ */
+int connection_pool_checkin ( connection_pool *p_connection_pool, connection_pool_connection **pp_connection, bool reusable );
+
+/// prune
+/** !
+ * Close every idle connection that timed out, or went bad
+ *
+ * @param p_connection_pool the connection pool
+ *
+ * @return the quantity of closed connections
+ */
+size_t connection_pool_prune ( connection_pool *p_connection_pool );
+
+/// accessors
+/** !
+ * Get the quantity of idle connections in a pool
+ *
+ * @param p_connection_pool the connection pool
+ *
+ * @return the quantity of idle connections
+ */
+size_t connection_pool_idle ( connection_pool *p_connection_pool );
+
+/** !
+ * Get the quantity of checked out connections in a pool
+ *
+ * @param p_connection_pool the connection pool
+ *
+ * @return the quantity of checked out connections
+ */
+size_t connection_pool_active ( connection_pool *p_connection_pool );
+
+/// destructors
+/** !
+ * Close every idle connection, then destroy a connection pool. Every
+ * connection must be checked in first.
+ *
+ * @param pp_connection_pool pointer to connection pool pointer
+ *
+ * @return 1 on success, 0 on error
+ */
+int connection_pool_destroy ( connection_pool **pp_connection_pool );
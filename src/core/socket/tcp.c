@@ -6,10 +6,32 @@
  * @author Jacob Smith
  */
 
+// feature test macros, for zero copy notifications
+#define _GNU_SOURCE
+
 // header
 #include <core/tcp.h>
 
-int socket_tcp_create ( socket_tcp *const p_socket_tcp, enum socket_address_family_e address_family, unsigned short port_number )
+// platform dependent includes
+#ifdef __linux__
+    #include <linux/errqueue.h>
+#endif
+
+// function declarations
+/** !
+ * Skip the bytes that a vectored transfer moved, dropping the segments that
+ * were moved in full and advancing into a partially moved segment
+ * 
+ * @param p_segments  the segments
+ * @param p_index     in: the first unfinished segment, out: the new first unfinished segment
+ * @param quantity    the quantity of segments
+ * @param transferred the quantity of bytes that were moved
+ * 
+ * @return void
+ */
+void socket_tcp_segments_advance ( struct iovec *const p_segments, size_t *const p_index, size_t quantity, size_t transferred );
+
+int socket_tcp_open ( socket_tcp *const p_socket_tcp, enum socket_address_family_e address_family, socket_port port_number, bool reuse_port )
 {
 
     // argument check
@@ -39,6 +61,9 @@ int socket_tcp_create ( socket_tcp *const p_socket_tcp, enum socket_address_fami
         // error check
         if ( _socket_tcp == INVALID_SOCKET ) goto failed_to_create_socket;
 
+        // SO_REUSEPORT is not available
+        if ( reuse_port ) goto failed_to_set_socket_option;
+
     #elif __APPLE__
 
         // create the socket
@@ -50,6 +75,9 @@ int socket_tcp_create ( socket_tcp *const p_socket_tcp, enum socket_address_fami
         // set options
         if ( setsockopt(_socket_tcp, SOL_SOCKET, SO_REUSEADDR, &option, sizeof(option)) == -1 ) goto failed_to_set_socket_option;
 
+        // share the port with other sockets
+        if ( reuse_port && setsockopt(_socket_tcp, SOL_SOCKET, SO_REUSEPORT, &option, sizeof(option)) == -1 ) goto failed_to_set_socket_option;
+
         // bind the socket to the port
         if ( bind(_socket_tcp,(struct sockaddr*) &socket_address, sizeof(socket_address)) == -1 ) goto failed_to_bind_socket;
 
@@ -64,6 +92,9 @@ int socket_tcp_create ( socket_tcp *const p_socket_tcp, enum socket_address_fami
         // set socket options
         if ( setsockopt(_socket_tcp, SOL_SOCKET, SO_REUSEADDR, &option, sizeof(option)) == -1 ) goto failed_to_set_socket_option;
 
+        // share the port with other sockets
+        if ( reuse_port && setsockopt(_socket_tcp, SOL_SOCKET, SO_REUSEPORT, &option, sizeof(option)) == -1 ) goto failed_to_set_socket_option;
+
         // bind the socket to the port
         if ( bind(_socket_tcp,(struct sockaddr*) &socket_address, sizeof(socket_address)) == -1 ) goto failed_to_bind_socket;
 
@@ -119,6 +150,20 @@ int socket_tcp_create ( socket_tcp *const p_socket_tcp, enum socket_address_fami
     }
 }
 
+int socket_tcp_create ( socket_tcp *const p_socket_tcp, enum socket_address_family_e address_family, socket_port port_number )
+{
+
+    // create a socket
+    return socket_tcp_open(p_socket_tcp, address_family, port_number, false);
+}
+
+int socket_tcp_create_reuse_port ( socket_tcp *const p_socket_tcp, enum socket_address_family_e address_family, socket_port port_number )
+{
+
+    // create a socket that shares its port
+    return socket_tcp_open(p_socket_tcp, address_family, port_number, true);
+}
+
 int socket_tcp_listen ( socket_tcp _socket_tcp, fn_socket_tcp_accept pfn_tcp_accept_callback, void *const p_tcp_accept_callback_parameter )
 {
 
@@ -129,7 +174,7 @@ int socket_tcp_listen ( socket_tcp _socket_tcp, fn_socket_tcp_accept pfn_tcp_acc
     socket_ip_address ip_address = { 0 };
 
     // listen for connections
-    if ( listen(_socket_tcp, 1) == -1 ) goto failed_to_listen;
+    if ( listen(_socket_tcp, SOMAXCONN) == -1 ) goto failed_to_listen;
 
     // accept a new connection
     new_socket = accept(_socket_tcp, (struct sockaddr *)&peer_addr, &addr_len);
@@ -272,6 +317,625 @@ int socket_tcp_send ( socket_tcp _socket_tcp, const void *const p_buffer, size_t
     }
 }
 
+int socket_tcp_zerocopy_enable ( socket_tcp_zerocopy *const p_zerocopy, socket_tcp _socket_tcp )
+{
+
+    // argument check
+    if ( p_zerocopy == (void *) 0 ) goto no_zerocopy;
+
+    // store the socket
+    *p_zerocopy = (socket_tcp_zerocopy)
+    {
+        ._socket_tcp = _socket_tcp,
+        .enabled     = false,
+        .sent        = 0,
+        .completed   = 0,
+        .copied      = 0
+    };
+
+    // platform dependent implementation
+    #if defined(__linux__) && defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+    {
+
+        // initialized data
+        int option = 1;
+
+        // ask the kernel for zero copy sends. if it says no, every send copies
+        p_zerocopy->enabled = ( setsockopt(_socket_tcp, SOL_SOCKET, SO_ZEROCOPY, &option, sizeof(option)) == 0 );
+    }
+    #endif
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_zerocopy:
+                #ifndef NDEBUG
+                    log_error("[socket] Null pointer provided for parameter \"p_zerocopy\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int socket_tcp_send_zerocopy ( socket_tcp_zerocopy *const p_zerocopy, const void *const p_buffer, size_t buffer_len, unsigned int *const p_ticket )
+{
+
+    // argument check
+    if ( p_zerocopy == (void *) 0 ) goto no_zerocopy;
+    if ( p_buffer   == (void *) 0 ) goto no_buffer;
+    if ( p_ticket   == (void *) 0 ) goto no_ticket;
+
+    // initialized data
+    const char  *p_next    = p_buffer;
+    size_t       remaining = buffer_len;
+    unsigned int sent      = p_zerocopy->sent;
+    int          flags     = 0;
+    ssize_t      result    = -1;
+
+    // small buffers are cheaper to copy than to pin
+    #if defined(__linux__) && defined(MSG_ZEROCOPY)
+        if ( p_zerocopy->enabled && buffer_len >= SOCKET_TCP_ZEROCOPY_MIN ) flags = MSG_ZEROCOPY;
+    #endif
+
+    // send every byte
+    while ( remaining )
+    {
+
+        // send data to the TCP socket
+        result = send(p_zerocopy->_socket_tcp, p_next, remaining, flags);
+
+        // error check
+        if ( result == -1 )
+        {
+
+            // interrupted
+            if ( errno == EINTR ) continue;
+
+            // out of memory for pinned pages. copy the rest
+            if ( errno == ENOBUFS && flags ) { flags = 0; continue; }
+
+            // error
+            goto failed_to_send;
+        }
+
+        // each zero copy send gets the next notification id
+        if ( flags ) p_zerocopy->sent++;
+
+        // advance
+        p_next    += result;
+        remaining -= (size_t) result;
+    }
+
+    // a copied buffer may be reused now, else once its last zero copy send is done
+    *p_ticket = ( p_zerocopy->sent == sent ) ? p_zerocopy->completed : p_zerocopy->sent;
+
+    // success
+    return (int) buffer_len;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_zerocopy:
+                #ifndef NDEBUG
+                    log_error("[socket] Null pointer provided for parameter \"p_zerocopy\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_buffer:
+                #ifndef NDEBUG
+                    log_error("[socket] Null pointer provided for parameter \"p_buffer\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_ticket:
+                #ifndef NDEBUG
+                    log_error("[socket] Null pointer provided for parameter \"p_ticket\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // socket errors
+        {
+            failed_to_send:
+                #ifndef NDEBUG
+                    log_error("[socket] Call to \"send\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int socket_tcp_zerocopy_reap ( socket_tcp_zerocopy *const p_zerocopy, bool block )
+{
+
+    // argument check
+    if ( p_zerocopy == (void *) 0 ) goto no_zerocopy;
+
+    // platform dependent implementation
+    #if defined(__linux__) && defined(MSG_ZEROCOPY)
+    {
+
+        // initialized data
+        bool reaped = false;
+
+        // read every pending notification
+        while ( p_zerocopy->sent != p_zerocopy->completed )
+        {
+
+            // initialized data
+            char control[CMSG_SPACE(sizeof(struct sock_extended_err)) + 64];
+            struct msghdr message =
+            {
+                .msg_control    = control,
+                .msg_controllen = sizeof(control)
+            };
+            struct pollfd poll_fd =
+            {
+                .fd     = p_zerocopy->_socket_tcp,
+                .events = 0
+            };
+
+            // read a notification from the error queue
+            if ( recvmsg(p_zerocopy->_socket_tcp, &message, MSG_ERRQUEUE | MSG_DONTWAIT) == -1 )
+            {
+
+                // interrupted
+                if ( errno == EINTR ) continue;
+
+                // error
+                if ( errno != EAGAIN && errno != EWOULDBLOCK ) goto failed_to_receive;
+
+                // done
+                if ( block == false || reaped ) break;
+
+                // wait for the error queue. the kernel reports it as POLLERR
+                if ( poll(&poll_fd, 1, -1) == -1 && errno != EINTR ) goto failed_to_poll;
+
+                // try again
+                continue;
+            }
+
+            // iterate through each control message
+            for ( struct cmsghdr *p_cmsg = CMSG_FIRSTHDR(&message); p_cmsg; p_cmsg = CMSG_NXTHDR(&message, p_cmsg) )
+            {
+
+                // initialized data
+                struct sock_extended_err extended_error = { 0 };
+
+                // skip anything that is not an extended error
+                if ( !( ( p_cmsg->cmsg_level == IPPROTO_IP   && p_cmsg->cmsg_type == IP_RECVERR   ) ||
+                        ( p_cmsg->cmsg_level == IPPROTO_IPV6 && p_cmsg->cmsg_type == IPV6_RECVERR ) ) ) continue;
+
+                // copy the extended error
+                memcpy(&extended_error, CMSG_DATA(p_cmsg), sizeof(extended_error));
+
+                // skip anything that is not a zero copy notification
+                if ( extended_error.ee_origin != SO_EE_ORIGIN_ZEROCOPY ) continue;
+
+                // the notification covers ids ee_info through ee_data. TCP completes them in order
+                p_zerocopy->completed = extended_error.ee_data + 1;
+
+                // the kernel copied the buffer anyway
+                if ( extended_error.ee_code & SO_EE_CODE_ZEROCOPY_COPIED ) p_zerocopy->copied += extended_error.ee_data - extended_error.ee_info + 1;
+
+                // set the flag
+                reaped = true;
+            }
+        }
+    }
+    #else
+
+        // every send copied
+        (void) block;
+    #endif
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_zerocopy:
+                #ifndef NDEBUG
+                    log_error("[socket] Null pointer provided for parameter \"p_zerocopy\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // socket errors
+        #if defined(__linux__) && defined(MSG_ZEROCOPY)
+        {
+            failed_to_receive:
+                #ifndef NDEBUG
+                    log_error("[socket] Call to \"recvmsg\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            failed_to_poll:
+                #ifndef NDEBUG
+                    log_error("[socket] Call to \"poll\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+        #endif
+    }
+}
+
+bool socket_tcp_zerocopy_done ( socket_tcp_zerocopy *const p_zerocopy, unsigned int ticket )
+{
+
+    // argument check
+    if ( p_zerocopy == (void *) 0 ) goto no_zerocopy;
+
+    // done if the kernel completed every send up to the ticket. survives wrap around
+    return (int) ( p_zerocopy->completed - ticket ) >= 0;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_zerocopy:
+                #ifndef NDEBUG
+                    log_error("[socket] Null pointer provided for parameter \"p_zerocopy\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return false;
+        }
+    }
+}
+
+int socket_tcp_zerocopy_flush ( socket_tcp_zerocopy *const p_zerocopy )
+{
+
+    // argument check
+    if ( p_zerocopy == (void *) 0 ) goto no_zerocopy;
+
+    // wait for every zero copy send
+    while ( p_zerocopy->sent != p_zerocopy->completed )
+        if ( socket_tcp_zerocopy_reap(p_zerocopy, true) == 0 ) goto failed_to_reap;
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_zerocopy:
+                #ifndef NDEBUG
+                    log_error("[socket] Null pointer provided for parameter \"p_zerocopy\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // socket errors
+        {
+            failed_to_reap:
+                #ifndef NDEBUG
+                    log_error("[socket] Failed to reap zero copy notifications in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int socket_tcp_receivev ( socket_tcp _socket_tcp, const struct iovec *const p_segments, size_t segment_quantity )
+{
+
+    // argument check
+    if ( p_segments == (void *) 0 ) goto no_segments;
+
+    // initialized data
+    struct msghdr message = 
+    {
+        .msg_iov    = (struct iovec *) p_segments,
+        .msg_iovlen = segment_quantity
+    };
+    int r = (int) recvmsg(_socket_tcp, &message, 0);
+
+    // error check
+    if ( r < 0 ) goto failed_to_recv;
+
+    // success
+    return r;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_segments:
+                #ifndef NDEBUG
+                    log_error("[socket] Null pointer provided for parameter \"p_segments\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif 
+
+                // error
+                return 0;
+        }
+
+        // socket errors
+        {
+            failed_to_recv:
+                #ifndef NDEBUG
+                    log_error("[socket] Call to \"recvmsg\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int socket_tcp_sendv ( socket_tcp _socket_tcp, const struct iovec *const p_segments, size_t segment_quantity )
+{
+
+    // argument check
+    if ( p_segments == (void *) 0 ) goto no_segments;
+
+    // initialized data
+    struct msghdr message = 
+    {
+        .msg_iov    = (struct iovec *) p_segments,
+        .msg_iovlen = segment_quantity
+    };
+    int result = -1;
+
+    // send data to the TCP socket
+    result = (int) sendmsg(_socket_tcp, &message, 0);
+    if ( result == -1 ) goto failed_to_send;
+
+    // success
+    return result;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_segments:
+                #ifndef NDEBUG
+                    log_error("[socket] Null pointer provided for parameter \"p_segments\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif 
+
+                // error
+                return 0;
+        }
+
+        // socket errors
+        {
+            failed_to_send:
+                #ifndef NDEBUG
+                    log_error("[socket] Call to \"sendmsg\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+void socket_tcp_segments_advance ( struct iovec *const p_segments, size_t *const p_index, size_t quantity, size_t transferred )
+{
+
+    // initialized data
+    size_t i = *p_index;
+
+    // skip the segments that were moved in full
+    for (; i < quantity && transferred >= p_segments[i].iov_len; i++)
+        transferred -= p_segments[i].iov_len;
+
+    // advance into a partially moved segment
+    if ( i < quantity )
+        p_segments[i].iov_base  = (char *) p_segments[i].iov_base + transferred,
+        p_segments[i].iov_len  -= transferred;
+
+    // store the index
+    *p_index = i;
+
+    // done
+    return;
+}
+
+int socket_tcp_receivev_all ( socket_tcp _socket_tcp, const struct iovec *const p_segments, size_t segment_quantity )
+{
+
+    // argument check
+    if ( p_segments       ==              (void *) 0 ) goto no_segments;
+    if ( segment_quantity > SOCKET_TCP_SEGMENTS_MAX ) goto too_many_segments;
+
+    // initialized data
+    struct iovec _segments[SOCKET_TCP_SEGMENTS_MAX] = { 0 };
+    size_t       total                              = 0,
+                 received                           = 0,
+                 i                                  = 0;
+
+    // copy the segments, so they can be advanced
+    for (size_t j = 0; j < segment_quantity; j++)
+        _segments[j] = p_segments[j],
+        total       += p_segments[j].iov_len;
+
+    // until every buffer is full
+    while ( received < total )
+    {
+
+        // initialized data
+        struct msghdr message = 
+        {
+            .msg_iov    = &_segments[i],
+            .msg_iovlen = segment_quantity - i
+        };
+        ssize_t r = recvmsg(_socket_tcp, &message, 0);
+
+        // retry after a signal
+        if ( r < 0 && errno == EINTR ) continue;
+
+        // error check
+        if ( r <  0 ) goto failed_to_recv;
+        if ( r == 0 ) goto connection_closed;
+
+        // update received bytes
+        received += (size_t) r;
+
+        // skip past the received bytes
+        socket_tcp_segments_advance(_segments, &i, segment_quantity, (size_t) r);
+    }
+
+    // success
+    return (int) received;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_segments:
+                #ifndef NDEBUG
+                    log_error("[socket] Null pointer provided for parameter \"p_segments\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif 
+
+                // error
+                return 0;
+
+            too_many_segments:
+                #ifndef NDEBUG
+                    log_error("[socket] Parameter \"segment_quantity\" must be at most %d in call to function \"%s\"\n", SOCKET_TCP_SEGMENTS_MAX, __FUNCTION__);
+                #endif 
+
+                // error
+                return 0;
+        }
+
+        // socket errors
+        {
+            failed_to_recv:
+                #ifndef NDEBUG
+                    log_error("[socket] Call to \"recvmsg\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            connection_closed:
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int socket_tcp_sendv_all ( socket_tcp _socket_tcp, const struct iovec *const p_segments, size_t segment_quantity )
+{
+
+    // argument check
+    if ( p_segments       ==              (void *) 0 ) goto no_segments;
+    if ( segment_quantity > SOCKET_TCP_SEGMENTS_MAX ) goto too_many_segments;
+
+    // initialized data
+    struct iovec _segments[SOCKET_TCP_SEGMENTS_MAX] = { 0 };
+    size_t       total                              = 0,
+                 sent                               = 0,
+                 i                                  = 0;
+
+    // copy the segments, so they can be advanced
+    for (size_t j = 0; j < segment_quantity; j++)
+        _segments[j] = p_segments[j],
+        total       += p_segments[j].iov_len;
+
+    // until every buffer is sent
+    while ( sent < total )
+    {
+
+        // initialized data
+        struct msghdr message = 
+        {
+            .msg_iov    = &_segments[i],
+            .msg_iovlen = segment_quantity - i
+        };
+        ssize_t r = sendmsg(_socket_tcp, &message, 0);
+
+        // retry after a signal
+        if ( r < 0 && errno == EINTR ) continue;
+
+        // error check
+        if ( r <= 0 ) goto failed_to_send;
+
+        // update sent bytes
+        sent += (size_t) r;
+
+        // skip past the sent bytes
+        socket_tcp_segments_advance(_segments, &i, segment_quantity, (size_t) r);
+    }
+
+    // success
+    return (int) sent;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_segments:
+                #ifndef NDEBUG
+                    log_error("[socket] Null pointer provided for parameter \"p_segments\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif 
+
+                // error
+                return 0;
+
+            too_many_segments:
+                #ifndef NDEBUG
+                    log_error("[socket] Parameter \"segment_quantity\" must be at most %d in call to function \"%s\"\n", SOCKET_TCP_SEGMENTS_MAX, __FUNCTION__);
+                #endif 
+
+                // error
+                return 0;
+        }
+
+        // socket errors
+        {
+            failed_to_send:
+                #ifndef NDEBUG
+                    log_error("[socket] Call to \"sendmsg\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
 int socket_tcp_connect ( socket_tcp *const p_socket_tcp, enum socket_address_family_e address_family, socket_ip_address ip_address, socket_port port_number )
 {
 
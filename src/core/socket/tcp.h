@@ -13,6 +13,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdbool.h>
 #include <errno.h>
 
 // posix
@@ -22,16 +23,36 @@
 #include <arpa/inet.h>
 #include <netdb.h>
 #include <unistd.h>
+#include <sys/uio.h>
+#include <poll.h>
 
 // gsdk
 /// core
 #include <core/log.h>
 #include <core/socket.h>
 
+// preprocessor definitions
+#define SOCKET_TCP_ZEROCOPY_MIN 16384
+#define SOCKET_TCP_SEGMENTS_MAX 16
+
+// structure declarations
+struct socket_tcp_zerocopy_s;
+
 // type definitions
 typedef int socket_tcp;
+typedef struct socket_tcp_zerocopy_s socket_tcp_zerocopy;
 typedef int(*fn_socket_tcp_accept)( socket_tcp _socket_tcp, socket_ip_address ip_address, socket_port port_number, void *const p_parameter );
 
+// structure definitions
+struct socket_tcp_zerocopy_s
+{
+    socket_tcp   _socket_tcp; // the TCP socket
+    bool         enabled;     // true if the kernel accepted SO_ZEROCOPY, else false
+    unsigned int sent;        // the quantity of zero copy sends
+    unsigned int completed;   // the quantity of zero copy sends the kernel is done with
+    size_t       copied;      // the quantity of zero copy sends the kernel copied anyway
+};
+
 /// construct
 /** !
  * Create a TCP socket
@@ -44,6 +65,18 @@ typedef int(*fn_socket_tcp_accept)( socket_tcp _socket_tcp, socket_ip_address ip
  */
 int socket_tcp_create ( socket_tcp *const p_socket_tcp, enum socket_address_family_e address_family, socket_port port_number );
 
+/** !
+ * Create a TCP socket that shares its port with other sockets made
+ * by this function. The kernel balances connections across the sockets.
+ * 
+ * @param p_socket_tcp   return
+ * @param address_family socket_address_family_ipv4 -or- socket_address_family_ipv6
+ * @param port_number    the port number
+ * 
+ * @return 1 on success, 0 on error
+ */
+int socket_tcp_create_reuse_port ( socket_tcp *const p_socket_tcp, enum socket_address_family_e address_family, socket_port port_number );
+
 /// listen
 /** !
  * Block and listen for a connection on a TCP socket, then call pfn_tcp_accept_callback.
@@ -83,6 +116,129 @@ int socket_tcp_receive ( socket_tcp _socket_tcp, void *const p_buffer, size_t bu
  */
 int socket_tcp_send ( socket_tcp _socket_tcp, const void *const p_buffer, size_t buffer_len );
 
+/// zero copy send
+/** !
+ * Enable zero copy sends on a TCP socket. If the platform can not send
+ * without copying, every send copies, and every ticket is done at once.
+ * 
+ * @param p_zerocopy  result
+ * @param _socket_tcp the TCP socket
+ * 
+ * @sa socket_tcp_send_zerocopy
+ * 
+ * @return 1 on success, 0 on error
+ */
+int socket_tcp_zerocopy_enable ( socket_tcp_zerocopy *const p_zerocopy, socket_tcp _socket_tcp );
+
+/** !
+ * Send data to a TCP socket without copying it into the kernel. The 
+ * kernel reads p_buffer after this function returns, so p_buffer must 
+ * not be modified or freed until its ticket is done. Buffers smaller 
+ * than SOCKET_TCP_ZEROCOPY_MIN bytes are copied, because pinning the 
+ * pages costs more than copying them.
+ * 
+ * @param p_zerocopy the zero copy TCP socket
+ * @param p_buffer   the data to send
+ * @param buffer_len the size of the data in bytes
+ * @param p_ticket   result
+ * 
+ * @sa socket_tcp_zerocopy_done
+ * 
+ * @return bytes sent on success, 0 on error
+ */
+int socket_tcp_send_zerocopy ( socket_tcp_zerocopy *const p_zerocopy, const void *const p_buffer, size_t buffer_len, unsigned int *const p_ticket );
+
+/** !
+ * Read completion notifications from the kernel
+ * 
+ * @param p_zerocopy the zero copy TCP socket
+ * @param block      true to wait for a notification if a send is in flight, else false
+ * 
+ * @return 1 on success, 0 on error
+ */
+int socket_tcp_zerocopy_reap ( socket_tcp_zerocopy *const p_zerocopy, bool block );
+
+/** !
+ * Test if the buffer of a zero copy send may be reused
+ * 
+ * @param p_zerocopy the zero copy TCP socket
+ * @param ticket     the ticket of the send
+ * 
+ * @sa socket_tcp_zerocopy_reap
+ * 
+ * @return true if the buffer may be reused, else false
+ */
+bool socket_tcp_zerocopy_done ( socket_tcp_zerocopy *const p_zerocopy, unsigned int ticket );
+
+/** !
+ * Wait until the buffer of every zero copy send may be reused
+ * 
+ * @param p_zerocopy the zero copy TCP socket
+ * 
+ * @return 1 on success, 0 on error
+ */
+int socket_tcp_zerocopy_flush ( socket_tcp_zerocopy *const p_zerocopy );
+
+/// vectored receive
+/** !
+ * Receive data from a TCP socket, and scatter it across a list of buffers
+ * in a single system call. The read may be short; callers that need every
+ * byte should loop, or use socket_tcp_receivev_all
+ * 
+ * @param _socket_tcp      the TCP socket
+ * @param p_segments       the buffers
+ * @param segment_quantity the quantity of buffers
+ * 
+ * @sa socket_tcp_sendv
+ * @sa socket_tcp_receivev_all
+ * 
+ * @return bytes read success, 0 on error
+ */
+int socket_tcp_receivev ( socket_tcp _socket_tcp, const struct iovec *const p_segments, size_t segment_quantity );
+
+/** !
+ * Receive data from a TCP socket until a list of buffers is full
+ * 
+ * @param _socket_tcp      the TCP socket
+ * @param p_segments       the buffers
+ * @param segment_quantity the quantity of buffers, at most SOCKET_TCP_SEGMENTS_MAX
+ * 
+ * @sa socket_tcp_receivev
+ * 
+ * @return bytes read on success, 0 on error or if the peer closed the connection first
+ */
+int socket_tcp_receivev_all ( socket_tcp _socket_tcp, const struct iovec *const p_segments, size_t segment_quantity );
+
+/// vectored send
+/** !
+ * Gather data from a list of buffers, and send it to a TCP socket in a 
+ * single system call. The send may be short; callers that need every
+ * byte sent should loop, or use socket_tcp_sendv_all
+ * 
+ * @param _socket_tcp      the TCP socket
+ * @param p_segments       the buffers
+ * @param segment_quantity the quantity of buffers
+ * 
+ * @sa socket_tcp_receivev
+ * @sa socket_tcp_sendv_all
+ * 
+ * @return bytes sent on success, 0 on error
+ */
+int socket_tcp_sendv ( socket_tcp _socket_tcp, const struct iovec *const p_segments, size_t segment_quantity );
+
+/** !
+ * Send every byte of a list of buffers to a TCP socket
+ * 
+ * @param _socket_tcp      the TCP socket
+ * @param p_segments       the buffers
+ * @param segment_quantity the quantity of buffers, at most SOCKET_TCP_SEGMENTS_MAX
+ * 
+ * @sa socket_tcp_sendv
+ * 
+ * @return bytes sent on success, 0 on error
+ */
+int socket_tcp_sendv_all ( socket_tcp _socket_tcp, const struct iovec *const p_segments, size_t segment_quantity );
+
 /// connect
 /** !
  * Connect to a TCP socket
@@ -6,10 +6,43 @@
  * @author Jacob Smith
  */
 
+// feature test macros, for batched messages
+#define _GNU_SOURCE
+
 // header
 #include <core/udp.h>
 
-int socket_udp_create ( socket_udp *const p_socket_udp, enum socket_address_family_e address_family, socket_port port_number )
+// platform dependent includes
+#ifdef __linux__
+    #include <netinet/udp.h>
+#endif
+
+// function declarations
+/** !
+ * Store an IP address and a port in a socket address
+ * 
+ * @param p_address  result
+ * @param ip_address the IP address
+ * @param port       the port number
+ * 
+ * @return the size of the socket address
+ */
+socklen_t socket_udp_address_pack ( struct sockaddr_storage *const p_address, socket_ip_address ip_address, socket_port port );
+
+/** !
+ * Load an IP address and a port from a socket address
+ * 
+ * @param p_address    the socket address
+ * @param p_ip_address result
+ * @param p_port       result
+ * 
+ * @return void
+ */
+void socket_udp_address_unpack ( const struct sockaddr_storage *const p_address, socket_ip_address *const p_ip_address, socket_port *const p_port );
+
+// function definitions
+
+int socket_udp_open ( socket_udp *const p_socket_udp, enum socket_address_family_e address_family, socket_port port_number, bool reuse_port )
 {
 
     // argument check
@@ -33,6 +66,9 @@ int socket_udp_create ( socket_udp *const p_socket_udp, enum socket_address_fami
         // error check
         if ( _socket_udp == INVALID_SOCKET ) goto failed_to_create_socket;
 
+        // SO_REUSEPORT is not available
+        if ( reuse_port ) goto failed_to_set_socket_option;
+
     #else
 
         // create the socket
@@ -44,6 +80,9 @@ int socket_udp_create ( socket_udp *const p_socket_udp, enum socket_address_fami
         // set socket options
         if ( setsockopt(_socket_udp, SOL_SOCKET, SO_REUSEADDR, &option, sizeof(option)) == -1 ) goto failed_to_set_socket_option;
 
+        // share the port with other sockets
+        if ( reuse_port && setsockopt(_socket_udp, SOL_SOCKET, SO_REUSEPORT, &option, sizeof(option)) == -1 ) goto failed_to_set_socket_option;
+
         // bind the socket to the port
         if ( address_family == socket_address_family_ipv4 )
         {
@@ -122,6 +161,20 @@ int socket_udp_create ( socket_udp *const p_socket_udp, enum socket_address_fami
     }
 }
 
+int socket_udp_create ( socket_udp *const p_socket_udp, enum socket_address_family_e address_family, socket_port port_number )
+{
+
+    // create a socket
+    return socket_udp_open(p_socket_udp, address_family, port_number, false);
+}
+
+int socket_udp_create_reuse_port ( socket_udp *const p_socket_udp, enum socket_address_family_e address_family, socket_port port_number )
+{
+
+    // create a socket that shares its port
+    return socket_udp_open(p_socket_udp, address_family, port_number, true);
+}
+
 int socket_udp_listen ( socket_udp _socket_udp, fn_socket_udp_accept pfn_udp_accept_callback, void *const p_udp_accept_callback_parameter )
 {
 
@@ -301,6 +354,476 @@ int socket_udp_send_to ( socket_udp _socket_udp, const void *const p_buffer, siz
     }
 }
 
+socklen_t socket_udp_address_pack ( struct sockaddr_storage *const p_address, socket_ip_address ip_address, socket_port port )
+{
+
+    // IPv4
+    if ( ip_address._type == socket_address_family_ipv4 )
+    {
+        struct sockaddr_in *s = (struct sockaddr_in *)p_address;
+        s->sin_family      = AF_INET;
+        s->sin_port        = htons(port);
+        s->sin_addr.s_addr = htonl(ip_address._address.ipv4);
+        return sizeof(struct sockaddr_in);
+    }
+
+    // IPv6
+    else if ( ip_address._type == socket_address_family_ipv6 )
+    {
+        struct sockaddr_in6 *s = (struct sockaddr_in6 *)p_address;
+        s->sin6_family = AF_INET6;
+        s->sin6_port   = htons(port);
+        memcpy(s->sin6_addr.s6_addr, ip_address._address.ipv6, 16);
+        return sizeof(struct sockaddr_in6);
+    }
+
+    // done
+    return 0;
+}
+
+void socket_udp_address_unpack ( const struct sockaddr_storage *const p_address, socket_ip_address *const p_ip_address, socket_port *const p_port )
+{
+
+    // store the type
+    p_ip_address->_type = (enum socket_address_family_e) ( ( p_address->ss_family == AF_INET ) ? socket_address_family_ipv4 : socket_address_family_ipv6 );
+
+    // store the address
+    if ( p_address->ss_family == AF_INET )
+    {
+        struct sockaddr_in *s = (struct sockaddr_in *)p_address;
+        p_ip_address->_address.ipv4 = ntohl(s->sin_addr.s_addr);
+    }
+    else if ( p_address->ss_family == AF_INET6 )
+    {
+        struct sockaddr_in6 *s = (struct sockaddr_in6 *)p_address;
+        memcpy(p_ip_address->_address.ipv6, s->sin6_addr.s6_addr, 16);
+    }
+
+    // store the port
+    *p_port = (unsigned short)ntohs(((struct sockaddr_in *)p_address)->sin_port);
+
+    // done
+    return;
+}
+
+int socket_udp_receive_batch ( socket_udp _socket_udp, socket_udp_message *const p_messages, size_t quantity )
+{
+
+    // argument check
+    if ( p_messages == (void *) 0 ) goto no_messages;
+    if ( quantity   ==          0 ) goto no_quantity;
+
+    // clamp the quantity
+    if ( quantity > SOCKET_UDP_BATCH_MAX ) quantity = SOCKET_UDP_BATCH_MAX;
+
+    // platform dependent implementation
+    #ifdef __linux__
+
+        // initialized data
+        struct mmsghdr          _headers[SOCKET_UDP_BATCH_MAX]   = { 0 };
+        struct iovec            _segments[SOCKET_UDP_BATCH_MAX]  = { 0 };
+        struct sockaddr_storage _addresses[SOCKET_UDP_BATCH_MAX] = { 0 };
+        union
+        {
+            char           _buffer[CMSG_SPACE(sizeof(int))];
+            struct cmsghdr _align;
+        } _control[SOCKET_UDP_BATCH_MAX];
+        int r = 0;
+
+        // describe each message
+        for (size_t i = 0; i < quantity; i++)
+        {
+            _segments[i] = (struct iovec) { .iov_base = p_messages[i].p_buffer, .iov_len = p_messages[i].buffer_len };
+            _headers[i].msg_hdr = (struct msghdr)
+            {
+                .msg_name       = &_addresses[i],
+                .msg_namelen    = sizeof(struct sockaddr_storage),
+                .msg_iov        = &_segments[i],
+                .msg_iovlen     = 1,
+                .msg_control    = _control[i]._buffer,
+                .msg_controllen = sizeof(_control[i]._buffer)
+            };
+        }
+
+        // wait for the first datagram, then take every queued datagram
+        r = recvmmsg(_socket_udp, _headers, (unsigned int) quantity, MSG_WAITFORONE, (void *) 0);
+
+        // error check
+        if ( r < 1 ) goto failed_to_recv;
+
+        // store each message
+        for (int i = 0; i < r; i++)
+        {
+
+            // store the size
+            p_messages[i].size         = _headers[i].msg_len,
+            p_messages[i].segment_size = 0;
+
+            // store the peer
+            socket_udp_address_unpack(&_addresses[i], &p_messages[i].ip_address, &p_messages[i].port);
+
+            // store the size of coalesced datagrams
+            for (struct cmsghdr *p_cmsg = CMSG_FIRSTHDR(&_headers[i].msg_hdr); p_cmsg; p_cmsg = CMSG_NXTHDR(&_headers[i].msg_hdr, p_cmsg))
+            {
+
+                // initialized data
+                int segment_size = 0;
+
+                // skip other messages
+                if ( p_cmsg->cmsg_level != IPPROTO_UDP || p_cmsg->cmsg_type != UDP_GRO ) continue;
+
+                // store the segment size
+                memcpy(&segment_size, CMSG_DATA(p_cmsg), sizeof(int));
+                p_messages[i].segment_size = (size_t) segment_size;
+            }
+        }
+    #else
+
+        // initialized data
+        int r = socket_udp_receive_from(_socket_udp, p_messages[0].p_buffer, p_messages[0].buffer_len, &p_messages[0].ip_address, &p_messages[0].port);
+
+        // error check
+        if ( r < 1 ) return 0;
+
+        // store the size
+        p_messages[0].size         = (size_t) r,
+        p_messages[0].segment_size = 0;
+
+        // one message
+        r = 1;
+    #endif
+
+    // success
+    return r;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_messages:
+                #ifndef NDEBUG
+                    printf("[socket] Null pointer provided for parameter \"p_messages\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif 
+
+                // error
+                return 0;
+
+            no_quantity:
+                #ifndef NDEBUG
+                    printf("[socket] Parameter \"quantity\" must be greater than 0 in call to function \"%s\"\n", __FUNCTION__);
+                #endif 
+
+                // error
+                return 0;
+        }
+
+        // socket errors
+        {
+            #ifdef __linux__
+            failed_to_recv:
+                #ifndef NDEBUG
+                    printf("[socket] Call to \"recvmmsg\" returned an erroneous value in call to function \"%s\": %s (%d)\n", __FUNCTION__, strerror(errno), errno);
+                #endif
+
+                // error
+                return 0;
+            #endif
+        }
+    }
+}
+
+int socket_udp_send_batch ( socket_udp _socket_udp, const socket_udp_message *const p_messages, size_t quantity )
+{
+
+    // argument check
+    if ( p_messages == (void *) 0 ) goto no_messages;
+
+    // initialized data
+    size_t sent = 0;
+
+    // platform dependent implementation
+    #ifdef __linux__
+
+        // initialized data
+        struct mmsghdr          _headers[SOCKET_UDP_BATCH_MAX];
+        struct iovec            _segments[SOCKET_UDP_BATCH_MAX];
+        struct sockaddr_storage _addresses[SOCKET_UDP_BATCH_MAX];
+
+        // send each batch
+        while ( sent < quantity )
+        {
+
+            // initialized data
+            size_t batch = ( quantity - sent > SOCKET_UDP_BATCH_MAX ) ? SOCKET_UDP_BATCH_MAX : quantity - sent;
+            int    r     = 0;
+
+            // describe each message
+            for (size_t i = 0; i < batch; i++)
+            {
+
+                // initialized data
+                const socket_udp_message *p_message = &p_messages[sent + i];
+
+                // clear the address
+                memset(&_addresses[i], 0, sizeof(struct sockaddr_storage));
+
+                // describe the message
+                _segments[i] = (struct iovec) { .iov_base = p_message->p_buffer, .iov_len = p_message->buffer_len };
+                _headers[i]  = (struct mmsghdr)
+                {
+                    .msg_hdr =
+                    {
+                        .msg_name    = &_addresses[i],
+                        .msg_namelen = socket_udp_address_pack(&_addresses[i], p_message->ip_address, p_message->port),
+                        .msg_iov     = &_segments[i],
+                        .msg_iovlen  = 1
+                    }
+                };
+            }
+
+            // send the batch
+            r = sendmmsg(_socket_udp, _headers, (unsigned int) batch, 0);
+
+            // error check
+            if ( r < 1 ) goto failed_to_send;
+
+            // update the counter
+            sent += (size_t) r;
+        }
+    #else
+
+        // send each message
+        for (; sent < quantity; sent++)
+            if ( 0 == socket_udp_send_to(_socket_udp, p_messages[sent].p_buffer, p_messages[sent].buffer_len, p_messages[sent].ip_address, p_messages[sent].port) ) goto failed_to_send;
+    #endif
+
+    // success
+    return (int) sent;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_messages:
+                #ifndef NDEBUG
+                    printf("[socket] Null pointer provided for parameter \"p_messages\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif 
+
+                // error
+                return 0;
+        }
+
+        // socket errors
+        {
+            failed_to_send:
+                #ifndef NDEBUG
+                    printf("[socket] Call to \"sendmmsg\" returned an erroneous value in call to function \"%s\": %s (%d)\n", __FUNCTION__, strerror(errno), errno);
+                #endif
+
+                // the messages before the failed message were sent
+                return (int) sent;
+        }
+    }
+}
+
+int socket_udp_send_segmented ( socket_udp _socket_udp, const void *const p_buffer, size_t buffer_len, size_t segment_size, socket_ip_address ip_address, socket_port port )
+{
+
+    // argument check
+    if ( p_buffer     == (void *) 0 ) goto no_buffer;
+    if ( segment_size ==          0 ) goto no_segment_size;
+
+    // initialized data
+    const char         *p_data    = p_buffer;
+    size_t              offset    = 0;
+    socket_udp_message  _messages[SOCKET_UDP_BATCH_MAX];
+
+    // platform dependent implementation
+    #ifdef __linux__
+    {
+
+        // initialized data
+        struct sockaddr_storage _address  = { 0 };
+        socklen_t               addr_len  = socket_udp_address_pack(&_address, ip_address, port);
+        size_t                  segments  = SOCKET_UDP_PAYLOAD_MAX / segment_size;
+        union
+        {
+            char           _buffer[CMSG_SPACE(sizeof(unsigned short))];
+            struct cmsghdr _align;
+        } _control = { 0 };
+
+        // clamp the quantity of segments per call
+        if ( segments > SOCKET_UDP_SEGMENTS_MAX ) segments = SOCKET_UDP_SEGMENTS_MAX;
+
+        // hand the kernel many datagrams per call
+        while ( segments > 1 && offset < buffer_len )
+        {
+
+            // initialized data
+            size_t          len       = ( buffer_len - offset > segments * segment_size ) ? segments * segment_size : buffer_len - offset;
+            unsigned short  gso_size  = (unsigned short) segment_size;
+            struct iovec    _segment  = { .iov_base = (void *) (p_data + offset), .iov_len = len };
+            struct msghdr   _header   =
+            {
+                .msg_name       = &_address,
+                .msg_namelen    = addr_len,
+                .msg_iov        = &_segment,
+                .msg_iovlen     = 1,
+                .msg_control    = _control._buffer,
+                .msg_controllen = sizeof(_control._buffer)
+            };
+            struct cmsghdr *p_cmsg    = CMSG_FIRSTHDR(&_header);
+
+            // set the segment size
+            p_cmsg->cmsg_level = IPPROTO_UDP,
+            p_cmsg->cmsg_type  = UDP_SEGMENT,
+            p_cmsg->cmsg_len   = CMSG_LEN(sizeof(unsigned short));
+            memcpy(CMSG_DATA(p_cmsg), &gso_size, sizeof(unsigned short));
+
+            // send the segments
+            if ( sendmsg(_socket_udp, &_header, 0) == -1 )
+            {
+
+                // the kernel or the device can not segment, so send batches instead
+                if ( errno == EIO || errno == EINVAL || errno == ENOPROTOOPT || errno == EOPNOTSUPP ) break;
+
+                // error
+                goto failed_to_send;
+            }
+
+            // update the offset
+            offset += len;
+        }
+    }
+    #endif
+
+    // send the rest as batches of datagrams
+    while ( offset < buffer_len )
+    {
+
+        // initialized data
+        size_t batch = 0;
+        size_t start = offset;
+        int    r     = 0;
+
+        // slice the buffer
+        for (; batch < SOCKET_UDP_BATCH_MAX && offset < buffer_len; batch++)
+        {
+
+            // initialized data
+            size_t len = ( buffer_len - offset > segment_size ) ? segment_size : buffer_len - offset;
+
+            // describe the datagram
+            _messages[batch] = (socket_udp_message)
+            {
+                .p_buffer   = (void *) (p_data + offset),
+                .buffer_len = len,
+                .ip_address = ip_address,
+                .port       = port
+            };
+
+            // update the offset
+            offset += len;
+        }
+
+        // send the batch
+        r = socket_udp_send_batch(_socket_udp, _messages, batch);
+
+        // error check
+        if ( r < (int) batch )
+        {
+
+            // store the quantity of bytes that were sent
+            offset = start;
+            for (int i = 0; i < r; i++) offset += _messages[i].buffer_len;
+
+            // error
+            goto failed_to_send;
+        }
+    }
+
+    // success
+    return (int) offset;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_buffer:
+                #ifndef NDEBUG
+                    printf("[socket] Null pointer provided for parameter \"p_buffer\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif 
+
+                // error
+                return 0;
+
+            no_segment_size:
+                #ifndef NDEBUG
+                    printf("[socket] Parameter \"segment_size\" must be greater than 0 in call to function \"%s\"\n", __FUNCTION__);
+                #endif 
+
+                // error
+                return 0;
+        }
+
+        // socket errors
+        {
+            failed_to_send:
+                #ifndef NDEBUG
+                    printf("[socket] Failed to send segments in call to function \"%s\": %s (%d)\n", __FUNCTION__, strerror(errno), errno);
+                #endif
+
+                // the bytes before the failed datagram were sent
+                return (int) offset;
+        }
+    }
+}
+
+int socket_udp_coalesce ( socket_udp _socket_udp, bool enable )
+{
+
+    // platform dependent implementation
+    #ifdef __linux__
+
+        // initialized data
+        int option = enable ? 1 : 0;
+
+        // set the option
+        if ( setsockopt(_socket_udp, IPPROTO_UDP, UDP_GRO, &option, sizeof(option)) == -1 ) goto failed_to_set_socket_option;
+
+        // success
+        return 1;
+    #else
+
+        // unused
+        (void) _socket_udp;
+
+        // coalescing is not available
+        if ( enable ) goto failed_to_set_socket_option;
+
+        // success
+        return 1;
+    #endif
+
+    // error handling
+    {
+
+        // socket errors
+        {
+            failed_to_set_socket_option:
+                #ifndef NDEBUG
+                    printf("[socket] Failed to set UDP GRO in call to function \"%s\": %s (%d)\n", __FUNCTION__, strerror(errno), errno);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
 int socket_udp_connect ( socket_udp *const p_socket_udp, socket_ip_address ip_address, socket_port port_number )
 {
 
@@ -13,6 +13,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdbool.h>
 #include <errno.h>
 
 // posix
@@ -28,10 +29,30 @@
 #include <core/log.h>
 #include <core/socket.h>
 
+// preprocessor definitions
+#define SOCKET_UDP_BATCH_MAX    64
+#define SOCKET_UDP_SEGMENTS_MAX 64
+#define SOCKET_UDP_PAYLOAD_MAX  65507
+
+// structure declarations
+struct socket_udp_message_s;
+
 // type definitions
 typedef int socket_udp;
+typedef struct socket_udp_message_s socket_udp_message;
 typedef int(*fn_socket_udp_accept)( socket_udp _socket_udp, socket_ip_address ip_address, socket_port port_number, void *const p_parameter );
 
+// structure definitions
+struct socket_udp_message_s
+{
+    void              *p_buffer;     // the datagram
+    size_t             buffer_len;   // the size of the datagram when sending, the size of p_buffer when receiving
+    size_t             size;         // the quantity of bytes received
+    size_t             segment_size; // the size of each coalesced datagram IF coalesced ELSE 0
+    socket_ip_address  ip_address;   // the IP address of the peer
+    socket_port        port;         // the port number of the peer
+};
+
 /// construct
 /** !
  * Create a UDP socket
@@ -44,6 +65,18 @@ typedef int(*fn_socket_udp_accept)( socket_udp _socket_udp, socket_ip_address ip
  */
 int socket_udp_create ( socket_udp *const p_socket_udp, enum socket_address_family_e address_family, socket_port port_number );
 
+/** !
+ * Create a UDP socket that shares its port with other sockets made
+ * by this function. The kernel balances datagrams across the sockets.
+ * 
+ * @param p_socket_udp   return
+ * @param address_family socket_address_family_ipv4 -or- socket_address_family_ipv6
+ * @param port_number    the port number
+ * 
+ * @return 1 on success, 0 on error
+ */
+int socket_udp_create_reuse_port ( socket_udp *const p_socket_udp, enum socket_address_family_e address_family, socket_port port_number );
+
 /// listen
 /** !
  * Block and listen for a connection on a UDP socket, then call pfn_udp_accept_callback.
@@ -83,6 +116,69 @@ int socket_udp_receive_from ( socket_udp _socket_udp, void *const p_buffer, size
  */
 int socket_udp_send_to ( socket_udp _socket_udp, const void *const p_buffer, size_t buffer_len, socket_ip_address ip_address, socket_port port );
 
+/// batch
+/** !
+ * Receive many datagrams from a UDP socket in one system call. Block for
+ * the first datagram, then take each datagram that is already queued, up
+ * to quantity, or SOCKET_UDP_BATCH_MAX. The size, IP address, port and
+ * segment size of each received message are stored.
+ * 
+ * @param _socket_udp the UDP socket
+ * @param p_messages  the messages
+ * @param quantity    the quantity of messages
+ * 
+ * @return the quantity of messages received on success, 0 on error
+ */
+int socket_udp_receive_batch ( socket_udp _socket_udp, socket_udp_message *const p_messages, size_t quantity );
+
+/** !
+ * Send many datagrams from a UDP socket, SOCKET_UDP_BATCH_MAX datagrams
+ * per system call. Each message is sent to its own IP address and port.
+ * An error stops the send at the message that failed, and the messages
+ * before it stay sent.
+ * 
+ * @param _socket_udp the UDP socket
+ * @param p_messages  the messages
+ * @param quantity    the quantity of messages
+ * 
+ * @return the quantity of messages sent, which is less than quantity on error
+ */
+int socket_udp_send_batch ( socket_udp _socket_udp, const socket_udp_message *const p_messages, size_t quantity );
+
+/// segmentation
+/** !
+ * Send a buffer as datagrams of segment_size bytes, the last of which may
+ * be shorter. Where the kernel supports UDP GSO, each system call hands the
+ * kernel up to SOCKET_UDP_SEGMENTS_MAX datagrams as one buffer, else the
+ * datagrams are sent in batches. An error stops the send, and the bytes
+ * before it stay sent.
+ * 
+ * @param _socket_udp  the UDP socket
+ * @param p_buffer     the data to send
+ * @param buffer_len   the size of the data in bytes
+ * @param segment_size the size of each datagram in bytes
+ * @param ip_address   the IP address to send to
+ * @param port         the port number to send to
+ * 
+ * @return the quantity of bytes sent, which is less than buffer_len on error
+ */
+int socket_udp_send_segmented ( socket_udp _socket_udp, const void *const p_buffer, size_t buffer_len, size_t segment_size, socket_ip_address ip_address, socket_port port );
+
+/** !
+ * Let the kernel coalesce consecutive datagrams from the same peer into one
+ * buffer with UDP GRO. A coalesced message holds datagrams of segment_size
+ * bytes, the last of which may be shorter, so receive buffers should hold
+ * SOCKET_UDP_PAYLOAD_MAX bytes.
+ * 
+ * @param _socket_udp the UDP socket
+ * @param enable      true to coalesce datagrams, false to receive them one by one
+ * 
+ * @sa socket_udp_receive_batch
+ * 
+ * @return 1 on success, 0 on error
+ */
+int socket_udp_coalesce ( socket_udp _socket_udp, bool enable );
+
 /// connect
 /** !
  * Connect to a UDP socket
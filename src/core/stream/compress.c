@@ -0,0 +1,778 @@
+/** !
+ * Compressed stream implementation
+ *
+ * @file src/core/stream/compress.c
+ *
+ * @author Jacob Smith
+ */
+
+// header file
+#include <core/stream.h>
+
+// preprocessor definitions
+#define STREAM_COMPRESSED_BLOCK_SIZE_DEFAULT 65536
+#define STREAM_COMPRESSED_BLOCK_SIZE_MAX     65536
+#define STREAM_COMPRESSED_BOUND(size)        ( (size) + (size) / 255 + 16 )
+#define STREAM_COMPRESSED_STORED             0x80000000U
+#define STREAM_COMPRESSED_HASH_LOG           14
+#define STREAM_COMPRESSED_MATCH_MIN          4
+#define STREAM_COMPRESSED_OFFSET_MAX         65535
+#define STREAM_COMPRESSED_LAST_LITERALS      5
+#define STREAM_COMPRESSED_MATCH_LIMIT        12
+
+// data
+static const unsigned char _stream_compressed_magic[4] = { 'G', 'S', 'Z', '1' };
+
+// structure definitions
+struct stream_compressed_s
+{
+    stream        *p_stream;
+    size_t         block_size;
+    unsigned char *p_block;
+
+    struct
+    {
+        unsigned char *p_data;
+        size_t         length;
+        bool           started;
+    } write;
+
+    struct
+    {
+        unsigned char *p_data;
+        size_t         cursor, length;
+        bool           started, end, corrupt;
+    } read;
+
+    unsigned int _table[1 << STREAM_COMPRESSED_HASH_LOG];
+};
+
+// forward declarations
+/// codec
+/** !
+ * Compress a block. Matches are found with a single entry hash table,
+ * and encoded as LZ4 style sequences of a token, literals, and a
+ * 16 bit offset.
+ *
+ * @param p_in    the block
+ * @param size    the size of the block in bytes
+ * @param p_out   the result, at least STREAM_COMPRESSED_BOUND(size) bytes
+ * @param p_table the hash table
+ *
+ * @return the size of the compressed block in bytes
+ */
+size_t stream_compressed_encode ( const unsigned char *p_in, size_t size, unsigned char *p_out, unsigned int *p_table );
+
+/** !
+ * Decompress a block
+ *
+ * @param p_in     the compressed block
+ * @param size     the size of the compressed block in bytes
+ * @param p_out    the result
+ * @param capacity the size of the result in bytes
+ *
+ * @return the size of the decompressed block in bytes on success, -1 on error
+ */
+long stream_compressed_decode ( const unsigned char *p_in, size_t size, unsigned char *p_out, size_t capacity );
+
+/// framing
+/** !
+ * Compress the pending writes, and write them to the underlying stream
+ *
+ * @param p_compressed the compressed stream state
+ *
+ * @return 1 on success, 0 on error
+ */
+int stream_compressed_emit ( struct stream_compressed_s *p_compressed );
+
+/** !
+ * Read the next block from the underlying stream, and decompress it
+ *
+ * @param p_compressed the compressed stream state
+ *
+ * @return 1 on success, 0 at the end of the frame, -1 IF the frame is corrupt OR truncated
+ */
+int stream_compressed_fill ( struct stream_compressed_s *p_compressed );
+
+/** !
+ * Read exactly size bytes from a stream
+ *
+ * @param p_stream the stream
+ * @param p_data   the result
+ * @param size     the quantity of bytes
+ *
+ * @return the quantity of bytes read
+ */
+size_t stream_compressed_read_all ( stream *p_stream, void *p_data, size_t size );
+
+/// stream
+fn_stream_read  stream_read_compressed;
+fn_stream_write stream_write_compressed;
+fn_stream_size  stream_size_compressed;
+fn_stream_flush stream_flush_compressed;
+fn_stream_seek  stream_seek_compressed;
+fn_stream_close stream_close_compressed;
+
+// function definitions
+int stream_from_compressed
+(
+    stream **pp_stream,
+    stream  *p_stream,
+    size_t   block_size
+)
+{
+
+    // argument check
+    if ( NULL == pp_stream ) goto no_stream;
+    if ( NULL ==  p_stream ) goto no_underlying_stream;
+    if ( STREAM_COMPRESSED_BLOCK_SIZE_MAX < block_size ) goto block_size_too_large;
+
+    // initialized data
+    stream                     *p_result     = NULL;
+    struct stream_compressed_s *p_compressed = NULL;
+
+    // default block size
+    if ( 0 == block_size ) block_size = STREAM_COMPRESSED_BLOCK_SIZE_DEFAULT;
+
+    // allocate memory for the state, the write buffer, the read buffer, and the compressed block
+    p_compressed = default_allocator(0, sizeof(struct stream_compressed_s) + block_size + STREAM_COMPRESSED_BLOCK_SIZE_MAX + STREAM_COMPRESSED_BOUND(STREAM_COMPRESSED_BLOCK_SIZE_MAX));
+    if ( NULL == p_compressed ) goto no_mem;
+
+    // populate the state
+    *p_compressed = (struct stream_compressed_s)
+    {
+        .p_stream   = p_stream,
+        .block_size = block_size,
+        .write      =
+        {
+            .p_data  = (unsigned char *)(p_compressed + 1),
+            .length  = 0,
+            .started = false
+        },
+        .read       =
+        {
+            .p_data  = (unsigned char *)(p_compressed + 1) + block_size,
+            .cursor  = 0,
+            .length  = 0,
+            .started = false,
+            .end     = false
+        }
+    };
+
+    // the compressed block follows the read buffer
+    p_compressed->p_block = p_compressed->read.p_data + STREAM_COMPRESSED_BLOCK_SIZE_MAX;
+
+    // allocate memory for a stream
+    p_result = default_allocator(0, sizeof(stream));
+    if ( NULL == p_result ) goto no_mem;
+
+    // populate the stream structure
+    *p_result = (stream)
+    {
+        .p_data    = p_compressed,
+        .type      = STREAM_TYPE_BUFFER,
+        .size      = -1,
+        .cursor    = 0,
+
+        .pfn_read  = stream_read_compressed,
+        .pfn_write = stream_write_compressed,
+        .pfn_size  = stream_size_compressed,
+        .pfn_flush = stream_flush_compressed,
+        .pfn_seek  = stream_seek_compressed,
+        .pfn_close = stream_close_compressed
+    };
+
+    // construct a lock
+    mutex_create(&p_result->_lock);
+
+    // return a pointer to the caller
+    *pp_stream = p_result;
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_stream:
+                #ifndef NDEBUG
+                    log_error("[stream] Null pointer provided for parameter \"pp_stream\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_underlying_stream:
+                #ifndef NDEBUG
+                    log_error("[stream] Null pointer provided for parameter \"p_stream\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            block_size_too_large:
+                #ifndef NDEBUG
+                    log_error("[stream] Parameter \"block_size\" must not exceed %d in call to function \"%s\"\n", STREAM_COMPRESSED_BLOCK_SIZE_MAX, __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[interfaces] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // release the state
+                if ( p_compressed ) p_compressed = default_allocator(p_compressed, 0);
+
+                // error
+                return 0;
+        }
+    }
+}
+
+size_t stream_compressed_encode ( const unsigned char *p_in, size_t size, unsigned char *p_out, unsigned int *p_table )
+{
+
+    // initialized data
+    size_t i        = 0,
+           anchor   = 0,
+           o        = 0,
+           literals = 0;
+
+    // short blocks are stored as literals
+    if ( size <= STREAM_COMPRESSED_MATCH_LIMIT ) goto last_literals;
+
+    // clear the hash table
+    memset(p_table, 0, sizeof(unsigned int) << STREAM_COMPRESSED_HASH_LOG);
+
+    // find matches, leaving room for the trailing literals
+    while ( i < size - STREAM_COMPRESSED_MATCH_LIMIT )
+    {
+
+        // initialized data
+        unsigned int sequence  = 0,
+                     candidate = 0,
+                     hash      = 0;
+        size_t       length    = STREAM_COMPRESSED_MATCH_MIN,
+                     offset    = 0,
+                     token     = 0;
+
+        // hash the next four bytes
+        memcpy(&sequence, p_in + i, sizeof(sequence));
+        hash = ( sequence * 2654435761U ) >> ( 32 - STREAM_COMPRESSED_HASH_LOG );
+
+        // swap the candidate with the current position
+        candidate     = p_table[hash];
+        p_table[hash] = (unsigned int) i;
+
+        // no match
+        if ( candidate >= i || i - candidate > STREAM_COMPRESSED_OFFSET_MAX || memcmp(p_in + candidate, p_in + i, STREAM_COMPRESSED_MATCH_MIN) )
+        {
+
+            // skip ahead faster through incompressible data
+            i += 1 + ( ( i - anchor ) >> 6 );
+
+            // next
+            continue;
+        }
+
+        // extend the match backwards
+        while ( i > anchor && candidate > 0 && p_in[i - 1] == p_in[candidate - 1] ) i--, candidate--;
+
+        // extend the match forwards
+        while ( i + length < size - STREAM_COMPRESSED_LAST_LITERALS && p_in[candidate + length] == p_in[i + length] ) length++;
+
+        // store the sequence token
+        literals = i - anchor;
+        offset   = i - candidate;
+        token    = o++;
+        p_out[token] = (unsigned char) ( ( ( literals < 15 ) ? literals : 15 ) << 4 );
+
+        // store the literal length
+        if ( literals >= 15 )
+        {
+            size_t remaining = literals - 15;
+
+            for (; remaining >= 255; remaining -= 255) p_out[o++] = 255;
+
+            p_out[o++] = (unsigned char) remaining;
+        }
+
+        // store the literals
+        memcpy(p_out + o, p_in + anchor, literals);
+        o += literals;
+
+        // store the offset
+        p_out[o++] = (unsigned char) ( offset & 0xff );
+        p_out[o++] = (unsigned char) ( offset >> 8 );
+
+        // store the match length
+        length -= STREAM_COMPRESSED_MATCH_MIN;
+        p_out[token] |= (unsigned char) ( ( length < 15 ) ? length : 15 );
+        if ( length >= 15 )
+        {
+            size_t remaining = length - 15;
+
+            for (; remaining >= 255; remaining -= 255) p_out[o++] = 255;
+
+            p_out[o++] = (unsigned char) remaining;
+        }
+
+        // advance past the match
+        i     += length + STREAM_COMPRESSED_MATCH_MIN;
+        anchor = i;
+
+        // index a position inside the match
+        if ( i - 2 < size - STREAM_COMPRESSED_MATCH_LIMIT )
+        {
+            memcpy(&sequence, p_in + i - 2, sizeof(sequence));
+            p_table[( sequence * 2654435761U ) >> ( 32 - STREAM_COMPRESSED_HASH_LOG )] = (unsigned int) ( i - 2 );
+        }
+    }
+
+    last_literals:
+
+    // store the final token
+    literals   = size - anchor;
+    p_out[o++] = (unsigned char) ( ( ( literals < 15 ) ? literals : 15 ) << 4 );
+
+    // store the literal length
+    if ( literals >= 15 )
+    {
+        size_t remaining = literals - 15;
+
+        for (; remaining >= 255; remaining -= 255) p_out[o++] = 255;
+
+        p_out[o++] = (unsigned char) remaining;
+    }
+
+    // store the literals
+    memcpy(p_out + o, p_in + anchor, literals);
+    o += literals;
+
+    // success
+    return o;
+}
+
+long stream_compressed_decode ( const unsigned char *p_in, size_t size, unsigned char *p_out, size_t capacity )
+{
+
+    // initialized data
+    size_t i = 0,
+           o = 0;
+
+    // decode each sequence
+    while ( i < size )
+    {
+
+        // initialized data
+        unsigned char token    = p_in[i++];
+        size_t        literals = token >> 4,
+                      length   = token & 15,
+                      offset   = 0;
+
+        // load the literal length
+        if ( literals == 15 )
+        {
+            unsigned char b = 255;
+
+            while ( b == 255 )
+            {
+                if ( i >= size ) return -1;
+
+                b = p_in[i++], literals += b;
+            }
+        }
+
+        // error check
+        if ( literals > size - i || literals > capacity - o ) return -1;
+
+        // copy the literals
+        memcpy(p_out + o, p_in + i, literals);
+        i += literals, o += literals;
+
+        // the last sequence has no match
+        if ( i == size ) break;
+
+        // load the offset
+        if ( size - i < 2 ) return -1;
+        offset = (size_t) p_in[i] | ( (size_t) p_in[i + 1] << 8 );
+        i += 2;
+
+        // error check
+        if ( offset == 0 || offset > o ) return -1;
+
+        // load the match length
+        if ( length == 15 )
+        {
+            unsigned char b = 255;
+
+            while ( b == 255 )
+            {
+                if ( i >= size ) return -1;
+
+                b = p_in[i++], length += b;
+            }
+        }
+        length += STREAM_COMPRESSED_MATCH_MIN;
+
+        // error check
+        if ( length > capacity - o ) return -1;
+
+        // copy the match
+        if ( offset >= length ) memcpy(p_out + o, p_out + o - offset, length);
+
+        // overlapping matches repeat the most recent bytes
+        else for (size_t j = 0; j < length; j++) p_out[o + j] = p_out[o + j - offset];
+
+        o += length;
+    }
+
+    // success
+    return (long) o;
+}
+
+int stream_compressed_emit ( struct stream_compressed_s *p_compressed )
+{
+
+    // initialized data
+    size_t         size       = 0;
+    unsigned int   header     = 0;
+    unsigned char  _header[4] = { 0 };
+    void          *p_payload  = p_compressed->p_block;
+
+    // write the frame header
+    if ( false == p_compressed->write.started )
+    {
+        if ( 4 != stream_write(p_compressed->p_stream, (void *) _stream_compressed_magic, 4) ) return 0;
+
+        p_compressed->write.started = true;
+    }
+
+    // fast exit
+    if ( 0 == p_compressed->write.length ) return 1;
+
+    // compress the block
+    size = stream_compressed_encode(p_compressed->write.p_data, p_compressed->write.length, p_compressed->p_block, p_compressed->_table);
+
+    // incompressible blocks are stored
+    if ( size >= p_compressed->write.length )
+        size      = p_compressed->write.length,
+        header    = STREAM_COMPRESSED_STORED,
+        p_payload = p_compressed->write.p_data;
+
+    // store the block header
+    header |= (unsigned int) size;
+    _header[0] = (unsigned char) ( header       ),
+    _header[1] = (unsigned char) ( header >>  8 ),
+    _header[2] = (unsigned char) ( header >> 16 ),
+    _header[3] = (unsigned char) ( header >> 24 );
+
+    // write the block
+    if ( 4 != stream_write(p_compressed->p_stream, _header, 4) ) return 0;
+    if ( (int) size != stream_write(p_compressed->p_stream, p_payload, size) ) return 0;
+
+    // clear the write buffer
+    p_compressed->write.length = 0;
+
+    // success
+    return 1;
+}
+
+size_t stream_compressed_read_all ( stream *p_stream, void *p_data, size_t size )
+{
+
+    // initialized data
+    size_t total = 0;
+
+    // read until done, or until the stream ends
+    while ( total < size )
+    {
+
+        // initialized data
+        int result = stream_read(p_stream, (char *) p_data + total, size - total);
+
+        // done
+        if ( result <= 0 ) break;
+
+        // update the total
+        total += (size_t) result;
+    }
+
+    // success
+    return total;
+}
+
+int stream_compressed_fill ( struct stream_compressed_s *p_compressed )
+{
+
+    // initialized data
+    unsigned char _header[4] = { 0 };
+    unsigned int  header     = 0;
+    size_t        size       = 0;
+    long          length     = 0;
+
+    // fast exit
+    if ( p_compressed->read.end ) return ( p_compressed->read.corrupt ) ? -1 : 0;
+
+    // read the frame header
+    if ( false == p_compressed->read.started )
+    {
+
+        // initialized data
+        unsigned char _magic[4] = { 0 };
+        size_t        quantity  = stream_compressed_read_all(p_compressed->p_stream, _magic, 4);
+
+        // an empty stream holds no frame
+        if ( 0 == quantity ) goto end_of_frame;
+
+        // error check
+        if ( 4 != quantity ) goto bad_frame;
+        if ( memcmp(_magic, _stream_compressed_magic, 4) ) goto bad_frame;
+
+        p_compressed->read.started = true;
+    }
+
+    // read the block header. A frame always ends with a marker, so a missing header is a truncated frame
+    if ( 4 != stream_compressed_read_all(p_compressed->p_stream, _header, 4) ) goto bad_frame;
+
+    // parse the block header
+    header = (unsigned int) _header[0]         |
+             (unsigned int) _header[1] <<  8   |
+             (unsigned int) _header[2] << 16   |
+             (unsigned int) _header[3] << 24;
+    size   = header & ~STREAM_COMPRESSED_STORED;
+
+    // end of frame marker
+    if ( 0 == size ) goto end_of_frame;
+
+    // stored block
+    if ( header & STREAM_COMPRESSED_STORED )
+    {
+
+        // error check
+        if ( STREAM_COMPRESSED_BLOCK_SIZE_MAX < size ) goto bad_frame;
+
+        // read the block
+        if ( size != stream_compressed_read_all(p_compressed->p_stream, p_compressed->read.p_data, size) ) goto bad_frame;
+
+        length = (long) size;
+    }
+
+    // compressed block
+    else
+    {
+
+        // error check
+        if ( STREAM_COMPRESSED_BOUND(STREAM_COMPRESSED_BLOCK_SIZE_MAX) < size ) goto bad_frame;
+
+        // read the block
+        if ( size != stream_compressed_read_all(p_compressed->p_stream, p_compressed->p_block, size) ) goto bad_frame;
+
+        // decompress the block
+        length = stream_compressed_decode(p_compressed->p_block, size, p_compressed->read.p_data, STREAM_COMPRESSED_BLOCK_SIZE_MAX);
+        if ( -1 == length ) goto bad_frame;
+    }
+
+    // update the read buffer
+    p_compressed->read.cursor = 0;
+    p_compressed->read.length = (size_t) length;
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // stream errors
+        {
+            end_of_frame:
+
+                // the frame is done
+                p_compressed->read.end = true;
+
+                // done
+                return 0;
+
+            bad_frame:
+                #ifndef NDEBUG
+                    log_error("[stream] Corrupt compressed frame in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // the frame is done, and every later read fails
+                p_compressed->read.end     = true,
+                p_compressed->read.corrupt = true;
+
+                // error
+                return -1;
+        }
+    }
+}
+
+int stream_read_compressed ( stream *p_stream, void *p_data, size_t size )
+{
+
+    // initialized data
+    struct stream_compressed_s *p_compressed = (struct stream_compressed_s *) p_stream->p_data;
+    size_t                      total        = 0;
+
+    // read until done
+    while ( total < size )
+    {
+
+        // initialized data
+        size_t available = p_compressed->read.length - p_compressed->read.cursor;
+
+        // refill the read buffer
+        if ( 0 == available )
+        {
+
+            // initialized data
+            int filled = stream_compressed_fill(p_compressed);
+
+            // error check
+            if ( -1 == filled ) goto bad_frame;
+
+            // end of frame
+            if ( 0 == filled )
+            {
+
+                // the size is known at the end of the frame
+                p_stream->size = p_stream->cursor + total;
+
+                // done
+                break;
+            }
+
+            // next
+            continue;
+        }
+
+        // clamp
+        if ( available > size - total ) available = size - total;
+
+        // copy from the read buffer
+        memcpy((char *) p_data + total, p_compressed->read.p_data + p_compressed->read.cursor, available);
+        p_compressed->read.cursor += available;
+        total                     += available;
+    }
+
+    // update cursor
+    p_stream->cursor += total;
+
+    // success
+    return (int) total;
+
+    // error handling
+    {
+
+        // stream errors
+        {
+            bad_frame:
+
+                // the size stays unknown, and the cursor does not move
+
+                // error
+                return -1;
+        }
+    }
+}
+
+int stream_write_compressed ( stream *p_stream, void *p_data, size_t size )
+{
+
+    // initialized data
+    struct stream_compressed_s *p_compressed = (struct stream_compressed_s *) p_stream->p_data;
+    size_t                      total        = 0;
+
+    // write until done
+    while ( total < size )
+    {
+
+        // initialized data
+        size_t available = p_compressed->block_size - p_compressed->write.length;
+
+        // clamp
+        if ( available > size - total ) available = size - total;
+
+        // copy into the write buffer
+        memcpy(p_compressed->write.p_data + p_compressed->write.length, (char *) p_data + total, available);
+        p_compressed->write.length += available;
+        total                      += available;
+
+        // emit full blocks
+        if ( p_compressed->write.length == p_compressed->block_size )
+            if ( 0 == stream_compressed_emit(p_compressed) ) break;
+    }
+
+    // update cursor
+    p_stream->cursor += total;
+
+    // success
+    return (int) total;
+}
+
+int stream_size_compressed ( stream *p_stream )
+{
+
+    // unused
+    (void) p_stream;
+
+    // success
+    return -1;
+}
+
+int stream_flush_compressed ( stream *p_stream )
+{
+
+    // initialized data
+    struct stream_compressed_s *p_compressed = (struct stream_compressed_s *) p_stream->p_data;
+
+    // emit the pending block
+    if ( p_compressed->write.length && 0 == stream_compressed_emit(p_compressed) ) return 0;
+
+    // success
+    return stream_flush(p_compressed->p_stream);
+}
+
+int stream_seek_compressed ( stream *p_stream, long offset, enum stream_seek_e whence )
+{
+
+    // unused
+    (void) p_stream;
+    (void) offset;
+    (void) whence;
+
+    // error
+    return 0;
+}
+
+int stream_close_compressed ( stream *p_stream )
+{
+
+    // initialized data
+    struct stream_compressed_s *p_compressed = (struct stream_compressed_s *) p_stream->p_data;
+    int                         result       = 1;
+    unsigned char               _end[4]      = { 0 };
+
+    // finish the frame
+    if ( p_compressed->write.started || p_compressed->write.length )
+    {
+        result = stream_compressed_emit(p_compressed)
+              && 4 == stream_write(p_compressed->p_stream, _end, 4)
+              && stream_flush(p_compressed->p_stream);
+    }
+
+    // release the state
+    p_compressed = default_allocator(p_compressed, 0);
+
+    // done
+    return result;
+}
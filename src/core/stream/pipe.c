@@ -0,0 +1,543 @@
+/** !
+ * Pipe stream implementation
+ *
+ * @file src/core/stream/pipe.c
+ *
+ * @author Jacob Smith
+ */
+
+// header file
+#include <core/stream.h>
+
+// preprocessor definitions
+#define STREAM_PIPE_CAPACITY_DEFAULT 65536
+#define STREAM_PIPE_CACHE_LINE       64
+#define STREAM_PIPE_SPIN             1024
+
+#if defined(__x86_64__) || defined(__i386__)
+    #define STREAM_PIPE_RELAX() __builtin_ia32_pause()
+#elif defined(__aarch64__)
+    #define STREAM_PIPE_RELAX() __asm__ volatile ( "yield" )
+#else
+    #define STREAM_PIPE_RELAX() ( (void) 0 )
+#endif
+
+// structure definitions
+struct stream_pipe_s
+{
+
+    // written by the producer
+    struct
+    {
+        size_t head;
+        size_t cached_tail;
+        int    closed;
+        int    waiting;
+    } producer;
+    char _producer_pad[STREAM_PIPE_CACHE_LINE - 2 * sizeof(size_t) - 2 * sizeof(int)];
+
+    // written by the consumer
+    struct
+    {
+        size_t tail;
+        size_t cached_head;
+        int    closed;
+        int    waiting;
+    } consumer;
+    char _consumer_pad[STREAM_PIPE_CACHE_LINE - 2 * sizeof(size_t) - 2 * sizeof(int)];
+
+    // read only after construction
+    char               *p_ring;
+    size_t              mask;
+    bool                blocking;
+    int                 references;
+
+    // sleeping
+    mutex               _lock;
+    condition_variable  _readable,
+                        _writable;
+};
+
+// forward declarations
+/// wake
+/** !
+ * Wake the other end of a pipe, if it is asleep
+ *
+ * @param p_pipe       the pipe state
+ * @param p_waiting    the waiting flag of the other end
+ * @param p_condition  the condition the other end sleeps on
+ *
+ * @return void
+ */
+void stream_pipe_wake ( struct stream_pipe_s *p_pipe, int *p_waiting, condition_variable *p_condition );
+
+/// release
+/** !
+ * Drop a reference to a pipe, and release it after both ends close
+ *
+ * @param p_pipe the pipe state
+ *
+ * @return void
+ */
+void stream_pipe_release ( struct stream_pipe_s *p_pipe );
+
+/// stream
+fn_stream_read  stream_read_pipe;
+fn_stream_read  stream_read_pipe_writer;
+fn_stream_write stream_write_pipe;
+fn_stream_write stream_write_pipe_reader;
+fn_stream_size  stream_size_pipe;
+fn_stream_flush stream_flush_pipe;
+fn_stream_seek  stream_seek_pipe;
+fn_stream_close stream_close_pipe_reader;
+fn_stream_close stream_close_pipe_writer;
+
+// function definitions
+int stream_from_pipe
+(
+    stream **pp_reader,
+    stream **pp_writer,
+    size_t   capacity,
+    bool     blocking
+)
+{
+
+    // argument check
+    if ( NULL == pp_reader ) goto no_reader;
+    if ( NULL == pp_writer ) goto no_writer;
+
+    // initialized data
+    struct stream_pipe_s *p_pipe   = NULL;
+    stream               *p_reader = NULL,
+                         *p_writer = NULL;
+    size_t                size     = 1;
+
+    // default capacity
+    if ( 0 == capacity ) capacity = STREAM_PIPE_CAPACITY_DEFAULT;
+
+    // round the capacity up to a power of two, so indices wrap with a mask
+    while ( size < capacity ) size <<= 1;
+
+    // allocate memory for the pipe state, and the ring
+    p_pipe = default_allocator(0, sizeof(struct stream_pipe_s) + size);
+    if ( NULL == p_pipe ) goto no_mem;
+
+    // populate the pipe state
+    *p_pipe = (struct stream_pipe_s)
+    {
+        .producer   = { 0 },
+        .consumer   = { 0 },
+        .p_ring     = (char *)(p_pipe + 1),
+        .mask       = size - 1,
+        .blocking   = blocking,
+        .references = 2
+    };
+
+    // construct the sleeping primitives
+    mutex_create(&p_pipe->_lock);
+    condition_variable_create(&p_pipe->_readable);
+    condition_variable_create(&p_pipe->_writable);
+
+    // allocate memory for the streams
+    p_reader = default_allocator(0, sizeof(stream));
+    if ( NULL == p_reader ) goto no_mem;
+
+    p_writer = default_allocator(0, sizeof(stream));
+    if ( NULL == p_writer ) goto no_mem;
+
+    // populate the reading end
+    *p_reader = (stream)
+    {
+        .p_data    = p_pipe,
+        .type      = STREAM_TYPE_PIPE,
+        .size      = -1,
+        .cursor    = 0,
+
+        .pfn_read  = stream_read_pipe,
+        .pfn_write = stream_write_pipe_reader,
+        .pfn_size  = stream_size_pipe,
+        .pfn_flush = stream_flush_pipe,
+        .pfn_seek  = stream_seek_pipe,
+        .pfn_close = stream_close_pipe_reader
+    };
+
+    // populate the writing end
+    *p_writer = (stream)
+    {
+        .p_data    = p_pipe,
+        .type      = STREAM_TYPE_PIPE,
+        .size      = -1,
+        .cursor    = 0,
+
+        .pfn_read  = stream_read_pipe_writer,
+        .pfn_write = stream_write_pipe,
+        .pfn_size  = stream_size_pipe,
+        .pfn_flush = stream_flush_pipe,
+        .pfn_seek  = stream_seek_pipe,
+        .pfn_close = stream_close_pipe_writer
+    };
+
+    // construct the locks
+    mutex_create(&p_reader->_lock);
+    mutex_create(&p_writer->_lock);
+
+    // return pointers to the caller
+    *pp_reader = p_reader;
+    *pp_writer = p_writer;
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_reader:
+                #ifndef NDEBUG
+                    log_error("[stream] Null pointer provided for parameter \"pp_reader\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_writer:
+                #ifndef NDEBUG
+                    log_error("[stream] Null pointer provided for parameter \"pp_writer\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[interfaces] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // release the reading end
+                if ( p_reader ) p_reader = default_allocator(p_reader, 0);
+
+                // release the pipe state
+                if ( p_pipe )
+                {
+                    mutex_destroy(&p_pipe->_lock);
+                    condition_variable_destroy(&p_pipe->_readable);
+                    condition_variable_destroy(&p_pipe->_writable);
+                    p_pipe = default_allocator(p_pipe, 0);
+                }
+
+                // error
+                return 0;
+        }
+    }
+}
+
+void stream_pipe_wake ( struct stream_pipe_s *p_pipe, int *p_waiting, condition_variable *p_condition )
+{
+
+    // order the index store before the waiting flag load
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    // fast exit
+    if ( 0 == __atomic_load_n(p_waiting, __ATOMIC_RELAXED) ) return;
+
+    // wake the other end
+    mutex_lock(&p_pipe->_lock);
+    condition_variable_broadcast(p_condition);
+    mutex_unlock(&p_pipe->_lock);
+
+    // done
+    return;
+}
+
+void stream_pipe_release ( struct stream_pipe_s *p_pipe )
+{
+
+    // the other end is still open
+    if ( 0 != __atomic_sub_fetch(&p_pipe->references, 1, __ATOMIC_ACQ_REL) ) return;
+
+    // destroy the sleeping primitives
+    mutex_destroy(&p_pipe->_lock);
+    condition_variable_destroy(&p_pipe->_readable);
+    condition_variable_destroy(&p_pipe->_writable);
+
+    // release the pipe state
+    p_pipe = default_allocator(p_pipe, 0);
+
+    // done
+    return;
+}
+
+int stream_read_pipe ( stream *p_stream, void *p_data, size_t size )
+{
+
+    // initialized data
+    struct stream_pipe_s *p_pipe   = p_stream->p_data;
+    size_t                capacity = p_pipe->mask + 1,
+                          tail     = p_pipe->consumer.tail,
+                          result   = 0;
+
+    // read until the request is satisfied
+    while ( result < size )
+    {
+
+        // initialized data
+        size_t available = p_pipe->consumer.cached_head - tail;
+
+        // refresh the producer's index when the cached one runs dry
+        if ( 0 == available )
+        {
+            p_pipe->consumer.cached_head = __atomic_load_n(&p_pipe->producer.head, __ATOMIC_ACQUIRE);
+            available                    = p_pipe->consumer.cached_head - tail;
+        }
+
+        // copy what is available
+        if ( available )
+        {
+
+            // initialized data
+            size_t n      = ( available < size - result ) ? available : size - result,
+                   offset = tail & p_pipe->mask,
+                   first  = ( n < capacity - offset ) ? n : capacity - offset;
+
+            // copy across the end of the ring
+            memcpy((char *)p_data + result, p_pipe->p_ring + offset, first);
+            memcpy((char *)p_data + result + first, p_pipe->p_ring, n - first);
+
+            // publish the space
+            tail   += n;
+            result += n;
+            __atomic_store_n(&p_pipe->consumer.tail, tail, __ATOMIC_RELEASE);
+
+            // wake a sleeping producer
+            stream_pipe_wake(p_pipe, &p_pipe->producer.waiting, &p_pipe->_writable);
+
+            continue;
+        }
+
+        // the producer closed, and everything it wrote has been read
+        if ( __atomic_load_n(&p_pipe->producer.closed, __ATOMIC_ACQUIRE) )
+        {
+            if ( __atomic_load_n(&p_pipe->producer.head, __ATOMIC_ACQUIRE) == tail )
+            {
+                p_stream->size = p_stream->cursor + result;
+                break;
+            }
+
+            continue;
+        }
+
+        // non blocking reads return what they have
+        if ( false == p_pipe->blocking ) break;
+
+        // spin for a while before sleeping
+        for (size_t i = 0; i < STREAM_PIPE_SPIN; i++)
+        {
+            if ( __atomic_load_n(&p_pipe->producer.head, __ATOMIC_ACQUIRE) != tail ) break;
+            STREAM_PIPE_RELAX();
+        }
+
+        if ( __atomic_load_n(&p_pipe->producer.head, __ATOMIC_ACQUIRE) != tail ) continue;
+
+        // sleep until the producer writes, or closes
+        mutex_lock(&p_pipe->_lock);
+        __atomic_store_n(&p_pipe->consumer.waiting, 1, __ATOMIC_SEQ_CST);
+
+        while
+        (
+            __atomic_load_n(&p_pipe->producer.head  , __ATOMIC_SEQ_CST) == tail &&
+            __atomic_load_n(&p_pipe->producer.closed, __ATOMIC_SEQ_CST) == 0
+        )
+            condition_variable_wait(&p_pipe->_readable, &p_pipe->_lock);
+
+        __atomic_store_n(&p_pipe->consumer.waiting, 0, __ATOMIC_RELAXED);
+        mutex_unlock(&p_pipe->_lock);
+    }
+
+    // update the cursor
+    p_stream->cursor += result;
+
+    // success
+    return (int) result;
+}
+
+int stream_write_pipe ( stream *p_stream, void *p_data, size_t size )
+{
+
+    // initialized data
+    struct stream_pipe_s *p_pipe   = p_stream->p_data;
+    size_t                capacity = p_pipe->mask + 1,
+                          head     = p_pipe->producer.head,
+                          result   = 0;
+
+    // write until the request is satisfied
+    while ( result < size )
+    {
+
+        // initialized data
+        size_t space = capacity - ( head - p_pipe->producer.cached_tail );
+
+        // nobody will read what is written
+        if ( __atomic_load_n(&p_pipe->consumer.closed, __ATOMIC_ACQUIRE) ) break;
+
+        // refresh the consumer's index when the cached one runs dry
+        if ( 0 == space )
+        {
+            p_pipe->producer.cached_tail = __atomic_load_n(&p_pipe->consumer.tail, __ATOMIC_ACQUIRE);
+            space                        = capacity - ( head - p_pipe->producer.cached_tail );
+        }
+
+        // copy what fits
+        if ( space )
+        {
+
+            // initialized data
+            size_t n      = ( space < size - result ) ? space : size - result,
+                   offset = head & p_pipe->mask,
+                   first  = ( n < capacity - offset ) ? n : capacity - offset;
+
+            // copy across the end of the ring
+            memcpy(p_pipe->p_ring + offset, (char *)p_data + result, first);
+            memcpy(p_pipe->p_ring, (char *)p_data + result + first, n - first);
+
+            // publish the data
+            head   += n;
+            result += n;
+            __atomic_store_n(&p_pipe->producer.head, head, __ATOMIC_RELEASE);
+
+            // wake a sleeping consumer
+            stream_pipe_wake(p_pipe, &p_pipe->consumer.waiting, &p_pipe->_readable);
+
+            continue;
+        }
+
+        // non blocking writes return what fit
+        if ( false == p_pipe->blocking ) break;
+
+        // spin for a while before sleeping
+        for (size_t i = 0; i < STREAM_PIPE_SPIN; i++)
+        {
+            if ( __atomic_load_n(&p_pipe->consumer.tail, __ATOMIC_ACQUIRE) != p_pipe->producer.cached_tail ) break;
+            STREAM_PIPE_RELAX();
+        }
+
+        if ( __atomic_load_n(&p_pipe->consumer.tail, __ATOMIC_ACQUIRE) != p_pipe->producer.cached_tail ) continue;
+
+        // sleep until the consumer reads, or closes
+        mutex_lock(&p_pipe->_lock);
+        __atomic_store_n(&p_pipe->producer.waiting, 1, __ATOMIC_SEQ_CST);
+
+        while
+        (
+            __atomic_load_n(&p_pipe->consumer.tail  , __ATOMIC_SEQ_CST) == p_pipe->producer.cached_tail &&
+            __atomic_load_n(&p_pipe->consumer.closed, __ATOMIC_SEQ_CST) == 0
+        )
+            condition_variable_wait(&p_pipe->_writable, &p_pipe->_lock);
+
+        __atomic_store_n(&p_pipe->producer.waiting, 0, __ATOMIC_RELAXED);
+        mutex_unlock(&p_pipe->_lock);
+    }
+
+    // update the cursor
+    p_stream->cursor += result;
+
+    // success
+    return (int) result;
+}
+
+int stream_read_pipe_writer ( stream *p_stream, void *p_data, size_t size )
+{
+
+    // unused
+    (void) p_stream;
+    (void) p_data;
+    (void) size;
+
+    // error
+    return 0;
+}
+
+int stream_write_pipe_reader ( stream *p_stream, void *p_data, size_t size )
+{
+
+    // unused
+    (void) p_stream;
+    (void) p_data;
+    (void) size;
+
+    // error
+    return 0;
+}
+
+int stream_size_pipe ( stream *p_stream )
+{
+
+    // initialized data
+    struct stream_pipe_s *p_pipe = p_stream->p_data;
+
+    // the quantity of bytes in the ring
+    return (int) ( __atomic_load_n(&p_pipe->producer.head, __ATOMIC_ACQUIRE) - __atomic_load_n(&p_pipe->consumer.tail, __ATOMIC_ACQUIRE) );
+}
+
+int stream_flush_pipe ( stream *p_stream )
+{
+
+    // unused
+    (void) p_stream;
+
+    // writes are published as they are made
+    return 1;
+}
+
+int stream_seek_pipe ( stream *p_stream, long offset, enum stream_seek_e whence )
+{
+
+    // unused
+    (void) p_stream;
+    (void) offset;
+    (void) whence;
+
+    // error
+    return 0;
+}
+
+int stream_close_pipe_reader ( stream *p_stream )
+{
+
+    // initialized data
+    struct stream_pipe_s *p_pipe = p_stream->p_data;
+
+    // close the reading end, and wake a sleeping producer
+    __atomic_store_n(&p_pipe->consumer.closed, 1, __ATOMIC_SEQ_CST);
+    mutex_lock(&p_pipe->_lock);
+    condition_variable_broadcast(&p_pipe->_writable);
+    mutex_unlock(&p_pipe->_lock);
+
+    // release the pipe
+    stream_pipe_release(p_pipe);
+
+    // success
+    return 1;
+}
+
+int stream_close_pipe_writer ( stream *p_stream )
+{
+
+    // initialized data
+    struct stream_pipe_s *p_pipe = p_stream->p_data;
+
+    // close the writing end, and wake a sleeping consumer
+    __atomic_store_n(&p_pipe->producer.closed, 1, __ATOMIC_SEQ_CST);
+    mutex_lock(&p_pipe->_lock);
+    condition_variable_broadcast(&p_pipe->_readable);
+    mutex_unlock(&p_pipe->_lock);
+
+    // release the pipe
+    stream_pipe_release(p_pipe);
+
+    // success
+    return 1;
+}
@@ -6,20 +6,58 @@
  * @author Jacob Smith
  */
 
+// feature test macros, for fileno
+#define _GNU_SOURCE
+
 // header file
 #include <core/stream.h>
 
+// preprocessor definitions
+#define STREAM_SOCKET_TCP_BUFFER_SIZE_DEFAULT 4096
+#define STREAM_SEGMENTS_MAX                   16
+#define STREAM_SEGMENT_SIZE_DEFAULT           65536
+
+// structure definitions
+struct stream_socket_tcp_buffered_s
+{
+    socket_tcp _socket;
+    size_t     capacity;
+
+    struct
+    {
+        char   *p_data;
+        size_t  cursor, length;
+    } read;
+
+    struct
+    {
+        char   *p_data;
+        size_t  length;
+    } write;
+};
+
+struct stream_segmented_buffer_s
+{
+    size_t   segment_size;
+    size_t   quantity, capacity;
+    char   **pp_segments;
+};
+
 // forward declarations
 /// read
 fn_stream_read stream_read_buffer;
 fn_stream_read stream_read_file;
 fn_stream_read stream_read_socket_tcp;
+fn_stream_read stream_read_socket_tcp_buffered;
+fn_stream_read stream_read_segmented_buffer;
 
 /// write
 fn_stream_write stream_write_buffer;
 fn_stream_write stream_write_dynamic_buffer;
 fn_stream_write stream_write_file;
 fn_stream_write stream_write_socket_tcp;
+fn_stream_write stream_write_socket_tcp_buffered;
+fn_stream_write stream_write_segmented_buffer;
 
 /// size
 fn_stream_size stream_size_buffer;
@@ -30,6 +68,7 @@ fn_stream_size stream_size_socket_tcp;
 fn_stream_flush stream_flush_buffer;
 fn_stream_flush stream_flush_file;
 fn_stream_flush stream_flush_socket_tcp;
+fn_stream_flush stream_flush_socket_tcp_buffered;
 
 /// seek
 fn_stream_seek stream_seek_buffer;
@@ -41,6 +80,18 @@ fn_stream_close stream_close_buffer;
 fn_stream_close stream_close_dynamic_buffer;
 fn_stream_close stream_close_file;
 fn_stream_close stream_close_socket_tcp;
+fn_stream_close stream_close_socket_tcp_buffered;
+fn_stream_close stream_close_segmented_buffer;
+
+/// vectored read
+fn_stream_readv stream_readv_socket_tcp;
+
+/// vectored write
+fn_stream_writev stream_writev_socket_tcp;
+fn_stream_writev stream_writev_socket_tcp_buffered;
+
+/// stats
+void stream_stats_record ( struct stream_stats_direction_s *p_direction, size_t size, int result, timestamp start );
 
 // function definitions
 int stream_from_path
@@ -379,6 +430,90 @@ int stream_from_dynamic_buffer ( stream **pp_stream )
     }
 }
 
+int stream_from_segmented_buffer ( stream **pp_stream, size_t segment_size )
+{
+
+    // argument check
+    if ( NULL == pp_stream ) goto no_stream;
+
+    // initialized data
+    stream                           *p_stream    = NULL;
+    struct stream_segmented_buffer_s *p_segmented = NULL;
+
+    // default segment size
+    if ( 0 == segment_size ) segment_size = STREAM_SEGMENT_SIZE_DEFAULT;
+
+    // allocate memory for the segment list
+    p_segmented = default_allocator(0, sizeof(struct stream_segmented_buffer_s));
+    if ( NULL == p_segmented ) goto no_mem;
+
+    // populate the segment list. Segments are allocated on first write
+    *p_segmented = (struct stream_segmented_buffer_s)
+    {
+        .segment_size = segment_size,
+        .quantity     = 0,
+        .capacity     = 0,
+        .pp_segments  = NULL
+    };
+
+    // allocate memory for a stream
+    p_stream = default_allocator(0, sizeof(stream));
+    if ( NULL == p_stream ) goto no_mem;
+
+    // populate the stream structure
+    *p_stream = (stream)
+    {
+        .p_data    = p_segmented,
+        .type      = STREAM_TYPE_SEGMENTED_BUFFER,
+        .size      = 0,
+        .cursor    = 0,
+        .pfn_read  = stream_read_segmented_buffer,
+        .pfn_write = stream_write_segmented_buffer,
+        .pfn_size  = stream_size_buffer,
+        .pfn_flush = stream_flush_buffer,
+        .pfn_seek  = stream_seek_buffer,
+        .pfn_close = stream_close_segmented_buffer,
+    };
+
+    // construct a lock
+    mutex_create(&p_stream->_lock);
+
+    // return a pointer to the caller
+    *pp_stream = p_stream;
+
+    // success
+    return 1;
+
+    // error handling
+    {
+        
+        // argument errors
+        {
+            no_stream:
+                #ifndef NDEBUG
+                    log_error("[stream] Null pointer provided for parameter \"pp_stream\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[interfaces] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // release the segment list
+                if ( p_segmented ) p_segmented = default_allocator(p_segmented, 0);
+
+                // error
+                return 0;
+        }
+    }
+}
+
 int stream_from_tcp_socket 
 ( 
     stream     **pp_stream, 
@@ -410,6 +545,107 @@ int stream_from_tcp_socket
         .pfn_flush = stream_flush_socket_tcp,
         .pfn_seek  = stream_seek_socket_tcp,
         .pfn_close = stream_close_socket_tcp,
+
+        .pfn_readv  = stream_readv_socket_tcp,
+        .pfn_writev = stream_writev_socket_tcp,
+    };
+
+    // construct a lock
+    mutex_create(&p_stream->_lock);
+
+    // return a pointer to the caller
+    *pp_stream = p_stream;
+
+    // success
+    return 1;
+
+    // error handling
+    {
+        
+        // argument errors
+        {
+            no_stream:
+                #ifndef NDEBUG
+                    log_error("[stream] Null pointer provided for parameter \"pp_stream\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[interfaces] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int stream_from_tcp_socket_buffered 
+( 
+    stream     **pp_stream, 
+    socket_tcp    _socket,
+    size_t        buffer_size
+)
+{
+
+    // argument check
+    if ( NULL == pp_stream ) goto no_stream;
+
+    // initialized data
+    stream                              *p_stream = NULL;
+    struct stream_socket_tcp_buffered_s *p_buffer = NULL;
+
+    // default buffer size
+    if ( 0 == buffer_size ) buffer_size = STREAM_SOCKET_TCP_BUFFER_SIZE_DEFAULT;
+
+    // allocate memory for the socket state, the read buffer, and the write buffer
+    p_buffer = default_allocator(0, sizeof(struct stream_socket_tcp_buffered_s) + 2 * buffer_size);
+    if ( NULL == p_buffer ) goto no_mem;
+
+    // populate the socket state
+    *p_buffer = (struct stream_socket_tcp_buffered_s)
+    {
+        ._socket  = _socket,
+        .capacity = buffer_size,
+        .read     = 
+        {
+            .p_data = (char *)(p_buffer + 1),
+            .cursor = 0,
+            .length = 0
+        },
+        .write    =
+        {
+            .p_data = (char *)(p_buffer + 1) + buffer_size,
+            .length = 0
+        }
+    };
+
+    // allocate memory for a stream
+    p_stream = default_allocator(0, sizeof(stream));
+    if ( NULL == p_stream ) goto no_mem;
+
+    // populate the stream structure
+    *p_stream = (stream)
+    {
+        .p_data    = p_buffer,
+        .type      = STREAM_TYPE_BUFFER,
+        .size      = -1,
+        .cursor    = 0,
+
+        .pfn_read  = stream_read_socket_tcp_buffered,
+        .pfn_write = stream_write_socket_tcp_buffered,
+        .pfn_size  = stream_size_socket_tcp,
+        .pfn_flush = stream_flush_socket_tcp_buffered,
+        .pfn_seek  = stream_seek_socket_tcp,
+        .pfn_close = stream_close_socket_tcp_buffered,
+
+        .pfn_writev = stream_writev_socket_tcp_buffered,
     };
 
     // construct a lock
@@ -442,6 +678,9 @@ int stream_from_tcp_socket
                     log_error("[interfaces] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // release the socket state
+                p_buffer = default_allocator(p_buffer, 0);
+
                 // error
                 return 0;
         }
@@ -456,14 +695,21 @@ int stream_read ( stream *p_stream, void *p_data, size_t size )
     if ( NULL ==   p_data ) goto no_data;
 
     // initialized data
-    int result = -1;
+    int       result = -1;
+    timestamp start  = 0;
 
     // lock
     mutex_lock(&p_stream->_lock);
 
+    // start the clock
+    if ( p_stream->p_stats ) start = timer_high_precision();
+
     // read the data
     result = p_stream->pfn_read(p_stream, p_data, size);
 
+    // record statistics
+    if ( p_stream->p_stats ) stream_stats_record(&p_stream->p_stats->read, size, result, start);
+
     // unlock
     mutex_unlock(&p_stream->_lock);
 
@@ -502,14 +748,21 @@ int stream_write ( stream *p_stream, void *p_data, size_t size )
     if ( NULL ==   p_data ) goto no_data;
 
     // initialized data
-    int result = -1;
+    int       result = -1;
+    timestamp start  = 0;
 
     // lock
     mutex_lock(&p_stream->_lock);
 
-    // read the data
+    // start the clock
+    if ( p_stream->p_stats ) start = timer_high_precision();
+
+    // write the data
     result = p_stream->pfn_write(p_stream, p_data, size);
 
+    // record statistics
+    if ( p_stream->p_stats ) stream_stats_record(&p_stream->p_stats->write, size, result, start);
+
     // unlock
     mutex_unlock(&p_stream->_lock);
 
@@ -540,20 +793,56 @@ int stream_write ( stream *p_stream, void *p_data, size_t size )
     }
 }
 
-int stream_flush ( stream *p_stream )
+int stream_readv ( stream *p_stream, const struct iovec *p_segments, size_t segment_quantity )
 {
 
     // argument check
-    if ( NULL == p_stream ) goto no_stream;
+    if ( NULL ==   p_stream ) goto no_stream;
+    if ( NULL == p_segments ) goto no_segments;
 
     // initialized data
-    int result = -1;
+    int       result = 0;
+    size_t    size   = 0;
+    timestamp start  = 0;
 
     // lock
     mutex_lock(&p_stream->_lock);
 
-    // read the data
-    result = p_stream->pfn_flush(p_stream);
+    // start the clock
+    if ( p_stream->p_stats ) start = timer_high_precision();
+
+    // vectored read
+    if ( p_stream->pfn_readv ) 
+        result = p_stream->pfn_readv(p_stream, p_segments, segment_quantity);
+
+    // read each segment in turn
+    else
+        for (size_t i = 0; i < segment_quantity; i++)
+        {
+
+            // initialized data
+            int r = p_stream->pfn_read(p_stream, p_segments[i].iov_base, p_segments[i].iov_len);
+
+            // error check
+            if ( r <= 0 ) break;
+
+            // update result
+            result += r;
+
+            // stop on a short read
+            if ( (size_t) r < p_segments[i].iov_len ) break;
+        }
+
+    // record statistics
+    if ( p_stream->p_stats )
+    {
+
+        // total the size of the buffers
+        for (size_t i = 0; i < segment_quantity; i++) size += p_segments[i].iov_len;
+
+        // record
+        stream_stats_record(&p_stream->p_stats->read, size, result, start);
+    }
 
     // unlock
     mutex_unlock(&p_stream->_lock);
@@ -571,27 +860,67 @@ int stream_flush ( stream *p_stream )
                     log_error("[stream] Null pointer provided for parameter \"p_stream\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // error
+                return 0;
+                
+            no_segments:
+                #ifndef NDEBUG
+                    log_error("[stream] Null pointer provided for parameter \"p_segments\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
                 // error
                 return 0;
         }
     }
 }
 
-int stream_seek ( stream *p_stream, long offset, enum stream_seek_e whence )
+int stream_writev ( stream *p_stream, const struct iovec *p_segments, size_t segment_quantity )
 {
 
     // argument check
-    if ( NULL ==           p_stream ) goto no_stream;
-    if ( NULL == p_stream->pfn_seek ) return 0;
+    if ( NULL ==   p_stream ) goto no_stream;
+    if ( NULL == p_segments ) goto no_segments;
 
     // initialized data
-    int result = -1;
+    int       result = 0;
+    size_t    size   = 0;
+    timestamp start  = 0;
 
     // lock
     mutex_lock(&p_stream->_lock);
 
-    // seek
-    result = p_stream->pfn_seek(p_stream, offset, whence);
+    // start the clock
+    if ( p_stream->p_stats ) start = timer_high_precision();
+
+    // vectored write
+    if ( p_stream->pfn_writev ) 
+        result = p_stream->pfn_writev(p_stream, p_segments, segment_quantity);
+
+    // write each segment in turn
+    else
+        for (size_t i = 0; i < segment_quantity; i++)
+        {
+
+            // initialized data
+            int w = p_stream->pfn_write(p_stream, p_segments[i].iov_base, p_segments[i].iov_len);
+
+            // update result
+            if ( w > 0 ) result += w;
+
+            // stop on a short write
+            if ( w < 0 || (size_t) w < p_segments[i].iov_len ) break;
+        }
+
+    // record statistics
+    if ( p_stream->p_stats )
+    {
+
+        // total the size of the buffers
+        for (size_t i = 0; i < segment_quantity; i++) size += p_segments[i].iov_len;
+
+        // record
+        stream_stats_record(&p_stream->p_stats->write, size, result, start);
+    }
 
     // unlock
     mutex_unlock(&p_stream->_lock);
@@ -609,32 +938,43 @@ int stream_seek ( stream *p_stream, long offset, enum stream_seek_e whence )
                     log_error("[stream] Null pointer provided for parameter \"p_stream\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // error
+                return 0;
+                
+            no_segments:
+                #ifndef NDEBUG
+                    log_error("[stream] Null pointer provided for parameter \"p_segments\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
                 // error
                 return 0;
         }
     }
 }
 
-int stream_tell ( stream *p_stream )
+int stream_flush ( stream *p_stream )
 {
 
     // argument check
     if ( NULL == p_stream ) goto no_stream;
-    
+
     // initialized data
-    size_t cursor = -1;
+    int result = -1;
 
     // lock
     mutex_lock(&p_stream->_lock);
 
-    // tell
-    cursor = p_stream->cursor;
+    // flush the stream
+    result = p_stream->pfn_flush(p_stream);
+
+    // record statistics
+    if ( p_stream->p_stats ) p_stream->p_stats->flushes++;
 
     // unlock
     mutex_unlock(&p_stream->_lock);
 
     // success
-    return (int) cursor;
+    return result;
 
     // error handling
     {
@@ -647,31 +987,35 @@ int stream_tell ( stream *p_stream )
                 #endif
 
                 // error
-                return -1;
+                return 0;
         }
     }
 }
 
-bool stream_eof ( stream *p_stream )
+int stream_seek ( stream *p_stream, long offset, enum stream_seek_e whence )
 {
 
     // argument check
-    if ( NULL == p_stream ) goto no_stream;
+    if ( NULL ==           p_stream ) goto no_stream;
+    if ( NULL == p_stream->pfn_seek ) return 0;
 
     // initialized data
-    bool eof = false;
+    int result = -1;
 
     // lock
     mutex_lock(&p_stream->_lock);
 
-    // eof?
-    eof = ( p_stream->size > 0 ) ? ( p_stream->cursor >= p_stream->size ) : false;
+    // seek
+    result = p_stream->pfn_seek(p_stream, offset, whence);
+
+    // record statistics
+    if ( p_stream->p_stats ) p_stream->p_stats->seeks++;
 
     // unlock
     mutex_unlock(&p_stream->_lock);
 
     // success
-    return eof;
+    return result;
 
     // error handling
     {
@@ -684,38 +1028,31 @@ bool stream_eof ( stream *p_stream )
                 #endif
 
                 // error
-                return true;
+                return 0;
         }
     }
 }
 
-int stream_peek ( stream *p_stream, void *p_data, size_t size )
+int stream_tell ( stream *p_stream )
 {
 
     // argument check
     if ( NULL == p_stream ) goto no_stream;
-    if ( NULL ==   p_data ) goto no_data;
-
+    
     // initialized data
-    int read = -1;
+    size_t cursor = -1;
 
     // lock
     mutex_lock(&p_stream->_lock);
 
-    // seek 
-    p_stream->pfn_seek(p_stream, 0, STREAM_SEEK_CURSOR);
-
-    // read the data
-    read = p_stream->pfn_read(p_stream, p_data, size);
-
-    // seek back
-    p_stream->pfn_seek(p_stream, -(long)read, STREAM_SEEK_CURSOR);
+    // tell
+    cursor = p_stream->cursor;
 
     // unlock
     mutex_unlock(&p_stream->_lock);
 
     // success
-    return read;
+    return (int) cursor;
 
     // error handling
     {
@@ -728,8 +1065,89 @@ int stream_peek ( stream *p_stream, void *p_data, size_t size )
                 #endif
 
                 // error
-                return 0;
-
+                return -1;
+        }
+    }
+}
+
+bool stream_eof ( stream *p_stream )
+{
+
+    // argument check
+    if ( NULL == p_stream ) goto no_stream;
+
+    // initialized data
+    bool eof = false;
+
+    // lock
+    mutex_lock(&p_stream->_lock);
+
+    // eof?
+    eof = ( p_stream->size > 0 ) ? ( p_stream->cursor >= p_stream->size ) : false;
+
+    // unlock
+    mutex_unlock(&p_stream->_lock);
+
+    // success
+    return eof;
+
+    // error handling
+    {
+        
+        // argument errors
+        {
+            no_stream:
+                #ifndef NDEBUG
+                    log_error("[stream] Null pointer provided for parameter \"p_stream\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return true;
+        }
+    }
+}
+
+int stream_peek ( stream *p_stream, void *p_data, size_t size )
+{
+
+    // argument check
+    if ( NULL == p_stream ) goto no_stream;
+    if ( NULL ==   p_data ) goto no_data;
+
+    // initialized data
+    int read = -1;
+
+    // lock
+    mutex_lock(&p_stream->_lock);
+
+    // seek 
+    p_stream->pfn_seek(p_stream, 0, STREAM_SEEK_CURSOR);
+
+    // read the data
+    read = p_stream->pfn_read(p_stream, p_data, size);
+
+    // seek back
+    p_stream->pfn_seek(p_stream, -(long)read, STREAM_SEEK_CURSOR);
+
+    // unlock
+    mutex_unlock(&p_stream->_lock);
+
+    // success
+    return read;
+
+    // error handling
+    {
+        
+        // argument errors
+        {
+            no_stream:
+                #ifndef NDEBUG
+                    log_error("[stream] Null pointer provided for parameter \"p_stream\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
             no_data:
                 #ifndef NDEBUG
                     log_error("[stream] Null pointer provided for parameter \"p_data\" in call to function \"%s\"\n", __FUNCTION__);
@@ -860,26 +1278,449 @@ int stream_pipe ( stream *p_destination, stream *p_source )
     }
 }
 
-int stream_size ( stream *p_stream )
+int stream_size ( stream *p_stream )
+{
+
+    // argument check
+    if ( NULL == p_stream ) goto no_stream;
+
+    // initialized data
+    int result = 0;
+
+    // lock
+    mutex_lock(&p_stream->_lock);
+
+    // store the size
+    result = p_stream->pfn_size(p_stream);
+
+    // unlock
+    mutex_unlock(&p_stream->_lock);
+
+    // success
+    return result;
+
+    // error handling
+    {
+        
+        // argument errors
+        {
+            no_stream:
+                #ifndef NDEBUG
+                    log_error("[stream] Null pointer provided for parameter \"p_stream\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int stream_descriptor ( stream *p_stream )
+{
+
+    // argument check
+    if ( NULL == p_stream ) goto no_stream;
+
+    // initialized data
+    int result = -1;
+
+    // lock
+    mutex_lock(&p_stream->_lock);
+
+    // file streams
+    if ( STREAM_TYPE_FILE == p_stream->type )
+    {
+
+        // write back anything buffered by the standard library
+        fflush((FILE *) p_stream->p_data);
+
+        // store the descriptor
+        result = fileno((FILE *) p_stream->p_data);
+    }
+
+    // unbuffered socket streams
+    else if ( stream_read_socket_tcp == p_stream->pfn_read )
+        result = (int)(size_t)p_stream->p_data;
+
+    // unlock
+    mutex_unlock(&p_stream->_lock);
+
+    // success
+    return result;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_stream:
+                #ifndef NDEBUG
+                    log_error("[stream] Null pointer provided for parameter \"p_stream\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return -1;
+        }
+    }
+}
+
+int stream_segments ( stream *p_stream, struct iovec *p_segments, size_t segment_quantity )
+{
+
+    // argument check
+    if ( NULL == p_stream ) goto no_stream;
+    if ( STREAM_TYPE_SEGMENTED_BUFFER != p_stream->type ) goto wrong_type;
+
+    // initialized data
+    struct stream_segmented_buffer_s *p_segmented = NULL;
+    size_t                            quantity    = 0;
+
+    // lock
+    mutex_lock(&p_stream->_lock);
+
+    // store the segment list
+    p_segmented = (struct stream_segmented_buffer_s *) p_stream->p_data;
+
+    // the quantity of segments that hold data
+    quantity = ( p_stream->size + p_segmented->segment_size - 1 ) / p_segmented->segment_size;
+
+    // describe each segment
+    for (size_t i = 0; p_segments && i < quantity && i < segment_quantity; i++)
+        p_segments[i] = (struct iovec)
+        {
+            .iov_base = p_segmented->pp_segments[i],
+            .iov_len  = ( i + 1 < quantity ) ? p_segmented->segment_size : p_stream->size - i * p_segmented->segment_size
+        };
+
+    // unlock
+    mutex_unlock(&p_stream->_lock);
+
+    // success
+    return (int) quantity;
+
+    // error handling
+    {
+        
+        // argument errors
+        {
+            no_stream:
+                #ifndef NDEBUG
+                    log_error("[stream] Null pointer provided for parameter \"p_stream\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            wrong_type:
+                #ifndef NDEBUG
+                    log_error("[stream] Parameter \"p_stream\" must be a segmented buffer stream in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int stream_flatten ( stream *p_stream, void **pp_data, size_t *p_size )
+{
+
+    // argument check
+    if ( NULL == p_stream ) goto no_stream;
+    if ( NULL ==  pp_data ) goto no_data;
+    if ( STREAM_TYPE_SEGMENTED_BUFFER != p_stream->type ) goto wrong_type;
+
+    // initialized data
+    struct stream_segmented_buffer_s *p_segmented = NULL;
+    char                             *p_result    = NULL;
+
+    // lock
+    mutex_lock(&p_stream->_lock);
+
+    // store the segment list
+    p_segmented = (struct stream_segmented_buffer_s *) p_stream->p_data;
+
+    // allocate memory for the result
+    p_result = default_allocator(0, ( p_stream->size ) ? p_stream->size : 1);
+    if ( NULL == p_result ) goto no_mem;
+
+    // copy each segment
+    for (size_t copied = 0, i = 0; copied < p_stream->size; i++)
+    {
+
+        // initialized data
+        size_t length = ( p_stream->size - copied < p_segmented->segment_size ) ? p_stream->size - copied : p_segmented->segment_size;
+
+        // copy
+        memcpy(p_result + copied, p_segmented->pp_segments[i], length);
+
+        // update copied bytes
+        copied += length;
+    }
+
+    // return the result to the caller
+    *pp_data = p_result;
+    if ( p_size ) *p_size = p_stream->size;
+
+    // unlock
+    mutex_unlock(&p_stream->_lock);
+
+    // success
+    return 1;
+
+    // error handling
+    {
+        
+        // argument errors
+        {
+            no_stream:
+                #ifndef NDEBUG
+                    log_error("[stream] Null pointer provided for parameter \"p_stream\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_data:
+                #ifndef NDEBUG
+                    log_error("[stream] Null pointer provided for parameter \"pp_data\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            wrong_type:
+                #ifndef NDEBUG
+                    log_error("[stream] Parameter \"p_stream\" must be a segmented buffer stream in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[interfaces] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // unlock
+                mutex_unlock(&p_stream->_lock);
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int stream_stats_enable ( stream *p_stream, bool enable )
+{
+
+    // argument check
+    if ( NULL == p_stream ) goto no_stream;
+
+    // initialized data
+    stream_stats *p_stats = NULL;
+
+    // lock
+    mutex_lock(&p_stream->_lock);
+
+    // start collecting statistics
+    if ( enable && NULL == p_stream->p_stats )
+    {
+
+        // allocate memory for the statistics
+        p_stats = default_allocator(0, sizeof(stream_stats));
+        if ( NULL == p_stats ) goto no_mem;
+
+        // zero the statistics
+        memset(p_stats, 0, sizeof(stream_stats));
+
+        // store the statistics
+        p_stream->p_stats = p_stats;
+    }
+
+    // stop collecting statistics
+    else if ( !enable && p_stream->p_stats )
+        p_stream->p_stats = default_allocator(p_stream->p_stats, 0);
+
+    // unlock
+    mutex_unlock(&p_stream->_lock);
+
+    // success
+    return 1;
+
+    // error handling
+    {
+        
+        // argument errors
+        {
+            no_stream:
+                #ifndef NDEBUG
+                    log_error("[stream] Null pointer provided for parameter \"p_stream\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[interfaces] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // unlock
+                mutex_unlock(&p_stream->_lock);
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int stream_stats_get ( stream *p_stream, stream_stats *p_stats )
+{
+
+    // argument check
+    if ( NULL == p_stream ) goto no_stream;
+    if ( NULL ==  p_stats ) goto no_stats;
+
+    // lock
+    mutex_lock(&p_stream->_lock);
+
+    // state check
+    if ( NULL == p_stream->p_stats ) goto not_enabled;
+
+    // copy the statistics
+    *p_stats = *p_stream->p_stats;
+
+    // unlock
+    mutex_unlock(&p_stream->_lock);
+
+    // success
+    return 1;
+
+    // error handling
+    {
+        
+        // argument errors
+        {
+            no_stream:
+                #ifndef NDEBUG
+                    log_error("[stream] Null pointer provided for parameter \"p_stream\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_stats:
+                #ifndef NDEBUG
+                    log_error("[stream] Null pointer provided for parameter \"p_stats\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // stream errors
+        {
+            not_enabled:
+                #ifndef NDEBUG
+                    log_error("[stream] Statistics are not enabled on parameter \"p_stream\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // unlock
+                mutex_unlock(&p_stream->_lock);
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int stream_stats_reset ( stream *p_stream )
+{
+
+    // argument check
+    if ( NULL == p_stream ) goto no_stream;
+
+    // lock
+    mutex_lock(&p_stream->_lock);
+
+    // zero the statistics
+    if ( p_stream->p_stats ) memset(p_stream->p_stats, 0, sizeof(stream_stats));
+
+    // unlock
+    mutex_unlock(&p_stream->_lock);
+
+    // success
+    return 1;
+
+    // error handling
+    {
+        
+        // argument errors
+        {
+            no_stream:
+                #ifndef NDEBUG
+                    log_error("[stream] Null pointer provided for parameter \"p_stream\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int stream_stats_json ( stream *p_stream, stream *p_destination )
 {
 
     // argument check
-    if ( NULL == p_stream ) goto no_stream;
+    if ( NULL ==      p_stream ) goto no_stream;
+    if ( NULL == p_destination ) goto no_destination;
 
     // initialized data
-    int result = 0;
+    stream_stats  _stats = { 0 };
+    char          _buffer[4096];
+    int           len = 0;
+    const char   *p_names[2] = { "read", "write" };
+    const struct stream_stats_direction_s *p_directions[2] = { &_stats.read, &_stats.write };
 
-    // lock
-    mutex_lock(&p_stream->_lock);
+    // snapshot the statistics before touching the destination, which may be the same stream
+    if ( 0 == stream_stats_get(p_stream, &_stats) ) goto failed_to_get_stats;
 
-    // store the size
-    result = p_stream->pfn_size(p_stream);
+    // open the object
+    len += snprintf(_buffer + len, sizeof(_buffer) - len, "{");
 
-    // unlock
-    mutex_unlock(&p_stream->_lock);
+    // each direction
+    for (size_t i = 0; i < 2; i++)
+    {
 
-    // success
-    return result;
+        // counters
+        len += snprintf(_buffer + len, sizeof(_buffer) - len,
+            "\"%s\":{\"bytes\":%llu,\"operations\":%llu,\"short_operations\":%llu,\"latency_ns\":[",
+            p_names[i],
+            p_directions[i]->bytes,
+            p_directions[i]->operations,
+            p_directions[i]->short_operations
+        );
+
+        // latency histogram
+        for (size_t j = 0; j < STREAM_STATS_LATENCY_BUCKETS; j++)
+            len += snprintf(_buffer + len, sizeof(_buffer) - len, "%s%llu", j ? "," : "", p_directions[i]->latency[j]);
+
+        // close the direction
+        len += snprintf(_buffer + len, sizeof(_buffer) - len, "]},");
+    }
+
+    // close the object
+    len += snprintf(_buffer + len, sizeof(_buffer) - len, "\"flushes\":%llu,\"seeks\":%llu}", _stats.flushes, _stats.seeks);
+
+    // write the object
+    return stream_write(p_destination, _buffer, (size_t) len);
 
     // error handling
     {
@@ -891,6 +1732,25 @@ int stream_size ( stream *p_stream )
                     log_error("[stream] Null pointer provided for parameter \"p_stream\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // error
+                return 0;
+
+            no_destination:
+                #ifndef NDEBUG
+                    log_error("[stream] Null pointer provided for parameter \"p_destination\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // stream errors
+        {
+            failed_to_get_stats:
+                #ifndef NDEBUG
+                    log_error("[stream] Failed to get statistics in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
                 // error
                 return 0;
         }
@@ -915,6 +1775,9 @@ int stream_destroy ( stream **pp_stream )
     // close
     p_stream->pfn_close(p_stream);
 
+    // release the statistics
+    if ( p_stream->p_stats ) p_stream->p_stats = default_allocator(p_stream->p_stats, 0);
+
     // unlock
     mutex_unlock(&p_stream->_lock);
 
@@ -1078,7 +1941,7 @@ int stream_flush_buffer ( stream *p_stream )
     (void) p_stream;
 
     // success
-    return 0;
+    return 1;
 }
 
 int stream_seek_buffer ( stream *p_stream, long offset, enum stream_seek_e whence )
@@ -1187,6 +2050,124 @@ int stream_close_dynamic_buffer ( stream *p_stream )
     return 1;
 }
 
+int stream_read_segmented_buffer ( stream *p_stream, void *p_data, size_t size ) 
+{ 
+
+    // initialized data
+    struct stream_segmented_buffer_s *p_segmented = (struct stream_segmented_buffer_s *) p_stream->p_data;
+    size_t                            to_read     = ( p_stream->cursor + size > p_stream->size ) ? ( p_stream->size - p_stream->cursor ) : size;
+    size_t                            read        = 0;
+
+    // copy from each segment
+    while ( read < to_read )
+    {
+
+        // initialized data
+        size_t index  = p_stream->cursor / p_segmented->segment_size,
+               offset = p_stream->cursor % p_segmented->segment_size,
+               length = p_segmented->segment_size - offset;
+
+        // clamp
+        if ( length > to_read - read ) length = to_read - read;
+
+        // copy
+        memcpy((char *) p_data + read, p_segmented->pp_segments[index] + offset, length);
+
+        // update cursor
+        p_stream->cursor += length;
+
+        // update read bytes
+        read += length;
+    }
+
+    // success
+    return (int) read; 
+}
+
+int stream_write_segmented_buffer ( stream *p_stream, void *p_data, size_t size ) 
+{ 
+
+    // initialized data
+    struct stream_segmented_buffer_s *p_segmented = (struct stream_segmented_buffer_s *) p_stream->p_data;
+    size_t                            written     = 0;
+
+    // write everything
+    while ( written < size )
+    {
+
+        // initialized data
+        size_t index  = p_stream->cursor / p_segmented->segment_size,
+               offset = p_stream->cursor % p_segmented->segment_size,
+               length = p_segmented->segment_size - offset;
+
+        // append a segment
+        if ( index == p_segmented->quantity )
+        {
+
+            // grow the segment list. Only the list of pointers is copied
+            if ( p_segmented->quantity == p_segmented->capacity )
+            {
+
+                // initialized data
+                size_t   capacity    = ( p_segmented->capacity ) ? p_segmented->capacity * 2 : 16;
+                char   **pp_segments = default_allocator(p_segmented->pp_segments, capacity * sizeof(char *));
+
+                // error check
+                if ( NULL == pp_segments ) break;
+
+                // update the segment list
+                p_segmented->pp_segments = pp_segments;
+                p_segmented->capacity    = capacity;
+            }
+
+            // allocate a segment
+            p_segmented->pp_segments[index] = default_allocator(0, p_segmented->segment_size);
+            if ( NULL == p_segmented->pp_segments[index] ) break;
+
+            // update the quantity of segments
+            p_segmented->quantity++;
+        }
+
+        // clamp
+        if ( length > size - written ) length = size - written;
+
+        // copy
+        memcpy(p_segmented->pp_segments[index] + offset, (char *) p_data + written, length);
+
+        // update cursor
+        p_stream->cursor += length;
+
+        // update written bytes
+        written += length;
+    }
+
+    // update size
+    if ( p_stream->cursor > p_stream->size ) p_stream->size = p_stream->cursor;
+
+    // success
+    return (int) written;
+}
+
+int stream_close_segmented_buffer ( stream *p_stream )
+{
+
+    // initialized data
+    struct stream_segmented_buffer_s *p_segmented = (struct stream_segmented_buffer_s *) p_stream->p_data;
+
+    // release each segment
+    for (size_t i = 0; i < p_segmented->quantity; i++)
+        p_segmented->pp_segments[i] = default_allocator(p_segmented->pp_segments[i], 0);
+
+    // release the segment list
+    if ( p_segmented->pp_segments ) p_segmented->pp_segments = default_allocator(p_segmented->pp_segments, 0);
+
+    // release the state
+    p_stream->p_data = default_allocator(p_segmented, 0);
+
+    // success
+    return 1;
+}
+
 int stream_size_file ( stream *p_stream ) 
 { 
 
@@ -1241,6 +2222,34 @@ int stream_write_socket_tcp ( stream *p_stream, void *p_data, size_t size )
     return bytes_written; 
 }
 
+int stream_readv_socket_tcp ( stream *p_stream, const struct iovec *p_segments, size_t segment_quantity ) 
+{ 
+
+    // initialized data
+    socket_tcp _socket = (socket_tcp)(size_t)p_stream->p_data;
+    int bytes_read = socket_tcp_receivev(_socket, p_segments, segment_quantity);
+
+    // update cursor
+    if ( bytes_read > 0 ) p_stream->cursor += bytes_read;
+
+    // success
+    return bytes_read; 
+}
+
+int stream_writev_socket_tcp ( stream *p_stream, const struct iovec *p_segments, size_t segment_quantity ) 
+{ 
+
+    // initialized data
+    socket_tcp _socket = (socket_tcp)(size_t)p_stream->p_data;
+    int bytes_written = socket_tcp_sendv(_socket, p_segments, segment_quantity);
+
+    // update cursor
+    if ( bytes_written > 0 ) p_stream->cursor += bytes_written;
+
+    // success
+    return bytes_written; 
+}
+
 int stream_size_socket_tcp ( stream *p_stream ) 
 { 
 
@@ -1282,3 +2291,285 @@ int stream_close_socket_tcp ( stream *p_stream )
     // success
     return 1;
 }
+
+int stream_send_all_socket_tcp ( socket_tcp _socket, const char *p_data, size_t size )
+{
+
+    // initialized data
+    size_t sent = 0;
+
+    // send everything
+    while ( sent < size )
+    {
+
+        // initialized data
+        int result = socket_tcp_send(_socket, p_data + sent, size - sent);
+
+        // error check
+        if ( result <= 0 ) break;
+
+        // update sent bytes
+        sent += (size_t) result;
+    }
+
+    // success
+    return (int) sent;
+}
+
+int stream_flush_socket_tcp_buffered ( stream *p_stream ) 
+{ 
+
+    // initialized data
+    struct stream_socket_tcp_buffered_s *p_buffer = p_stream->p_data;
+    size_t                               pending  = p_buffer->write.length;
+    int                                  sent     = 0;
+
+    // fast exit
+    if ( 0 == pending ) return 1;
+
+    // send the coalesced writes
+    sent = stream_send_all_socket_tcp(p_buffer->_socket, p_buffer->write.p_data, pending);
+    if ( (int) pending != sent ) goto failed_to_send;
+
+    // empty the write buffer
+    p_buffer->write.length = 0;
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // socket errors
+        {
+            failed_to_send:
+                #ifndef NDEBUG
+                    log_error("[stream] Failed to flush %zu buffered bytes in call to function \"%s\"\n", pending, __FUNCTION__);
+                #endif
+
+                // drop the sent prefix, so it isn't sent again
+                memmove(p_buffer->write.p_data, p_buffer->write.p_data + sent, pending - (size_t) sent),
+                p_buffer->write.length -= (size_t) sent;
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int stream_read_socket_tcp_buffered ( stream *p_stream, void *p_data, size_t size ) 
+{ 
+
+    // initialized data
+    struct stream_socket_tcp_buffered_s *p_buffer  = p_stream->p_data;
+    size_t                               available = p_buffer->read.length - p_buffer->read.cursor;
+    int                                  result    = 0;
+
+    // fast exit
+    if ( 0 == size ) return 0;
+
+    // refill
+    if ( 0 == available )
+    {
+
+        // send pending writes before blocking, so a request is never stuck behind its response
+        if ( 0 == stream_flush_socket_tcp_buffered(p_stream) ) return 0;
+
+        // large reads bypass the buffer
+        if ( size >= p_buffer->capacity )
+        {
+
+            // receive directly into the caller's buffer
+            result = socket_tcp_receive(p_buffer->_socket, p_data, size);
+
+            // update cursor
+            if ( result > 0 ) p_stream->cursor += result;
+
+            // done
+            return result;
+        }
+
+        // read ahead as much as the socket will give
+        result = socket_tcp_receive(p_buffer->_socket, p_buffer->read.p_data, p_buffer->capacity);
+
+        // error check
+        if ( result <= 0 ) return 0;
+
+        // reset the read buffer
+        p_buffer->read.cursor = 0,
+        p_buffer->read.length = (size_t) result,
+        available             = (size_t) result;
+    }
+
+    // clamp
+    if ( size > available ) size = available;
+
+    // copy
+    memcpy(p_data, p_buffer->read.p_data + p_buffer->read.cursor, size);
+
+    // update cursors
+    p_buffer->read.cursor += size,
+    p_stream->cursor      += size;
+
+    // success
+    return (int) size;
+}
+
+int stream_write_socket_tcp_buffered ( stream *p_stream, void *p_data, size_t size ) 
+{ 
+
+    // initialized data
+    struct stream_socket_tcp_buffered_s *p_buffer = p_stream->p_data;
+    int                                  result   = (int) size;
+
+    // make room 
+    if ( p_buffer->write.length + size > p_buffer->capacity )
+        if ( 0 == stream_flush_socket_tcp_buffered(p_stream) ) return 0;
+
+    // large writes bypass the buffer
+    if ( size >= p_buffer->capacity )
+        result = stream_send_all_socket_tcp(p_buffer->_socket, p_data, size);
+
+    // coalesce small writes
+    else
+        memcpy(p_buffer->write.p_data + p_buffer->write.length, p_data, size),
+        p_buffer->write.length += size;
+
+    // update cursor
+    if ( result > 0 ) p_stream->cursor += result;
+
+    // success
+    return result;
+}
+
+int stream_writev_socket_tcp_buffered ( stream *p_stream, const struct iovec *p_segments, size_t segment_quantity ) 
+{ 
+
+    // initialized data
+    struct stream_socket_tcp_buffered_s *p_buffer                         = p_stream->p_data;
+    struct iovec                         _segments[STREAM_SEGMENTS_MAX+1] = { 0 };
+    size_t                               total                            = 0,
+                                         sent                             = 0,
+                                         quantity                         = 0;
+
+    // compute the size of the write
+    for (size_t i = 0; i < segment_quantity; i++) total += p_segments[i].iov_len;
+
+    // coalesce small writes
+    if ( p_buffer->write.length + total <= p_buffer->capacity )
+    {
+
+        // copy each segment
+        for (size_t i = 0; i < segment_quantity; i++)
+            memcpy(p_buffer->write.p_data + p_buffer->write.length, p_segments[i].iov_base, p_segments[i].iov_len),
+            p_buffer->write.length += p_segments[i].iov_len;
+
+        // update cursor
+        p_stream->cursor += total;
+
+        // success
+        return (int) total;
+    }
+
+    // too many segments to gather at once
+    if ( segment_quantity > STREAM_SEGMENTS_MAX )
+    {
+
+        // write each segment in turn
+        for (size_t i = 0; i < segment_quantity; i++)
+            if ( (int) p_segments[i].iov_len != stream_write_socket_tcp_buffered(p_stream, p_segments[i].iov_base, p_segments[i].iov_len) ) break;
+            else sent += p_segments[i].iov_len;
+
+        // done
+        return (int) sent;
+    }
+
+    // send the pending writes ahead of the segments
+    if ( p_buffer->write.length )
+        _segments[quantity++] = (struct iovec) { .iov_base = p_buffer->write.p_data, .iov_len = p_buffer->write.length };
+
+    // gather the segments
+    for (size_t i = 0; i < segment_quantity; i++)
+        _segments[quantity++] = p_segments[i];
+
+    // send everything
+    total += p_buffer->write.length;
+    for (size_t i = 0; sent < total; )
+    {
+
+        // initialized data
+        int    result    = socket_tcp_sendv(p_buffer->_socket, &_segments[i], quantity - i);
+        size_t remaining = 0;
+
+        // error check
+        if ( result <= 0 ) break;
+
+        // update sent bytes
+        sent += (size_t) result, remaining = (size_t) result;
+
+        // skip the segments that were sent in full
+        for (; i < quantity && remaining >= _segments[i].iov_len; i++)
+            remaining -= _segments[i].iov_len;
+
+        // advance into a partially sent segment
+        if ( i < quantity )
+            _segments[i].iov_base  = (char *) _segments[i].iov_base + remaining,
+            _segments[i].iov_len  -= remaining;
+    }
+
+    // the pending writes were sent in part. drop the sent prefix, so it isn't sent again
+    if ( sent < p_buffer->write.length )
+    {
+
+        // shift the unsent bytes to the front
+        memmove(p_buffer->write.p_data, p_buffer->write.p_data + sent, p_buffer->write.length - sent),
+        p_buffer->write.length -= sent;
+
+        // error
+        return 0;
+    }
+
+    // the pending writes were sent
+    sent -= p_buffer->write.length;
+    p_buffer->write.length = 0;
+
+    // update cursor
+    p_stream->cursor += sent;
+
+    // success
+    return (int) sent;
+}
+
+int stream_close_socket_tcp_buffered ( stream *p_stream )
+{
+
+    // initialized data
+    int result = stream_flush_socket_tcp_buffered(p_stream);
+
+    // release the socket state
+    p_stream->p_data = default_allocator(p_stream->p_data, 0);
+
+    // done
+    return result;
+}
+
+void stream_stats_record ( struct stream_stats_direction_s *p_direction, size_t size, int result, timestamp start )
+{
+
+    // initialized data
+    timestamp          elapsed = timer_high_precision() - start;
+    unsigned long long ns      = (unsigned long long) ((double) elapsed * 1000000000.0 / (double) timer_seconds_divisor());
+    size_t             bucket  = 0;
+
+    // bin the latency by its most significant bit
+    for (; ns > 1 && bucket < STREAM_STATS_LATENCY_BUCKETS - 1; ns >>= 1) bucket++;
+
+    // update the counters
+    p_direction->operations++;
+    p_direction->latency[bucket]++;
+    if ( result > 0 ) p_direction->bytes += (unsigned long long) result;
+    if ( result < 0 || (size_t) result < size ) p_direction->short_operations++;
+
+    // done
+    return;
+}
@@ -27,10 +27,12 @@
 // enumeration definitions
 enum stream_type_e
 {
-    STREAM_TYPE_FILE           = 0,
-    STREAM_TYPE_BUFFER         = 1,
-    STREAM_TYPE_DYNAMIC_BUFFER = 2,
-    STREAM_TYPE_QUANTITY       = 3
+    STREAM_TYPE_FILE             = 0,
+    STREAM_TYPE_BUFFER           = 1,
+    STREAM_TYPE_DYNAMIC_BUFFER   = 2,
+    STREAM_TYPE_SEGMENTED_BUFFER = 3,
+    STREAM_TYPE_PIPE             = 4,
+    STREAM_TYPE_QUANTITY         = 5
 };
 
 enum stream_seek_e
@@ -41,19 +43,41 @@ enum stream_seek_e
     STREAM_SEEK_QUANTITY = 3
 };
 
+// preprocessor definitions
+#define STREAM_STATS_LATENCY_BUCKETS 32
+
 // structure declarations
 struct stream_s;
+struct stream_stats_s;
 
 // type definitions
-typedef struct stream_s stream;
+typedef struct stream_s       stream;
+typedef struct stream_stats_s stream_stats;
 typedef int (fn_stream_read)  ( stream *p_stream, void *p_data, size_t size );
 typedef int (fn_stream_write) ( stream *p_stream, void *p_data, size_t size );
 typedef int (fn_stream_size)  ( stream *p_stream );
 typedef int (fn_stream_flush) ( stream *p_stream );
 typedef int (fn_stream_seek)  ( stream *p_stream, long offset, enum stream_seek_e whence );
 typedef int (fn_stream_close) ( stream *p_stream );
+typedef int (fn_stream_readv)  ( stream *p_stream, const struct iovec *p_segments, size_t segment_quantity );
+typedef int (fn_stream_writev) ( stream *p_stream, const struct iovec *p_segments, size_t segment_quantity );
 
 // structure definitions
+struct stream_stats_direction_s
+{
+    unsigned long long bytes;
+    unsigned long long operations;
+    unsigned long long short_operations;
+    unsigned long long latency[STREAM_STATS_LATENCY_BUCKETS];
+};
+
+struct stream_stats_s
+{
+    struct stream_stats_direction_s read, write;
+    unsigned long long              flushes;
+    unsigned long long              seeks;
+};
+
 struct stream_s
 {
     void               *p_data;
@@ -61,6 +85,7 @@ struct stream_s
     size_t              size;
     size_t              cursor;
     mutex               _lock;
+    stream_stats       *p_stats;
     
     fn_stream_read     *pfn_read;
     fn_stream_write    *pfn_write; 
@@ -68,6 +93,8 @@ struct stream_s
     fn_stream_flush    *pfn_flush; 
     fn_stream_seek     *pfn_seek;
     fn_stream_close    *pfn_close;
+    fn_stream_readv    *pfn_readv;
+    fn_stream_writev   *pfn_writev;
 };
 
 // function declarations
@@ -124,6 +151,20 @@ int stream_from_buffer
  */
 int stream_from_dynamic_buffer ( stream **pp_stream );
 
+/** !
+ * Construct a stream from a growable list of fixed size segments. 
+ * Growing the stream never moves data that was already written. 
+ * 
+ * @param pp_stream    result
+ * @param segment_size the size of each segment in bytes, or 0 for the default
+ * 
+ * @sa stream_segments
+ * @sa stream_flatten
+ * 
+ * @return 1 on success, 0 on error
+ */
+int stream_from_segmented_buffer ( stream **pp_stream, size_t segment_size );
+
 /** !
  * Construct a stream from a TCP socket
  * 
@@ -138,6 +179,70 @@ int stream_from_tcp_socket
     socket_tcp   _socket 
 );
 
+/** !
+ * Construct a buffered stream from a TCP socket. Reads are served from
+ * a read-ahead buffer, and writes are coalesced until the buffer fills,
+ * or until the stream is flushed or destroyed. 
+ * 
+ * @param pp_stream   result
+ * @param _socket     the TCP socket
+ * @param buffer_size the size of the read and write buffers in bytes, or 0 for the default
+ * 
+ * @sa stream_flush
+ * 
+ * @return 1 on success, 0 on error
+ */
+int stream_from_tcp_socket_buffered 
+( 
+    stream    **pp_stream, 
+    socket_tcp   _socket,
+    size_t       buffer_size
+);
+
+/** !
+ * Construct a stream that compresses writes to, and decompresses reads 
+ * from, another stream. Data is framed in independently compressed 
+ * blocks. The frame is finished when the stream is destroyed, which 
+ * does not destroy the underlying stream. Reading a corrupt or truncated
+ * frame returns -1, and the size of the stream stays unknown.
+ * 
+ * @param pp_stream  result
+ * @param p_stream   the underlying stream
+ * @param block_size the size of each block in bytes, up to 65536, or 0 for the default
+ * 
+ * @sa stream_flush
+ * 
+ * @return 1 on success, 0 on error
+ */
+int stream_from_compressed
+(
+    stream **pp_stream,
+    stream  *p_stream,
+    size_t   block_size
+);
+
+/** !
+ * Construct a pipe between a producer thread and a consumer thread. The
+ * ends share a single producer, single consumer ring, and exchange data 
+ * without locks. Blocking reads wait until the request is satisfied, or 
+ * the writer is destroyed, and blocking writes wait for space. Non
+ * blocking reads and writes transfer what they can, and return. 
+ * 
+ * @param pp_reader result, the end the consumer reads from
+ * @param pp_writer result, the end the producer writes to
+ * @param capacity  the size of the ring in bytes, rounded up to a power of two, or 0 for the default
+ * @param blocking  true for blocking reads and writes, false for non blocking
+ * 
+ * @return 1 on success, 0 on error
+ */
+int stream_from_pipe
+(
+    stream **pp_reader,
+    stream **pp_writer,
+    size_t   capacity,
+    bool     blocking
+);
+
 /// read
 /** !
  * Read from a stream
@@ -161,6 +266,18 @@ int stream_read ( stream *p_stream, void *p_data, size_t size );
  */
 int stream_peek ( stream *p_stream, void *p_data, size_t size );
 
+/** !
+ * Read from a stream, and scatter the data across a list of buffers.
+ * Streams without a vectored read read each buffer in turn.
+ * 
+ * @param p_stream         the stream
+ * @param p_segments       the buffers
+ * @param segment_quantity the quantity of buffers
+ * 
+ * @return bytes read on success, 0 on error
+ */
+int stream_readv ( stream *p_stream, const struct iovec *p_segments, size_t segment_quantity );
+
 /// write
 /** !
  * Write to a stream
@@ -173,9 +290,21 @@ int stream_peek ( stream *p_stream, void *p_data, size_t size );
  */
 int stream_write ( stream *p_stream, void *p_data, size_t size );
 
+/** !
+ * Gather data from a list of buffers, and write it to a stream. Streams
+ * without a vectored write write each buffer in turn.
+ * 
+ * @param p_stream         the stream
+ * @param p_segments       the buffers
+ * @param segment_quantity the quantity of buffers
+ * 
+ * @return bytes written on success, 0 on error
+ */
+int stream_writev ( stream *p_stream, const struct iovec *p_segments, size_t segment_quantity );
+
 /// flush
 /** !
- * Flush a stream
+ * Flush a stream. Buffered socket streams send any coalesced writes.
  * 
  * @param p_stream the stream
  * 
@@ -246,6 +375,85 @@ int stream_pipe ( stream *p_destination, stream *p_source );
  */
 int stream_size ( stream *p_stream );
 
+/// descriptor
+/** !
+ * Get the operating system descriptor that backs a stream. Pending
+ * writes on file streams are flushed first. 
+ * 
+ * @param p_stream the stream
+ * 
+ * @return the descriptor on success, -1 if the stream has no descriptor
+ */
+int stream_descriptor ( stream *p_stream );
+
+/// segments
+/** !
+ * Describe the segments of a segmented buffer stream. The result can 
+ * be passed to stream_writev, or walked in place. 
+ * 
+ * @param p_stream         the segmented buffer stream
+ * @param p_segments       the result, or null to count the segments
+ * @param segment_quantity the quantity of entries in p_segments
+ * 
+ * @return the quantity of segments that hold data
+ */
+int stream_segments ( stream *p_stream, struct iovec *p_segments, size_t segment_quantity );
+
+/** !
+ * Copy the contents of a segmented buffer stream into one contiguous
+ * allocation. The caller releases the result with default_allocator.
+ * 
+ * @param p_stream the segmented buffer stream
+ * @param pp_data  result
+ * @param p_size   result, the size of the contents in bytes, or null
+ * 
+ * @return 1 on success, 0 on error
+ */
+int stream_flatten ( stream *p_stream, void **pp_data, size_t *p_size );
+
+/// stats
+/** !
+ * Start or stop collecting statistics on a stream. Statistics count 
+ * bytes, operations and short operations in each direction, flushes and
+ * seeks, and bin the latency of each read and write into power of two 
+ * nanosecond buckets. Streams do not collect statistics by default. 
+ * 
+ * @param p_stream the stream
+ * @param enable   true to collect statistics, false to stop and discard them
+ * 
+ * @return 1 on success, 0 on error
+ */
+int stream_stats_enable ( stream *p_stream, bool enable );
+
+/** !
+ * Get a snapshot of the statistics of a stream
+ * 
+ * @param p_stream the stream
+ * @param p_stats  result
+ * 
+ * @return 1 on success, 0 on error
+ */
+int stream_stats_get ( stream *p_stream, stream_stats *p_stats );
+
+/** !
+ * Zero the statistics of a stream
+ * 
+ * @param p_stream the stream
+ * 
+ * @return 1 on success, 0 on error
+ */
+int stream_stats_reset ( stream *p_stream );
+
+/** !
+ * Write the statistics of a stream as a JSON object
+ * 
+ * @param p_stream      the stream
+ * @param p_destination the stream to write the JSON text to
+ * 
+ * @return bytes written on success, 0 on error
+ */
+int stream_stats_json ( stream *p_stream, stream *p_destination );
+
 /// destructors
 /** !
  * Destroy a stream
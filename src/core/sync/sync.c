@@ -826,10 +826,7 @@ int condition_variable_wait_timeout ( condition_variable *p_condition_variable,
     // Platform dependent initialized data
     #ifdef _WIN64
     #else
-        struct timespec abstime = { 
-            .tv_sec  = _time * ( 1 / SEC_2_NS ),
-            .tv_nsec = _time % SEC_2_NS
-        };
+        struct timespec abstime = { 0 };
     #endif
 
     // platform dependent implementation
@@ -838,6 +835,12 @@ int condition_variable_wait_timeout ( condition_variable *p_condition_variable,
         // TODO
     #else
 
+        // pthread_cond_timedwait waits until an absolute time
+        clock_gettime(CLOCK_REALTIME, &abstime);
+        _time          += abstime.tv_nsec;
+        abstime.tv_sec += _time / SEC_2_NS;
+        abstime.tv_nsec = _time % SEC_2_NS;
+
         // done
         return ( pthread_cond_timedwait(p_condition_variable, p_mutex, &abstime) == 0 );
     #endif
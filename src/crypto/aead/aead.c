@@ -9,6 +9,9 @@
 // header file
 #include <crypto/aead.h>
 
+// preprocessor definitions
+#define AEAD_CHUNK 4096
+
 // structure definitions
 struct aead_s
 {
@@ -18,6 +21,35 @@ struct aead_s
     chacha20       *p_chacha20;
 };
 
+// function declarations
+/** !
+ * Encrypt or decrypt a message, and compute its poly1305 message 
+ * authentication code, in one pass. Each chunk of ciphertext is
+ * authenticated while it is still in cache. p_out may equal p_in.
+ * 
+ * @param p_out    result
+ * @param p_aead   the aead
+ * @param tag      result
+ * @param p_aad    the aad
+ * @param aad_len  the quantity of bytes of aad
+ * @param p_in     the plaintext when encrypting, else the ciphertext
+ * @param len      the quantity of bytes of p_in
+ * @param encrypt  true to encrypt, false to decrypt
+ * 
+ * @return 1 on success, 0 on error
+ */
+int aead_process
+(
+    void         *p_out,
+    aead         *p_aead,
+    poly1305_tag  tag,
+
+    const void *p_aad, size_t aad_len,
+    const void *p_in , size_t len,
+
+    bool encrypt
+);
+
 // function definitions
 int aead_construct
 (
@@ -108,29 +140,30 @@ int aead_construct
     }
 }
 
-int aead_encrypt
-( 
-    void         *p_ciphertext, 
-    aead         *p_aead, 
-    poly1305_tag  tag, 
+int aead_process
+(
+    void         *p_out,
+    aead         *p_aead,
+    poly1305_tag  tag,
 
-    const void *p_aad,       size_t aad_len, 
-    const void *p_plaintext, size_t len
+    const void *p_aad, size_t aad_len,
+    const void *p_in , size_t len,
+
+    bool encrypt
 )
 {
 
-    // argument check
-    if ( NULL == p_aead ) goto no_aead;
+    // static data
+    static const unsigned char zeros[16] = { 0 };
 
     // initialized data
-    poly1305_one_time_key _one_time_key = { 0 };
-    chacha20_nonce        current_nonce = { 0 };
-    unsigned long long   *p_seq_part    = NULL;
-    unsigned char        *p_data        = NULL;
-    size_t                aad_pad       = (16 - (aad_len % 16)) % 16;
-    size_t                text_pad      = (16 - (len % 16)) % 16;
-    size_t                data_len      = 0;
-    size_t                offset        = 0;
+    poly1305_one_time_key  _one_time_key = { 0 };
+    chacha20_nonce         current_nonce = { 0 };
+    unsigned long long    *p_seq_part    = NULL;
+    poly1305               _poly1305     = { 0 };
+    unsigned char          lengths[16]   = { 0 };
+    unsigned char         *p_o           = p_out;
+    const unsigned char   *p_i           = p_in;
 
     // construct the nonce
     memcpy(current_nonce, p_aead->nonce, sizeof(chacha20_nonce));
@@ -140,48 +173,106 @@ int aead_encrypt
     // generate the one time key
     poly1305_key_generate(&_one_time_key, p_aead->key, current_nonce, 0);
 
+    // authenticate the aad
+    poly1305_init(&_poly1305, _one_time_key);
+    poly1305_update(&_poly1305, p_aad, aad_len);
+    poly1305_update(&_poly1305, zeros, (16 - (aad_len % 16)) % 16);
+
     // seek block 1
     chacha20_seek(p_aead->p_chacha20, 1);
 
     // set the nonce
     chacha20_nonce_set(p_aead->p_chacha20, current_nonce);
 
-    // encrypt
-    chacha20_encrypt(p_ciphertext, p_aead->p_chacha20, (void *)p_plaintext, len);
+    // encrypt or decrypt, and authenticate the ciphertext, a chunk at a time
+    for (size_t off = 0; off < len; off += AEAD_CHUNK)
+    {
 
-    // store the length of the message authentication code 
-    data_len = (aad_len + aad_pad) + (len + text_pad) + 16;
+        // initialized data
+        size_t n = ( len - off ) < AEAD_CHUNK ? ( len - off ) : AEAD_CHUNK;
 
-    // allocate memory for the message authentication code 
-    p_data = default_allocator(NULL, data_len);
-    if ( NULL == p_data ) goto no_mem;
+        // encrypt, then authenticate the ciphertext
+        if ( encrypt )
+            chacha20_encrypt(p_o + off, p_aead->p_chacha20, (void *) (p_i + off), n),
+            poly1305_update(&_poly1305, p_o + off, n);
+
+        // authenticate the ciphertext, then decrypt
+        else
+            poly1305_update(&_poly1305, p_i + off, n),
+            chacha20_decrypt(p_o + off, p_aead->p_chacha20, (void *) (p_i + off), n);
+    }
 
-    // zero set
-    memset(p_data, 0, data_len);
+    // pack the lengths
+    pack_pack(lengths, "%i64%i64", (unsigned long long)aad_len, (unsigned long long)len);
+
+    // authenticate the padding and the lengths
+    poly1305_update(&_poly1305, zeros, (16 - (len % 16)) % 16);
+    poly1305_update(&_poly1305, lengths, sizeof(lengths));
+
+    // store the tag
+    if ( encrypt ) poly1305_final(&_poly1305, tag);
+
+    // verify the tag
+    else
+    {
 
-    // copy the aad
-    memcpy(p_data + offset, p_aad, aad_len);
-    offset += aad_len + aad_pad;
+        // initialized data
+        poly1305_tag  computed_tag = { 0 };
+        unsigned char difference   = 0;
 
-    // copy the ciphertext
-    memcpy(p_data + offset, p_ciphertext, len);
-    offset += len + text_pad;
+        // compute the tag
+        poly1305_final(&_poly1305, computed_tag);
 
-    // pack the aad
-    pack_pack(p_data + offset, "%i64%i64", (unsigned long long)aad_len, (unsigned long long)len);
+        // compare every byte, so the time taken does not depend on the tag
+        for (size_t i = 0; i < sizeof(poly1305_tag); i++)
+            difference |= computed_tag[i] ^ tag[i];
 
-    // compute the poly1305 message authentication code 
-    poly1305_mac(p_data, data_len, tag, _one_time_key);
+        // error check
+        if ( difference ) goto tag_verification_failed;
+    }
 
     // increment the sequence counter
     p_aead->sequence++;
 
-    // release the message authentication code 
-    p_data = default_allocator(p_data, 0);
-    
     // success
     return 1;
 
+    // error handling
+    {
+
+        // tag verification errors
+        {
+            tag_verification_failed:
+                #ifndef NDEBUG
+                    log_error("[aead] Tag verification failed in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // never release unauthenticated plaintext
+                memset(p_out, 0, len);
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int aead_encrypt
+( 
+    void         *p_ciphertext, 
+    aead         *p_aead, 
+    poly1305_tag  tag, 
+
+    const void *p_aad,       size_t aad_len, 
+    const void *p_plaintext, size_t len
+)
+{
+
+    // argument check
+    if ( NULL == p_aead ) goto no_aead;
+
+    // done
+    return aead_process(p_ciphertext, p_aead, tag, p_aad, aad_len, p_plaintext, len, true);
+
     // error handling
     {
 
@@ -195,12 +286,33 @@ int aead_encrypt
                 // error
                 return 0;
         }
+    }
+}
 
-        // standard library errors
+int aead_encrypt_in_place
+(
+    aead         *p_aead,
+    poly1305_tag  tag,
+
+    const void *p_aad , size_t aad_len,
+    void       *p_data, size_t len
+)
+{
+
+    // argument check
+    if ( NULL == p_aead ) goto no_aead;
+
+    // done
+    return aead_process(p_data, p_aead, tag, p_aad, aad_len, p_data, len, true);
+
+    // error handling
+    {
+
+        // argument errors
         {
-            no_mem:
+            no_aead:
                 #ifndef NDEBUG
-                    log_error("[interfaces] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[aead] Null pointer provided for parameter \"p_aead\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // error
@@ -251,69 +363,8 @@ int aead_decrypt
     // argument check
     if ( NULL == p_aead ) goto no_aead;
 
-    // initialized data
-    poly1305_one_time_key _one_time_key = { 0 };
-    chacha20_nonce        current_nonce = { 0 };
-    unsigned long long   *p_seq_part    = NULL;
-    unsigned char        *p_data        = NULL;
-    size_t                aad_pad       = (16 - (aad_len % 16)) % 16;
-    size_t                text_pad      = (16 - (len % 16)) % 16;
-    size_t                data_len      = 0;
-    poly1305_tag          computed_tag  = { 0 };
-    size_t                offset        = 0;
-
-    // construct the nonce
-    memcpy(current_nonce, p_aead->nonce, sizeof(chacha20_nonce));
-    p_seq_part = (unsigned long long *)&current_nonce[1];
-    *p_seq_part ^= p_aead->sequence;
-
-    // generate the one time key
-    poly1305_key_generate(&_one_time_key, p_aead->key, current_nonce, 0);
-
-    // store the length of the message authentication code 
-    data_len = (aad_len + aad_pad) + (len + text_pad) + 16;
-
-    // allocate memory for the message authentication code 
-    p_data = default_allocator(NULL, data_len);
-    if ( NULL == p_data ) goto no_mem;
-
-    // zero set
-    memset(p_data, 0, data_len);
-
-    // copy the aad
-    memcpy(p_data + offset, p_aad, aad_len);
-    offset += aad_len + aad_pad;
-
-    // copy the ciphertext
-    memcpy(p_data + offset, p_ciphertext, len);
-    offset += len + text_pad;
-
-    // pack the aad
-    pack_pack(p_data + offset, "%i64%i64", (unsigned long long)aad_len, (unsigned long long)len);
-
-    // compute the poly1305 message authentication code 
-    poly1305_mac(p_data, data_len, computed_tag, _one_time_key);
-
-    // release the message authentication code 
-    default_allocator(p_data, 0);
-
-    // verify the tag
-    if ( 0 != memcmp(computed_tag, tag, 16) ) goto tag_verification_failed;
-
-    // seek block 1
-    chacha20_seek(p_aead->p_chacha20, 1);
-
-    // set the nonce
-    chacha20_nonce_set(p_aead->p_chacha20, current_nonce);
-
-    // decrypt
-    chacha20_decrypt(p_plaintext, p_aead->p_chacha20, (void *)p_ciphertext, len);
-
-    // increment the sequence counter
-    p_aead->sequence++;
-    
-    // success
-    return 1;
+    // done
+    return aead_process(p_plaintext, p_aead, tag, p_aad, aad_len, p_ciphertext, len, false);
 
     // error handling
     {
@@ -328,23 +379,33 @@ int aead_decrypt
                 // error
                 return 0;
         }
+    }
+}
 
-        // tag verification errors
-        {
-            tag_verification_failed:
-                #ifndef NDEBUG
-                    log_error("[aead] Tag verification failed in call to function \"%s\"\n", __FUNCTION__);
-                #endif
+int aead_decrypt_in_place
+(
+    aead         *p_aead,
+    poly1305_tag  tag,
 
-                // error
-                return 0;
-        }
+    const void *p_aad , size_t aad_len,
+    void       *p_data, size_t len
+)
+{
 
-        // standard library errors
+    // argument check
+    if ( NULL == p_aead ) goto no_aead;
+
+    // done
+    return aead_process(p_data, p_aead, tag, p_aad, aad_len, p_data, len, false);
+
+    // error handling
+    {
+
+        // argument errors
         {
-            no_mem:
+            no_aead:
                 #ifndef NDEBUG
-                    log_error("[interfaces] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[aead] Null pointer provided for parameter \"p_aead\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // error
@@ -353,7 +414,6 @@ int aead_decrypt
     }
 }
 
-
 int aead_destroy ( aead **pp_aead )
 {
 
@@ -73,6 +73,27 @@ int aead_encrypt
     const void *p_plaintext, size_t len
 );
 
+/** !
+ * Encrypt a message in place, in one pass
+ * 
+ * @param p_aead     the aead
+ * @param tag        result
+ * @param p_aad      the aad
+ * @param aad_len    the quantity of bytes of aad
+ * @param p_data     the plaintext, and the ciphertext on return
+ * @param len        the quantity of bytes of plaintext
+ * 
+ * @return 1 on success, 0 on error
+ */
+int aead_encrypt_in_place
+(
+    aead         *p_aead,
+    poly1305_tag  tag,
+
+    const void *p_aad , size_t aad_len,
+    void       *p_data, size_t len
+);
+
 /// seek
 /** !
  * Set the sequence counter
@@ -86,7 +107,7 @@ int aead_sequence_set ( aead *p_aead, size_t sequence );
 
 /// decrypt
 /** !
- * Encrypt a message
+ * Encrypt a message. If the tag does not match, p_plaintext is zeroed.
  * 
  * @param p_plaintext  the plaintext
  * @param p_aead       the aead
@@ -108,6 +129,28 @@ int aead_decrypt
     void *p_ciphertext, size_t len
 );
 
+/** !
+ * Decrypt a message in place, in one pass. If the tag does not match, 
+ * p_data is zeroed.
+ * 
+ * @param p_aead     the aead
+ * @param tag        the poly1305 tag
+ * @param p_aad      the aad
+ * @param aad_len    the quantity of bytes of aad
+ * @param p_data     the ciphertext, and the plaintext on return
+ * @param len        the quantity of bytes of ciphertext
+ * 
+ * @return 1 on success, 0 on error
+ */
+int aead_decrypt_in_place
+(
+    aead         *p_aead,
+    poly1305_tag  tag,
+
+    const void *p_aad , size_t aad_len,
+    void       *p_data, size_t len
+);
+
 /// destructors
 /** !
  * Release an AEAD
@@ -9,20 +9,32 @@
 // header file
 #include <crypto/chacha20.h>
 
+// x86 SIMD kernels
+#if ( defined(__x86_64__) || defined(__i386__) ) && ( defined(__GNUC__) || defined(__clang__) )
+    #define CHACHA20_X86
+    #include <immintrin.h>
+#endif
+
+// enumeration definitions
+enum chacha20_kernel_e
+{
+    chacha20_kernel_scalar = 0, // 1 block at a time
+    chacha20_kernel_sse2   = 1, // 4 blocks at a time
+    chacha20_kernel_avx2   = 2, // 8 blocks at a time
+    chacha20_kernel_avx512 = 3  // 16 blocks at a time
+};
+
 // structure definitions
 struct chacha20_s
 {
-    chacha20_state   state;
-    chacha20_key     key;
-    chacha20_nonce   nonce;
-    int              count;
-    int              block;
-    
+    chacha20_state         state;
+    chacha20_key           key;
+    chacha20_nonce         nonce;
+    int                    count;
+    int                    block;
+    enum chacha20_kernel_e kernel;
 };
 
-// type definitions
-typedef unsigned _BitInt(130) u130;
-
 // function declarations
 /** !
  * ChaCha20 quarter round
@@ -42,6 +54,83 @@ void chacha20_quarter_round
     unsigned int *d
 );
 
+/** !
+ * Choose the widest key stream kernel this CPU can run
+ * 
+ * @return the kernel
+ */
+enum chacha20_kernel_e chacha20_kernel_select ( void );
+
+/** !
+ * XOR many blocks of key stream into a buffer. p_out may equal p_in.
+ * 
+ * @param p_out   result
+ * @param p_in    the input
+ * @param state   the input block. the block counter is ignored
+ * @param counter the block counter of the first block
+ * @param blocks  the quantity of 64 byte blocks
+ * @param kernel  the widest kernel to use
+ * 
+ * @return void
+ */
+void chacha20_blocks ( unsigned char *p_out, const unsigned char *p_in, const chacha20_state state, unsigned int counter, size_t blocks, enum chacha20_kernel_e kernel );
+
+/** !
+ * XOR blocks of key stream into a buffer, a block at a time
+ * 
+ * @param p_out   result
+ * @param p_in    the input
+ * @param state   the input block. the block counter is ignored
+ * @param counter the block counter of the first block
+ * @param blocks  the quantity of 64 byte blocks
+ * 
+ * @return the quantity of blocks processed
+ */
+size_t chacha20_blocks_scalar ( unsigned char *p_out, const unsigned char *p_in, const chacha20_state state, unsigned int counter, size_t blocks );
+
+#ifdef CHACHA20_X86
+
+/** !
+ * XOR blocks of key stream into a buffer, 4 blocks at a time
+ * 
+ * @param p_out   result
+ * @param p_in    the input
+ * @param state   the input block. the block counter is ignored
+ * @param counter the block counter of the first block
+ * @param blocks  the quantity of 64 byte blocks
+ * 
+ * @return the quantity of blocks processed, a multiple of 4
+ */
+size_t chacha20_blocks_sse2 ( unsigned char *p_out, const unsigned char *p_in, const chacha20_state state, unsigned int counter, size_t blocks );
+
+/** !
+ * XOR blocks of key stream into a buffer, 8 blocks at a time
+ * 
+ * @param p_out   result
+ * @param p_in    the input
+ * @param state   the input block. the block counter is ignored
+ * @param counter the block counter of the first block
+ * @param blocks  the quantity of 64 byte blocks
+ * 
+ * @return the quantity of blocks processed, a multiple of 8
+ */
+size_t chacha20_blocks_avx2 ( unsigned char *p_out, const unsigned char *p_in, const chacha20_state state, unsigned int counter, size_t blocks );
+
+/** !
+ * XOR blocks of key stream into a buffer, 16 blocks at a time
+ * 
+ * @param p_out   result
+ * @param p_in    the input
+ * @param state   the input block. the block counter is ignored
+ * @param counter the block counter of the first block
+ * @param blocks  the quantity of 64 byte blocks
+ * 
+ * @return the quantity of blocks processed, a multiple of 16
+ */
+size_t chacha20_blocks_avx512 ( unsigned char *p_out, const unsigned char *p_in, const chacha20_state state, unsigned int counter, size_t blocks );
+
+#endif
+
 // function definitions
 void chacha20_block_print ( chacha20_state block )
 {
@@ -184,7 +273,8 @@ int chacha20_construct
             key[4], key[5], key[6], key[7],
         },
         .nonce = { nonce[0], nonce[1], nonce[2], },
-        .block = block
+        .block = block,
+        .kernel = chacha20_kernel_select()
     }; 
 
     // return a pointer to the caller
@@ -233,37 +323,19 @@ int chacha20_process ( void *p_ciphertext, chacha20 *p_chacha20, void *p_plainte
     char   *p_c      = (char *) p_ciphertext;
 
     // process each full block
-    for (size_t i = 0; i < items; i++)
+    if ( items )
     {
 
-        // initialized data
-        char ciphertext[64] = { 0 };
-
         // setup
         chacha20_setup(p_chacha20);
 
-        // build the block key
-        chacha20_round(p_chacha20);
-
-        // copy the block key
-        memcpy(ciphertext, p_chacha20->state, sizeof(chacha20_state));
-
-        // compute and store ciphertext
-        for (size_t i = 0; i < sizeof(chacha20_state); i++)
-            ciphertext[i] = p_p[i] ^ ciphertext[i];
-        
-        // debug
-        #ifdef CHACHA20_DEBUG
-            log_info("\nCiphertext: \n");
-            chacha20_block_byte_print((unsigned int *)ciphertext);
-        #endif
-
-        memcpy(p_c, ciphertext, sizeof(chacha20_state));
+        // xor the key stream, many blocks at a time
+        chacha20_blocks((unsigned char *) p_c, (const unsigned char *) p_p, p_chacha20->state, (unsigned int) p_chacha20->block, items, p_chacha20->kernel);
 
         // step
-        p_c += sizeof(chacha20_state),
-        p_p += sizeof(chacha20_state),
-        p_chacha20->block++;
+        p_c += items * sizeof(chacha20_state),
+        p_p += items * sizeof(chacha20_state),
+        p_chacha20->block += (int) items;
     }
 
     // process the residual
@@ -467,6 +539,313 @@ int chacha20_round ( chacha20 *p_chacha20 )
     return 1;
 }
 
+size_t chacha20_blocks_scalar ( unsigned char *p_out, const unsigned char *p_in, const chacha20_state state, unsigned int counter, size_t blocks )
+{
+
+    // process each block
+    for (size_t i = 0; i < blocks; i++)
+    {
+
+        // initialized data
+        unsigned int s[16] = { 0 },
+                     x[16] = { 0 };
+
+        // copy the input block, and set the block counter
+        memcpy(s, state, sizeof(chacha20_state));
+        s[12] = counter + (unsigned int) i;
+        memcpy(x, s, sizeof(chacha20_state));
+
+        // 10 iterations; 4 column quarter rounds and 4 diagonal quarter rounds
+        for ( int j = 0; j < 10; j++ )
+
+            chacha20_quarter_round(&x[0], &x[4], &x[8] , &x[12]),
+            chacha20_quarter_round(&x[1], &x[5], &x[9] , &x[13]),
+            chacha20_quarter_round(&x[2], &x[6], &x[10], &x[14]),
+            chacha20_quarter_round(&x[3], &x[7], &x[11], &x[15]),
+
+            chacha20_quarter_round(&x[0], &x[5], &x[10], &x[15]),
+            chacha20_quarter_round(&x[1], &x[6], &x[11], &x[12]),
+            chacha20_quarter_round(&x[2], &x[7], &x[8] , &x[13]),
+            chacha20_quarter_round(&x[3], &x[4], &x[9] , &x[14]);
+
+        // accumulate
+        for ( int j = 0; j < 16; j++ ) x[j] += s[j];
+
+        // xor a word at a time
+        for ( int j = 0; j < 16; j++ )
+        {
+
+            // initialized data
+            unsigned int word = 0;
+
+            // load, xor, store
+            memcpy(&word, p_in + 4 * j, sizeof(word));
+            word ^= x[j];
+            memcpy(p_out + 4 * j, &word, sizeof(word));
+        }
+
+        // step
+        p_out += sizeof(chacha20_state),
+        p_in  += sizeof(chacha20_state);
+    }
+
+    // done
+    return blocks;
+}
+
+#ifdef CHACHA20_X86
+
+// add rotate xor, on every lane
+#define CHACHA20_QUARTER_ROUND(add, xor, rotate, a, b, c, d) \
+    a = add(a, b), d = xor(d, a), d = rotate(d, 16),         \
+    c = add(c, d), b = xor(b, c), b = rotate(b, 12),         \
+    a = add(a, b), d = xor(d, a), d = rotate(d,  8),         \
+    c = add(c, d), b = xor(b, c), b = rotate(b,  7)
+
+// 10 iterations; 4 column quarter rounds and 4 diagonal quarter rounds
+#define CHACHA20_DOUBLE_ROUNDS(add, xor, rotate, x)                          \
+    for ( int j = 0; j < 10; j++ )                                           \
+        CHACHA20_QUARTER_ROUND(add, xor, rotate, x[0], x[4], x[8] , x[12]),  \
+        CHACHA20_QUARTER_ROUND(add, xor, rotate, x[1], x[5], x[9] , x[13]),  \
+        CHACHA20_QUARTER_ROUND(add, xor, rotate, x[2], x[6], x[10], x[14]),  \
+        CHACHA20_QUARTER_ROUND(add, xor, rotate, x[3], x[7], x[11], x[15]),  \
+        CHACHA20_QUARTER_ROUND(add, xor, rotate, x[0], x[5], x[10], x[15]),  \
+        CHACHA20_QUARTER_ROUND(add, xor, rotate, x[1], x[6], x[11], x[12]),  \
+        CHACHA20_QUARTER_ROUND(add, xor, rotate, x[2], x[7], x[8] , x[13]),  \
+        CHACHA20_QUARTER_ROUND(add, xor, rotate, x[3], x[4], x[9] , x[14])
+
+// transpose a 4x4 matrix of words, in every 128-bit lane
+#define CHACHA20_TRANSPOSE(unpacklo32, unpackhi32, unpacklo64, unpackhi64, a, b, c, d) \
+{                                                                                     \
+    __typeof__(a) t0 = unpacklo32(a, b), t1 = unpacklo32(c, d),                       \
+                  t2 = unpackhi32(a, b), t3 = unpackhi32(c, d);                       \
+    a = unpacklo64(t0, t1), b = unpackhi64(t0, t1),                                   \
+    c = unpacklo64(t2, t3), d = unpackhi64(t2, t3);                                   \
+}
+
+#define CHACHA20_SSE2_ROTATE(v, n) _mm_or_si128(_mm_slli_epi32(v, n), _mm_srli_epi32(v, 32 - (n)))
+#define CHACHA20_AVX2_ROTATE(v, n) _mm256_or_si256(_mm256_slli_epi32(v, n), _mm256_srli_epi32(v, 32 - (n)))
+
+__attribute__((target("sse2")))
+size_t chacha20_blocks_sse2 ( unsigned char *p_out, const unsigned char *p_in, const chacha20_state state, unsigned int counter, size_t blocks )
+{
+
+    // initialized data
+    size_t processed = blocks & ~(size_t) 3;
+
+    // process 4 blocks at a time
+    for (size_t i = 0; i < processed; i += 4)
+    {
+
+        // initialized data
+        __m128i s[16], x[16];
+
+        // broadcast each word of the input block to 4 lanes, with a different block counter in each
+        for ( int j = 0; j < 16; j++ ) s[j] = _mm_set1_epi32((int) state[j]);
+        s[12] = _mm_add_epi32(_mm_set1_epi32((int) ( counter + (unsigned int) i )), _mm_setr_epi32(0, 1, 2, 3));
+
+        // copy the input blocks
+        for ( int j = 0; j < 16; j++ ) x[j] = s[j];
+
+        // rounds
+        CHACHA20_DOUBLE_ROUNDS(_mm_add_epi32, _mm_xor_si128, CHACHA20_SSE2_ROTATE, x);
+
+        // accumulate
+        for ( int j = 0; j < 16; j++ ) x[j] = _mm_add_epi32(x[j], s[j]);
+
+        // each group of 4 words
+        for ( int g = 0; g < 4; g++ )
+        {
+
+            // turn lanes into blocks
+            CHACHA20_TRANSPOSE(_mm_unpacklo_epi32, _mm_unpackhi_epi32, _mm_unpacklo_epi64, _mm_unpackhi_epi64, x[4*g+0], x[4*g+1], x[4*g+2], x[4*g+3]);
+
+            // xor 16 bytes at a time
+            for ( int b = 0; b < 4; b++ )
+                _mm_storeu_si128(
+                    (__m128i *) (p_out + 64 * b + 16 * g),
+                    _mm_xor_si128(_mm_loadu_si128((const __m128i *) (p_in + 64 * b + 16 * g)), x[4*g+b])
+                );
+        }
+
+        // step
+        p_out += 4 * sizeof(chacha20_state),
+        p_in  += 4 * sizeof(chacha20_state);
+    }
+
+    // done
+    return processed;
+}
+
+__attribute__((target("avx2")))
+size_t chacha20_blocks_avx2 ( unsigned char *p_out, const unsigned char *p_in, const chacha20_state state, unsigned int counter, size_t blocks )
+{
+
+    // initialized data
+    size_t processed = blocks & ~(size_t) 7;
+
+    // process 8 blocks at a time
+    for (size_t i = 0; i < processed; i += 8)
+    {
+
+        // initialized data
+        __m256i s[16], x[16];
+
+        // broadcast each word of the input block to 8 lanes, with a different block counter in each
+        for ( int j = 0; j < 16; j++ ) s[j] = _mm256_set1_epi32((int) state[j]);
+        s[12] = _mm256_add_epi32(_mm256_set1_epi32((int) ( counter + (unsigned int) i )), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+
+        // copy the input blocks
+        for ( int j = 0; j < 16; j++ ) x[j] = s[j];
+
+        // rounds
+        CHACHA20_DOUBLE_ROUNDS(_mm256_add_epi32, _mm256_xor_si256, CHACHA20_AVX2_ROTATE, x);
+
+        // accumulate, then turn lanes into blocks. blocks 0-3 are in the low half, 4-7 in the high half
+        for ( int j = 0; j < 16; j++ ) x[j] = _mm256_add_epi32(x[j], s[j]);
+        for ( int g = 0; g < 4; g++ )
+            CHACHA20_TRANSPOSE(_mm256_unpacklo_epi32, _mm256_unpackhi_epi32, _mm256_unpacklo_epi64, _mm256_unpackhi_epi64, x[4*g+0], x[4*g+1], x[4*g+2], x[4*g+3]);
+
+        // xor 32 bytes at a time
+        for ( int b = 0; b < 4; b++ )
+        {
+
+            // initialized data
+            __m256i lo_0 = _mm256_permute2x128_si256(x[b], x[4+b] , 0x20),
+                    lo_1 = _mm256_permute2x128_si256(x[8+b], x[12+b], 0x20),
+                    hi_0 = _mm256_permute2x128_si256(x[b], x[4+b] , 0x31),
+                    hi_1 = _mm256_permute2x128_si256(x[8+b], x[12+b], 0x31);
+
+            // block b
+            _mm256_storeu_si256((__m256i *) (p_out + 64 * b +  0), _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) (p_in + 64 * b +  0)), lo_0));
+            _mm256_storeu_si256((__m256i *) (p_out + 64 * b + 32), _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) (p_in + 64 * b + 32)), lo_1));
+
+            // block b + 4
+            _mm256_storeu_si256((__m256i *) (p_out + 64 * (b + 4) +  0), _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) (p_in + 64 * (b + 4) +  0)), hi_0));
+            _mm256_storeu_si256((__m256i *) (p_out + 64 * (b + 4) + 32), _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) (p_in + 64 * (b + 4) + 32)), hi_1));
+        }
+
+        // step
+        p_out += 8 * sizeof(chacha20_state),
+        p_in  += 8 * sizeof(chacha20_state);
+    }
+
+    // done
+    return processed;
+}
+
+__attribute__((target("avx512f")))
+size_t chacha20_blocks_avx512 ( unsigned char *p_out, const unsigned char *p_in, const chacha20_state state, unsigned int counter, size_t blocks )
+{
+
+    // initialized data
+    size_t processed = blocks & ~(size_t) 15;
+
+    // process 16 blocks at a time
+    for (size_t i = 0; i < processed; i += 16)
+    {
+
+        // initialized data
+        __m512i s[16], x[16];
+
+        // broadcast each word of the input block to 16 lanes, with a different block counter in each
+        for ( int j = 0; j < 16; j++ ) s[j] = _mm512_set1_epi32((int) state[j]);
+        s[12] = _mm512_add_epi32(_mm512_set1_epi32((int) ( counter + (unsigned int) i )), _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+
+        // copy the input blocks
+        for ( int j = 0; j < 16; j++ ) x[j] = s[j];
+
+        // rounds
+        CHACHA20_DOUBLE_ROUNDS(_mm512_add_epi32, _mm512_xor_si512, _mm512_rol_epi32, x);
+
+        // accumulate, then turn lanes into blocks. 128-bit lane l of x[4*g+b] holds words 4g to 4g+3 of block b + 4l
+        for ( int j = 0; j < 16; j++ ) x[j] = _mm512_add_epi32(x[j], s[j]);
+        for ( int g = 0; g < 4; g++ )
+            CHACHA20_TRANSPOSE(_mm512_unpacklo_epi32, _mm512_unpackhi_epi32, _mm512_unpacklo_epi64, _mm512_unpackhi_epi64, x[4*g+0], x[4*g+1], x[4*g+2], x[4*g+3]);
+
+        // xor 64 bytes at a time
+        for ( int b = 0; b < 4; b++ )
+        {
+
+            // initialized data
+            __m512i u0 = _mm512_shuffle_i32x4(x[b]  , x[4+b] , 0x44),
+                    u1 = _mm512_shuffle_i32x4(x[b]  , x[4+b] , 0xee),
+                    u2 = _mm512_shuffle_i32x4(x[8+b], x[12+b], 0x44),
+                    u3 = _mm512_shuffle_i32x4(x[8+b], x[12+b], 0xee),
+                    k[4] =
+                    {
+                        _mm512_shuffle_i32x4(u0, u2, 0x88),
+                        _mm512_shuffle_i32x4(u0, u2, 0xdd),
+                        _mm512_shuffle_i32x4(u1, u3, 0x88),
+                        _mm512_shuffle_i32x4(u1, u3, 0xdd)
+                    };
+
+            // blocks b, b + 4, b + 8, and b + 12
+            for ( int l = 0; l < 4; l++ )
+                _mm512_storeu_si512(
+                    (void *) (p_out + 64 * (b + 4 * l)),
+                    _mm512_xor_si512(_mm512_loadu_si512((const void *) (p_in + 64 * (b + 4 * l))), k[l])
+                );
+        }
+
+        // step
+        p_out += 16 * sizeof(chacha20_state),
+        p_in  += 16 * sizeof(chacha20_state);
+    }
+
+    // done
+    return processed;
+}
+
+#undef CHACHA20_QUARTER_ROUND
+#undef CHACHA20_DOUBLE_ROUNDS
+#undef CHACHA20_TRANSPOSE
+#undef CHACHA20_SSE2_ROTATE
+#undef CHACHA20_AVX2_ROTATE
+
+#endif
+
+enum chacha20_kernel_e chacha20_kernel_select ( void )
+{
+
+    // platform dependent implementation
+    #ifdef CHACHA20_X86
+
+        // detect CPU features
+        __builtin_cpu_init();
+
+        // widest first
+        if ( __builtin_cpu_supports("avx512f") ) return chacha20_kernel_avx512;
+        if ( __builtin_cpu_supports("avx2")    ) return chacha20_kernel_avx2;
+        if ( __builtin_cpu_supports("sse2")    ) return chacha20_kernel_sse2;
+    #endif
+
+    // portable
+    return chacha20_kernel_scalar;
+}
+
+void chacha20_blocks ( unsigned char *p_out, const unsigned char *p_in, const chacha20_state state, unsigned int counter, size_t blocks, enum chacha20_kernel_e kernel )
+{
+
+    // initialized data
+    size_t processed = 0;
+
+    // widest kernel first, then narrower kernels for the rest
+    #ifdef CHACHA20_X86
+        if ( kernel >= chacha20_kernel_avx512 ) processed += chacha20_blocks_avx512(p_out + 64 * processed, p_in + 64 * processed, state, counter + (unsigned int) processed, blocks - processed);
+        if ( kernel >= chacha20_kernel_avx2   ) processed += chacha20_blocks_avx2  (p_out + 64 * processed, p_in + 64 * processed, state, counter + (unsigned int) processed, blocks - processed);
+        if ( kernel >= chacha20_kernel_sse2   ) processed += chacha20_blocks_sse2  (p_out + 64 * processed, p_in + 64 * processed, state, counter + (unsigned int) processed, blocks - processed);
+    #else
+        (void) kernel;
+    #endif
+
+    // the last few blocks
+    chacha20_blocks_scalar(p_out + 64 * processed, p_in + 64 * processed, state, counter + (unsigned int) processed, blocks - processed);
+
+    // done
+    return;
+}
+
 void chacha20_quarter_round 
 ( 
     unsigned int *a,
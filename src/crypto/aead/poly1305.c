@@ -9,8 +9,18 @@
 // header file
 #include <crypto/poly1305.h>
 
+// preprocessor definitions
+// #define POLY1305_RADIX_26
+
+// 3 limbs of 44 bits if the compiler has 128-bit products, else 5 limbs of 26 bits
+#if defined(__SIZEOF_INT128__) && !defined(POLY1305_RADIX_26)
+    #define POLY1305_RADIX_44
+#endif
+
 // type definitions
-typedef unsigned _BitInt(256) u256;
+#ifdef POLY1305_RADIX_44
+    typedef unsigned __int128 u128;
+#endif
 
 // function declarations
 /** !
@@ -22,34 +32,35 @@ typedef unsigned _BitInt(256) u256;
  */
 int poly1305_clamp ( poly1305_one_time_key key );
 
-void u256_print ( u256 x )
-{
-
-    // static data
-    static const char hex[] = "0123456789abcdef";
-
-    // initialized data
-    int started = 0;
-
-    // print characters
-    for (int i = 63; i >= 0; --i)
-    {
-
-        // initialized data
-        unsigned digit = (unsigned)((x >> (i * 4)) & 0xF);
-
-        // print the character
-        if ( digit != 0 || started || i == 0 )
-            putchar(hex[digit]),
-            started = 1;
-    }
+/** !
+ * Load a little endian 64-bit word
+ * 
+ * @param p the bytes
+ * 
+ * @return the word
+ */
+unsigned long long poly1305_load_64 ( const unsigned char *p );
 
-    // formatting
-    putchar('\n');
+/** !
+ * Load a little endian 32-bit word
+ * 
+ * @param p the bytes
+ * 
+ * @return the word
+ */
+unsigned int poly1305_load_32 ( const unsigned char *p );
 
-    // done
-    return;
-}
+/** !
+ * Add blocks of a message to the accumulator, and multiply by r
+ * 
+ * @param p_poly1305 the poly1305 state
+ * @param p_message  the blocks
+ * @param len        the quantity of bytes, a multiple of 16
+ * @param final      true if the block is a padded partial block, else false
+ * 
+ * @return void
+ */
+void poly1305_blocks ( poly1305 *p_poly1305, const unsigned char *p_message, size_t len, bool final );
 
 void poly1305_block_print ( void *p_block, size_t len )
 {
@@ -69,6 +80,23 @@ void poly1305_block_print ( void *p_block, size_t len )
 }
 
 // function definitions
+unsigned long long poly1305_load_64 ( const unsigned char *p )
+{
+
+    // little endian
+    return   (unsigned long long) p[0]        | (unsigned long long) p[1] << 8 
+           | (unsigned long long) p[2] << 16  | (unsigned long long) p[3] << 24 
+           | (unsigned long long) p[4] << 32  | (unsigned long long) p[5] << 40 
+           | (unsigned long long) p[6] << 48  | (unsigned long long) p[7] << 56;
+}
+
+unsigned int poly1305_load_32 ( const unsigned char *p )
+{
+
+    // little endian
+    return (unsigned int) p[0] | (unsigned int) p[1] << 8 | (unsigned int) p[2] << 16 | (unsigned int) p[3] << 24;
+}
+
 int poly1305_clamp ( poly1305_one_time_key key )
 {
 
@@ -85,140 +113,448 @@ int poly1305_clamp ( poly1305_one_time_key key )
     return 1;
 }
 
-int poly1305_mac 
-(
-    const unsigned char   *p_message, 
-    size_t                 len, 
-    poly1305_tag           tag, 
-    poly1305_one_time_key  key
-)
+int poly1305_init ( poly1305 *p_poly1305, const poly1305_one_time_key key )
 {
 
-    // static data
-    #ifdef POLY1305_DEBUG
-    static int block_no = 1;
-    #endif
+    // argument check
+    if ( NULL == p_poly1305 ) goto no_poly1305;
+    if ( NULL == key        ) goto no_key;
 
     // initialized data
-    size_t off = 0;
-    u256   r = 0,
-           s = 0,
-           a = 0;
-    #ifdef POLY1305_DEBUG
-        u256 s_temp = 0, r_temp = 0;
-    #endif
+    poly1305_one_time_key r = { 0 };
 
-    #ifdef POLY1305_DEBUG
+    // clamp a copy of the key
+    memcpy(r, key, sizeof(poly1305_one_time_key));
+    poly1305_clamp(r);
 
-        // reset the block number
-        block_no = 1;
+    // zero set
+    memset(p_poly1305, 0, sizeof(poly1305));
 
-        // print s
-        printf("s as a 128-bit number: ");
-        for ( int i = 0; i < 16; i++ ) 
-            s_temp |= (u256) key[i + 16] << (8 * i);
-        u256_print(s_temp);
+    // split r into limbs
+    #ifdef POLY1305_RADIX_44
+    {
 
-        // print r before clamping
-        printf("r before clamping: ");
-        for (int i = 0; i < 16; i++) 
-            printf("%02x%c", key[i], (i == 15) ? '\n' : ':');
+        // initialized data
+        unsigned long long t0 = poly1305_load_64(&r[0]),
+                           t1 = poly1305_load_64(&r[8]);
+
+        // 44 + 44 + 40 bits
+        p_poly1305->r[0] =   t0                       & 0xfffffffffff,
+        p_poly1305->r[1] = ( t0 >> 44 | t1 << 20 )    & 0xfffffffffff,
+        p_poly1305->r[2] = ( t1 >> 24 )               & 0x3ffffffffff;
+    }
+    #else
+
+        // 26 bits each
+        p_poly1305->r[0] = ( poly1305_load_32(&r[ 0])      ) & 0x3ffffff,
+        p_poly1305->r[1] = ( poly1305_load_32(&r[ 3]) >> 2 ) & 0x3ffffff,
+        p_poly1305->r[2] = ( poly1305_load_32(&r[ 6]) >> 4 ) & 0x3ffffff,
+        p_poly1305->r[3] = ( poly1305_load_32(&r[ 9]) >> 6 ) & 0x3ffffff,
+        p_poly1305->r[4] = ( poly1305_load_32(&r[12]) >> 8 ) & 0x3ffffff;
     #endif
 
-    // clamp the key
-    poly1305_clamp(key);
+    // store s
+    memcpy(p_poly1305->s, &key[16], sizeof(p_poly1305->s));
 
-    #ifdef POLY1305_DEBUG
+    // erase the copy
+    memset(r, 0, sizeof(r));
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_poly1305:
+                #ifndef NDEBUG
+                    log_error("[poly1305] Null pointer provided for parameter \"p_poly1305\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
 
-        // print r after clamp
-        printf("Clamped r as a number: ");
-        for ( int i = 0; i < 16; i++ ) 
-            r_temp |= (u256) key [i] << (8 * i);
-        u256_print(r_temp);
+            no_key:
+                #ifndef NDEBUG
+                    log_error("[poly1305] Null pointer provided for parameter \"key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+void poly1305_blocks ( poly1305 *p_poly1305, const unsigned char *p_message, size_t len, bool final )
+{
+
+    #ifdef POLY1305_RADIX_44
+
+        // initialized data
+        const unsigned long long mask_44 = 0xfffffffffff,
+                                 mask_42 = 0x3ffffffffff,
+                                 hibit   = final ? 0 : 1ULL << 40;
+        unsigned long long r0 = p_poly1305->r[0], r1 = p_poly1305->r[1], r2 = p_poly1305->r[2],
+                           h0 = p_poly1305->h[0], h1 = p_poly1305->h[1], h2 = p_poly1305->h[2],
+                           s1 = r1 * ( 5 << 2 ),  s2 = r2 * ( 5 << 2 );
+
+        // each block
+        for (size_t i = 0; i < len; i += 16)
+        {
+
+            // initialized data
+            unsigned long long t0 = poly1305_load_64(&p_message[i + 0]),
+                               t1 = poly1305_load_64(&p_message[i + 8]),
+                               c  = 0;
+            u128 d0 = 0, d1 = 0, d2 = 0;
+
+            // h += m
+            h0 +=   t0                       & mask_44,
+            h1 += ( t0 >> 44 | t1 << 20 )    & mask_44,
+            h2 += ( ( t1 >> 24 )             & mask_42 ) | hibit;
+
+            // h *= r. 2^130 = 5 (mod p), and the limbs of r above the first are scaled by 4 to line up with the 42 bit top limb
+            d0 = (u128) h0 * r0 + (u128) h1 * s2 + (u128) h2 * s1,
+            d1 = (u128) h0 * r1 + (u128) h1 * r0 + (u128) h2 * s2,
+            d2 = (u128) h0 * r2 + (u128) h1 * r1 + (u128) h2 * r0;
+
+            // partial reduction
+            c = (unsigned long long) ( d0 >> 44 ), h0 = (unsigned long long) d0 & mask_44, d1 += c,
+            c = (unsigned long long) ( d1 >> 44 ), h1 = (unsigned long long) d1 & mask_44, d2 += c,
+            c = (unsigned long long) ( d2 >> 42 ), h2 = (unsigned long long) d2 & mask_42,
+            h0 += c * 5, c = h0 >> 44, h0 &= mask_44,
+            h1 += c;
+        }
+
+        // store the accumulator
+        p_poly1305->h[0] = h0, p_poly1305->h[1] = h1, p_poly1305->h[2] = h2;
+    #else
+
+        // initialized data
+        const unsigned int mask_26 = 0x3ffffff,
+                           hibit   = final ? 0 : 1U << 24;
+        unsigned int r0 = (unsigned int) p_poly1305->r[0], r1 = (unsigned int) p_poly1305->r[1],
+                     r2 = (unsigned int) p_poly1305->r[2], r3 = (unsigned int) p_poly1305->r[3],
+                     r4 = (unsigned int) p_poly1305->r[4],
+                     h0 = (unsigned int) p_poly1305->h[0], h1 = (unsigned int) p_poly1305->h[1],
+                     h2 = (unsigned int) p_poly1305->h[2], h3 = (unsigned int) p_poly1305->h[3],
+                     h4 = (unsigned int) p_poly1305->h[4],
+                     s1 = r1 * 5, s2 = r2 * 5, s3 = r3 * 5, s4 = r4 * 5;
+
+        // each block
+        for (size_t i = 0; i < len; i += 16)
+        {
+
+            // initialized data
+            unsigned long long d0 = 0, d1 = 0, d2 = 0, d3 = 0, d4 = 0;
+            unsigned int       c  = 0;
+
+            // h += m
+            h0 += ( poly1305_load_32(&p_message[i +  0])      ) & mask_26,
+            h1 += ( poly1305_load_32(&p_message[i +  3]) >> 2 ) & mask_26,
+            h2 += ( poly1305_load_32(&p_message[i +  6]) >> 4 ) & mask_26,
+            h3 += ( poly1305_load_32(&p_message[i +  9]) >> 6 ) & mask_26,
+            h4 += ( poly1305_load_32(&p_message[i + 12]) >> 8 ) | hibit;
+
+            // h *= r. 2^130 = 5 (mod p)
+            d0 = (unsigned long long) h0 * r0 + (unsigned long long) h1 * s4 + (unsigned long long) h2 * s3 + (unsigned long long) h3 * s2 + (unsigned long long) h4 * s1,
+            d1 = (unsigned long long) h0 * r1 + (unsigned long long) h1 * r0 + (unsigned long long) h2 * s4 + (unsigned long long) h3 * s3 + (unsigned long long) h4 * s2,
+            d2 = (unsigned long long) h0 * r2 + (unsigned long long) h1 * r1 + (unsigned long long) h2 * r0 + (unsigned long long) h3 * s4 + (unsigned long long) h4 * s3,
+            d3 = (unsigned long long) h0 * r3 + (unsigned long long) h1 * r2 + (unsigned long long) h2 * r1 + (unsigned long long) h3 * r0 + (unsigned long long) h4 * s4,
+            d4 = (unsigned long long) h0 * r4 + (unsigned long long) h1 * r3 + (unsigned long long) h2 * r2 + (unsigned long long) h3 * r1 + (unsigned long long) h4 * r0;
+
+            // partial reduction
+            c = (unsigned int) ( d0 >> 26 ), h0 = (unsigned int) d0 & mask_26, d1 += c,
+            c = (unsigned int) ( d1 >> 26 ), h1 = (unsigned int) d1 & mask_26, d2 += c,
+            c = (unsigned int) ( d2 >> 26 ), h2 = (unsigned int) d2 & mask_26, d3 += c,
+            c = (unsigned int) ( d3 >> 26 ), h3 = (unsigned int) d3 & mask_26, d4 += c,
+            c = (unsigned int) ( d4 >> 26 ), h4 = (unsigned int) d4 & mask_26,
+            h0 += c * 5, c = h0 >> 26, h0 &= mask_26,
+            h1 += c;
+        }
+
+        // store the accumulator
+        p_poly1305->h[0] = h0, p_poly1305->h[1] = h1, p_poly1305->h[2] = h2, p_poly1305->h[3] = h3, p_poly1305->h[4] = h4;
     #endif
 
-    // compute r
-    for ( int i = 0; i < 16; i++ ) 
-        r |= (u256) key [i + 0] << (8 * i);
+    // done
+    return;
+}
+
+int poly1305_update ( poly1305 *p_poly1305, const void *p_message, size_t len )
+{
 
-    // compute s
-    for ( int i = 0; i < 16; i++ ) 
-        s |= (u256) key [i + 16] << (8 * i);
+    // argument check
+    if ( NULL == p_poly1305 ) goto no_poly1305;
+    if ( NULL == p_message && len ) goto no_message;
 
-    // compute the message authentication code
-    while ( off < len )
+    // initialized data
+    const unsigned char *p_m = p_message;
+
+    // fill the partial block
+    if ( p_poly1305->leftover )
+    {
+
+        // initialized data
+        size_t want = 16 - p_poly1305->leftover;
+
+        // clamp
+        if ( want > len ) want = len;
+
+        // copy
+        memcpy(&p_poly1305->buffer[p_poly1305->leftover], p_m, want);
+
+        // step
+        p_poly1305->leftover += want,
+        p_m                  += want,
+        len                  -= want;
+
+        // not a full block yet
+        if ( p_poly1305->leftover < 16 ) return 1;
+
+        // process the full block
+        poly1305_blocks(p_poly1305, p_poly1305->buffer, 16, false);
+        p_poly1305->leftover = 0;
+    }
+
+    // process full blocks in place
+    if ( len >= 16 )
     {
 
         // initialized data
-        u256 n = 0;
-        size_t b = ( len - off ) < 16 ? ( len - off ) : 16;
-       
-        #ifdef POLY1305_DEBUG
-
-            // print the block number
-            printf("\nBlock #%d\n", block_no);
-            
-            // print the accumulator
-            printf("Acc = "), u256_print(a);
-
-            // print the content of the block
-            printf("Block = "), poly1305_block_print((void *)(p_message + off), b);
-        #endif
-        
-        // compute n
-        for ( size_t i = 0; i < b; i++)
-            n |= (u256) p_message[off + i] << (8 * i);
-        n |= (u256)1 << (8 * b);
-            
-        #ifdef POLY1305_DEBUG
-
-            // print the block with the 1 byte
-            printf("Block with 0x01 byte = "), u256_print(n);
-
-            // print the sum of the accumulator and block
-            printf("Acc + block = "), u256_print(a + n);
-        #endif
-        
-        // update the accumulator
-        a = (a + n) * r;
-
-        #ifdef POLY1305_DEBUG
-
-            // print accumulator + block * r
-            printf("(Acc + Block) * r =\n"), u256_print(a);
-        #endif
-
-        // modulo 2^130-5
-        a = a % (((u256)1 << 130) - 5);
-
-        #ifdef POLY1305_DEBUG
-
-            // print the accumulator 
-            printf("Acc = ((Acc + Block) * r) %% P = "), u256_print(a);
-            block_no++;
-        #endif
-        
+        size_t full = len & ~(size_t) 15;
+
+        // process
+        poly1305_blocks(p_poly1305, p_m, full, false);
+
         // step
-        off += b;
+        p_m += full,
+        len -= full;
     }
 
-    a += s;
+    // store the rest
+    if ( len )
+        memcpy(p_poly1305->buffer, p_m, len),
+        p_poly1305->leftover = len;
 
-    #ifdef POLY1305_DEBUG
-        printf("\nAcc + s = ");
-        u256_print(a);
-    #endif
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_poly1305:
+                #ifndef NDEBUG
+                    log_error("[poly1305] Null pointer provided for parameter \"p_poly1305\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_message:
+                #ifndef NDEBUG
+                    log_error("[poly1305] Null pointer provided for parameter \"p_message\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int poly1305_final ( poly1305 *p_poly1305, poly1305_tag tag )
+{
+
+    // argument check
+    if ( NULL == p_poly1305 ) goto no_poly1305;
+    if ( NULL == tag        ) goto no_tag;
+
+    // process the partial block, with the 1 byte after the message instead of above the block
+    if ( p_poly1305->leftover )
+    {
+
+        // pad
+        p_poly1305->buffer[p_poly1305->leftover] = 1;
+        memset(&p_poly1305->buffer[p_poly1305->leftover + 1], 0, 16 - p_poly1305->leftover - 1);
 
-    for ( int i = 0; i < 16; i++ )
-        tag[i] = (unsigned char)((a >> (8 * i)) & 0xff);
+        // process
+        poly1305_blocks(p_poly1305, p_poly1305->buffer, 16, true);
+    }
+
+    #ifdef POLY1305_RADIX_44
+    {
+
+        // initialized data
+        const unsigned long long mask_44 = 0xfffffffffff,
+                                 mask_42 = 0x3ffffffffff;
+        unsigned long long h0 = p_poly1305->h[0], h1 = p_poly1305->h[1], h2 = p_poly1305->h[2],
+                           g0 = 0, g1 = 0, g2 = 0, c = 0, mask = 0,
+                           t0 = poly1305_load_64(&p_poly1305->s[0]),
+                           t1 = poly1305_load_64(&p_poly1305->s[8]);
+
+        // full carry
+        c = h1 >> 44, h1 &= mask_44, h2 += c,
+        c = h2 >> 42, h2 &= mask_42, h0 += c * 5,
+        c = h0 >> 44, h0 &= mask_44, h1 += c,
+        c = h1 >> 44, h1 &= mask_44, h2 += c,
+        c = h2 >> 42, h2 &= mask_42, h0 += c * 5,
+        c = h0 >> 44, h0 &= mask_44, h1 += c;
+
+        // g = h - p
+        g0 = h0 + 5, c = g0 >> 44, g0 &= mask_44,
+        g1 = h1 + c, c = g1 >> 44, g1 &= mask_44,
+        g2 = h2 + c - ( 1ULL << 42 );
+
+        // h = h < p ? h : g, without branching
+        mask = ( g2 >> 63 ) - 1,
+        g0 &= mask, g1 &= mask, g2 &= mask,
+        mask = ~mask,
+        h0 = ( h0 & mask ) | g0,
+        h1 = ( h1 & mask ) | g1,
+        h2 = ( h2 & mask ) | g2;
+
+        // h += s, mod 2^128
+        h0 += (   t0                    & mask_44 )    , c = h0 >> 44, h0 &= mask_44,
+        h1 += ( ( t0 >> 44 | t1 << 20 ) & mask_44 ) + c, c = h1 >> 44, h1 &= mask_44,
+        h2 += ( ( t1 >> 24 )            & mask_42 ) + c,               h2 &= mask_42;
+
+        // pack
+        h0 = h0       | h1 << 44,
+        h1 = h1 >> 20 | h2 << 24;
+
+        // store the tag
+        for ( int i = 0; i < 8; i++ )
+            tag[i]     = (unsigned char) ( h0 >> ( 8 * i ) ),
+            tag[i + 8] = (unsigned char) ( h1 >> ( 8 * i ) );
+    }
+    #else
+    {
+
+        // initialized data
+        const unsigned int mask_26 = 0x3ffffff;
+        unsigned int h0 = (unsigned int) p_poly1305->h[0], h1 = (unsigned int) p_poly1305->h[1],
+                     h2 = (unsigned int) p_poly1305->h[2], h3 = (unsigned int) p_poly1305->h[3],
+                     h4 = (unsigned int) p_poly1305->h[4],
+                     g0 = 0, g1 = 0, g2 = 0, g3 = 0, g4 = 0, c = 0, mask = 0;
+        unsigned long long f = 0;
+
+        // full carry
+        c = h1 >> 26, h1 &= mask_26, h2 += c,
+        c = h2 >> 26, h2 &= mask_26, h3 += c,
+        c = h3 >> 26, h3 &= mask_26, h4 += c,
+        c = h4 >> 26, h4 &= mask_26, h0 += c * 5,
+        c = h0 >> 26, h0 &= mask_26, h1 += c;
+
+        // g = h - p
+        g0 = h0 + 5, c = g0 >> 26, g0 &= mask_26,
+        g1 = h1 + c, c = g1 >> 26, g1 &= mask_26,
+        g2 = h2 + c, c = g2 >> 26, g2 &= mask_26,
+        g3 = h3 + c, c = g3 >> 26, g3 &= mask_26,
+        g4 = h4 + c - ( 1U << 26 );
+
+        // h = h < p ? h : g, without branching
+        mask = ( g4 >> 31 ) - 1,
+        g0 &= mask, g1 &= mask, g2 &= mask, g3 &= mask, g4 &= mask,
+        mask = ~mask,
+        h0 = ( h0 & mask ) | g0,
+        h1 = ( h1 & mask ) | g1,
+        h2 = ( h2 & mask ) | g2,
+        h3 = ( h3 & mask ) | g3,
+        h4 = ( h4 & mask ) | g4;
+
+        // pack into 4 words
+        h0 = h0       | h1 << 26,
+        h1 = h1 >>  6 | h2 << 20,
+        h2 = h2 >> 12 | h3 << 14,
+        h3 = h3 >> 18 | h4 <<  8;
+
+        // h += s, mod 2^128
+        f = (unsigned long long) h0 + poly1305_load_32(&p_poly1305->s[ 0])          , h0 = (unsigned int) f,
+        f = (unsigned long long) h1 + poly1305_load_32(&p_poly1305->s[ 4]) + (f >> 32), h1 = (unsigned int) f,
+        f = (unsigned long long) h2 + poly1305_load_32(&p_poly1305->s[ 8]) + (f >> 32), h2 = (unsigned int) f,
+        f = (unsigned long long) h3 + poly1305_load_32(&p_poly1305->s[12]) + (f >> 32), h3 = (unsigned int) f;
+
+        // store the tag
+        for ( int i = 0; i < 4; i++ )
+            tag[i +  0] = (unsigned char) ( h0 >> ( 8 * i ) ),
+            tag[i +  4] = (unsigned char) ( h1 >> ( 8 * i ) ),
+            tag[i +  8] = (unsigned char) ( h2 >> ( 8 * i ) ),
+            tag[i + 12] = (unsigned char) ( h3 >> ( 8 * i ) );
+    }
+    #endif
 
     #ifdef POLY1305_DEBUG
         printf("Tag: ");
         for (int i = 0; i < 16; i++) printf("%02x%c", tag[i], (i == 15) ? '\n' : ':');
     #endif
 
+    // erase the state
+    memset(p_poly1305, 0, sizeof(poly1305));
+
     // success
     return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_poly1305:
+                #ifndef NDEBUG
+                    log_error("[poly1305] Null pointer provided for parameter \"p_poly1305\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_tag:
+                #ifndef NDEBUG
+                    log_error("[poly1305] Null pointer provided for parameter \"tag\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int poly1305_mac 
+(
+    const unsigned char   *p_message, 
+    size_t                 len, 
+    poly1305_tag           tag, 
+    poly1305_one_time_key  key
+)
+{
+
+    // initialized data
+    poly1305 _poly1305 = { 0 };
+
+    // compute the message authentication code
+    if ( 0 == poly1305_init(&_poly1305, key) ) goto failed_to_compute_mac;
+    if ( 0 == poly1305_update(&_poly1305, p_message, len) ) goto failed_to_compute_mac;
+    if ( 0 == poly1305_final(&_poly1305, tag) ) goto failed_to_compute_mac;
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // poly1305 errors
+        {
+            failed_to_compute_mac:
+                #ifndef NDEBUG
+                    log_error("[poly1305] Failed to compute message authentication code in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
 }
 
 int poly1305_key_generate
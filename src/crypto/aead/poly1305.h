@@ -27,11 +27,58 @@
 // preprocessor definitions
 // #define POLY1305_DEBUG
 
+// structure declarations
+struct poly1305_s;
+
 // type definitions
 typedef unsigned char poly1305_one_time_key[32];
 typedef unsigned char poly1305_tag         [16];
 
+typedef struct poly1305_s poly1305;
+
+// structure definitions
+struct poly1305_s
+{
+    unsigned long long r[5];       // the clamped key, in 3 limbs of 44 bits, or 5 limbs of 26 bits
+    unsigned long long h[5];       // the accumulator, in the same limbs as r
+    unsigned char      s[16];      // the key that is added to the accumulator at the end
+    unsigned char      buffer[16]; // a partial block
+    size_t             leftover;   // the quantity of bytes in buffer
+};
+
 // function declarations
+/// streaming
+/** !
+ * Start computing a message authentication code
+ * 
+ * @param p_poly1305 result
+ * @param key        the key
+ * 
+ * @return 1 on success, 0 on error
+ */
+int poly1305_init ( poly1305 *p_poly1305, const poly1305_one_time_key key );
+
+/** !
+ * Authenticate more of a message
+ * 
+ * @param p_poly1305 the poly1305 state
+ * @param p_message  the next part of the message
+ * @param len        the quantity of bytes to authenticate
+ * 
+ * @return 1 on success, 0 on error
+ */
+int poly1305_update ( poly1305 *p_poly1305, const void *p_message, size_t len );
+
+/** !
+ * Finish computing a message authentication code, then erase the state
+ * 
+ * @param p_poly1305 the poly1305 state
+ * @param tag        result
+ * 
+ * @return 1 on success, 0 on error
+ */
+int poly1305_final ( poly1305 *p_poly1305, poly1305_tag tag );
+
 /// message
 /** !
  * Compute a message authentication code  
@@ -13,119 +13,264 @@
 #define RED "\033[91m"
 #define BLUE "\033[94m"
 #define RESET "\033[0m"
+#define ED25519_BATCH_MAX 64
+
+// structure definitions
+struct ge25519_s
+{
+    fe25519 X, Y, Z, T; // extended coordinates, x = X/Z, y = Y/Z, x*y = T/Z
+};
+
+struct ge25519_precomp_s
+{
+    fe25519 yplusx, yminusx, xy2d; // affine (y + x, y - x, 2dxy)
+};
+
+struct ed25519_expanded_key_s
+{
+    ed25519_public_key       public_key;   // the encoded public key, for H(R || A || M)
+    struct ge25519_precomp_s table[32][8]; // table[i][j] = (j + 1) * 256^i * A
+};
 
 // type definitions
-typedef unsigned _BitInt(256) i256;
-typedef unsigned _BitInt(512) i512;
+typedef struct ge25519_s ge25519;
+typedef struct ge25519_precomp_s ge25519_precomp;
 
 // constant data
-static const i256 Q  = 0x7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEDWB;
-static const i256 D  = 0x52036CEE2B6FFE738CC740797779E89800700A4D4141D8AB75EB4DCA135978A3WB;
-static const i256 I  = 0x2B8324804FC1DF0B2B4D00993DFBD7A72F431806AD2FE478C4EE1B274A0EA0B0WB;
-static const i256 Bx = 0x216936D3CD6E53FEC0A4E231FDD6DC5C692CC7609525A7B2C9562D608F25D51AWB;
-static const i256 By = 0x6666666666666666666666666666666666666666666666666666666666666658WB;
-static const i256 L  = 0x1000000000000000000000000000000014DEF9DEA2F79CD65812631A5CF5D3EDWB;
+static const fe25519 D  = { 0x34dca135978a3ULL, 0x1a8283b156ebdULL, 0x5e7a26001c029ULL, 0x739c663a03cbbULL, 0x52036cee2b6ffULL };
+static const fe25519 D2 = { 0x69b9426b2f159ULL, 0x35050762add7aULL, 0x3cf44c0038052ULL, 0x6738cc7407977ULL, 0x2406d9dc56dffULL };
+static const fe25519 I  = { 0x61b274a0ea0b0ULL, 0x0d5a5fc8f189dULL, 0x7ef5e9cbd0c60ULL, 0x78595a6804c9eULL, 0x2b8324804fc1dULL };
+static const ge25519 B  =
+{
+    .X = { 0x62d608f25d51aULL, 0x412a4b4f6592aULL, 0x75b7171a4b31dULL, 0x1ff60527118feULL, 0x216936d3cd6e5ULL },
+    .Y = { 0x6666666666658ULL, 0x4ccccccccccccULL, 0x1999999999999ULL, 0x3333333333333ULL, 0x6666666666666ULL },
+    .Z = { 1, 0, 0, 0, 0 },
+    .T = { 0x68ab3a5b7dda3ULL, 0x00eea2a5eadbbULL, 0x2af8df483c27eULL, 0x332b375274732ULL, 0x67875f0fd78b7ULL }
+};
+static const long long L[32] =
+{
+    0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58, 0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10
+};
+
+// data
+static ge25519_precomp base_table[32][8] = { 0 }; // base_table[i][j] = (j + 1) * 256^i * B
+static bool initialized = false;
 
 // function declarations
 /** !
- * Modular exponentiation by squaring
+ * Set a point to the neutral element
  * 
- * @param b the base
- * @param e the exponent
- * @param m the modulus
+ * @param P result
  * 
- * @return (b ^ e) mod m 
+ * @return void
  */
-i256 expmod ( i256 b, i256 e, i256 m );
+void ge25519_identity ( ge25519 *P );
 
 /** !
- * Modular inverse 
+ * Add two points on a twisted Edwards curve. P, _Q and R may alias
  * 
- * @param x the number
+ * @param R  the result
+ * @param P  the first point
+ * @param _Q the second point
  * 
- * @return the modular inverse of x mod 2^255-19
+ * @return void
  */
-i256 inv ( i256 x );
+void ge25519_add ( ge25519 *R, const ge25519 *P, const ge25519 *_Q );
 
 /** !
- * Recover the x-coordinate on a twisted Edwards curve given a y-coordinate
+ * Double a point on a twisted Edwards curve. P and R may alias
  * 
- * @param y the y-coordinate
+ * @param R the result
+ * @param P the point
  * 
- * @return the x-coordinate
+ * @return void
  */
-i256 xrecover ( i256 y );
+void ge25519_double ( ge25519 *R, const ge25519 *P );
 
 /** !
- * Add two points on a twisted Edwards curve
+ * Multiply a point by the cofactor, 8, which clears any small order
+ * component. P and R may alias
  * 
- * @param P  the first point
- * @param _Q the second point
- * @param R  the result
+ * @param R the result
+ * @param P the point
  * 
  * @return void
  */
-void edwards ( i256 P[2], i256 _Q[2], i256 R[2] );
+void ge25519_mul_by_cofactor ( ge25519 *R, const ge25519 *P );
 
 /** !
- * Scalar multiplication of a point on a twisted Edwards curve
+ * Copy _Q into P if b is 1, in constant time
  * 
- * @param P the point
- * @param e the scalar
- * @param R the result
+ * @param P  result
+ * @param _Q the point
+ * @param b  1 to copy, 0 to leave
  * 
  * @return void
  */
-void scalarmult ( i256 P[2], i256 e, i256 R[2] );
+void ge25519_cmov ( ge25519 *P, const ge25519 *_Q, unsigned int b );
 
 /** !
- * Get the n'th bit of some data
+ * Scalar multiplication of a point on a twisted Edwards curve, 4 bits at
+ * a time, in constant time
  * 
- * @param h the data
- * @param i the n'th bit
+ * @param R the result
+ * @param P the point
+ * @param e the scalar, 32 little endian bytes
  * 
- * @return 1 IF set, 0 IF clear
+ * @return void
  */
-int bit ( const unsigned char *h, int i );
+void ge25519_scalarmult ( ge25519 *R, const ge25519 *P, const unsigned char e[32] );
 
 /** !
- * Store a 256-bit integer in a buffer
+ * Test if two points are equal
  * 
- * @param y   the integer
- * @param out the buffer
+ * @param P  the first point
+ * @param _Q the second point
  * 
- * @return void
+ * @return true if P equals _Q, else false
  */
-void encodeint ( i256 y, unsigned char *out );
+bool ge25519_equal ( const ge25519 *P, const ge25519 *_Q );
 
 /** !
  * Store a point on a twisted edwards curve in a buffer
  * 
- * @param P   the point
  * @param out the buffer
+ * @param P   the point
  * 
  * @return void
  */
-void encodepoint ( i256 P[2], unsigned char *out );
+void ge25519_to_bytes ( unsigned char out[32], const ge25519 *P );
 
 /** !
- * Load a 256-bit integer from a buffer
+ * Load a point on a twisted edwards curve from a buffer
  * 
+ * @param P result
  * @param s the buffer
  * 
- * @return the 256-bit integer
+ * @return 1 on success, 0 on error
  */
-i256 decodeint ( const unsigned char *s );
+int ge25519_from_bytes ( ge25519 *P, const unsigned char s[32] );
 
 /** !
- * Load a point on a twisted edwards curve from a buffer
+ * Reduce an integer modulo the group order L
  * 
- * @param s the buffer
- * @param P the result
+ * @param r result, 32 little endian bytes
+ * @param x the integer, as 64 signed limbs of 8 bits. x is destroyed
  * 
- * @return 1 on success, 0 on error
+ * @return void
+ */
+void sc25519_mod_l ( unsigned char r[32], long long x[64] );
+
+/** !
+ * Reduce a 512-bit integer modulo the group order L
+ * 
+ * @param r result, 32 little endian bytes
+ * @param s the integer, 64 little endian bytes
+ * 
+ * @return void
+ */
+void sc25519_reduce ( unsigned char r[32], const unsigned char s[64] );
+
+/** !
+ * Compute (a * b + c) mod L
+ * 
+ * @param s result, 32 little endian bytes
+ * @param a the first factor
+ * @param b the second factor
+ * @param c the addend
+ * 
+ * @return void
+ */
+void sc25519_muladd ( unsigned char s[32], const unsigned char a[32], const unsigned char b[32], const unsigned char c[32] );
+
+/** !
+ * Test if a scalar is less than the group order L
+ * 
+ * @param s the scalar, 32 little endian bytes
+ * 
+ * @return true if s < L, else false
+ */
+bool sc25519_is_canonical ( const unsigned char s[32] );
+
+/** !
+ * Compute L - s
+ * 
+ * @param r result, 32 little endian bytes
+ * @param s the scalar, less than L
+ * 
+ * @return void
+ */
+void sc25519_negate ( unsigned char r[32], const unsigned char s[32] );
+
+/** !
+ * Add a precomputed point to a point on a twisted Edwards curve. P and R may alias
+ * 
+ * @param R  the result
+ * @param P  the point
+ * @param _Q the precomputed point
+ * 
+ * @return void
+ */
+void ge25519_madd ( ge25519 *R, const ge25519 *P, const ge25519_precomp *_Q );
+
+/** !
+ * Build the table of a point, for fixed-base scalar multiplication
+ * 
+ * @param table result, table[i][j] = (j + 1) * 256^i * P
+ * @param P     the point
+ * 
+ * @return void
+ */
+void ge25519_precomp_table ( ge25519_precomp table[32][8], const ge25519 *P );
+
+/** !
+ * Select b * 256^i * P from a table, in constant time
+ * 
+ * @param t     result
+ * @param table the table of P
+ * @param i     the row of the table
+ * @param b     the signed digit, from -8 to 8
+ * 
+ * @return void
  */
-int decodepoint ( const unsigned char *s, i256 P[2] );
+void ge25519_select ( ge25519_precomp *t, const ge25519_precomp table[32][8], int i, signed char b );
+
+/** !
+ * Scalar multiplication of a point with its table, in constant time
+ * 
+ * @param R     the result
+ * @param table the table of the point
+ * @param e     the scalar, 32 little endian bytes. the top bit must be clear
+ * 
+ * @return void
+ */
+void ge25519_scalarmult_table ( ge25519 *R, const ge25519_precomp table[32][8], const unsigned char e[32] );
+
+/** !
+ * Scalar multiplication of the base point, in constant time
+ * 
+ * @param R the result
+ * @param e the scalar, 32 little endian bytes. the top bit must be clear
+ * 
+ * @return void
+ */
+void ge25519_scalarmult_base ( ge25519 *R, const unsigned char e[32] );
+
+/** !
+ * Compute the sum of many scalar multiples, in variable time. Each scalar
+ * is consumed 4 bits at a time, and all the points share the doublings
+ * (Straus).
+ * 
+ * @param R         the result
+ * @param p_points  an array of quantity points
+ * @param p_scalars an array of quantity scalars, 32 little endian bytes each
+ * @param quantity  the quantity of points
+ * @param p_tables  an array of quantity tables of 16 points, for scratch
+ * 
+ * @return void
+ */
+void ge25519_multiscalarmult_vartime ( ge25519 *R, const ge25519 *p_points, const unsigned char (*p_scalars)[32], size_t quantity, ge25519 (*p_tables)[16] );
 
 /** !
  * Hash a message with SHA512
@@ -141,12 +286,26 @@ void H ( const unsigned char *m, size_t len, unsigned char *out );
 /** !
  * Compute a cryptographic scalar for a message
  * 
- * @param m the message
+ * @param m   the message
+ * @param len the length of the message
+ * @param out result, the hash of the message mod L
+ * 
+ * @return void
+ */
+void Hint ( const unsigned char *m, size_t len, unsigned char out[32] );
+
+/** !
+ * Compute the challenge scalar H(R || A || M) mod L, without copying the message
+ * 
+ * @param R   the encoded R
+ * @param A   the encoded public key
+ * @param m   the message
  * @param len the length of the message
+ * @param out result
  * 
- * @return the "Hint"
+ * @return void
  */
-i256 Hint ( const unsigned char *m, size_t len );
+void Hram ( const unsigned char R[32], const unsigned char A[32], const unsigned char *m, size_t len, unsigned char out[32] );
 
 /** !
  * Derive the public key from the private key
@@ -159,297 +318,547 @@ i256 Hint ( const unsigned char *m, size_t len );
 void public_key_derive ( const unsigned char *sk, unsigned char *pk );
 
 // function definitions
-i256 add_mod ( i256 a, i256 b, i256 m ) { return (a + b) % m; }
-i256 sub_mod ( i256 a, i256 b, i256 m ) { return (a - b + m) % m; }
-i256 mul_mod ( i256 a, i256 b, i256 m ) { return ((i512)a * b) % m; }
-i256 sqr_mod ( i256 a, i256 m )         { return mul_mod(a, a, m); }
-i256 inv     ( i256 x )                 { return expmod(x, Q - 2, Q); }
+void ge25519_identity ( ge25519 *P )
+{
+
+    // (0, 1)
+    fe25519_0(P->X), fe25519_1(P->Y), fe25519_1(P->Z), fe25519_0(P->T);
+
+    // done
+    return;
+}
+
+void ge25519_add ( ge25519 *R, const ge25519 *P, const ge25519 *_Q )
+{
+
+    // initialized data
+    fe25519 a, b, c, d, e, f, g, h, t;
+
+    // RFC 8032 > 5.1.4
+    fe25519_sub(a, P->Y, P->X),
+    fe25519_sub(t, _Q->Y, _Q->X),
+    fe25519_mul(a, a, t);
+    fe25519_add(b, P->Y, P->X),
+    fe25519_add(t, _Q->Y, _Q->X),
+    fe25519_mul(b, b, t);
+    fe25519_mul(c, P->T, _Q->T),
+    fe25519_mul(c, c, D2);
+    fe25519_mul(d, P->Z, _Q->Z),
+    fe25519_add(d, d, d);
+    fe25519_sub(e, b, a),
+    fe25519_sub(f, d, c),
+    fe25519_add(g, d, c),
+    fe25519_add(h, b, a);
+
+    // store the result
+    fe25519_mul(R->X, e, f),
+    fe25519_mul(R->Y, g, h),
+    fe25519_mul(R->T, e, h),
+    fe25519_mul(R->Z, f, g);
+
+    // done
+    return;
+}
+
+void ge25519_double ( ge25519 *R, const ge25519 *P )
+{
+
+    // initialized data
+    fe25519 a, b, c, e, f, g, h;
+
+    // RFC 8032 > 5.1.4
+    fe25519_sq(a, P->X),
+    fe25519_sq(b, P->Y),
+    fe25519_sq(c, P->Z),
+    fe25519_add(c, c, c),
+    fe25519_add(h, a, b),
+    fe25519_add(e, P->X, P->Y),
+    fe25519_sq(e, e),
+    fe25519_sub(e, h, e),
+    fe25519_sub(g, a, b),
+    fe25519_add(f, c, g);
+
+    // store the result
+    fe25519_mul(R->X, e, f),
+    fe25519_mul(R->Y, g, h),
+    fe25519_mul(R->T, e, h),
+    fe25519_mul(R->Z, f, g);
+
+    // done
+    return;
+}
+
+void ge25519_mul_by_cofactor ( ge25519 *R, const ge25519 *P )
+{
+
+    // [8]P
+    ge25519_double(R, P),
+    ge25519_double(R, R),
+    ge25519_double(R, R);
+
+    // done
+    return;
+}
+
+void ge25519_cmov ( ge25519 *P, const ge25519 *_Q, unsigned int b )
+{
+
+    // copy each coordinate
+    fe25519_cmov(P->X, _Q->X, b),
+    fe25519_cmov(P->Y, _Q->Y, b),
+    fe25519_cmov(P->Z, _Q->Z, b),
+    fe25519_cmov(P->T, _Q->T, b);
+
+    // done
+    return;
+}
 
-i256 expmod ( i256 b, i256 e, i256 m )
+void ge25519_scalarmult ( ge25519 *R, const ge25519 *P, const unsigned char e[32] )
 {
 
     // initialized data
-    i256 t = 1;
+    ge25519 table[16], T;
+
+    // table[i] = i * P
+    ge25519_identity(&table[0]);
+    table[1] = *P;
+    for (int i = 2; i < 16; i++) ge25519_add(&table[i], &table[i - 1], P);
 
-    // process the exponent
-    while (e > 0)
+    // start at the neutral element
+    ge25519_identity(R);
+
+    // most significant window first
+    for (int i = 63; i >= 0; i--)
     {
 
-        // odd exponent 
-        if (e % 2 == 1) t = mul_mod(t, b, m);
+        // initialized data
+        unsigned int w = ( e[i / 2] >> ( 4 * ( i % 2 ) ) ) & 0xf;
+
+        // R = 16 * R
+        ge25519_double(R, R),
+        ge25519_double(R, R),
+        ge25519_double(R, R),
+        ge25519_double(R, R);
 
-        // square
-        b = sqr_mod(b, m);
+        // T = table[w], without a secret dependent load
+        ge25519_identity(&T);
+        for (unsigned int j = 1; j < 16; j++)
+            ge25519_cmov(&T, &table[j], ( ( j ^ w ) - 1 ) >> 31);
 
-        // shift
-        e /= 2;
+        // R = R + T
+        ge25519_add(R, R, &T);
     }
-    
+
     // done
-    return t;
+    return;
 }
 
-i256 xrecover ( i256 y )
+void ge25519_madd ( ge25519 *R, const ge25519 *P, const ge25519_precomp *_Q )
 {
 
     // initialized data
-    i256 y2 = 0;
-    i256 num = 0, den = 0;
-    i256 xx = 0, x = 0, x2 = 0;
+    fe25519 a, b, c, d, e, f, g, h;
+
+    // RFC 8032 > 5.1.4, with Z2 = 1
+    fe25519_sub(a, P->Y, P->X),
+    fe25519_mul(a, a, _Q->yminusx);
+    fe25519_add(b, P->Y, P->X),
+    fe25519_mul(b, b, _Q->yplusx);
+    fe25519_mul(c, P->T, _Q->xy2d);
+    fe25519_add(d, P->Z, P->Z);
+    fe25519_sub(e, b, a),
+    fe25519_sub(f, d, c),
+    fe25519_add(g, d, c),
+    fe25519_add(h, b, a);
 
-    // y2 = (y^2) mod Q
-    y2  = sqr_mod(y, Q);
+    // store the result
+    fe25519_mul(R->X, e, f),
+    fe25519_mul(R->Y, g, h),
+    fe25519_mul(R->T, e, h),
+    fe25519_mul(R->Z, f, g);
 
-    // num = (y^2 - 1) mod Q
-    num = sub_mod(y2, 1, Q);
+    // done
+    return;
+}
 
-    // den = (d * y^2 + 1) mod Q
-    den = add_mod(
-        mul_mod(D, y2, Q),
-        1,
-        Q
-    );
-    
-    // xx = (num / den) mod Q
-    xx = mul_mod(
-        num, 
-        inv(den),
-        Q
-    );
-    
-    // NOTE: This is a fun party trick from section 5.1.3 of the RFC
-    // x = sqrt(xx)
-    x = expmod(xx, (Q + 3) / 8, Q);
-    
-    // correct x
-    x2 = sqr_mod(x, Q);
-    if (sub_mod(x2, xx, Q) != 0) 
-        x = mul_mod(x, I, Q);
-    
-    // force x to be even
-    if (x % 2 != 0) 
-        x = Q - x;
+void ge25519_precomp_table ( ge25519_precomp table[32][8], const ge25519 *P )
+{
+
+    // initialized data
+    ge25519 points[32 * 8];
+    fe25519 products[32 * 8];
+    ge25519 _P = *P;
+    fe25519 z_inv, t;
+
+    // points[8 * i + j] = (j + 1) * 256^i * P
+    for (int i = 0; i < 32; i++)
+    {
+
+        // multiples of 256^i * P
+        points[8 * i] = _P;
+        for (int j = 1; j < 8; j++) ge25519_add(&points[8 * i + j], &points[8 * i + j - 1], &_P);
+
+        // _P = 256 * _P
+        for (int j = 0; j < 8; j++) ge25519_double(&_P, &_P);
+    }
+
+    // invert every Z with one inversion
+    fe25519_copy(products[0], points[0].Z);
+    for (int i = 1; i < 32 * 8; i++) fe25519_mul(products[i], products[i - 1], points[i].Z);
+    fe25519_invert(z_inv, products[32 * 8 - 1]);
+
+    // store each point in affine form
+    for (int i = 32 * 8 - 1; i >= 0; i--)
+    {
+
+        // initialized data
+        ge25519_precomp *p_precomp = &table[i / 8][i % 8];
+        fe25519 x, y;
+
+        // 1 / Z_i
+        if ( i ) fe25519_mul(t, z_inv, products[i - 1]), fe25519_mul(z_inv, z_inv, points[i].Z);
+        else     fe25519_copy(t, z_inv);
+
+        // affine coordinates
+        fe25519_mul(x, points[i].X, t),
+        fe25519_mul(y, points[i].Y, t);
+
+        // (y + x, y - x, 2dxy)
+        fe25519_add(p_precomp->yplusx, y, x),
+        fe25519_sub(p_precomp->yminusx, y, x),
+        fe25519_mul(p_precomp->xy2d, x, y),
+        fe25519_mul(p_precomp->xy2d, p_precomp->xy2d, D2);
+    }
 
     // done
-    return x;
+    return;
 }
 
-void edwards ( i256 P[2], i256 _Q[2], i256 R[2] )
+void ge25519_select ( ge25519_precomp *t, const ge25519_precomp table[32][8], int i, signed char b )
 {
 
     // initialized data
-    i256 x1 =  P[0], y1 =  P[1];
-    i256 x2 = _Q[0], y2 = _Q[1];
-    i256 x1y2 = 0, x2y1  = 0,
-         y1y2 = 0, x1x2  = 0;
-    i256 x_num = 0, x_den = 0;
-    i256 y_num = 0, y_den = 0;
-    i256 temp  = 0;
-
-    // compute intermediate products
-    x1y2 = mul_mod(x1, y2, Q),
-    x2y1 = mul_mod(x2, y1, Q),
-    y1y2 = mul_mod(y1, y2, Q),
-    x1x2 = mul_mod(x1, x2, Q);
-
-    // compute the denominator term
-    temp = mul_mod(
-        D, 
-        mul_mod(
-            x1x2, 
-            y1y2, 
-            Q
-        ), 
-        Q
-    );
+    unsigned int negative = (unsigned char) b >> 7;
+    unsigned int b_abs    = (unsigned int) ( b - ( ( -(int) negative & b ) * 2 ) );
+    fe25519      minus_xy2d;
 
-    // compute x
-    x_num = add_mod(x1y2, x2y1, Q),
-    x_den = add_mod(1, temp, Q);
+    // start at the neutral element
+    fe25519_1(t->yplusx), fe25519_1(t->yminusx), fe25519_0(t->xy2d);
 
-    // compute y
-    y_num = add_mod(y1y2, x1x2, Q),
-    y_den = sub_mod(1, temp, Q);
-    
-    // store the results
-    R[0] = mul_mod(
-        x_num, 
-        inv(x_den), 
-        Q
-    ),
-
-    R[1] = mul_mod(
-        y_num, 
-        inv(y_den), 
-        Q
-    );
+    // t = table[i][|b| - 1], without a secret dependent load
+    for (unsigned int j = 1; j <= 8; j++)
+        fe25519_cmov(t->yplusx , table[i][j - 1].yplusx , ( ( j ^ b_abs ) - 1 ) >> 31),
+        fe25519_cmov(t->yminusx, table[i][j - 1].yminusx, ( ( j ^ b_abs ) - 1 ) >> 31),
+        fe25519_cmov(t->xy2d   , table[i][j - 1].xy2d   , ( ( j ^ b_abs ) - 1 ) >> 31);
+
+    // -t = (y - x, y + x, -2dxy)
+    fe25519_cswap(t->yplusx, t->yminusx, negative),
+    fe25519_neg(minus_xy2d, t->xy2d),
+    fe25519_cmov(t->xy2d, minus_xy2d, negative);
 
     // done
     return;
 }
 
-void scalarmult ( i256 P[2], i256 e, i256 R[2] )
+void ge25519_scalarmult_table ( ge25519 *R, const ge25519_precomp table[32][8], const unsigned char e[32] )
 {
 
     // initialized data
-    i256 _Q[2] = { P[0], P[1] };
+    signed char     digits[64] = { 0 };
+    signed char     carry      = 0;
+    ge25519_precomp t          = { 0 };
 
-    // store initial point
-    R[0] = 0; R[1] = 1;
-    
-    while (e > 0)
+    // split e into 64 signed radix 16 digits, from -8 to 8
+    for (int i = 0; i < 32; i++)
+        digits[2 * i]     = e[i] & 0xf,
+        digits[2 * i + 1] = ( e[i] >> 4 ) & 0xf;
+
+    for (int i = 0; i < 63; i++)
+        digits[i]      += carry,
+        carry           = (signed char) ( ( digits[i] + 8 ) >> 4 ),
+        digits[i]      -= (signed char) ( carry * 16 );
+    digits[63] += carry;
+
+    // start at the neutral element
+    ge25519_identity(R);
+
+    // the odd digits
+    for (int i = 1; i < 64; i += 2)
+        ge25519_select(&t, table, i / 2, digits[i]),
+        ge25519_madd(R, R, &t);
+
+    // R = 16 * R
+    ge25519_double(R, R),
+    ge25519_double(R, R),
+    ge25519_double(R, R),
+    ge25519_double(R, R);
+
+    // the even digits
+    for (int i = 0; i < 64; i += 2)
+        ge25519_select(&t, table, i / 2, digits[i]),
+        ge25519_madd(R, R, &t);
+
+    // done
+    return;
+}
+
+void ge25519_scalarmult_base ( ge25519 *R, const unsigned char e[32] )
+{
+
+    // R = e * B
+    ge25519_scalarmult_table(R, (const ge25519_precomp (*)[8]) base_table, e);
+
+    // done
+    return;
+}
+
+void ge25519_multiscalarmult_vartime ( ge25519 *R, const ge25519 *p_points, const unsigned char (*p_scalars)[32], size_t quantity, ge25519 (*p_tables)[16] )
+{
+
+    // p_tables[i][j] = j * p_points[i]
+    for (size_t i = 0; i < quantity; i++)
     {
+        ge25519_identity(&p_tables[i][0]);
+        p_tables[i][1] = p_points[i];
+        for (int j = 2; j < 16; j++) ge25519_add(&p_tables[i][j], &p_tables[i][j - 1], &p_points[i]);
+    }
 
-        // initialized data
-        i256 T[2] = { 0, 0 };
+    // start at the neutral element
+    ge25519_identity(R);
+
+    // most significant window first
+    for (int w = 63; w >= 0; w--)
+    {
+
+        // R = 16 * R
+        if ( w != 63 )
+            ge25519_double(R, R),
+            ge25519_double(R, R),
+            ge25519_double(R, R),
+            ge25519_double(R, R);
 
-        // odd
-        if (e % 2 == 1)
+        // add each point's multiple for this window
+        for (size_t i = 0; i < quantity; i++)
         {
-            
-            // initialized data
-            i256 T[2] = { 0, 0 };
 
-            // add points
-            edwards(R, _Q, T);
+            // initialized data
+            unsigned int d = ( p_scalars[i][w / 2] >> ( 4 * ( w % 2 ) ) ) & 0xf;
 
-            // store result
-            R[0] = T[0], 
-            R[1] = T[1];
+            // the scalars are public, so zero windows are skipped
+            if ( d ) ge25519_add(R, R, &p_tables[i][d]);
         }
+    }
 
-        // add points
-        edwards(_Q, _Q, T);
+    // done
+    return;
+}
 
-        // store result
-        _Q[0] = T[0],
-        _Q[1] = T[1];
+bool ge25519_equal ( const ge25519 *P, const ge25519 *_Q )
+{
 
-        // iterate
-        e /= 2;
-    }
+    // initialized data
+    fe25519 l, r;
+
+    // X1 * Z2 = X2 * Z1
+    fe25519_mul(l, P->X, _Q->Z),
+    fe25519_mul(r, _Q->X, P->Z);
+    if ( false == fe25519_equal(l, r) ) return false;
+
+    // Y1 * Z2 = Y2 * Z1
+    fe25519_mul(l, P->Y, _Q->Z),
+    fe25519_mul(r, _Q->Y, P->Z);
+
+    // done
+    return fe25519_equal(l, r);
 }
 
-int bit ( const unsigned char *h, int i )
+void ge25519_to_bytes ( unsigned char out[32], const ge25519 *P )
 {
 
+    // initialized data
+    fe25519 z_inv, x, y;
+
+    // affine coordinates
+    fe25519_invert(z_inv, P->Z),
+    fe25519_mul(x, P->X, z_inv),
+    fe25519_mul(y, P->Y, z_inv);
+
+    // encode y
+    fe25519_to_bytes(out, y);
+
+    // encode the parity of x
+    out[31] |= (unsigned char) ( fe25519_is_negative(x) << 7 );
+
     // done
-    return (h[i / 8] >> (i % 8)) & 1;
+    return;
 }
 
-void encodeint ( i256 y, unsigned char *out )
+int ge25519_from_bytes ( ge25519 *P, const unsigned char s[32] )
 {
 
-    // serialize the integer
-    for (int i = 0; i < 32; i++)
-        out[i] = (unsigned char)(y >> (i * 8));
-    
+    // initialized data
+    fe25519 u, v, v3, x, vxx, t;
+    int sign = s[31] >> 7;
+
+    // decode y, ignoring the sign of x
+    fe25519_from_bytes(P->Y, s);
+    fe25519_1(P->Z);
+
+    // u = y^2 - 1, v = d * y^2 + 1
+    fe25519_sq(u, P->Y),
+    fe25519_mul(v, u, D),
+    fe25519_sub(u, u, P->Z),
+    fe25519_add(v, v, P->Z);
+
+    // NOTE: This is a fun party trick from section 5.1.3 of the RFC
+    // x = u * v^3 * (u * v^7)^((p - 5) / 8)
+    fe25519_sq(v3, v),
+    fe25519_mul(v3, v3, v),
+    fe25519_sq(x, v3),
+    fe25519_mul(x, x, v),
+    fe25519_mul(x, x, u),
+    fe25519_pow22523(x, x),
+    fe25519_mul(x, x, v3),
+    fe25519_mul(x, x, u);
+
+    // v * x^2 = u, or v * x^2 = -u and x needs a factor of sqrt(-1)
+    fe25519_sq(vxx, x),
+    fe25519_mul(vxx, vxx, v);
+    if ( false == fe25519_equal(vxx, u) )
+    {
+
+        // error check
+        fe25519_neg(t, u);
+        if ( false == fe25519_equal(vxx, t) ) return 0;
+
+        // correct x
+        fe25519_mul(x, x, I);
+    }
+
+    // error check
+    if ( fe25519_is_zero(x) && sign ) return 0;
+
+    // correct the sign of x
+    if ( fe25519_is_negative(x) != sign ) fe25519_neg(x, x);
+
+    // store the result
+    fe25519_copy(P->X, x),
+    fe25519_mul(P->T, x, P->Y);
+
+    // success
+    return 1;
+}
+
+void sc25519_mod_l ( unsigned char r[32], long long x[64] )
+{
+
+    // initialized data
+    long long carry = 0;
+    int i = 0, j = 0;
+
+    // fold each byte above 2^256 into the lower bytes, since 2^252 = -(L - 2^252) (mod L)
+    for (i = 63; i >= 32; i--)
+    {
+        carry = 0;
+        for (j = i - 32; j < i - 12; j++)
+        {
+            x[j] += carry - 16 * x[i] * L[j - (i - 32)];
+            carry = ( x[j] + 128 ) >> 8;
+            x[j] -= carry * 256;
+        }
+        x[j] += carry;
+        x[i] = 0;
+    }
+
+    // fold the bits above 2^252
+    carry = 0;
+    for (j = 0; j < 32; j++)
+    {
+        x[j] += carry - ( x[31] >> 4 ) * L[j];
+        carry = x[j] >> 8;
+        x[j] &= 255;
+    }
+
+    // x < 2L, subtract L at most once
+    for (j = 0; j < 32; j++) x[j] -= carry * L[j];
+
+    // propagate the carries, and store the result
+    for (i = 0; i < 32; i++)
+        x[i + 1] += x[i] >> 8,
+        r[i] = (unsigned char) ( x[i] & 255 );
+
     // done
     return;
 }
 
-void encodepoint ( i256 P[2], unsigned char *out )
+void sc25519_reduce ( unsigned char r[32], const unsigned char s[64] )
 {
 
     // initialized data
-    i256 x = P[0], y = P[1];
+    long long x[64];
 
-    // encode y
-    encodeint(y, out);
+    // widen
+    for (int i = 0; i < 64; i++) x[i] = s[i];
 
-    // encode the parity of x
-    if ((x & 1) == 1) out[31] |= 0x80;
+    // reduce
+    sc25519_mod_l(r, x);
+
+    // done
+    return;
 }
 
-i256 decodeint ( const unsigned char *s )
+void sc25519_muladd ( unsigned char s[32], const unsigned char a[32], const unsigned char b[32], const unsigned char c[32] )
 {
 
     // initialized data
-    i256 sum = 0;
+    long long x[64] = { 0 };
 
-    // reconstruct the integer
-    for (int i = 0; i < 32; i++) 
-        sum |= ((i256)s[i]) << (i * 8);
-    
-    // done 
-    return sum;
+    // c
+    for (int i = 0; i < 32; i++) x[i] = c[i];
+
+    // a * b + c
+    for (int i = 0; i < 32; i++)
+        for (int j = 0; j < 32; j++)
+            x[i + j] += (long long) a[i] * b[j];
+
+    // reduce
+    sc25519_mod_l(s, x);
+
+    // done
+    return;
 }
 
-int decodepoint ( const unsigned char *s, i256 P[2] )
+bool sc25519_is_canonical ( const unsigned char s[32] )
+{
+
+    // most significant byte first
+    for (int i = 31; i >= 0; i--)
+    {
+        if ( s[i] < L[i] ) return true;
+        if ( s[i] > L[i] ) return false;
+    }
+
+    // s = L
+    return false;
+}
+
+void sc25519_negate ( unsigned char r[32], const unsigned char s[32] )
 {
 
     // initialized data
-    i256 x     = 0, y     = decodeint(s),
-         x2    = 0, y2    = 0;
-    i256 term1 = 0, term2 = 0, 
-         term3 = 0, term4 = 0;
-    i256 lhs   = 0;
-
-    // clear the sign of y
-    y &= ~(((i256)1) << 255); 
-    
-    // recover x from y
-    x = xrecover(y);
+    long long borrow = 0;
 
-    // correct x
-    if ((x & 1) != ((s[31] >> 7) & 1)) x = Q - x;
-    
-    // x2 = x^2 mod Q
-    x2 = sqr_mod(x, Q), 
-    
-    // y2 = y^2 mod Q
-    y2 = sqr_mod(y, Q);
-    
-    // term1 = -x^2 mod Q
-    term1 = sub_mod(0, x2, Q),
-
-    // term2 = y2
-    term2 = y2,
-
-    // term3 = -1 mod Q
-    term3 = sub_mod(0, 1, Q),
-
-    // term4 = -d * ( x^2 + y^2 ) mod Q
-    term4 = sub_mod( 
-        0, 
-        mul_mod(
-            D, 
-            mul_mod(
-                x2,
-                y2,
-                Q
-            ),
-            Q
-        ),
-        Q
-    ); 
-    
-    // NOTE: 
-    //       -x^2 + y^2                 = 1 + d*x^2*y^2
-    //       -x^2 + y^2 - 1 - d*x^2*y^2 = 0
-    // lhs = -x^2 + y^2 - 1 - d*x^2*y^2
-    lhs = add_mod(
-        add_mod(
-            term1,
-            term2,
-            Q
-        ), 
-        add_mod(
-            term3,
-            term4,
-            Q
-        ),
-        Q
-    );
-    
-    // error check
-    if ( lhs != 0 ) return 0; 
-    
-    // store the result
-    P[0] = x, P[1] = y;
+    // schoolbook subtraction
+    for (int i = 0; i < 32; i++)
+    {
+        long long t = L[i] - s[i] - borrow;
 
-    // success
-    return 1;
+        borrow = t < 0;
+        r[i] = (unsigned char) ( t + 256 * borrow );
+    }
+
+    // done
+    return;
 }
 
 void H ( const unsigned char *m, size_t len, unsigned char *out )
@@ -471,54 +880,79 @@ void H ( const unsigned char *m, size_t len, unsigned char *out )
     return;
 }
 
-// Hint(m)
-i256 Hint ( const unsigned char *m, size_t len )
+void Hint ( const unsigned char *m, size_t len, unsigned char out[32] )
 {
 
     // initialized data
     unsigned char h[64] = { 0 };
-    i512 sum = 0;
-    i256 res = 0;
 
     // hash the message
     H(m, len, h);
     
-    // hash -> 512-bit integer
-    for (int i = 0; i < 64; i++) 
-        sum |= ((i512)h[i]) << (i*8);
-    
-    // reduce the integer
-    res = sum % L;
+    // reduce the hash
+    sc25519_reduce(out, h);
+
+    // done
+    return;
+}
+
+void Hram ( const unsigned char R[32], const unsigned char A[32], const unsigned char *m, size_t len, unsigned char out[32] )
+{
+
+    // initialized data
+    sha512_state  state = { 0 };
+    unsigned char h[64] = { 0 };
+
+    // R || A || M
+    sha512_construct(&state),
+    sha512_update(&state, R, 32),
+    sha512_update(&state, A, 32);
+    if ( len ) sha512_update(&state, m, len);
+    sha512_final(&state, h);
+
+    // reduce the hash
+    sc25519_reduce(out, h);
 
     // done
-    return res;
+    return;
 }
 
 void public_key_derive ( const unsigned char *sk, unsigned char *pk )
 {
 
     // initialized data
-    i256          A[2]  = { 0, 0 },
-                  B[2]  = { Bx, By };
-    i256          a     = 0;
+    ge25519       A     = { 0 };
     unsigned char h[64] = { 0 };
 
     // RFC 8032 Section 5.1.5 > 1
     H(sk, 32, h);
     
-    // RFC 8032 Section 5.1.5 > 3
-    a = decodeint(h);
-
     // RFC 8032 Section 5.1.5 > 2
-    a &= ~(((i256)0b111)); 
-    a &= ~(((i256)1) << 255); 
-    a |= ((i256)1) << 254; 
+    h[0]  &= 248;
+    h[31] &= 127;
+    h[31] |= 64;
     
-    // RFC 8032 > Section 5.1.5 > 4
-    scalarmult(B, a, A);
+    // RFC 8032 > Section 5.1.5 > 3, 4
+    ge25519_scalarmult_base(&A, h);
 
     // store the public key
-    encodepoint(A, pk);
+    ge25519_to_bytes(pk, &A);
+
+    // done
+    return;
+}
+
+void ed25519_init ( void )
+{
+
+    // state check
+    if ( initialized == true ) return;
+
+    // base_table[i][j] = (j + 1) * 256^i * B
+    ge25519_precomp_table(base_table, &B);
+
+    // set the initialized flag
+    initialized = true;
 
     // done
     return;
@@ -601,6 +1035,82 @@ int ed25519_key_pair_construct
     }
 }
 
+int ed25519_expanded_key_construct ( ed25519_expanded_key **pp_expanded_key, const ed25519_public_key *p_public_key )
+{
+
+    // argument check
+    if ( NULL == pp_expanded_key ) goto no_expanded_key;
+    if ( NULL ==    p_public_key ) goto no_public_key;
+
+    // initialized data
+    ed25519_expanded_key *p_expanded_key = NULL;
+    ge25519               A              = { 0 };
+
+    // RFC 8032 > 5.1.7 > 1
+    if ( 0 == ge25519_from_bytes(&A, (const unsigned char *)p_public_key) ) goto invalid_public_key;
+
+    // allocate memory for the expanded key
+    p_expanded_key = default_allocator(0, sizeof(ed25519_expanded_key));
+    if ( NULL == p_expanded_key ) goto no_mem;
+
+    // store the encoded key
+    memcpy(p_expanded_key->public_key, p_public_key, sizeof(ed25519_public_key));
+
+    // table[i][j] = (j + 1) * 256^i * A
+    ge25519_precomp_table(p_expanded_key->table, &A);
+
+    // return a pointer to the caller
+    *pp_expanded_key = p_expanded_key;
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_expanded_key:
+                #ifndef NDEBUG
+                    log_error("[ed25519] Null pointer provided for parameter \"pp_expanded_key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_public_key:
+                #ifndef NDEBUG
+                    log_error("[ed25519] Null pointer provided for parameter \"p_public_key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // ed25519 errors
+        {
+            invalid_public_key:
+                #ifndef NDEBUG
+                    log_error("[ed25519] Parameter \"p_public_key\" is not a point on the curve in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[interfaces] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
 int ed25519_sign
 ( 
     ed25519_signature         *p_signature, 
@@ -619,12 +1129,9 @@ int ed25519_sign
 
     // initialized data;
     unsigned char h[64] = { 0 };
-    i256 a = 0;
-    i256 r = 0;
-    i256 B[2] = { Bx, By };
-    i256 R[2] = { 0, 0 };
-    i256 h_ram = 0;
-    i256 S = 0;
+    unsigned char r[32] = { 0 };
+    unsigned char h_ram[32] = { 0 };
+    ge25519 R = { 0 };
     unsigned char R_enc[32];
     unsigned char *temp = NULL;
 
@@ -634,25 +1141,23 @@ int ed25519_sign
 
     // RFC 8032 > 5.1.6 > 1
     H((const unsigned char *)p_private_key, 32, h),
-
-    a = decodeint(h);
-    a &= ~(((i256)0b111));
-    a &= ~(((i256)1) << 255);
-    a |= ((i256)1) << 254;
+    h[0]  &= 248,
+    h[31] &= 127,
+    h[31] |= 64;
     
     // Append the second half of the digest and the message
     memcpy(temp, h + 32, 32);
     memcpy(temp + 32, p_message, message_len);
     
     // RFC 8032 > 5.1.6 > 2
-    r = Hint(temp, 32 + message_len);
+    Hint(temp, 32 + message_len, r);
 
     // release the transient allocation
     temp = default_allocator(temp, 0);
     
     // RFC 8032 > 5.1.6 > 3
-    scalarmult(B, r, R);
-    encodepoint(R, R_enc);
+    ge25519_scalarmult_base(&R, r);
+    ge25519_to_bytes(R_enc, &R);
 
     // allocate memory for h_ram
     temp = default_allocator(0, 32 + 32 + message_len);
@@ -664,17 +1169,14 @@ int ed25519_sign
     memcpy(temp + 64, p_message, message_len);
     
     // RFC 8032 > 5.1.6 > 4
-    h_ram = Hint(temp, 32 + 32 + message_len);
+    Hint(temp, 32 + 32 + message_len, h_ram);
 
     // release the transient allocation
     temp = default_allocator(temp, 0);
     
-    // RFC 8032 > 5.1.6 > 5
-    S = (i256)( ((i512)r + ((i512)h_ram * (i512)a)) % (i512)L );
-    
-    // RFC 8032 > 5.1.6 > 6
+    // RFC 8032 > 5.1.6 > 5, 6
     memcpy(p_signature, R_enc, 32);
-    encodeint(S, ((unsigned char*)p_signature) + 32);
+    sc25519_muladd(((unsigned char*)p_signature) + 32, h_ram, h, r);
     
     // success
     return 1;
@@ -745,23 +1247,20 @@ int ed25519_verify
     if ( NULL ==  p_public_key ) goto no_public_key;
 
     // initialized data
-    i256 R[2]           = { 0, 0 };
-    i256 A[2]           = { 0, 0 };
-    i256 S              = 0;
-    i256 h_ram          = 0;
-    i256 B[2]           = { Bx, By };
-    i256 SB[2]          = { 0, 0 };
-    i256 hA[2]          = { 0, 0 };
-    i256 RhA[2]         = { 0, 0 };
-    unsigned char *temp = NULL;
+    ge25519 R               = { 0 };
+    ge25519 A               = { 0 };
+    ge25519 SB              = { 0 };
+    ge25519 RhA             = { 0 };
+    unsigned char h_ram[32] = { 0 };
+    const unsigned char *S  = ((const unsigned char*)p_signature) + 32;
+    unsigned char *temp     = NULL;
 
     // RFC 8032 > 5.1.7 > 1
-    if ( 0 ==  decodepoint((const unsigned char *)p_signature, R) ) return 0;
-    if ( 0 == decodepoint((const unsigned char *)p_public_key, A) ) return 0;
+    if ( 0 ==  ge25519_from_bytes(&R, (const unsigned char *)p_signature) ) return 0;
+    if ( 0 == ge25519_from_bytes(&A, (const unsigned char *)p_public_key) ) return 0;
     
-    // decode S
-    S = decodeint(((const unsigned char*)p_signature) + 32);
-    if (S >= L) return 0;
+    // S < L
+    if ( false == sc25519_is_canonical(S) ) return 0;
     
     // allocate memory for the verification process
     temp = default_allocator(0, 32 + 32 + message_len);
@@ -777,18 +1276,22 @@ int ed25519_verify
     memcpy(temp + 64, p_message, message_len);
     
     // RFC 8032 > 5.1.7 > 2
-    h_ram = Hint(temp, 32 + 32 + message_len);
+    Hint(temp, 32 + 32 + message_len, h_ram);
 
     // release the transient allocation
     temp = default_allocator(temp, 0);
     
     // RFC 8032 > 5.1.7 > 3
-    scalarmult(B, S, SB),
-    scalarmult(A, h_ram, hA),
-    edwards(R, hA, RhA);
+    ge25519_scalarmult_base(&SB, S),
+    ge25519_scalarmult(&RhA, &A, h_ram),
+    ge25519_add(&RhA, &R, &RhA);
+
+    // [8][S]B = [8]R + [8][h]A, the same equation as ed25519_verify_batch
+    ge25519_mul_by_cofactor(&SB, &SB),
+    ge25519_mul_by_cofactor(&RhA, &RhA);
     
     // done
-    return ( SB[0] == RhA[0] && SB[1] == RhA[1] ) ? 1 : 0;
+    return ge25519_equal(&SB, &RhA) ? 1 : 0;
 
     // error handling
     {
@@ -833,6 +1336,271 @@ int ed25519_verify
     }
 }
 
+int ed25519_verify_batch
+(
+    const ed25519_signature  *const *pp_signatures,
+    const unsigned char      *const *pp_messages,
+    const size_t                    *p_message_lens,
+    const ed25519_public_key *const *pp_public_keys,
+    size_t                           quantity
+)
+{
+
+    // argument check
+    if ( NULL ==  pp_signatures ) goto no_signatures;
+    if ( NULL ==    pp_messages ) goto no_messages;
+    if ( NULL == p_message_lens ) goto no_message_lens;
+    if ( NULL == pp_public_keys ) goto no_public_keys;
+
+    // initialized data
+    size_t         n         = ( quantity < ED25519_BATCH_MAX ) ? quantity : ED25519_BATCH_MAX;
+    size_t         points    = 2 * n + 1;
+    int            result    = 1;
+    FILE          *urandom   = NULL;
+    void          *p_scratch = NULL;
+    ge25519       *p_points  = NULL;
+    ge25519      (*p_tables)[16] = NULL;
+    unsigned char (*p_scalars)[32] = NULL;
+    unsigned char (*p_z)[16] = NULL;
+
+    // nothing to verify
+    if ( 0 == quantity ) return 1;
+
+    // open urandom
+    urandom = fopen("/dev/urandom", "rb");
+    if ( NULL == urandom ) goto failed_to_open_urandom;
+
+    // allocate the scratch space for one batch
+    p_scratch = default_allocator(0, points * ( sizeof(ge25519) + sizeof(*p_tables) + sizeof(*p_scalars) ) + n * sizeof(*p_z));
+    if ( NULL == p_scratch ) goto no_mem;
+
+    // carve the scratch space
+    p_tables  = p_scratch,
+    p_points  = (ge25519 *) ( p_tables + points ),
+    p_scalars = (unsigned char (*)[32]) ( p_points + points ),
+    p_z       = (unsigned char (*)[16]) ( p_scalars + points );
+
+    // verify quantity signatures, n at a time
+    for (size_t i = 0; i < quantity && result; i += n)
+    {
+
+        // initialized data
+        size_t        k        = ( quantity - i < n ) ? quantity - i : n;
+        unsigned char s[32]    = { 0 },
+                      h[32]    = { 0 },
+                      zero[32] = { 0 };
+        ge25519       sum      = { 0 },
+                      O        = { 0 };
+
+        // one random 128-bit weight per signature
+        if ( k != fread(p_z, sizeof(*p_z), k, urandom) ) goto failed_to_read_urandom;
+
+        // check  [8]( [z_j]R_j + [z_j * h_j]A_j - [z_j * S_j]B ) = 0 for every j at once
+        for (size_t j = 0; j < k; j++)
+        {
+
+            // initialized data
+            const unsigned char *p_signature  = (const unsigned char *) pp_signatures[i + j];
+            const unsigned char *p_public_key = (const unsigned char *) pp_public_keys[i + j];
+
+            // RFC 8032 > 5.1.7 > 1
+            if (
+                0     == ge25519_from_bytes(&p_points[2 * j], p_signature)      ||
+                0     == ge25519_from_bytes(&p_points[2 * j + 1], p_public_key) ||
+                false == sc25519_is_canonical(p_signature + 32)
+            )
+            {
+                result = 0;
+                break;
+            }
+
+            // RFC 8032 > 5.1.7 > 2
+            Hram(p_signature, p_public_key, pp_messages[i + j], p_message_lens[i + j], h);
+
+            // z_j
+            memset(p_scalars[2 * j], 0, 32),
+            memcpy(p_scalars[2 * j], p_z[j], 16);
+
+            // z_j * h_j
+            sc25519_muladd(p_scalars[2 * j + 1], p_scalars[2 * j], h, zero);
+
+            // sum of z_j * S_j
+            sc25519_muladd(s, p_scalars[2 * j], p_signature + 32, s);
+        }
+
+        // a signature failed to decode
+        if ( 0 == result ) break;
+
+        // -sum of z_j * S_j
+        p_points[2 * k] = B;
+        sc25519_negate(p_scalars[2 * k], s);
+
+        // RFC 8032 > 5.1.7 > 3
+        ge25519_multiscalarmult_vartime(&sum, p_points, (const unsigned char (*)[32]) p_scalars, 2 * k + 1, p_tables);
+        ge25519_mul_by_cofactor(&sum, &sum);
+        ge25519_identity(&O);
+        result = ge25519_equal(&sum, &O) ? 1 : 0;
+    }
+
+    // release the scratch space
+    p_scratch = default_allocator(p_scratch, 0);
+
+    // close urandom
+    fclose(urandom);
+
+    // done
+    return result;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_signatures:
+                #ifndef NDEBUG
+                    log_error("[ed25519] Null pointer provided for parameter \"pp_signatures\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+                
+                // error
+                return 0;
+
+            no_messages:
+                #ifndef NDEBUG
+                    log_error("[ed25519] Null pointer provided for parameter \"pp_messages\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+                
+                // error
+                return 0;
+
+            no_message_lens:
+                #ifndef NDEBUG
+                    log_error("[ed25519] Null pointer provided for parameter \"p_message_lens\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+                
+                // error
+                return 0;
+
+            no_public_keys:
+                #ifndef NDEBUG
+                    log_error("[ed25519] Null pointer provided for parameter \"pp_public_keys\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+                
+                // error
+                return 0;
+        }
+
+        // standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[interfaces] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // close urandom
+                fclose(urandom);
+
+                // error
+                return 0;
+
+            failed_to_open_urandom:
+                #ifndef NDEBUG
+                    log_error("[ed25519] Failed to open \"/dev/urandom\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+            
+            failed_to_read_urandom:
+                #ifndef NDEBUG
+                    log_error("[ed25519] Failed to read \"/dev/urandom\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // release the scratch space
+                p_scratch = default_allocator(p_scratch, 0);
+
+                // close urandom
+                fclose(urandom);
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int ed25519_verify_expanded
+(
+    const ed25519_signature    *p_signature,
+    const unsigned char        *p_message,
+    size_t                      message_len,
+    const ed25519_expanded_key *p_expanded_key
+)
+{
+
+    // argument check
+    if ( NULL ==    p_signature ) goto no_signature;
+    if ( NULL ==      p_message ) goto no_message;
+    if ( NULL == p_expanded_key ) goto no_expanded_key;
+
+    // initialized data
+    ge25519 R               = { 0 };
+    ge25519 SB              = { 0 };
+    ge25519 RhA             = { 0 };
+    unsigned char h_ram[32] = { 0 };
+    const unsigned char *S  = ((const unsigned char*)p_signature) + 32;
+
+    // RFC 8032 > 5.1.7 > 1
+    if ( 0 == ge25519_from_bytes(&R, (const unsigned char *)p_signature) ) return 0;
+    
+    // S < L
+    if ( false == sc25519_is_canonical(S) ) return 0;
+
+    // RFC 8032 > 5.1.7 > 2
+    Hram((const unsigned char *)p_signature, p_expanded_key->public_key, p_message, message_len, h_ram);
+
+    // RFC 8032 > 5.1.7 > 3
+    ge25519_scalarmult_base(&SB, S),
+    ge25519_scalarmult_table(&RhA, (const ge25519_precomp (*)[8]) p_expanded_key->table, h_ram),
+    ge25519_add(&RhA, &R, &RhA);
+
+    // [8][S]B = [8]R + [8][h]A, the same equation as ed25519_verify_batch
+    ge25519_mul_by_cofactor(&SB, &SB),
+    ge25519_mul_by_cofactor(&RhA, &RhA);
+    
+    // done
+    return ge25519_equal(&SB, &RhA) ? 1 : 0;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_signature:
+                #ifndef NDEBUG
+                    log_error("[ed25519] Null pointer provided for parameter \"p_signature\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+                
+                // error
+                return 0;
+
+            no_message:
+                #ifndef NDEBUG
+                    log_error("[ed25519] Null pointer provided for parameter \"p_message\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+                
+                // error
+                return 0;
+
+            no_expanded_key:
+                #ifndef NDEBUG
+                    log_error("[ed25519] Null pointer provided for parameter \"p_expanded_key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+                
+                // error
+                return 0;
+        }
+    }
+}
+
 int ed25519_public_key_print ( ed25519_public_key *p_public_key )
 {
 
@@ -1359,4 +2127,41 @@ int ed25519_signature_unpack ( ed25519_signature *p_signature, void *p_buffer )
         }
     }
 }
- 
\ No newline at end of file
+ 
+
+int ed25519_expanded_key_destroy ( ed25519_expanded_key **pp_expanded_key )
+{
+
+    // argument check
+    if ( NULL == pp_expanded_key ) goto no_expanded_key;
+
+    // initialized data
+    ed25519_expanded_key *p_expanded_key = *pp_expanded_key;
+
+    // fast exit
+    if ( NULL == p_expanded_key ) return 1;
+
+    // no more pointer for caller
+    *pp_expanded_key = NULL;
+
+    // release the expanded key
+    p_expanded_key = default_allocator(p_expanded_key, 0);
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_expanded_key:
+                #ifndef NDEBUG
+                    log_error("[ed25519] Null pointer provided for parameter \"pp_expanded_key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
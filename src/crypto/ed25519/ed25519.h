@@ -23,13 +23,29 @@
 
 /// crypto
 #include <crypto/sha.h>
+#include <crypto/fe25519.h>
+
+// structure declarations
+struct ed25519_expanded_key_s;
 
 // type definitions
+typedef struct ed25519_expanded_key_s ed25519_expanded_key;
 typedef unsigned char ed25519_public_key  [32];
 typedef unsigned char ed25519_private_key [32];
 typedef unsigned char ed25519_signature   [64];
 
 // function declarations
+/// initializer
+/** !
+ * This gets called at runtime before main. Builds the base point table
+ * used for signing and key generation.
+ * 
+ * @param void
+ * 
+ * @return void
+ */
+void ed25519_init ( void ) __attribute__((constructor));
+
 /// constructors
 /** !
  * Construct an Ed25519 key pair
@@ -45,6 +61,19 @@ int ed25519_key_pair_construct
     ed25519_private_key *p_private_key
 );
 
+/** !
+ * Construct an expanded public key. The point is decoded once, and
+ * expanded into a table, so each ed25519_verify_expanded call skips
+ * decompressing the key and uses fast fixed-base multiplication. Worth
+ * it for a key that verifies more than a couple of signatures.
+ * 
+ * @param pp_expanded_key result
+ * @param p_public_key    the public key
+ * 
+ * @return 1 on success, 0 on error
+ */
+int ed25519_expanded_key_construct ( ed25519_expanded_key **pp_expanded_key, const ed25519_public_key *p_public_key );
+
 /// sign
 /** !
  * Sign a message
@@ -68,7 +97,10 @@ int ed25519_sign
 
 /// verify
 /** !
- * Verify a signature
+ * Verify a signature, with the cofactored equation of RFC 8032 section
+ * 5.1.7, [8][S]B = [8]R + [8][k]A. ed25519_verify, ed25519_verify_expanded,
+ * and ed25519_verify_batch use the same equation, so they accept the same
+ * signatures, even if R or A has a small order component.
  * 
  * @param p_signature  the signature to verify
  * @param p_message    the message
@@ -85,6 +117,51 @@ int ed25519_verify
     const ed25519_public_key *p_public_key
 );
 
+/** !
+ * Verify many signatures at once. The signatures are weighted by random
+ * scalars and checked with one multi-scalar multiplication, which is much
+ * faster than calling ed25519_verify for each. Uses the cofactored
+ * equation of RFC 8032 section 5.1.7. Does not say which signature is
+ * bad; call ed25519_verify on each to find out.
+ * 
+ * @param pp_signatures  an array of quantity signatures
+ * @param pp_messages    an array of quantity messages
+ * @param p_message_lens an array of quantity message lengths
+ * @param pp_public_keys an array of quantity public keys
+ * @param quantity       the quantity of signatures
+ * 
+ * @return 1 if every signature is valid, else 0
+ */
+int ed25519_verify_batch
+(
+    const ed25519_signature  *const *pp_signatures,
+    const unsigned char      *const *pp_messages,
+    const size_t                    *p_message_lens,
+    const ed25519_public_key *const *pp_public_keys,
+    size_t                           quantity
+);
+
+/** !
+ * Verify a signature with an expanded public key, with the same cofactored
+ * equation as ed25519_verify
+ * 
+ * @param p_signature    the signature to verify
+ * @param p_message      the message
+ * @param message_len    length of the message
+ * @param p_expanded_key the expanded public key
+ * 
+ * @sa ed25519_verify
+ * 
+ * @return 1 on success, 0 on error
+ */
+int ed25519_verify_expanded
+(
+    const ed25519_signature    *p_signature,
+    const unsigned char        *p_message,
+    size_t                      message_len,
+    const ed25519_expanded_key *p_expanded_key
+);
+
 /// print
 /** !
  * Print a public key
@@ -195,3 +272,13 @@ int ed25519_signature_pack ( void *p_buffer, ed25519_signature *p_signature );
  * @return 1 on success, 0 on error
  */
 int ed25519_signature_unpack ( ed25519_signature *p_signature, void *p_buffer );
+
+/// destructors
+/** !
+ * Destroy an expanded public key
+ * 
+ * @param pp_expanded_key pointer to expanded public key pointer
+ * 
+ * @return 1 on success, 0 on error
+ */
+int ed25519_expanded_key_destroy ( ed25519_expanded_key **pp_expanded_key );
@@ -0,0 +1,460 @@
+/** !
+ * GF(2^255-19) field arithmetic implementation
+ *
+ * @file src/crypto/fe25519/fe25519.c
+ *
+ * @author Jacob Smith
+ */
+
+// header file
+#include <crypto/fe25519.h>
+
+// preprocessor definitions
+#define FE25519_MASK 0x7ffffffffffffULL
+
+// type definitions
+typedef unsigned __int128 u128;
+
+// function declarations
+/** !
+ * Load 8 little endian bytes
+ *
+ * @param p the bytes
+ *
+ * @return the 64 bit integer
+ */
+unsigned long long fe25519_load_64 ( const unsigned char *p );
+
+/** !
+ * Propagate the carries of a product, leaving each limb under 2^52
+ *
+ * @param h result
+ * @param r the 128 bit limbs of the product
+ *
+ * @return void
+ */
+void fe25519_carry_128 ( fe25519 h, u128 r[5] );
+
+/** !
+ * Propagate the carries of a field element, leaving each limb under 2^52
+ *
+ * @param h the field element
+ *
+ * @return void
+ */
+void fe25519_carry ( fe25519 h );
+
+// function definitions
+unsigned long long fe25519_load_64 ( const unsigned char *p )
+{
+
+    // done
+    return ( (unsigned long long) p[0] <<  0 ) | ( (unsigned long long) p[1] <<  8 )
+         | ( (unsigned long long) p[2] << 16 ) | ( (unsigned long long) p[3] << 24 )
+         | ( (unsigned long long) p[4] << 32 ) | ( (unsigned long long) p[5] << 40 )
+         | ( (unsigned long long) p[6] << 48 ) | ( (unsigned long long) p[7] << 56 );
+}
+
+void fe25519_carry_128 ( fe25519 h, u128 r[5] )
+{
+
+    // initialized data
+    unsigned long long c = 0;
+
+    // carry each limb into the next
+    c = (unsigned long long) ( r[0] >> 51 ), h[0] = (unsigned long long) r[0] & FE25519_MASK, r[1] += c;
+    c = (unsigned long long) ( r[1] >> 51 ), h[1] = (unsigned long long) r[1] & FE25519_MASK, r[2] += c;
+    c = (unsigned long long) ( r[2] >> 51 ), h[2] = (unsigned long long) r[2] & FE25519_MASK, r[3] += c;
+    c = (unsigned long long) ( r[3] >> 51 ), h[3] = (unsigned long long) r[3] & FE25519_MASK, r[4] += c;
+    c = (unsigned long long) ( r[4] >> 51 ), h[4] = (unsigned long long) r[4] & FE25519_MASK;
+
+    // 2^255 = 19 (mod p)
+    h[0] += c * 19;
+
+    // carry once more
+    h[1] += h[0] >> 51, h[0] &= FE25519_MASK;
+
+    // done
+    return;
+}
+
+void fe25519_carry ( fe25519 h )
+{
+
+    // initialized data
+    unsigned long long c = 0;
+
+    // carry each limb into the next
+    c = h[0] >> 51, h[0] &= FE25519_MASK, h[1] += c;
+    c = h[1] >> 51, h[1] &= FE25519_MASK, h[2] += c;
+    c = h[2] >> 51, h[2] &= FE25519_MASK, h[3] += c;
+    c = h[3] >> 51, h[3] &= FE25519_MASK, h[4] += c;
+    c = h[4] >> 51, h[4] &= FE25519_MASK;
+
+    // 2^255 = 19 (mod p)
+    h[0] += c * 19;
+
+    // done
+    return;
+}
+
+void fe25519_0 ( fe25519 h )
+{
+
+    // zero
+    h[0] = h[1] = h[2] = h[3] = h[4] = 0;
+
+    // done
+    return;
+}
+
+void fe25519_1 ( fe25519 h )
+{
+
+    // one
+    h[0] = 1, h[1] = h[2] = h[3] = h[4] = 0;
+
+    // done
+    return;
+}
+
+void fe25519_copy ( fe25519 h, const fe25519 f )
+{
+
+    // copy
+    h[0] = f[0], h[1] = f[1], h[2] = f[2], h[3] = f[3], h[4] = f[4];
+
+    // done
+    return;
+}
+
+void fe25519_from_bytes ( fe25519 h, const unsigned char s[32] )
+{
+
+    // 51 bits at a time
+    h[0] = ( fe25519_load_64(s +  0) >>  0 ) & FE25519_MASK,
+    h[1] = ( fe25519_load_64(s +  6) >>  3 ) & FE25519_MASK,
+    h[2] = ( fe25519_load_64(s + 12) >>  6 ) & FE25519_MASK,
+    h[3] = ( fe25519_load_64(s + 19) >>  1 ) & FE25519_MASK,
+    h[4] = ( fe25519_load_64(s + 24) >> 12 ) & FE25519_MASK;
+
+    // done
+    return;
+}
+
+void fe25519_to_bytes ( unsigned char s[32], const fe25519 h )
+{
+
+    // initialized data
+    fe25519 t = { h[0], h[1], h[2], h[3], h[4] };
+    unsigned long long w[4] = { 0 };
+
+    // t < 2^255 + small
+    fe25519_carry(t);
+    fe25519_carry(t);
+
+    // add 19, so that t >= 2^255 IF AND ONLY IF the original t >= p
+    t[0] += 19;
+    fe25519_carry(t);
+
+    // add 2^255 - 19, then drop 2^255. this subtracts p IF the original t >= p
+    t[0] += FE25519_MASK + 1 - 19,
+    t[1] += FE25519_MASK,
+    t[2] += FE25519_MASK,
+    t[3] += FE25519_MASK,
+    t[4] += FE25519_MASK;
+
+    // carry, without folding the top carry back in
+    t[1] += t[0] >> 51, t[0] &= FE25519_MASK;
+    t[2] += t[1] >> 51, t[1] &= FE25519_MASK;
+    t[3] += t[2] >> 51, t[2] &= FE25519_MASK;
+    t[4] += t[3] >> 51, t[3] &= FE25519_MASK;
+    t[4] &= FE25519_MASK;
+
+    // pack 5 limbs of 51 bits into 4 words of 64 bits
+    w[0] = ( t[0] >>  0 ) | ( t[1] << 51 ),
+    w[1] = ( t[1] >> 13 ) | ( t[2] << 38 ),
+    w[2] = ( t[2] >> 26 ) | ( t[3] << 25 ),
+    w[3] = ( t[3] >> 39 ) | ( t[4] << 12 );
+
+    // store
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 8; j++)
+            s[8 * i + j] = (unsigned char) ( w[i] >> ( 8 * j ) );
+
+    // done
+    return;
+}
+
+void fe25519_add ( fe25519 h, const fe25519 f, const fe25519 g )
+{
+
+    // add each limb
+    h[0] = f[0] + g[0],
+    h[1] = f[1] + g[1],
+    h[2] = f[2] + g[2],
+    h[3] = f[3] + g[3],
+    h[4] = f[4] + g[4];
+
+    // reduce
+    fe25519_carry(h);
+
+    // done
+    return;
+}
+
+void fe25519_sub ( fe25519 h, const fe25519 f, const fe25519 g )
+{
+
+    // add 4p, so that no limb goes negative
+    h[0] = ( f[0] + 0x1fffffffffffb4ULL ) - g[0],
+    h[1] = ( f[1] + 0x1ffffffffffffcULL ) - g[1],
+    h[2] = ( f[2] + 0x1ffffffffffffcULL ) - g[2],
+    h[3] = ( f[3] + 0x1ffffffffffffcULL ) - g[3],
+    h[4] = ( f[4] + 0x1ffffffffffffcULL ) - g[4];
+
+    // reduce
+    fe25519_carry(h);
+
+    // done
+    return;
+}
+
+void fe25519_neg ( fe25519 h, const fe25519 f )
+{
+
+    // initialized data
+    fe25519 zero = { 0 };
+
+    // 0 - f
+    fe25519_sub(h, zero, f);
+
+    // done
+    return;
+}
+
+void fe25519_mul ( fe25519 h, const fe25519 f, const fe25519 g )
+{
+
+    // initialized data
+    unsigned long long f0 = f[0], f1 = f[1], f2 = f[2], f3 = f[3], f4 = f[4],
+                       g0 = g[0], g1 = g[1], g2 = g[2], g3 = g[3], g4 = g[4],
+                       g1_19 = g1 * 19, g2_19 = g2 * 19, g3_19 = g3 * 19, g4_19 = g4 * 19;
+    u128 r[5];
+
+    // schoolbook, folding the high products with 2^255 = 19 (mod p)
+    r[0] = (u128) f0 * g0 + (u128) f1 * g4_19 + (u128) f2 * g3_19 + (u128) f3 * g2_19 + (u128) f4 * g1_19,
+    r[1] = (u128) f0 * g1 + (u128) f1 * g0    + (u128) f2 * g4_19 + (u128) f3 * g3_19 + (u128) f4 * g2_19,
+    r[2] = (u128) f0 * g2 + (u128) f1 * g1    + (u128) f2 * g0    + (u128) f3 * g4_19 + (u128) f4 * g3_19,
+    r[3] = (u128) f0 * g3 + (u128) f1 * g2    + (u128) f2 * g1    + (u128) f3 * g0    + (u128) f4 * g4_19,
+    r[4] = (u128) f0 * g4 + (u128) f1 * g3    + (u128) f2 * g2    + (u128) f3 * g1    + (u128) f4 * g0;
+
+    // reduce
+    fe25519_carry_128(h, r);
+
+    // done
+    return;
+}
+
+void fe25519_mul_small ( fe25519 h, const fe25519 f, unsigned int n )
+{
+
+    // initialized data
+    u128 r[5] =
+    {
+        (u128) f[0] * n,
+        (u128) f[1] * n,
+        (u128) f[2] * n,
+        (u128) f[3] * n,
+        (u128) f[4] * n
+    };
+
+    // reduce
+    fe25519_carry_128(h, r);
+
+    // done
+    return;
+}
+
+void fe25519_sq ( fe25519 h, const fe25519 f )
+{
+
+    // initialized data
+    unsigned long long f0 = f[0], f1 = f[1], f2 = f[2], f3 = f[3], f4 = f[4],
+                       f0_2 = f0 * 2, f1_2 = f1 * 2,
+                       f1_38 = f1 * 38, f2_38 = f2 * 38, f3_38 = f3 * 38,
+                       f3_19 = f3 * 19, f4_19 = f4 * 19;
+    u128 r[5];
+
+    // each cross product once, doubled
+    r[0] = (u128) f0   * f0 + (u128) f1_38 * f4 + (u128) f2_38 * f3,
+    r[1] = (u128) f0_2 * f1 + (u128) f2_38 * f4 + (u128) f3_19 * f3,
+    r[2] = (u128) f0_2 * f2 + (u128) f1    * f1 + (u128) f3_38 * f4,
+    r[3] = (u128) f0_2 * f3 + (u128) f1_2  * f2 + (u128) f4_19 * f4,
+    r[4] = (u128) f0_2 * f4 + (u128) f1_2  * f3 + (u128) f2    * f2;
+
+    // reduce
+    fe25519_carry_128(h, r);
+
+    // done
+    return;
+}
+
+void fe25519_sq_n ( fe25519 h, const fe25519 f, int n )
+{
+
+    // first square
+    fe25519_sq(h, f);
+
+    // the rest
+    for (int i = 1; i < n; i++) fe25519_sq(h, h);
+
+    // done
+    return;
+}
+
+void fe25519_invert ( fe25519 h, const fe25519 f )
+{
+
+    // initialized data
+    fe25519 z2, z9, z11, z2_5_0, z2_10_0, z2_20_0, z2_50_0, z2_100_0, t;
+
+    // z^(p - 2), with 254 squarings and 11 multiplications
+    fe25519_sq(z2, f);
+    fe25519_sq_n(t, z2, 2);
+    fe25519_mul(z9, t, f);
+    fe25519_mul(z11, z9, z2);
+    fe25519_sq(t, z11);
+    fe25519_mul(z2_5_0, t, z9);
+    fe25519_sq_n(t, z2_5_0, 5);
+    fe25519_mul(z2_10_0, t, z2_5_0);
+    fe25519_sq_n(t, z2_10_0, 10);
+    fe25519_mul(z2_20_0, t, z2_10_0);
+    fe25519_sq_n(t, z2_20_0, 20);
+    fe25519_mul(t, t, z2_20_0);
+    fe25519_sq_n(t, t, 10);
+    fe25519_mul(z2_50_0, t, z2_10_0);
+    fe25519_sq_n(t, z2_50_0, 50);
+    fe25519_mul(z2_100_0, t, z2_50_0);
+    fe25519_sq_n(t, z2_100_0, 100);
+    fe25519_mul(t, t, z2_100_0);
+    fe25519_sq_n(t, t, 50);
+    fe25519_mul(t, t, z2_50_0);
+    fe25519_sq_n(t, t, 5);
+    fe25519_mul(h, t, z11);
+
+    // done
+    return;
+}
+
+void fe25519_pow22523 ( fe25519 h, const fe25519 f )
+{
+
+    // initialized data
+    fe25519 z2, z9, z11, z2_5_0, z2_10_0, z2_20_0, z2_50_0, z2_100_0, t;
+
+    // z^(2^252 - 3), with the same chain as the inversion
+    fe25519_sq(z2, f);
+    fe25519_sq_n(t, z2, 2);
+    fe25519_mul(z9, t, f);
+    fe25519_mul(z11, z9, z2);
+    fe25519_sq(t, z11);
+    fe25519_mul(z2_5_0, t, z9);
+    fe25519_sq_n(t, z2_5_0, 5);
+    fe25519_mul(z2_10_0, t, z2_5_0);
+    fe25519_sq_n(t, z2_10_0, 10);
+    fe25519_mul(z2_20_0, t, z2_10_0);
+    fe25519_sq_n(t, z2_20_0, 20);
+    fe25519_mul(t, t, z2_20_0);
+    fe25519_sq_n(t, t, 10);
+    fe25519_mul(z2_50_0, t, z2_10_0);
+    fe25519_sq_n(t, z2_50_0, 50);
+    fe25519_mul(z2_100_0, t, z2_50_0);
+    fe25519_sq_n(t, z2_100_0, 100);
+    fe25519_mul(t, t, z2_100_0);
+    fe25519_sq_n(t, t, 50);
+    fe25519_mul(t, t, z2_50_0);
+    fe25519_sq_n(t, t, 2);
+    fe25519_mul(h, t, f);
+
+    // done
+    return;
+}
+
+void fe25519_cswap ( fe25519 f, fe25519 g, unsigned int b )
+{
+
+    // initialized data
+    unsigned long long mask = 0 - (unsigned long long) b;
+
+    // swap each limb
+    for (int i = 0; i < 5; i++)
+    {
+
+        // initialized data
+        unsigned long long x = ( f[i] ^ g[i] ) & mask;
+
+        // swap
+        f[i] ^= x,
+        g[i] ^= x;
+    }
+
+    // done
+    return;
+}
+
+void fe25519_cmov ( fe25519 f, const fe25519 g, unsigned int b )
+{
+
+    // initialized data
+    unsigned long long mask = 0 - (unsigned long long) b;
+
+    // copy each limb
+    for (int i = 0; i < 5; i++) f[i] ^= ( f[i] ^ g[i] ) & mask;
+
+    // done
+    return;
+}
+
+bool fe25519_is_zero ( const fe25519 f )
+{
+
+    // initialized data
+    unsigned char s[32];
+    unsigned char x = 0;
+
+    // canonical encoding
+    fe25519_to_bytes(s, f);
+
+    // accumulate every bit
+    for (int i = 0; i < 32; i++) x |= s[i];
+
+    // done
+    return 0 == x;
+}
+
+int fe25519_is_negative ( const fe25519 f )
+{
+
+    // initialized data
+    unsigned char s[32];
+
+    // canonical encoding
+    fe25519_to_bytes(s, f);
+
+    // done
+    return s[0] & 1;
+}
+
+bool fe25519_equal ( const fe25519 f, const fe25519 g )
+{
+
+    // initialized data
+    fe25519 d;
+
+    // f - g
+    fe25519_sub(d, f, g);
+
+    // done
+    return fe25519_is_zero(d);
+}
@@ -0,0 +1,232 @@
+/** !
+ * GF(2^255-19) field arithmetic interface
+ *
+ * @file src/crypto/fe25519/fe25519.h
+ *
+ * @author Jacob Smith
+ */
+
+// header guard
+#pragma once
+
+// standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+// gsdk
+/// core
+#include <core/log.h>
+
+// platform check
+#ifndef __SIZEOF_INT128__
+    #error "fe25519 needs a compiler with unsigned __int128"
+#endif
+
+// type definitions
+/** !
+ * An element of GF(2^255-19), as 5 limbs of 51 bits, least significant
+ * limb first. Limbs may exceed 51 bits between reductions.
+ */
+typedef unsigned long long fe25519[5];
+
+// function declarations
+/// constructors
+/** !
+ * Set a field element to zero
+ *
+ * @param h result
+ *
+ * @return void
+ */
+void fe25519_0 ( fe25519 h );
+
+/** !
+ * Set a field element to one
+ *
+ * @param h result
+ *
+ * @return void
+ */
+void fe25519_1 ( fe25519 h );
+
+/** !
+ * Copy a field element
+ *
+ * @param h result
+ * @param f the field element
+ *
+ * @return void
+ */
+void fe25519_copy ( fe25519 h, const fe25519 f );
+
+/// serialization
+/** !
+ * Load a field element from 32 little endian bytes. The top bit is ignored.
+ *
+ * @param h result
+ * @param s the bytes
+ *
+ * @return void
+ */
+void fe25519_from_bytes ( fe25519 h, const unsigned char s[32] );
+
+/** !
+ * Store the canonical encoding of a field element in 32 little endian bytes
+ *
+ * @param s result
+ * @param h the field element
+ *
+ * @return void
+ */
+void fe25519_to_bytes ( unsigned char s[32], const fe25519 h );
+
+/// arithmetic
+/** !
+ * h = f + g
+ *
+ * @param h result
+ * @param f the first field element
+ * @param g the second field element
+ *
+ * @return void
+ */
+void fe25519_add ( fe25519 h, const fe25519 f, const fe25519 g );
+
+/** !
+ * h = f - g
+ *
+ * @param h result
+ * @param f the first field element
+ * @param g the second field element
+ *
+ * @return void
+ */
+void fe25519_sub ( fe25519 h, const fe25519 f, const fe25519 g );
+
+/** !
+ * h = -f
+ *
+ * @param h result
+ * @param f the field element
+ *
+ * @return void
+ */
+void fe25519_neg ( fe25519 h, const fe25519 f );
+
+/** !
+ * h = f * g
+ *
+ * @param h result
+ * @param f the first field element
+ * @param g the second field element
+ *
+ * @return void
+ */
+void fe25519_mul ( fe25519 h, const fe25519 f, const fe25519 g );
+
+/** !
+ * h = f * n, for a small n
+ *
+ * @param h result
+ * @param f the field element
+ * @param n the small integer, less than 2^32
+ *
+ * @return void
+ */
+void fe25519_mul_small ( fe25519 h, const fe25519 f, unsigned int n );
+
+/** !
+ * h = f^2
+ *
+ * @param h result
+ * @param f the field element
+ *
+ * @return void
+ */
+void fe25519_sq ( fe25519 h, const fe25519 f );
+
+/** !
+ * h = f^(2^n)
+ *
+ * @param h result
+ * @param f the field element
+ * @param n the quantity of squarings, at least 1
+ *
+ * @return void
+ */
+void fe25519_sq_n ( fe25519 h, const fe25519 f, int n );
+
+/** !
+ * h = 1 / f, or 0 if f is 0
+ *
+ * @param h result
+ * @param f the field element
+ *
+ * @return void
+ */
+void fe25519_invert ( fe25519 h, const fe25519 f );
+
+/** !
+ * h = f^((p - 5) / 8), the exponent used to compute square roots
+ *
+ * @param h result
+ * @param f the field element
+ *
+ * @return void
+ */
+void fe25519_pow22523 ( fe25519 h, const fe25519 f );
+
+/// constant time
+/** !
+ * Swap two field elements if b is 1, in constant time
+ *
+ * @param f the first field element
+ * @param g the second field element
+ * @param b 1 to swap, 0 to leave
+ *
+ * @return void
+ */
+void fe25519_cswap ( fe25519 f, fe25519 g, unsigned int b );
+
+/** !
+ * Copy g into f if b is 1, in constant time
+ *
+ * @param f result
+ * @param g the field element
+ * @param b 1 to copy, 0 to leave
+ *
+ * @return void
+ */
+void fe25519_cmov ( fe25519 f, const fe25519 g, unsigned int b );
+
+/// accessors
+/** !
+ * Test if a field element is zero
+ *
+ * @param f the field element
+ *
+ * @return true if f is zero, else false
+ */
+bool fe25519_is_zero ( const fe25519 f );
+
+/** !
+ * Test if a field element is negative, that is, if the least significant
+ * bit of its canonical encoding is set
+ *
+ * @param f the field element
+ *
+ * @return 1 if f is negative, else 0
+ */
+int fe25519_is_negative ( const fe25519 f );
+
+/** !
+ * Test if two field elements are equal
+ *
+ * @param f the first field element
+ * @param g the second field element
+ *
+ * @return true if f equals g, else false
+ */
+bool fe25519_equal ( const fe25519 f, const fe25519 g );
@@ -26,155 +26,1082 @@
 #define RED "\033[91m"
 #define BLUE "\033[94m"
 #define RESET "\033[0m"
+#define RSA_WINDOW 5
+#define RSA_SIEVE_WINDOW  4096 // the quantity of offsets in a sieve window
+#define RSA_SIEVE_LIMIT   8192 // sieve with the odd primes below this
+#define RSA_SIEVE_PRIMES  1027 // the quantity of odd primes below RSA_SIEVE_LIMIT
+#define RSA_SIEVE_WINDOWS 64   // give up after this many windows
+#define RSA_SIEVE_BATCH   64   // the quantity of candidates tested concurrently
+
+// structure definitions
+struct bn_mont_s
+{
+    i2048              n, rr, one; // the modulus, R^2 mod n, and R mod n
+    unsigned long long n0;         // -n^-1 mod 2^64
+    size_t             k;          // the quantity of limbs in n, R = 2^(64k)
+};
+
+struct rsa_sieve_s
+{
+    i2048          base;                         // the candidate at offset 0, odd
+    unsigned short primes[RSA_SIEVE_PRIMES];     // the sieving primes
+    unsigned short residues[RSA_SIEVE_PRIMES];   // base mod primes[i]
+    bool           composite[RSA_SIEVE_WINDOW];  // true if base + offset has a small factor
+};
+
+struct rsa_prime_job_s
+{
+    i2048  candidate; // the candidate
+    int    k;         // the quantity of Miller-Rabin rounds
+    bool   prime;     // result
+    bool  *p_found;   // set by the first job to find a prime
+};
+
+// type definitions
+typedef unsigned __int128       u128;
+typedef struct bn_mont_s        bn_mont;
+typedef struct rsa_sieve_s      rsa_sieve;
+typedef struct rsa_prime_job_s  rsa_prime_job;
 
 size_t file_load ( const char *path, void *buffer, bool binary_mode );
 
 // data
 unsigned short primes[] =
 {
-    2WB  , 3WB  , 5WB  , 7WB  , 11WB , 13WB , 17WB , 19WB , 23WB , 29WB , 31WB ,
-    37WB , 41WB , 43WB , 47WB , 53WB , 59WB , 61WB , 67WB , 71WB , 73WB , 79WB ,
-    83WB , 89WB , 97WB , 101WB, 103WB, 107WB, 109WB, 113WB, 127WB, 131WB, 137WB,
-    139WB, 149WB, 151WB, 157WB, 163WB, 167WB, 173WB, 179WB, 181WB, 191WB, 193WB,
-    197WB, 199WB, 211WB, 223WB, 227WB, 229WB, 233WB, 239WB, 241WB, 251WB, 257WB,
-    263WB, 269WB, 271WB, 277WB, 281WB, 283WB, 293WB, 307WB, 311WB, 313WB, 317WB,
-    331WB, 337WB, 347WB, 349WB, 353WB, 359WB, 367WB, 373WB, 379WB, 383WB, 389WB,
-    397WB, 401WB, 409WB, 419WB, 421WB, 431WB, 433WB, 439WB, 443WB, 449WB, 457WB,
-    461WB, 463WB, 467WB, 479WB, 487WB, 491WB, 499WB, 503WB, 509WB, 521WB, 523WB,
-    541WB
-};
+    2  , 3  , 5  , 7  , 11 , 13 , 17 , 19 , 23 , 29 , 31 ,
+    37 , 41 , 43 , 47 , 53 , 59 , 61 , 67 , 71 , 73 , 79 ,
+    83 , 89 , 97 , 101, 103, 107, 109, 113, 127, 131, 137,
+    139, 149, 151, 157, 163, 167, 173, 179, 181, 191, 193,
+    197, 199, 211, 223, 227, 229, 233, 239, 241, 251, 257,
+    263, 269, 271, 277, 281, 283, 293, 307, 311, 313, 317,
+    331, 337, 347, 349, 353, 359, 367, 373, 379, 383, 389,
+    397, 401, 409, 419, 421, 431, 433, 439, 443, 449, 457,
+    461, 463, 467, 479, 487, 491, 499, 503, 509, 521, 523,
+    541
+};
+
+size_t len_primes = sizeof(primes)/sizeof(*primes);
+
+// function declarations
+/// bignum
+/** !
+ * Compute the quantity of significant limbs in a bignum
+ * 
+ * @param a the bignum
+ * @param k the quantity of limbs in a
+ * 
+ * @return the index of the highest nonzero limb, plus one
+ */
+size_t bn_limbs ( const unsigned long long *a, size_t k );
+
+/** !
+ * Compute the quantity of bits required to represent a bignum
+ * 
+ * @param a the bignum
+ * 
+ * @return the quantity of bits, or 1 if a is 0
+ */
+size_t req_bits ( const i2048 a );
+
+/** !
+ * Compare two bignums
+ * 
+ * @param a the first bignum
+ * @param b the second bignum
+ * @param k the quantity of limbs in a and b
+ * 
+ * @return -1 if a < b, 0 if a = b, 1 if a > b
+ */
+int bn_cmp ( const unsigned long long *a, const unsigned long long *b, size_t k );
+
+/** !
+ * r = a + b
+ * 
+ * @param r result
+ * @param a the first bignum
+ * @param b the second bignum
+ * @param k the quantity of limbs in r, a and b
+ * 
+ * @return the carry out of the top limb
+ */
+unsigned long long bn_add ( unsigned long long *r, const unsigned long long *a, const unsigned long long *b, size_t k );
+
+/** !
+ * r = a - b
+ * 
+ * @param r result
+ * @param a the first bignum
+ * @param b the second bignum
+ * @param k the quantity of limbs in r, a and b
+ * 
+ * @return the borrow out of the top limb
+ */
+unsigned long long bn_sub ( unsigned long long *r, const unsigned long long *a, const unsigned long long *b, size_t k );
+
+/** !
+ * r = a * b, truncated to RSA_LIMBS limbs
+ * 
+ * @param r result
+ * @param a the first bignum
+ * @param b the second bignum
+ * 
+ * @return void
+ */
+void bn_mul ( i2048 r, const i2048 a, const i2048 b );
+
+/** !
+ * r = a * m + c
+ * 
+ * @param r result
+ * @param a the bignum
+ * @param m the small factor
+ * @param c the small addend
+ * 
+ * @return the carry out of the top limb
+ */
+unsigned long long bn_mul_small ( i2048 r, const i2048 a, unsigned long long m, unsigned long long c );
+
+/** !
+ * Compute a mod m, for a small m
+ * 
+ * @param a the bignum
+ * @param m the small modulus
+ * 
+ * @return a mod m
+ */
+unsigned long long bn_mod_small ( const i2048 a, unsigned long long m );
+
+/** !
+ * Divide two bignums, one bit at a time
+ * 
+ * @param q result, the quotient, or null
+ * @param r result, the remainder, or null
+ * @param a the dividend
+ * @param b the divisor, not zero
+ * 
+ * @return void
+ */
+void bn_divmod ( i2048 q, i2048 r, const i2048 a, const i2048 b );
+
+/** !
+ * Compute the inverse of a modulo m with the extended Euclidean algorithm
+ * 
+ * @param r result
+ * @param a the bignum
+ * @param m the modulus
+ * 
+ * @return true if the inverse exists, else false
+ */
+bool bn_mod_inverse ( i2048 r, const i2048 a, const i2048 m );
+
+/** !
+ * Fill a bignum with random bits from /dev/urandom
+ * 
+ * @param r    result
+ * @param bits the quantity of random bits
+ * 
+ * @return 1 on success, 0 on error
+ */
+int random_n_bit_int ( i2048 r, size_t bits );
+
+/// montgomery
+/** !
+ * Construct a Montgomery context for an odd modulus
+ * 
+ * @param p_mont result
+ * @param n      the modulus
+ * 
+ * @return void
+ */
+void bn_mont_construct ( bn_mont *p_mont, const i2048 n );
+
+/** !
+ * r = a * b / R mod n, for a, b < n
+ * 
+ * @param r      result. may alias a or b
+ * @param a      the first bignum
+ * @param b      the second bignum
+ * @param p_mont the Montgomery context
+ * 
+ * @return void
+ */
+void bn_mont_mul ( i2048 r, const i2048 a, const i2048 b, const bn_mont *p_mont );
+
+/** !
+ * r = base^exp mod n, with a sliding window over the exponent
+ * 
+ * @param r      result
+ * @param base   the base
+ * @param exp    the exponent
+ * @param p_mont the Montgomery context of n
+ * 
+ * @return void
+ */
+void mod_exp ( i2048 r, const i2048 base, const i2048 exp, const bn_mont *p_mont );
+
+/// prime search
+/** !
+ * Test a candidate for primality with trial division and Miller-Rabin
+ * 
+ * @param n the candidate
+ * @param k the quantity of Miller-Rabin rounds
+ * 
+ * @return true if n is probably prime, else false
+ */
+bool miller_rabin ( const i2048 n, int k );
+
+/** !
+ * Construct a sieve over the window of odd candidates starting at base
+ * 
+ * @param p_sieve result
+ * @param base    the first candidate, odd
+ * 
+ * @return void
+ */
+void rsa_sieve_construct ( rsa_sieve *p_sieve, const i2048 base );
+
+/** !
+ * Mark each offset in the current window that has a small prime factor
+ * 
+ * @param p_sieve the sieve
+ * 
+ * @return void
+ */
+void rsa_sieve_mark ( rsa_sieve *p_sieve );
+
+/** !
+ * Slide the sieve to the next window, updating the residues without
+ * dividing the base again
+ * 
+ * @param p_sieve the sieve
+ * 
+ * @return void
+ */
+void rsa_sieve_advance ( rsa_sieve *p_sieve );
+
+/** !
+ * Run Miller-Rabin on a candidate, unless another job has already found a prime
+ * 
+ * @param p_parameter pointer to a rsa_prime_job
+ * 
+ * @return p_parameter
+ */
+void *rsa_prime_test ( void *p_parameter );
+
+/** !
+ * Generate a prime with num_digits decimal digits. Candidates are sieved
+ * incrementally from a random starting point, and survivors are tested in
+ * batches on a thread pool
+ * 
+ * @param n             result
+ * @param num_digits    the quantity of decimal digits
+ * @param k             the quantity of Miller-Rabin rounds
+ * @param p_thread_pool the thread pool that tests candidates, or null to test them in the caller
+ * 
+ * @return 1 on success, 0 on error
+ */
+int generate_prime ( i2048 n, int num_digits, int k, thread_pool *p_thread_pool );
+
+/// rsa
+/** !
+ * Compute the CRT exponents and coefficient of a private key
+ * 
+ * @param p_private_key the private key, with p, q and b
+ * 
+ * @return 1 on success, 0 on error
+ */
+int private_key_crt ( private_key *p_private_key );
+
+// function definitions
+size_t bn_limbs ( const unsigned long long *a, size_t k )
+{
+
+    // skip leading zeros
+    while ( k && 0 == a[k - 1] ) k--;
+
+    // done
+    return k;
+}
+
+size_t req_bits ( const i2048 a )
+{
+
+    // initialized data
+    size_t k = bn_limbs(a, RSA_LIMBS);
+
+    // Special case
+    if ( k == 0 ) return 1;
+
+    // done
+    return 64 * k - __builtin_clzll(a[k - 1]);
+}
+
+int bn_cmp ( const unsigned long long *a, const unsigned long long *b, size_t k )
+{
+
+    // most significant limb first
+    while ( k-- )
+        if ( a[k] != b[k] )
+            return ( a[k] > b[k] ) ? 1 : -1;
+
+    // a = b
+    return 0;
+}
+
+unsigned long long bn_add ( unsigned long long *r, const unsigned long long *a, const unsigned long long *b, size_t k )
+{
+
+    // initialized data
+    u128 carry = 0;
+
+    // add with carry
+    for (size_t i = 0; i < k; i++)
+        carry = (u128) a[i] + b[i] + (unsigned long long) carry,
+        r[i]  = (unsigned long long) carry,
+        carry >>= 64;
+
+    // done
+    return (unsigned long long) carry;
+}
+
+unsigned long long bn_sub ( unsigned long long *r, const unsigned long long *a, const unsigned long long *b, size_t k )
+{
+
+    // initialized data
+    unsigned long long borrow = 0;
+
+    // subtract with borrow
+    for (size_t i = 0; i < k; i++)
+    {
+
+        // initialized data
+        u128 d = (u128) a[i] - b[i] - borrow;
+
+        // store the limb
+        r[i]   = (unsigned long long) d,
+        borrow = (unsigned long long) ( d >> 64 ) & 1;
+    }
+
+    // done
+    return borrow;
+}
+
+void bn_mul ( i2048 r, const i2048 a, const i2048 b )
+{
+
+    // initialized data
+    i2048  t  = { 0 };
+    size_t ka = bn_limbs(a, RSA_LIMBS),
+           kb = bn_limbs(b, RSA_LIMBS);
+
+    // schoolbook
+    for (size_t i = 0; i < ka; i++)
+    {
+
+        // initialized data
+        u128 carry = 0;
+
+        // t += a[i] * b << 64i
+        for (size_t j = 0; j < kb && i + j < RSA_LIMBS; j++)
+            carry    = (u128) a[i] * b[j] + t[i + j] + (unsigned long long) carry,
+            t[i + j] = (unsigned long long) carry,
+            carry  >>= 64;
+
+        // propagate the carry
+        if ( i + kb < RSA_LIMBS ) t[i + kb] = (unsigned long long) carry;
+    }
+
+    // store the result
+    memcpy(r, t, sizeof(i2048));
+
+    // done
+    return;
+}
+
+unsigned long long bn_mul_small ( i2048 r, const i2048 a, unsigned long long m, unsigned long long c )
+{
+
+    // initialized data
+    u128 carry = c;
+
+    // multiply each limb
+    for (size_t i = 0; i < RSA_LIMBS; i++)
+        carry  = (u128) a[i] * m + (unsigned long long) carry,
+        r[i]   = (unsigned long long) carry,
+        carry >>= 64;
+
+    // done
+    return (unsigned long long) carry;
+}
+
+unsigned long long bn_mod_small ( const i2048 a, unsigned long long m )
+{
+
+    // initialized data
+    u128 rem = 0;
+
+    // most significant limb first
+    for (size_t i = bn_limbs(a, RSA_LIMBS); i-- > 0;)
+        rem = ( ( rem << 64 ) | a[i] ) % m;
+
+    // done
+    return (unsigned long long) rem;
+}
+
+void bn_divmod ( i2048 q, i2048 r, const i2048 a, const i2048 b )
+{
+
+    // initialized data
+    i2048  _q   = { 0 },
+           _r   = { 0 };
+    size_t k    = bn_limbs(b, RSA_LIMBS) + 1,
+           bits = req_bits(a);
+
+    // the remainder never needs more than one limb over b
+    if ( k > RSA_LIMBS ) k = RSA_LIMBS;
+
+    // long division, most significant bit first
+    for (size_t i = bits; i-- > 0;)
+    {
+
+        // initialized data
+        unsigned long long top = _r[k - 1] >> 63;
+
+        // _r = 2 * _r + bit i of a
+        for (size_t j = k - 1; j > 0; j--) _r[j] = ( _r[j] << 1 ) | ( _r[j - 1] >> 63 );
+        _r[0] = ( _r[0] << 1 ) | ( ( a[i / 64] >> ( i % 64 ) ) & 1 );
+
+        // subtract the divisor
+        if ( top || bn_cmp(_r, b, k) >= 0 )
+            bn_sub(_r, _r, b, k),
+            _q[i / 64] |= 1ULL << ( i % 64 );
+    }
+
+    // store the results
+    if ( q ) memcpy(q, _q, sizeof(i2048));
+    if ( r ) memcpy(r, _r, sizeof(i2048));
+
+    // done
+    return;
+}
+
+bool bn_mod_inverse ( i2048 r, const i2048 a, const i2048 m )
+{
+
+    // initialized data
+    i2048  r0 = { 0 }, r1 = { 0 }, r2 = { 0 },
+           s0 = { 0 }, s1 = { 1 }, s2 = { 0 },
+           q  = { 0 }, t  = { 0 },
+           one = { 1 };
+    size_t steps = 0;
+
+    // r0 = m, r1 = a mod m
+    memcpy(r0, m, sizeof(i2048));
+    bn_divmod(NULL, r1, a, m);
+
+    // the coefficients of a alternate in sign, so only their magnitudes are kept
+    while ( bn_limbs(r1, RSA_LIMBS) )
+    {
+
+        // r2 = r0 - q * r1
+        bn_divmod(q, r2, r0, r1);
+
+        // s2 = s0 + q * s1
+        bn_mul(t, q, s1),
+        bn_add(s2, s0, t, RSA_LIMBS);
+
+        // shift
+        memcpy(r0, r1, sizeof(i2048)), memcpy(r1, r2, sizeof(i2048)),
+        memcpy(s0, s1, sizeof(i2048)), memcpy(s1, s2, sizeof(i2048));
+        steps++;
+    }
+
+    // error check
+    if ( 0 != bn_cmp(r0, one, RSA_LIMBS) ) return false;
+
+    // the coefficient is negative after an even quantity of steps
+    if ( steps % 2 == 0 ) bn_sub(s0, m, s0, RSA_LIMBS);
+
+    // store the result
+    memcpy(r, s0, sizeof(i2048));
+
+    // success
+    return true;
+}
+
+int random_n_bit_int ( i2048 r, size_t bits )
+{
+
+    // initialized data
+    size_t bytes = (bits + 7) / 8;
+    FILE *urandom = fopen("/dev/urandom", "rb");
+
+    // error check
+    if ( urandom == NULL ) goto no_random;
+
+    // clear
+    memset(r, 0, sizeof(i2048));
+
+    // Read random
+    if ( 1 != fread(r, bytes, 1, urandom) ) goto failed_to_read_random;
+    fclose(urandom);
+
+    // Ensure result is within the desired bit range
+    if ( bits % 64 ) r[bits / 64] &= ( 1ULL << ( bits % 64 ) ) - 1;
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // standard library errors
+        {
+            no_random:
+                #ifndef NDEBUG
+                    log_error("[rsa] Failed to open \"/dev/urandom\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            failed_to_read_random:
+                #ifndef NDEBUG
+                    log_error("[rsa] Failed to read \"/dev/urandom\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // close urandom
+                fclose(urandom);
+
+                // error
+                return 0;
+        }
+    }
+}
+
+void bn_mont_construct ( bn_mont *p_mont, const i2048 n )
+{
+
+    // initialized data
+    unsigned long long inv = n[0];
+
+    // store the modulus
+    memcpy(p_mont->n, n, sizeof(i2048));
+    p_mont->k = bn_limbs(n, RSA_LIMBS);
+
+    // n^-1 mod 2^64, each Newton step doubles the correct bits
+    for (int i = 0; i < 5; i++) inv *= 2 - n[0] * inv;
+    p_mont->n0 = -inv;
+
+    // R mod n, then R^2 mod n, by doubling 1
+    memset(p_mont->rr, 0, sizeof(i2048));
+    p_mont->rr[0] = 1;
+    for (size_t i = 0; i < 128 * p_mont->k; i++)
+    {
+
+        // rr = 2 * rr mod n
+        if ( bn_add(p_mont->rr, p_mont->rr, p_mont->rr, p_mont->k) || bn_cmp(p_mont->rr, n, p_mont->k) >= 0 )
+            bn_sub(p_mont->rr, p_mont->rr, n, p_mont->k);
+
+        // R mod n
+        if ( i + 1 == 64 * p_mont->k ) memcpy(p_mont->one, p_mont->rr, sizeof(i2048));
+    }
+
+    // done
+    return;
+}
+
+void bn_mont_mul ( i2048 r, const i2048 a, const i2048 b, const bn_mont *p_mont )
+{
+
+    // initialized data
+    const unsigned long long *n = p_mont->n;
+    size_t                    k = p_mont->k;
+    unsigned long long        t[RSA_LIMBS + 2] = { 0 };
+
+    // coarsely integrated operand scanning
+    for (size_t i = 0; i < k; i++)
+    {
+
+        // initialized data
+        u128               c = 0;
+        unsigned long long m = 0;
+
+        // t += a * b[i]
+        for (size_t j = 0; j < k; j++)
+            c    = (u128) a[j] * b[i] + t[j] + (unsigned long long) c,
+            t[j] = (unsigned long long) c,
+            c  >>= 64;
+        c        = (u128) t[k] + (unsigned long long) c,
+        t[k]     = (unsigned long long) c,
+        t[k + 1] = (unsigned long long) ( c >> 64 );
+
+        // t = ( t + m * n ) / 2^64, where m makes the low limb zero
+        m = t[0] * p_mont->n0;
+        c = ( (u128) m * n[0] + t[0] ) >> 64;
+        for (size_t j = 1; j < k; j++)
+            c        = (u128) m * n[j] + t[j] + (unsigned long long) c,
+            t[j - 1] = (unsigned long long) c,
+            c      >>= 64;
+        c        = (u128) t[k] + (unsigned long long) c,
+        t[k - 1] = (unsigned long long) c,
+        t[k]     = t[k + 1] + (unsigned long long) ( c >> 64 );
+    }
+
+    // t < 2n, subtract n at most once
+    if ( t[k] || bn_cmp(t, n, k) >= 0 ) bn_sub(t, t, n, k);
+
+    // store the result
+    memcpy(r, t, k * sizeof(unsigned long long));
+    memset(r + k, 0, ( RSA_LIMBS - k ) * sizeof(unsigned long long));
+
+    // done
+    return;
+}
+
+void mod_exp ( i2048 r, const i2048 base, const i2048 exp, const bn_mont *p_mont )
+{
+
+    // initialized data
+    i2048 g[1 << ( RSA_WINDOW - 1 )];
+    i2048 acc = { 0 },
+          x   = { 0 },
+          one = { 1 };
+    long  i   = (long) req_bits(exp) - 1;
+    bool  started = false;
+
+    // x = base mod n
+    if ( bn_cmp(base, p_mont->n, RSA_LIMBS) >= 0 ) bn_divmod(NULL, x, base, p_mont->n);
+    else memcpy(x, base, sizeof(i2048));
+
+    // g[j] = x^(2j + 1), in the Montgomery domain
+    bn_mont_mul(g[0], x, p_mont->rr, p_mont),
+    bn_mont_mul(acc, g[0], g[0], p_mont);
+    for (int j = 1; j < 1 << ( RSA_WINDOW - 1 ); j++) bn_mont_mul(g[j], g[j - 1], acc, p_mont);
+
+    // start at 1
+    memcpy(acc, p_mont->one, sizeof(i2048));
+
+    // most significant bit first
+    while ( i >= 0 )
+    {
+
+        // initialized data
+        long l = 0;
+        unsigned int window = 0;
+
+        // a zero bit costs one squaring
+        if ( 0 == ( ( exp[i / 64] >> ( i % 64 ) ) & 1 ) )
+        {
+            if ( started ) bn_mont_mul(acc, acc, acc, p_mont);
+            i--;
+            continue;
+        }
+
+        // the longest window of at most RSA_WINDOW bits that ends in a 1
+        l = ( i - RSA_WINDOW + 1 < 0 ) ? 0 : i - RSA_WINDOW + 1;
+        while ( 0 == ( ( exp[l / 64] >> ( l % 64 ) ) & 1 ) ) l++;
+
+        // the bits of the window
+        for (long j = i; j >= l; j--)
+            window = ( window << 1 ) | ( ( exp[j / 64] >> ( j % 64 ) ) & 1 );
+
+        // acc = acc^(2^width) * x^window
+        if ( started )
+        {
+            for (long j = i; j >= l; j--) bn_mont_mul(acc, acc, acc, p_mont);
+            bn_mont_mul(acc, acc, g[window >> 1], p_mont);
+        }
+        else
+            memcpy(acc, g[window >> 1], sizeof(i2048)),
+            started = true;
+
+        // next window
+        i = l - 1;
+    }
+
+    // leave the Montgomery domain
+    bn_mont_mul(r, acc, one, p_mont);
+
+    // done
+    return;
+}
+
+bool is_divisible_by_small_primes ( const i2048 n )
+{
+
+    // iterate through some small prime numbers
+    for (size_t i = 0; i < len_primes; i++)
+
+        // Test
+        if ( bn_mod_small(n, primes[i]) == 0 ) return true;
+
+    // done
+    return false;
+}
+
+bool miller_rabin_iteration ( const i2048 n, const bn_mont *p_mont )
+{
+
+    // initialized data
+    i2048  a        = { 0 },
+           d        = { 0 },
+           x        = { 0 },
+           n_less_1 = { 0 },
+           n_less_4 = { 0 },
+           one      = { 1 },
+           two      = { 2 },
+           four     = { 4 },
+           minus_one = { 0 };
+    size_t s        = 0;
+
+    // n - 1 = 2^s * d
+    bn_sub(n_less_1, n, one, RSA_LIMBS);
+    memcpy(d, n_less_1, sizeof(i2048));
+    while ( 0 == ( d[0] & 1 ) )
+    {
+        for (size_t j = 0; j < RSA_LIMBS - 1; j++) d[j] = ( d[j] >> 1 ) | ( d[j + 1] << 63 );
+        d[RSA_LIMBS - 1] >>= 1;
+        s++;
+    }
+
+    // a = 2 + random mod (n - 4)
+    bn_sub(n_less_4, n, four, RSA_LIMBS);
+    if ( 0 == random_n_bit_int(a, 64 * p_mont->k + 64) ) return false;
+    bn_divmod(NULL, a, a, n_less_4);
+    bn_add(a, a, two, RSA_LIMBS);
+
+    // x = a^d mod n
+    mod_exp(x, a, d, p_mont);
+    if ( 0 == bn_cmp(x, one, RSA_LIMBS) || 0 == bn_cmp(x, n_less_1, RSA_LIMBS) ) return true;
+
+    // square s - 1 times, in the Montgomery domain, looking for -1
+    bn_sub(minus_one, n, p_mont->one, RSA_LIMBS);
+    bn_mont_mul(x, x, p_mont->rr, p_mont);
+    for (size_t j = 1; j < s; j++)
+    {
+        bn_mont_mul(x, x, x, p_mont);
+        if ( 0 == bn_cmp(x, minus_one, RSA_LIMBS) ) return true;
+    }
+
+    // composite
+    return false;
+}
+
+bool miller_rabin ( const i2048 n, int k )
+{
+
+    // initialized data
+    bn_mont mont = { 0 };
+
+    // Fast exit
+    if ( is_divisible_by_small_primes(n) ) return false;
+
+    // construct a Montgomery context
+    bn_mont_construct(&mont, n);
+
+    // k rounds
+    for (int i = 0; i < k; i++)
+        if ( !miller_rabin_iteration(n, &mont) )
+            return false;
+
+    // probably prime
+    return true;
+}
+
+int generate_random ( i2048 n, int num_digits )
+{
+
+    // initialized data
+    i2048 min_n_digit_number = { 1 },
+          max_n_digit_number = { 1 },
+          range              = { 0 };
+
+    // 10^(num_digits - 1), 10^num_digits
+    for (int i = 1; i < num_digits; i++)
+        bn_mul_small(min_n_digit_number, min_n_digit_number, 10, 0);
+    bn_mul_small(max_n_digit_number, min_n_digit_number, 10, 0);
+    bn_sub(range, max_n_digit_number, min_n_digit_number, RSA_LIMBS);
+
+    while ( true )
+    {
+
+        // n = min + random mod range
+        if ( 0 == random_n_bit_int(n, req_bits(range) + 64) ) return 0;
+        bn_divmod(NULL, n, n, range);
+        bn_add(n, n, min_n_digit_number, RSA_LIMBS);
+
+        // Reject trivial bad cases early
+        if ( 0 == ( n[0] & 1 ) || 0 == bn_mod_small(n, 5) ) continue;
+
+        // success
+        return 1;
+    }
+}
+
+void rsa_sieve_construct ( rsa_sieve *p_sieve, const i2048 base )
+{
 
-size_t len_primes = sizeof(primes)/sizeof(*primes);
+    // initialized data
+    bool   composite[RSA_SIEVE_LIMIT] = { 0 };
+    size_t quantity                   = 0;
 
-size_t req_bits ( i2048 a );
+    // the odd primes below the limit, by the sieve of Eratosthenes
+    for (size_t i = 3; i < RSA_SIEVE_LIMIT; i += 2)
+    {
 
-i2048 egcd ( i2048 a, i2048 b, i2048 *x, i2048 *y );
+        // skip composites
+        if ( composite[i] ) continue;
 
-i2048 mod_exp(i2048 x, i2048 a, i2048 n );
+        // store the prime
+        p_sieve->primes[quantity++] = (unsigned short) i;
 
-i2048 random_n_bit_int ( size_t bits );
+        // mark its odd multiples
+        for (size_t j = i * i; j < RSA_SIEVE_LIMIT; j += 2 * i) composite[j] = true;
+    }
 
-bool is_divisible_by_small_primes ( i2048 n )
-{
+    // store the base
+    memcpy(p_sieve->base, base, sizeof(i2048));
 
-    // iterate through some small prime numbers
-    for (size_t i = 0; i < len_primes; i++)
+    // the only bignum divisions of the search
+    for (size_t i = 0; i < RSA_SIEVE_PRIMES; i++)
+        p_sieve->residues[i] = (unsigned short) bn_mod_small(base, p_sieve->primes[i]);
 
-        // Test
-        if ( n % (i2048)primes[i] == 0 ) return true;
+    // sieve the first window
+    rsa_sieve_mark(p_sieve);
 
     // done
-    return false;
+    return;
 }
 
-bool miller_rabin_iteration ( i2048 n )
+void rsa_sieve_mark ( rsa_sieve *p_sieve )
 {
 
-    // Fast exit
-    if ( is_divisible_by_small_primes(n) )
-        return (n <= (i2048)primes[len_primes - 1]);
-
-    // initialized data
-    i2048 a = 2 + random_n_bit_int(1024) % (n - 4);
-    i2048 e = n - 1;
-    i2048 first_check = mod_exp(a, e, n);
-    bool prev = true;
-
-    //printf("Testing a = %llu, mod_exp(a, n-1, n) = %llu\n", (unsigned long long)a, (unsigned long long)first_check);fflush(stdout);
-
-    // error check
-    if ( 1 != first_check ) return false;
+    // clear
+    memset(p_sieve->composite, 0, sizeof(p_sieve->composite));
 
-    // Miller-Rabin inner loop
-    while ( e % 2 == 0 )
-    {   
+    // for each prime ...
+    for (size_t i = 0; i < RSA_SIEVE_PRIMES; i++)
+    {
 
         // initialized data
-        i2048 x = 0;
+        size_t p = p_sieve->primes[i],
+               o = ( p - p_sieve->residues[i] ) % p;
 
-        // Compute x
-        e >>= 1,
-        x = mod_exp(a, e, n);
-        
-        //printf(" + mod_exp(a, e, n) = %llu\n", (unsigned long long)x); fflush(stdout);
-        
-        
-        if ( prev )
-        {
-            if      ( x == n - 1 ) prev = false;
-            else if ( x != 1 )     return false;
-        }
+        // ... mark each offset where p divides base + offset
+        for (size_t j = o; j < RSA_SIEVE_WINDOW; j += p) p_sieve->composite[j] = true;
     }
-    return true;
+
+    // done
+    return;
 }
 
-bool miller_rabin ( i2048 n, i2048 k )
+void rsa_sieve_advance ( rsa_sieve *p_sieve )
 {
-    for (size_t i = 0; i < k; i++)
-        if ( !miller_rabin_iteration(n) )
-            return false;
 
-    return true;
+    // initialized data
+    i2048 window = { RSA_SIEVE_WINDOW };
+
+    // base += window
+    bn_add(p_sieve->base, p_sieve->base, window, RSA_LIMBS);
+
+    // residues += window
+    for (size_t i = 0; i < RSA_SIEVE_PRIMES; i++)
+        p_sieve->residues[i] = (unsigned short) ( ( p_sieve->residues[i] + RSA_SIEVE_WINDOW ) % p_sieve->primes[i] );
+
+    // sieve the next window
+    rsa_sieve_mark(p_sieve);
+
+    // done
+    return;
 }
 
-i2048 generate_random ( int num_digits )
+void *rsa_prime_test ( void *p_parameter )
 {
-    i2048 min_n_digit_number = 1;
-    i2048 max_n_digit_number = 1;
 
-    for (int i = 1; i < num_digits; i++)
-        min_n_digit_number *= 10,
-        max_n_digit_number *= 10;
+    // initialized data
+    rsa_prime_job *p_job = p_parameter;
 
-    max_n_digit_number *= 10;
+    // another job already found a prime
+    if ( __atomic_load_n(p_job->p_found, __ATOMIC_RELAXED) ) return p_parameter;
 
-    while ( true )
-    {
-        i2048 n = random_n_bit_int(1024);
-        n = min_n_digit_number + n % (max_n_digit_number - min_n_digit_number);
+    // test
+    p_job->prime = miller_rabin(p_job->candidate, p_job->k);
 
-        // Reject trivial bad cases early
-        if (n % 2 == 0 || n % 5 == 0)
-            continue;
+    // stop the other jobs
+    if ( p_job->prime ) __atomic_store_n(p_job->p_found, true, __ATOMIC_RELAXED);
 
-        int r = n % 10;
-        if ( r == 1 || r == 3 || r == 7 || r == 9 ) {
-            return n;
-        }
-    }
+    // done
+    return p_parameter;
 }
 
-i2048 generate_prime ( int num_digits, int k )
+int generate_prime ( i2048 n, int num_digits, int k, thread_pool *p_thread_pool )
 {
 
     // initialized data
-    int i = 0;
+    rsa_sieve     *p_sieve = default_allocator(0, sizeof(rsa_sieve));
+    rsa_prime_job  _jobs[RSA_SIEVE_BATCH];
+    i2048          base    = { 0 },
+                   max     = { 1 };
+    size_t         offset  = 0,
+                   windows = 0;
+    bool           found   = false;
+
+    // error check
+    if ( NULL == p_sieve ) goto no_mem;
+
+    // candidates must be less than 10^num_digits
+    for (int i = 0; i < num_digits; i++) bn_mul_small(max, max, 10, 0);
+
+    // sieve from a random odd starting point
+    if ( 0 == generate_random(base, num_digits) ) goto failed_to_generate_random;
+    rsa_sieve_construct(p_sieve, base);
 
     // Attempt
-    while (i < 10000)
+    while ( windows < RSA_SIEVE_WINDOWS )
     {
 
         // initialized data
-        i2048 n = generate_random(num_digits);
+        size_t quantity = 0;
 
-        // Increment attempt
-        i++;
+        // collect a batch of candidates that survived the sieve
+        while ( quantity < RSA_SIEVE_BATCH && windows < RSA_SIEVE_WINDOWS )
+        {
 
-        // Verbose
-        // printf("iteration %d (expected %2.2lf total)\n", i, num_digits * 2.3);fflush(stdout);
-        
-        // Test
-        if ( miller_rabin(n, k) )
+            // initialized data
+            i2048 o = { offset };
+
+            // next window
+            if ( offset == RSA_SIEVE_WINDOW )
+            {
+                rsa_sieve_advance(p_sieve),
+                offset = 0,
+                windows++;
+                continue;
+            }
+
+            // the base is odd, so only even offsets are candidates
+            offset += 2;
+
+            // skip candidates with small factors
+            if ( p_sieve->composite[offset - 2] ) continue;
+
+            // the candidate
+            _jobs[quantity] = (rsa_prime_job)
+            {
+                .k       = k,
+                .prime   = false,
+                .p_found = &found
+            };
+            bn_add(_jobs[quantity].candidate, p_sieve->base, o, RSA_LIMBS);
+
+            // ran past num_digits, restart from a new random point
+            if ( bn_cmp(_jobs[quantity].candidate, max, RSA_LIMBS) >= 0 )
+            {
+                if ( 0 == generate_random(base, num_digits) ) goto failed_to_generate_random;
+                rsa_sieve_construct(p_sieve, base),
+                offset = 0;
+                continue;
+            }
+
+            // keep the candidate
+            quantity++;
+        }
+
+        // test the batch
+        for (size_t i = 0; i < quantity; i++)
+            if ( NULL == p_thread_pool || 0 == thread_pool_execute(p_thread_pool, rsa_prime_test, &_jobs[i]) )
+                rsa_prime_test(&_jobs[i]);
+
+        // wait for the batch
+        if ( p_thread_pool ) thread_pool_wait_idle(p_thread_pool);
+
+        // the first prime in the batch
+        for (size_t i = 0; i < quantity; i++)
+        {
+
+            // skip composites
+            if ( false == _jobs[i].prime ) continue;
+
+            // store the result
+            memcpy(n, _jobs[i].candidate, sizeof(i2048));
+
+            // release the sieve
+            p_sieve = default_allocator(p_sieve, 0);
 
             // success
-            return n;
+            return 1;
+        }
     }
 
+    // release the sieve
+    p_sieve = default_allocator(p_sieve, 0);
+
     // error
     return 0;
+
+    // error handling
+    {
+
+        // rsa errors
+        {
+            failed_to_generate_random:
+                #ifndef NDEBUG
+                    log_error("[rsa] Failed to generate a random candidate in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // release the sieve
+                p_sieve = default_allocator(p_sieve, 0);
+
+                // error
+                return 0;
+        }
+
+        // standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[interfaces] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int private_key_crt ( private_key *p_private_key )
+{
+
+    // initialized data
+    i2048 one = { 1 },
+          t   = { 0 };
+
+    // dp = b mod (p - 1)
+    bn_sub(t, p_private_key->p, one, RSA_LIMBS);
+    if ( 0 == bn_limbs(t, RSA_LIMBS) ) return 0;
+    bn_divmod(NULL, p_private_key->dp, p_private_key->b, t);
+
+    // dq = b mod (q - 1)
+    bn_sub(t, p_private_key->q, one, RSA_LIMBS);
+    if ( 0 == bn_limbs(t, RSA_LIMBS) ) return 0;
+    bn_divmod(NULL, p_private_key->dq, p_private_key->b, t);
+
+    // q_inv = q^-1 mod p
+    if ( false == bn_mod_inverse(p_private_key->q_inv, p_private_key->q, p_private_key->p) ) return 0;
+
+    // success
+    return 1;
 }
 
 int key_pair_construct ( public_key **pp_public_key, private_key **pp_private_key )
+{
+
+    // done
+    return key_pair_construct_parallel(pp_public_key, pp_private_key, NULL);
+}
+
+int key_pair_construct_parallel ( public_key **pp_public_key, private_key **pp_private_key, thread_pool *p_thread_pool )
 {
 
     // argument check
@@ -184,81 +1111,63 @@ int key_pair_construct ( public_key **pp_public_key, private_key **pp_private_ke
     // initialized data
     public_key  *p_public_key  = default_allocator(0, sizeof(public_key));
     private_key *p_private_key = default_allocator(0, sizeof(private_key));
-    i2048 n = 0, a = 0,
-          p = 0, q = 0, b = 0;
+    i2048 n = { 0 }, a = { 0 },
+          p = { 0 }, q = { 0 }, b = { 0 },
+          one = { 1 };
 
-    // Seed the RNG
-    srand(time(0));
+    // error check
+    if ( NULL == p_public_key || NULL == p_private_key ) goto no_mem;
 
-    // (Not) random primes
-    p = generate_prime(100, 5); 
-    q = generate_prime(100, 5); 
+    // Random primes
+    if ( 0 == generate_prime(p, 100, 5, p_thread_pool) ) goto failed_to_generate_prime;
+    if ( 0 == generate_prime(q, 100, 5, p_thread_pool) ) goto failed_to_generate_prime;
 
     // store the product of the prime factors in the public key
-    n = p * q;
+    bn_mul(n, p, q);
 
-    // Public
+    // Public and private exponents
     {
 
         // initialized data
-        i2048 euler_totient = (p - 1) * (q - 1),
-              gcd           = 0,
-              x             = 0,
-              y             = 0;
-              
-        size_t bits = req_bits(euler_totient);
+        i2048  euler_totient = { 0 },
+               p_less_1      = { 0 },
+               q_less_1      = { 0 };
+        size_t bits          = 0,
+               i             = 0;
+
+        // (p - 1) * (q - 1)
+        bn_sub(p_less_1, p, one, RSA_LIMBS),
+        bn_sub(q_less_1, q, one, RSA_LIMBS),
+        bn_mul(euler_totient, p_less_1, q_less_1);
+        bits = req_bits(euler_totient);
         
         // 1000 attempts to generate a
-        for (size_t i = 0; i < 1000; i++)
+        for (i = 0; i < 1000; i++)
         {
 
             // Generate a random number A
-            a = random_n_bit_int(bits);
+            if ( 0 == random_n_bit_int(a, bits) ) goto failed_to_generate_exponent;
 
             // Fast exit
-            if ( a <= 1 || a >= euler_totient) continue;
+            if ( bn_cmp(a, one, RSA_LIMBS) <= 0 || bn_cmp(a, euler_totient, RSA_LIMBS) >= 0 ) continue;
             
-            // Clear
-            x = y = 0;
-
-            // Compute the GCD 
-            gcd = egcd(a, euler_totient, &x, &y);
-
-            // This value of A works :D 
-            if ( gcd == 1 ) break;
+            // This value of A works :D, and B is its inverse
+            if ( bn_mod_inverse(b, a, euler_totient) ) break;
         }
-    }
 
-    // Private
-    {
-        
-        // initialized data
-        i2048 phi = (p - 1) * (q - 1);
-        i2048 gcd = 0;
-        i2048 y   = 0;
-        
-        // Compute the GCD, storing a factor as B
-        gcd = egcd(a, phi, &b, &y);
-
-        // Not acceptable
-        if ( abs((int)gcd) != 1 ) return EXIT_FAILURE;
-
-        // Posative mod
-        if ( b < 0 ) b = b + phi;
+        // error check
+        if ( i == 1000 ) goto failed_to_generate_exponent;
     }
 
     // Populate the public and private keys
-    *p_public_key = (public_key)
-    {
-        .a = a,
-        .n = n
-    },
-    *p_private_key = (private_key)
-    {
-        .p = p,
-        .q = q,
-        .b = b
-    },
+    memcpy(p_public_key->a, a, sizeof(i2048)),
+    memcpy(p_public_key->n, n, sizeof(i2048)),
+    memcpy(p_private_key->p, p, sizeof(i2048)),
+    memcpy(p_private_key->q, q, sizeof(i2048)),
+    memcpy(p_private_key->b, b, sizeof(i2048));
+
+    // CRT parameters
+    if ( 0 == private_key_crt(p_private_key) ) goto failed_to_generate_exponent;
 
     // return pointers to the caller
     *pp_private_key = p_private_key,
@@ -288,6 +1197,48 @@ int key_pair_construct ( public_key **pp_public_key, private_key **pp_private_ke
                 // error
                 return 0;
         }
+
+        // rsa errors
+        {
+            failed_to_generate_prime:
+                #ifndef NDEBUG
+                    log_error("[rsa] Failed to generate a prime in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // release the keys
+                p_public_key  = default_allocator(p_public_key, 0),
+                p_private_key = default_allocator(p_private_key, 0);
+
+                // error
+                return 0;
+
+            failed_to_generate_exponent:
+                #ifndef NDEBUG
+                    log_error("[rsa] Failed to generate an exponent in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // release the keys
+                p_public_key  = default_allocator(p_public_key, 0),
+                p_private_key = default_allocator(p_private_key, 0);
+
+                // error
+                return 0;
+        }
+
+        // standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[interfaces] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // release the keys
+                if ( p_public_key  ) p_public_key  = default_allocator(p_public_key, 0);
+                if ( p_private_key ) p_private_key = default_allocator(p_private_key, 0);
+
+                // error
+                return 0;
+        }
     }
 }
 
@@ -425,118 +1376,139 @@ int key_pair_from_files
     }
 }
 
-size_t req_bits ( i2048 n )
+int rsa_encrypt ( void *p_x, void *p_y, public_key *p_public_key )
 {
 
-    // Special case
-    if ( n == 0 ) return 1;
-
     // initialized data
-    size_t ret = 0;
+    bn_mont mont = { 0 };
 
-    // Right shift until n == 0 
-    while ( n > 0 )
-        n >>= 1, ret++;
+    // argument check
+    if ( NULL == p_x          ) goto no_x;
+    if ( NULL == p_y          ) goto no_y;
+    if ( NULL == p_public_key ) goto no_public_key;
 
+    // y = x^a mod n
+    bn_mont_construct(&mont, p_public_key->n),
+    mod_exp(p_y, p_x, p_public_key->a, &mont);
+        
     // success
-    return ret;
-}
-
-i2048 egcd ( i2048 a, i2048 b, i2048 *x, i2048 *y )
-{
+    return 1;
 
-    // Base case
-    if ( b == 0 )
+    // error handling
     {
 
-        // Store x and y
-        *x = 1, *y = 0;
+        // argument errors
+        {
+            no_x:
+                #ifndef NDEBUG
+                    log_error("[rsa] Null pointer provided for parameter \"p_x\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
-        // done
-        return a;
-    }
+                // error
+                return 0;
 
-    // initialized data
-    i2048 x1, y1;
-    i2048 gcd = egcd(b, a % b, &x1, &y1);
+            no_y:
+                #ifndef NDEBUG
+                    log_error("[rsa] Null pointer provided for parameter \"p_y\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
-    // Store x and y
-    *x = y1,
-    *y = x1 - ( a / b ) * y1;
+                // error
+                return 0;
 
-    // done
-    return gcd;
+            no_public_key:
+                #ifndef NDEBUG
+                    log_error("[rsa] Null pointer provided for parameter \"p_public_key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
 }
 
-i2048 mod_exp ( i2048 base, i2048 exp, i2048 mod )
+int rsa_decrypt ( void *p_y, void *p_z, public_key *p_public_key, private_key *p_private_key )
 {
 
-    // initialized data
-    i2048 result = 1;
-
-    // Modulate
-    base %= mod;
-
-    // Exponent
-    while (exp > 0)
-    {
-        if (exp & 1) result = (result * base) % mod;
-        exp >>= 1,
-        base = (base * base) % mod;
-    }
+    // argument check
+    if ( NULL == p_y           ) goto no_y;
+    if ( NULL == p_z           ) goto no_z;
+    if ( NULL == p_public_key  ) goto no_public_key;
+    if ( NULL == p_private_key ) goto no_private_key;
 
+    // initialized data
+    bn_mont mont_p = { 0 },
+            mont_q = { 0 };
+    i2048   m1     = { 0 },
+            m2     = { 0 },
+            h      = { 0 };
+
+    // m1 = y^dp mod p, m2 = y^dq mod q
+    bn_mont_construct(&mont_p, p_private_key->p),
+    bn_mont_construct(&mont_q, p_private_key->q),
+    mod_exp(m1, p_y, p_private_key->dp, &mont_p),
+    mod_exp(m2, p_y, p_private_key->dq, &mont_q);
+
+    // h = (m1 - m2) mod p
+    bn_divmod(NULL, h, m2, p_private_key->p);
+    if ( bn_sub(h, m1, h, RSA_LIMBS) ) bn_add(h, h, p_private_key->p, RSA_LIMBS);
+
+    // h = h * q_inv mod p, the second product cancels the factor of R^-1
+    bn_mont_mul(h, h, p_private_key->q_inv, &mont_p),
+    bn_mont_mul(h, h, mont_p.rr, &mont_p);
+
+    // z = m2 + h * q
+    bn_mul(h, h, p_private_key->q),
+    bn_add(p_z, m2, h, RSA_LIMBS);
+    
     // success
-    return result;
-}
+    return 1;
 
-i2048 enc_block ( i2048 x, public_key *p_public_key )
-{
-    
-    // done
-    return mod_exp(x, p_public_key->a, p_public_key->n);
-}
+    // error handling
+    {
 
-i2048 dec_block ( i2048 y, public_key *p_public_key, private_key *p_private_key )
-{
+        // argument errors
+        {
+            no_y:
+                #ifndef NDEBUG
+                    log_error("[rsa] Null pointer provided for parameter \"p_y\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
-    // done
-    return mod_exp(y, p_private_key->b, p_public_key->n);
-}
+                // error
+                return 0;
 
-int rsa_encrypt ( void *p_x, void *p_y, public_key *p_public_key )
-{
+            no_z:
+                #ifndef NDEBUG
+                    log_error("[rsa] Null pointer provided for parameter \"p_z\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
-    // initialized data
-    i2048 x = *(i2048 *)p_x,
-          y = mod_exp(x, p_public_key->a, p_public_key->n);
+                // error
+                return 0;
 
-    // store the result
-    *(i2048 *)p_y = y;
-        
-    // done
-    return 1;
-}
+            no_public_key:
+                #ifndef NDEBUG
+                    log_error("[rsa] Null pointer provided for parameter \"p_public_key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
-int rsa_decrypt ( void *p_y, void *p_z, public_key *p_public_key, private_key *p_private_key )
-{
+                // error
+                return 0;
 
-    // initialized data
-    i2048 y = *(i2048 *)p_y,
-          z = mod_exp(y, p_private_key->b, p_public_key->n);
+            no_private_key:
+                #ifndef NDEBUG
+                    log_error("[rsa] Null pointer provided for parameter \"p_private_key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
-    // store the result
-    *(i2048 *)p_z = z;
-    
-    // done
-    return 1;
+                // error
+                return 0;
+        }
+    }
 }
 
-int print_n_bit_int ( i2048 a )
+int print_n_bit_int ( const i2048 a )
 { 
 
     // initialized data
     size_t bits = 0;
-    void *p_int = &a;
+    const void *p_int = a;
 
     // Compute how many bits are required to represent a
     bits = req_bits(a) + 32;
@@ -545,38 +1517,12 @@ int print_n_bit_int ( i2048 a )
     putchar('0'), putchar('x');
   
     for (signed i = (bits >> 5) - 1; i >= 0; i--)
-        printf("%08x", ((unsigned int *) p_int)[i]);
+        printf("%08x", ((const unsigned int *) p_int)[i]);
 
     // done
     return 1;
 }
 
-i2048 random_n_bit_int ( size_t bits )
-{
-
-    // initialized data
-    i2048 result = 0;
-    size_t bytes = (bits + 7) / 8;
-    FILE *urandom = fopen("/dev/urandom", "rb");
-
-    // error check
-    if ( urandom == NULL ) goto no_random;
-
-    // Read random
-    fread(&result, bytes, 1, urandom),
-    fclose(urandom);
-
-    // Ensure result is within the desired bit range
-    if (bits < 1024)
-        result &= ((i2048) 1 << bits) - 1;
-
-    // success
-    return result;
-
-    no_random:
-        return 0;
-}
-
 int print_public_key ( public_key *p_public_key )
 {
 
@@ -598,7 +1544,7 @@ int print_public_key_short ( public_key *p_public_key )
 {
 
     // Print the product of p and q
-    printf(BLUE "0x...%llx" RESET "\n", (unsigned long long) p_public_key->n);
+    printf(BLUE "0x...%llx" RESET "\n", p_public_key->n[0]);
 
     // success
     return 1;
@@ -851,6 +1797,9 @@ int private_key_unpack ( private_key *p_private_key, void *p_buffer )
     // error check
     if ( 0 != strncmp("b", buf, 2) ) goto no_private_b;
 
+    // derive the CRT parameters
+    if ( 0 == private_key_crt(p_private_key) ) goto failed_to_derive_crt;
+
     // success
     return 1;
 
@@ -883,6 +1832,17 @@ int private_key_unpack ( private_key *p_private_key, void *p_buffer )
                 // error
                 return 0;
         }
+
+        // rsa errors
+        {
+            failed_to_derive_crt:
+                #ifndef NDEBUG
+                    log_error("[rsa] Failed to derive CRT parameters in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
     }
 }
 
@@ -26,12 +26,27 @@
 /// crypto
 #include <crypto/sha.h>
 
+/// performance
+#include <performance/thread_pool.h>
+
+// platform check
+#ifndef __SIZEOF_INT128__
+    #error "rsa needs a compiler with unsigned __int128"
+#endif
+
+// preprocessor definitions
+#define RSA_LIMBS 32
+
 // structure declarations
 struct public_key_s;
 struct private_key_s;
 
 // type definitions
-typedef _BitInt(2048) i2048;
+/** !
+ * A 2048 bit unsigned integer, as 32 limbs of 64 bits, least significant
+ * limb first
+ */
+typedef unsigned long long i2048[RSA_LIMBS];
 
 typedef struct public_key_s  public_key;
 typedef struct private_key_s private_key;
@@ -45,6 +60,7 @@ struct public_key_s
 struct private_key_s
 {
     i2048 p, q, b;
+    i2048 dp, dq, q_inv; // b mod (p - 1), b mod (q - 1), q^-1 mod p
 };
 
 // function declarations
@@ -52,17 +68,29 @@ struct private_key_s
  * Construct a public private key pair from /dev/urandom
  * 
  * @param pp_public_key result
- * @param pp_public_key result
+ * @param pp_private_key result
  * 
  * @return 1 on success, 0 on error
  */
 int key_pair_construct ( public_key **pp_public_key, private_key **pp_private_key );
 
+/** !
+ * Construct a public private key pair from /dev/urandom, testing prime
+ * candidates concurrently on a thread pool
+ * 
+ * @param pp_public_key result
+ * @param pp_private_key result
+ * @param p_thread_pool the thread pool that tests prime candidates, or null to test them in the caller
+ * 
+ * @return 1 on success, 0 on error
+ */
+int key_pair_construct_parallel ( public_key **pp_public_key, private_key **pp_private_key, thread_pool *p_thread_pool );
+
 /** !
  * Construct a public private key pair from a file
  * 
  * @param pp_public_key      result
- * @param pp_public_key      result
+ * @param pp_private_key     result
  * @param p_public_key_path  path to public key file
  * @param p_private_key_path path to private key file 
  *
@@ -83,7 +111,7 @@ int key_pair_from_files
  * 
  * @return 1 on success, 0 on error
  */
-int print_n_bit_int ( i2048 a );
+int print_n_bit_int ( const i2048 a );
 
 /** !
  * Print a public key
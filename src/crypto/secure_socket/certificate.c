@@ -9,6 +9,9 @@
 // header file
 #include <crypto/certificate.h>
 
+// preprocessor definitions
+#define CERTIFICATE_PACKED_MAX 160
+
 // structure definitions
 struct certificate_s
 {
@@ -21,6 +24,21 @@ struct certificate_s
     ed25519_signature   signature;
 };
 
+// function declarations
+/** !
+ * Check that an issuer may sign a certificate, and pack the part of the
+ * certificate that the issuer signed
+ * 
+ * @param p_certificate the certificate
+ * @param p_issuer      the issuer, or null if the certificate is self-signed
+ * @param p_buffer      result, at least CERTIFICATE_PACKED_MAX bytes
+ * @param p_len         result, the length of the signed part
+ * @param pp_public_key result, the public key of the signer
+ * 
+ * @return 1 on success, 0 on error
+ */
+int certificate_signed_part ( certificate *p_certificate, certificate *p_issuer, char *p_buffer, size_t *p_len, ed25519_public_key **pp_public_key );
+
 // function definitions
 int certificate_construct
 (
@@ -223,7 +241,7 @@ int certificate_sign ( certificate *p_certificate, ed25519_public_key *p_public_
     if ( NULL ==  p_private_key ) goto no_private_key;
 
     // initialized data
-    char _buf[160] = { 0 };
+    char _buf[CERTIFICATE_PACKED_MAX] = { 0 };
     size_t len = 0;
 
     // pack the certificate
@@ -273,15 +291,10 @@ int certificate_sign ( certificate *p_certificate, ed25519_public_key *p_public_
     }
 }
 
-int certificate_verify ( certificate *p_certificate, certificate *p_issuer )
+int certificate_signed_part ( certificate *p_certificate, certificate *p_issuer, char *p_buffer, size_t *p_len, ed25519_public_key **pp_public_key )
 {
 
-    // argument check
-    if ( NULL == p_certificate ) goto no_certificate;
-
     // initialized data
-    char _buf[160] = { 0 };
-    size_t len = 0;
     ed25519_public_key *p_public_key = NULL;
 
     // CA uses their key
@@ -315,44 +328,69 @@ int certificate_verify ( certificate *p_certificate, certificate *p_issuer )
         p_public_key = &p_issuer->public_key;
     }
 
-    // pack the certificate
-    len = certificate_pack(_buf, p_certificate);
+    // pack the certificate, less the signature
+    *p_len = certificate_pack(p_buffer, p_certificate) - sizeof(ed25519_signature);
 
-    // done
-    return ed25519_verify(
-        &p_certificate->signature,
-        (const unsigned char *)_buf,
-        len - sizeof(ed25519_signature),
-        p_public_key
-    );
+    // return the key to the caller
+    *pp_public_key = p_public_key;
+
+    // success
+    return 1;
 
     // error handling
     {
 
-        // argument errors
+        // certificate errors
         {
-            no_certificate:
+            issuer_not_ca:
                 #ifndef NDEBUG
-                    log_error("[certificate] Null pointer provided for parameter \"p_certificate\" in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[certificate] Issuer certificate is not a CA in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // error
                 return 0;
-        }
 
-        // certificate errors
-        {
-            issuer_not_ca:
+            issuer_mismatch:
                 #ifndef NDEBUG
-                    log_error("[certificate] Issuer certificate is not a CA in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[certificate] Issuer certificate subject does not match certificate issuer hash in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // error
                 return 0;
+        }
+    }
+}
 
-            issuer_mismatch:
+int certificate_verify ( certificate *p_certificate, certificate *p_issuer )
+{
+
+    // argument check
+    if ( NULL == p_certificate ) goto no_certificate;
+
+    // initialized data
+    char _buf[CERTIFICATE_PACKED_MAX] = { 0 };
+    size_t len = 0;
+    ed25519_public_key *p_public_key = NULL;
+
+    // check the issuer, and pack the certificate
+    if ( 0 == certificate_signed_part(p_certificate, p_issuer, _buf, &len, &p_public_key) ) return 0;
+
+    // done
+    return ed25519_verify(
+        &p_certificate->signature,
+        (const unsigned char *)_buf,
+        len,
+        p_public_key
+    );
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_certificate:
                 #ifndef NDEBUG
-                    log_error("[certificate] Issuer certificate subject does not match certificate issuer hash in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[certificate] Null pointer provided for parameter \"p_certificate\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // error
@@ -369,21 +407,52 @@ int certificate_chain_verify ( certificate **pp_chain, size_t count, certificate
     if ( NULL == p_trust_root ) goto no_trust_root;
 
     // initialized data
-    certificate *p_issuer = NULL;
-
-    // iterate through each certificate in the chain
-    for (size_t i = 0; i < count; i++)
+    size_t                     quantity       = count + 1;
+    void                      *p_scratch      = NULL;
+    char                     (*p_buffers)[CERTIFICATE_PACKED_MAX] = NULL;
+    size_t                    *p_lens         = NULL;
+    const unsigned char      **pp_messages    = NULL;
+    const ed25519_signature  **pp_signatures  = NULL;
+    const ed25519_public_key **pp_public_keys = NULL;
+    int                        result         = 0;
+
+    // allocate memory for every signed part of the chain, and the trust root
+    p_scratch = default_allocator(0, quantity * ( CERTIFICATE_PACKED_MAX + sizeof(size_t) + 3 * sizeof(void *) ));
+    if ( NULL == p_scratch ) goto no_mem;
+
+    // carve the allocation
+    p_buffers      = p_scratch,
+    p_lens         = (size_t *) ( p_buffers + quantity ),
+    pp_messages    = (const unsigned char **) ( p_lens + quantity ),
+    pp_signatures  = (const ed25519_signature **) ( pp_messages + quantity ),
+    pp_public_keys = (const ed25519_public_key **) ( pp_signatures + quantity );
+
+    // iterate through each certificate in the chain, then the trust root (it should be self-signed)
+    for (size_t i = 0; i < quantity; i++)
     {
 
-        // store the issuer for the current certificate
-        p_issuer = ( i + 1 < count ) ? pp_chain[i + 1] : p_trust_root;
+        // initialized data
+        certificate        *p_certificate = ( i < count ) ? pp_chain[i] : p_trust_root;
+        certificate        *p_issuer      = ( i + 1 < count ) ? pp_chain[i + 1] : ( i < count ) ? p_trust_root : NULL;
+        ed25519_public_key *p_public_key  = NULL;
 
-        // verify the current certificate using its issuer
-        if ( 0 == certificate_verify(pp_chain[i], p_issuer) ) goto failed_to_verify_certificate;
+        // check the issuer of the current certificate
+        if ( 0 == certificate_signed_part(p_certificate, p_issuer, p_buffers[i], &p_lens[i], &p_public_key) ) goto failed_to_verify_certificate;
+
+        // store the signature
+        pp_messages[i]    = (const unsigned char *) p_buffers[i],
+        pp_signatures[i]  = (const ed25519_signature *) &p_certificate->signature,
+        pp_public_keys[i] = (const ed25519_public_key *) p_public_key;
     }
 
-    // verify the trust root (it should be self-signed)
-    if ( 0 == certificate_verify(p_trust_root, NULL) ) goto failed_to_verify_trust_root;
+    // verify every signature at once
+    result = ed25519_verify_batch(pp_signatures, pp_messages, p_lens, pp_public_keys, quantity);
+
+    // release the allocation
+    p_scratch = default_allocator(p_scratch, 0);
+
+    // error check
+    if ( 0 == result ) goto failed_to_verify_certificate;
 
     // success
     return 1;
@@ -417,12 +486,18 @@ int certificate_chain_verify ( certificate **pp_chain, size_t count, certificate
                     log_error("[certificate] Failed to verify certificate chain in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // release the allocation
+                if ( p_scratch ) p_scratch = default_allocator(p_scratch, 0);
+
                 // error
                 return 0;
-            
-            failed_to_verify_trust_root:
+        }
+
+        // standard library errors
+        {
+            no_mem:
                 #ifndef NDEBUG
-                    log_error("[certificate] Failed to verify trust root in call to function \"%s\"\n", __FUNCTION__);
+                    log_error("[interfaces] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // error
@@ -13,8 +13,11 @@
 struct secure_socket_s
 {
     socket_tcp      tcp_socket;
-    aead           *p_aead;
+    aead           *p_send_aead;
+    aead           *p_receive_aead;
     chacha20_nonce  nonce; 
+    unsigned char  *p_send_buffer;
+    size_t          send_buffer_size;
 };
 
 
@@ -47,7 +50,8 @@ int secure_socket_handshake ( secure_socket *p_secure_socket, bool is_server, ce
     sha512_state         s         = { 0 };
     sha512_hash          h         = { 0 };
     chacha20_key         key       = { 0 };
-    chacha20_nonce       nonce     = { 0 };
+    chacha20_nonce       nonce     = { 0 },
+                         reply     = { 0 };
 
     // construct a key pair
     if ( 0 == x25519_key_pair_construct(&pub, &priv) ) goto failed_to_construct_key_pair;
@@ -175,8 +179,14 @@ int secure_socket_handshake ( secure_socket *p_secure_socket, bool is_server, ce
     // store the nonce
     memcpy(nonce, h + 32, 8);
 
-    // construct the aead
-    if ( 0 == aead_construct(&p_secure_socket->p_aead, key, nonce) ) goto failed_to_construct_aead;
+    // server to client messages flip a bit of the fixed part of the nonce, 
+    // so each direction has its own sequence and the two never share a nonce
+    memcpy(reply, nonce, sizeof(chacha20_nonce));
+    reply[0] ^= 1;
+
+    // construct an aead for each direction
+    if ( 0 == aead_construct(&p_secure_socket->p_send_aead   , key, ( is_server ) ? reply : nonce) ) goto failed_to_construct_aead;
+    if ( 0 == aead_construct(&p_secure_socket->p_receive_aead, key, ( is_server ) ? nonce : reply) ) goto failed_to_construct_aead;
     
     // success
     return 1;
@@ -210,6 +220,9 @@ int secure_socket_handshake ( secure_socket *p_secure_socket, bool is_server, ce
                     log_error("[secure socket] Failed to construct aead in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // release the send aead
+                if ( p_secure_socket->p_send_aead ) aead_destroy(&p_secure_socket->p_send_aead);
+
                 // error
                 return 0;
         }
@@ -485,6 +498,10 @@ int secure_socket_construct
     // store the tcp socket
     p_secure_socket->tcp_socket = tcp_socket;
 
+    // the send buffer grows on demand
+    p_secure_socket->p_send_buffer    = NULL,
+    p_secure_socket->send_buffer_size = 0;
+
     // perform handshake
     if ( 0 == secure_socket_handshake(p_secure_socket, is_server, p_certificate, p_private_key) ) goto failed_to_handshake;
 
@@ -513,6 +530,105 @@ int secure_socket_construct
     }
 }
 
+int secure_socket_pool_open ( void **pp_connection, socket_tcp *p_socket_tcp, socket_ip_address ip_address, socket_port port_number, void *p_parameter )
+{
+
+    // initialized data
+    socket_tcp     tcp_socket      = -1;
+    secure_socket *p_secure_socket = NULL;
+
+    // connect
+    if ( 0 == socket_tcp_connect(&tcp_socket, ip_address._type, ip_address, port_number) ) goto failed_to_connect_tcp_socket;
+
+    // handshake
+    if ( 0 == secure_socket_construct(&p_secure_socket, tcp_socket, false, (certificate *) p_parameter, NULL) ) goto failed_to_construct_secure_socket;
+
+    // return the connection to the caller
+    *pp_connection = p_secure_socket,
+    *p_socket_tcp  = tcp_socket;
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // socket errors
+        {
+            failed_to_connect_tcp_socket:
+                #ifndef NDEBUG
+                    log_error("[secure socket] Failed to connect tcp socket in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // secure socket errors
+        {
+            failed_to_construct_secure_socket:
+                #ifndef NDEBUG
+                    log_error("[secure socket] Failed to construct secure socket in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // destroy the socket
+                socket_tcp_destroy(&tcp_socket);
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int secure_socket_pool_close ( void *p_connection, socket_tcp _socket_tcp, void *p_parameter )
+{
+
+    // initialized data
+    secure_socket *p_secure_socket = p_connection;
+
+    // unused
+    (void) p_parameter;
+
+    // destroy the secure socket
+    secure_socket_destroy(&p_secure_socket);
+
+    // done
+    return socket_tcp_destroy(&_socket_tcp);
+}
+
+int secure_socket_connection_pool_construct
+(
+    connection_pool **pp_connection_pool,
+    size_t            max_idle,
+    size_t            max_per_host,
+    size_t            wait_timeout,
+    size_t            idle_timeout,
+    certificate      *p_certificate
+)
+{
+
+    // argument check
+    if ( NULL == p_certificate ) goto no_certificate;
+
+    // done
+    return connection_pool_construct_custom(pp_connection_pool, max_idle, max_per_host, wait_timeout, idle_timeout, secure_socket_pool_open, secure_socket_pool_close, p_certificate);
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_certificate:
+                #ifndef NDEBUG
+                    log_error("[secure socket] Null pointer provided for parameter \"p_certificate\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
 int secure_socket_send ( secure_socket *p_secure_socket, const void *p_data, size_t len )
 {
 
@@ -521,29 +637,43 @@ int secure_socket_send ( secure_socket *p_secure_socket, const void *p_data, siz
     if ( NULL ==          p_data ) goto no_data;
 
     // initialized data
-    unsigned char *p_ciphertext = NULL;
     poly1305_tag   tag          = { 0 };
     uint64_t       n_len        = (uint64_t)len;
     int            sent         = 0;
 
-    // allocate memory for ciphertext
-    p_ciphertext = default_allocator(NULL, len + sizeof(n_len) + sizeof(tag)); 
-    if ( NULL == p_ciphertext ) goto no_mem;
+    // grow the send buffer (at least one byte, so empty messages can be sent)
+    if ( p_secure_socket->send_buffer_size < len || NULL == p_secure_socket->p_send_buffer )
+    {
 
-    // encrypt, passing the length as AAD
-    if ( 0 == aead_encrypt(p_ciphertext+sizeof(n_len), p_secure_socket->p_aead, tag, &n_len, sizeof(n_len), p_data, len) ) goto failed_to_encrypt;
+        // initialized data
+        size_t size = len ? len : 1;
 
-    // store the length
-    memcpy(p_ciphertext, &n_len, sizeof(n_len));
-    
-    // store the tag
-    memcpy(p_ciphertext+sizeof(n_len)+len, tag, sizeof(tag));
+        // reallocate
+        p_secure_socket->p_send_buffer = default_allocator(p_secure_socket->p_send_buffer, size);
+        p_secure_socket->send_buffer_size = p_secure_socket->p_send_buffer ? size : 0;
 
-    // send length prefix, ciphertext, and tag
-    sent = socket_tcp_send(p_secure_socket->tcp_socket, p_ciphertext, len+sizeof(n_len)+sizeof(tag));
-    
-    // release ciphertext
-    p_ciphertext = default_allocator(p_ciphertext, 0);
+        // error check
+        if ( NULL == p_secure_socket->p_send_buffer ) goto no_mem;
+    }
+
+    // encrypt into the send buffer, passing the length as AAD
+    if ( 0 == aead_encrypt(p_secure_socket->p_send_buffer, p_secure_socket->p_send_aead, tag, &n_len, sizeof(n_len), p_data, len) ) goto failed_to_encrypt;
+
+    // send length prefix, ciphertext, and tag, looping over short sends
+    sent = socket_tcp_sendv_all
+    (
+        p_secure_socket->tcp_socket, 
+        (struct iovec[])
+        {
+            { .iov_base = &n_len                        , .iov_len = sizeof(n_len) },
+            { .iov_base = p_secure_socket->p_send_buffer, .iov_len = len           },
+            { .iov_base = tag                           , .iov_len = sizeof(tag)   }
+        },
+        3
+    );
+
+    // error check
+    if ( 0 == sent ) goto failed_to_send;
 
     // success
     return sent;
@@ -570,6 +700,17 @@ int secure_socket_send ( secure_socket *p_secure_socket, const void *p_data, siz
                 return 0;
         }
 
+        // socket errors
+        {
+            failed_to_send:
+                #ifndef NDEBUG
+                    log_error("[secure socket] Failed to send data in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
         // aead errors
         {
             failed_to_encrypt:
@@ -577,9 +718,6 @@ int secure_socket_send ( secure_socket *p_secure_socket, const void *p_data, siz
                     log_error("[secure socket] Failed to encrypt message in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
-                // release ciphertext
-                p_ciphertext = default_allocator(p_ciphertext, 0);
-
                 // error
                 return 0;
         }
@@ -607,31 +745,27 @@ int secure_socket_receive ( secure_socket *p_secure_socket, void *p_buffer, size
     // initialized data
     uint64_t       n_len      = 0;
     poly1305_tag   tag        = { 0 };
-    unsigned char *ciphertext = NULL;
-    int r = 0;
 
-    // read the length
-    r = socket_tcp_receive(p_secure_socket->tcp_socket, &n_len, sizeof(n_len));
-    if ( 0 == r ) return 0;
-    if ( sizeof(n_len) != r ) goto failed_to_receive;
+    // read the length. 0 if the peer closed the connection
+    if ( 0 == socket_tcp_receivev_all(p_secure_socket->tcp_socket, (struct iovec[]) { { .iov_base = &n_len, .iov_len = sizeof(n_len) } }, 1) ) return 0;
 
     // error check
     if ( n_len > buffer_len ) goto buffer_too_small;
 
-    // allocate memory for the message
-    ciphertext = default_allocator(NULL, (size_t)n_len);
-
-    // read the ciphertext
-    socket_tcp_receive(p_secure_socket->tcp_socket, ciphertext, (size_t)n_len);
-
-    // read the tag
-    socket_tcp_receive(p_secure_socket->tcp_socket, tag, sizeof(tag));
+    // read the ciphertext into the caller's buffer, and the tag, looping over short reads
+    if ( 0 == socket_tcp_receivev_all
+    (
+        p_secure_socket->tcp_socket, 
+        (struct iovec[])
+        {
+            { .iov_base = p_buffer, .iov_len = (size_t)n_len },
+            { .iov_base = tag     , .iov_len = sizeof(tag)   }
+        },
+        2
+    ) ) goto failed_to_receive;
     
-    // decrypt the message
-    if ( 0 == aead_decrypt(p_buffer, p_secure_socket->p_aead, tag, &n_len, sizeof(n_len), ciphertext, (size_t)n_len) ) goto failed_to_decrypt;
-
-    // release the ciphertext
-    ciphertext = default_allocator(ciphertext, 0);
+    // decrypt the message in place
+    if ( 0 == aead_decrypt_in_place(p_secure_socket->p_receive_aead, tag, &n_len, sizeof(n_len), p_buffer, (size_t)n_len) ) goto failed_to_decrypt;
 
     // success
     return (int)n_len;
@@ -686,9 +820,6 @@ int secure_socket_receive ( secure_socket *p_secure_socket, void *p_buffer, size
                 #ifndef NDEBUG
                     log_error("[secure socket] Failed to decrypt message in call to function \"%s\"\n", __FUNCTION__);
                 #endif
-
-                // release the ciphertext
-                ciphertext = default_allocator(ciphertext, 0);
                 
                 // error
                 return 0;
@@ -709,8 +840,14 @@ int secure_socket_destroy ( secure_socket **pp_secure_socket )
     *pp_secure_socket = NULL;
 
     // destroy AEAD
-    if ( p_secure_socket->p_aead ) 
-        aead_destroy(&p_secure_socket->p_aead);
+    if ( p_secure_socket->p_send_aead ) 
+        aead_destroy(&p_secure_socket->p_send_aead);
+    if ( p_secure_socket->p_receive_aead ) 
+        aead_destroy(&p_secure_socket->p_receive_aead);
+
+    // release the send buffer
+    if ( p_secure_socket->p_send_buffer )
+        p_secure_socket->p_send_buffer = default_allocator(p_secure_socket->p_send_buffer, 0);
 
     // release memory
     default_allocator(p_secure_socket, 0);
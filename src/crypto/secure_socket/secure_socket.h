@@ -23,6 +23,7 @@
 #include <core/pack.h>
 #include <core/socket.h>
 #include <core/tcp.h>
+#include <core/connection_pool.h>
 
 /// crypto
 #include <crypto/ed25519.h>
@@ -130,6 +131,36 @@ int secure_socket_send ( secure_socket *p_secure_socket, const void *p_data, siz
  */
 int secure_socket_receive ( secure_socket *p_secure_socket, void *p_buffer, size_t buffer_len );
 
+/// connection pool
+/** !
+ * Construct a pool of secure connections. Each connection is handshaked
+ * once, and reused by later checkouts, so the key exchange and the
+ * certificate verification are paid once per connection, instead of
+ * once per request. The p_connection of a checked out connection is
+ * its secure socket.
+ *
+ * @param pp_connection_pool result
+ * @param max_idle           the maximum quantity of idle connections kept for each host
+ * @param max_per_host       the maximum quantity of open connections to each host, or 0 for no limit
+ * @param wait_timeout       milliseconds that a checkout waits when max_per_host connections to the host are open, or 0 to fail at once
+ * @param idle_timeout       milliseconds that an idle connection may be reused for, or 0 for no limit
+ * @param p_certificate      the certificate that verifies each server
+ *
+ * @sa connection_pool_checkout
+ * @sa connection_pool_checkin
+ *
+ * @return 1 on success, 0 on error
+ */
+int secure_socket_connection_pool_construct
+(
+    connection_pool **pp_connection_pool,
+    size_t            max_idle,
+    size_t            max_per_host,
+    size_t            wait_timeout,
+    size_t            idle_timeout,
+    certificate      *p_certificate
+);
+
 /// descructor
 /** !
  * Release the secure socket and underlying resources.
@@ -22,6 +22,297 @@
 /// crypto
 #include <crypto/sha.h>
 
+// platform dependent compression functions
+#if ( defined(__x86_64__) || defined(__i386__) ) && ( defined(__GNUC__) || defined(__clang__) )
+    #define SHA_X86
+    #include <immintrin.h>
+#elif defined(__aarch64__) && ( defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO) )
+    #define SHA_ARM
+    #include <arm_neon.h>
+#endif
+
+// multi buffer kernels, written with vector extensions
+#if ( defined(__x86_64__) || defined(__i386__) || defined(__aarch64__) ) && ( defined(__GNUC__) || defined(__clang__) )
+    #define SHA_MULTI
+#endif
+
+// preprocessor definitions
+#define SHA_MULTI_LANES 16
+
+/** !
+ * Compress blocks of a message into a SHA-256 state
+ *
+ * @param state  the state
+ * @param p_data the message
+ * @param blocks the quantity of 64 byte blocks
+ *
+ * @return void
+ */
+typedef void (fn_sha256_blocks) ( unsigned int state[8], const unsigned char *p_data, size_t blocks );
+
+/** !
+ * Compress blocks of a message into a SHA-512 state
+ *
+ * @param state  the state
+ * @param p_data the message
+ * @param blocks the quantity of 128 byte blocks
+ *
+ * @return void
+ */
+typedef void (fn_sha512_blocks) ( unsigned long long state[8], const unsigned char *p_data, size_t blocks );
+
+/** !
+ * Expand a 128 byte block into the 80 word SHA-512 message schedule,
+ * with the round constants added
+ *
+ * @param m      result
+ * @param p_data the block
+ *
+ * @return void
+ */
+typedef void (fn_sha512_schedule) ( unsigned long long m[80], const unsigned char *p_data );
+
+/** !
+ * Compress a block of each of many messages into a transposed SHA-256 state
+ *
+ * @param state     the state, one column to a lane
+ * @param pp_blocks a 64 byte block for each lane
+ *
+ * @return void
+ */
+typedef void (fn_sha256_multi_blocks) ( unsigned int state[8][SHA_MULTI_LANES], const unsigned char *const pp_blocks[SHA_MULTI_LANES] );
+
+/** !
+ * Compress a block of each of many messages into a transposed SHA-512 state
+ *
+ * @param state     the state, one column to a lane
+ * @param pp_blocks a 128 byte block for each lane
+ *
+ * @return void
+ */
+typedef void (fn_sha512_multi_blocks) ( unsigned long long state[8][SHA_MULTI_LANES], const unsigned char *const pp_blocks[SHA_MULTI_LANES] );
+
+// structure definitions
+struct sha_multi_lane_s
+{
+    size_t        message; // the index of the message in the lane
+    size_t        offset;  // the offset of the next block of the message
+    size_t        full;    // the quantity of whole blocks left in the message
+    size_t        tail;    // the quantity of padded blocks left
+    bool          active;  // true if the lane holds a message, else false
+    unsigned char _tail[256];
+};
+
+// function declarations
+/** !
+ * Compress blocks of a message into a SHA-256 state, using the fastest
+ * kernel this CPU can run
+ *
+ * @param state  the state
+ * @param p_data the message
+ * @param blocks the quantity of 64 byte blocks
+ *
+ * @return void
+ */
+void sha256_blocks ( unsigned int state[8], const unsigned char *p_data, size_t blocks );
+
+/** !
+ * Compress blocks of a message into a SHA-512 state, using the fastest
+ * kernel this CPU can run
+ *
+ * @param state  the state
+ * @param p_data the message
+ * @param blocks the quantity of 128 byte blocks
+ *
+ * @return void
+ */
+void sha512_blocks ( unsigned long long state[8], const unsigned char *p_data, size_t blocks );
+
+/** !
+ * Choose the fastest SHA-256 kernel this CPU can run
+ *
+ * @return the kernel
+ */
+fn_sha256_blocks *sha256_blocks_select ( void );
+
+/** !
+ * Choose the fastest SHA-512 kernel this CPU can run
+ *
+ * @return the kernel
+ */
+fn_sha512_blocks *sha512_blocks_select ( void );
+
+/** !
+ * Compress SHA-256 blocks in portable C
+ *
+ * @param state  the state
+ * @param p_data the message
+ * @param blocks the quantity of 64 byte blocks
+ *
+ * @return void
+ */
+void sha256_blocks_scalar ( unsigned int state[8], const unsigned char *p_data, size_t blocks );
+
+/** !
+ * Compress SHA-512 blocks in portable C
+ *
+ * @param state  the state
+ * @param p_data the message
+ * @param blocks the quantity of 128 byte blocks
+ *
+ * @return void
+ */
+void sha512_blocks_scalar ( unsigned long long state[8], const unsigned char *p_data, size_t blocks );
+
+/** !
+ * Expand a SHA-512 message schedule in portable C
+ *
+ * @param m      result
+ * @param p_data the block
+ *
+ * @return void
+ */
+void sha512_schedule_scalar ( unsigned long long m[80], const unsigned char *p_data );
+
+/** !
+ * Compress SHA-512 blocks, expanding each message schedule with pfn_schedule
+ *
+ * @param state        the state
+ * @param p_data       the message
+ * @param blocks       the quantity of 128 byte blocks
+ * @param pfn_schedule the message schedule function
+ *
+ * @return void
+ */
+void sha512_blocks_schedule ( unsigned long long state[8], const unsigned char *p_data, size_t blocks, fn_sha512_schedule *pfn_schedule );
+
+#ifdef SHA_X86
+
+/** !
+ * Compress SHA-256 blocks with the Intel SHA extensions
+ *
+ * @param state  the state
+ * @param p_data the message
+ * @param blocks the quantity of 64 byte blocks
+ *
+ * @return void
+ */
+void sha256_blocks_sha_ni ( unsigned int state[8], const unsigned char *p_data, size_t blocks );
+
+/** !
+ * Compress SHA-512 blocks, with an AVX2 message schedule
+ *
+ * @param state  the state
+ * @param p_data the message
+ * @param blocks the quantity of 128 byte blocks
+ *
+ * @return void
+ */
+void sha512_blocks_avx2 ( unsigned long long state[8], const unsigned char *p_data, size_t blocks );
+
+/** !
+ * Expand a SHA-512 message schedule 4 words at a time, with AVX2
+ *
+ * @param m      result
+ * @param p_data the block
+ *
+ * @return void
+ */
+void sha512_schedule_avx2 ( unsigned long long m[80], const unsigned char *p_data );
+
+#endif
+
+/** !
+ * Choose the widest multi buffer SHA-256 kernel this CPU can run
+ *
+ * @param p_lanes result, the quantity of lanes of the kernel
+ *
+ * @return the kernel IF the CPU can run one ELSE null
+ */
+fn_sha256_multi_blocks *sha256_multi_select ( size_t *p_lanes );
+
+/** !
+ * Choose the widest multi buffer SHA-512 kernel this CPU can run
+ *
+ * @param p_lanes result, the quantity of lanes of the kernel
+ *
+ * @return the kernel IF the CPU can run one ELSE null
+ */
+fn_sha512_multi_blocks *sha512_multi_select ( size_t *p_lanes );
+
+#ifdef SHA_MULTI
+
+/** !
+ * Compress a block of each of 4 messages into a transposed SHA-256 state
+ *
+ * @param state     the state, one column to a lane
+ * @param pp_blocks a 64 byte block for each lane
+ *
+ * @return void
+ */
+void sha256_multi_blocks_x4 ( unsigned int state[8][SHA_MULTI_LANES], const unsigned char *const pp_blocks[SHA_MULTI_LANES] );
+
+#endif
+
+#if defined(SHA_MULTI) && defined(SHA_X86)
+
+/** !
+ * Compress a block of each of 8 messages into a transposed SHA-256 state
+ *
+ * @param state     the state, one column to a lane
+ * @param pp_blocks a 64 byte block for each lane
+ *
+ * @return void
+ */
+void sha256_multi_blocks_x8 ( unsigned int state[8][SHA_MULTI_LANES], const unsigned char *const pp_blocks[SHA_MULTI_LANES] );
+
+/** !
+ * Compress a block of each of 16 messages into a transposed SHA-256 state
+ *
+ * @param state     the state, one column to a lane
+ * @param pp_blocks a 64 byte block for each lane
+ *
+ * @return void
+ */
+void sha256_multi_blocks_x16 ( unsigned int state[8][SHA_MULTI_LANES], const unsigned char *const pp_blocks[SHA_MULTI_LANES] );
+
+/** !
+ * Compress a block of each of 4 messages into a transposed SHA-512 state
+ *
+ * @param state     the state, one column to a lane
+ * @param pp_blocks a 128 byte block for each lane
+ *
+ * @return void
+ */
+void sha512_multi_blocks_x4 ( unsigned long long state[8][SHA_MULTI_LANES], const unsigned char *const pp_blocks[SHA_MULTI_LANES] );
+
+/** !
+ * Compress a block of each of 8 messages into a transposed SHA-512 state
+ *
+ * @param state     the state, one column to a lane
+ * @param pp_blocks a 128 byte block for each lane
+ *
+ * @return void
+ */
+void sha512_multi_blocks_x8 ( unsigned long long state[8][SHA_MULTI_LANES], const unsigned char *const pp_blocks[SHA_MULTI_LANES] );
+
+#endif
+
+#ifdef SHA_ARM
+
+/** !
+ * Compress SHA-256 blocks with the ARMv8 SHA-2 instructions
+ *
+ * @param state  the state
+ * @param p_data the message
+ * @param blocks the quantity of 64 byte blocks
+ *
+ * @return void
+ */
+void sha256_blocks_arm ( unsigned int state[8], const unsigned char *p_data, size_t blocks );
+
+#endif
+
 // data
 static const unsigned int k[] =
 {
@@ -67,65 +358,719 @@ static const unsigned long long k512[] =
     0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
 };
 
-int sha256_transform ( sha256_state *p_sha256_state, const unsigned char *p_data )
+// the chosen single buffer kernels, null until the first block
+static fn_sha256_blocks *pfn_sha256_blocks = NULL;
+static fn_sha512_blocks *pfn_sha512_blocks = NULL;
+
+// the multi buffer kernels forced by sha_kernel_select
+static bool                    sha256_multi_forced = false,
+                               sha512_multi_forced = false;
+static fn_sha256_multi_blocks *pfn_sha256_multi    = NULL;
+static fn_sha512_multi_blocks *pfn_sha512_multi    = NULL;
+static size_t                  sha256_multi_lanes  = 0,
+                               sha512_multi_lanes  = 0;
+
+void sha256_blocks_scalar ( unsigned int state[8], const unsigned char *p_data, size_t blocks )
 {
 
-    // argument check
-    if ( NULL == p_sha256_state ) goto no_state;
-    if ( NULL ==         p_data ) goto no_data;
+    // each block
+    for (size_t n = 0; n < blocks; n++, p_data += 64)
+    {
+
+        // initialized data
+        unsigned int a = 0, b  = 0, c  = 0,
+                     d = 0, e  = 0, f  = 0,
+                     g = 0, h  = 0, i  = 0,
+                     j = 0,
+                     
+                     t1 = 0, t2 = 0; 
+        unsigned int m[64];
+
+        for 
+        (
+            i = 0, j = 0;
+            i < 16;
+            ++i, j += 4
+        )
+        {
+            m[i] = ( (unsigned int) p_data[j + 0] << 24 )
+                 | ( (unsigned int) p_data[j + 1] << 16 )
+                 | ( (unsigned int) p_data[j + 2] <<  8 )
+                 | ( (unsigned int) p_data[j + 3] <<  0 );
+        }
+
+        for
+        (
+            ;
+            i < 64;
+            ++i
+        )
+            m[i] = ((((m[i - 2]) >> (17)) | ((m[i - 2]) << (32 - (17)))) ^ (((m[i - 2]) >> (19)) | ((m[i - 2]) << (32 - (19)))) ^ ((m[i - 2]) >> 10)) + m[i - 7] + ((((m[i - 15]) >> (7)) | ((m[i - 15]) << (32 - (7)))) ^ (((m[i - 15]) >> (18)) | ((m[i - 15]) << (32 - (18)))) ^ ((m[i - 15]) >> 3)) + m[i - 16];
+
+        // initialize the state
+        a = state[0], b = state[1],
+        c = state[2], d = state[3],
+        e = state[4], f = state[5],
+        g = state[6], h = state[7];
+
+        // iterate through the data
+        for (i = 0; i < 64; ++i)
+            
+            // calculate the transformation
+            t1 = h + ((((e) >> (6)) | ((e) << (32 - (6)))) ^ (((e) >> (11)) | ((e) << (32 - (11)))) ^ (((e) >> (25)) | ((e) << (32 - (25))))) + (((e) & (f)) ^ (~(e) & (g))) + k[i] + m[i],
+            t2 = ((((a) >> (2)) | ((a) << (32 - (2)))) ^ (((a) >> (13)) | ((a) << (32 - (13)))) ^ (((a) >> (22)) | ((a) << (32 - (22))))) + (((a) & (b)) ^ ((a) & (c)) ^ ((b) & (c))),
+            
+            // update the state
+            h = g, g = f, f = e, e =  d + t1,
+            d = c, c = b, b = a, a = t1 + t2;
+
+        // update the state
+        state[0] += a, state[1] += b,
+        state[2] += c, state[3] += d,
+        state[4] += e, state[5] += f,
+        state[6] += g, state[7] += h;
+    }
+
+    // done
+    return;
+}
+
+void sha512_schedule_scalar ( unsigned long long m[80], const unsigned char *p_data )
+{
 
     // initialized data
-    unsigned int a = 0, b  = 0, c  = 0,
-                 d = 0, e  = 0, f  = 0,
-                 g = 0, h  = 0, i  = 0,
-                 j = 0,
-                 
-                 t1 = 0, t2 = 0; 
-    unsigned int m[64];
+    int i, j;
 
     for 
     (
         i = 0, j = 0;
         i < 16;
-        ++i, j += 4
+        ++i, j += 8
     )
     {
-        m[i] = ( p_data[j + 0] << 24 )
-             | ( p_data[j + 1] << 16 )
-             | ( p_data[j + 2] <<  8 )
-             | ( p_data[j + 3] <<  0 );
+        m[i] = ( (unsigned long long)p_data[j + 0] << 56 )
+             | ( (unsigned long long)p_data[j + 1] << 48 )
+             | ( (unsigned long long)p_data[j + 2] << 40 )
+             | ( (unsigned long long)p_data[j + 3] << 32 )
+             | ( (unsigned long long)p_data[j + 4] << 24 )
+             | ( (unsigned long long)p_data[j + 5] << 16 )
+             | ( (unsigned long long)p_data[j + 6] <<  8 )
+             | ( (unsigned long long)p_data[j + 7] <<  0 );
     }
 
     for
     (
         ;
-        i < 64;
+        i < 80;
         ++i
     )
-        m[i] = ((((m[i - 2]) >> (17)) | ((m[i - 2]) << (32 - (17)))) ^ (((m[i - 2]) >> (19)) | ((m[i - 2]) << (32 - (19)))) ^ ((m[i - 2]) >> 10)) + m[i - 7] + ((((m[i - 15]) >> (7)) | ((m[i - 15]) << (32 - (7)))) ^ (((m[i - 15]) >> (18)) | ((m[i - 15]) << (32 - (18)))) ^ ((m[i - 15]) >> 3)) + m[i - 16];
+        m[i] = ((((m[i - 2]) >> (19)) | ((m[i - 2]) << (64 - (19)))) ^ (((m[i - 2]) >> (61)) | ((m[i - 2]) << (64 - (61)))) ^ ((m[i - 2]) >> 6)) 
+             + m[i - 7] 
+             + ((((m[i - 15]) >> (1)) | ((m[i - 15]) << (64 - (1)))) ^ (((m[i - 15]) >> (8)) | ((m[i - 15]) << (64 - (8)))) ^ ((m[i - 15]) >> 7)) 
+             + m[i - 16];
 
-    // initialize the state
-    a = p_sha256_state->_state[0], b = p_sha256_state->_state[1],
-    c = p_sha256_state->_state[2], d = p_sha256_state->_state[3],
-    e = p_sha256_state->_state[4], f = p_sha256_state->_state[5],
-    g = p_sha256_state->_state[6], h = p_sha256_state->_state[7];
+    // add the round constants
+    for ( i = 0; i < 80; i++ ) m[i] += k512[i];
+
+    // done
+    return;
+}
+
+void sha512_blocks_schedule ( unsigned long long state[8], const unsigned char *p_data, size_t blocks, fn_sha512_schedule *pfn_schedule )
+{
+
+    // each block
+    for (size_t n = 0; n < blocks; n++, p_data += 128)
+    {
+
+        // initialized data
+        unsigned long long a = 0, b  = 0, c  = 0,
+                           d = 0, e  = 0, f  = 0,
+                           g = 0, h  = 0,
+                           t1 = 0, t2 = 0; 
+        unsigned long long m[80];
+
+        // expand the message, and add the round constants
+        pfn_schedule(m, p_data);
+
+        // initialize the state
+        a = state[0], b = state[1],
+        c = state[2], d = state[3],
+        e = state[4], f = state[5],
+        g = state[6], h = state[7];
+
+        // iterate through the data
+        for (int i = 0; i < 80; ++i)
+        {
+
+            // calculate the transformation
+            t1 = h + ((((e) >> (14)) | ((e) << (64 - (14)))) ^ (((e) >> (18)) | ((e) << (64 - (18)))) ^ (((e) >> (41)) | ((e) << (64 - (41))))) + (((e) & (f)) ^ (~(e) & (g))) + m[i],
+            
+            t2 = ((((a) >> (28)) | ((a) << (64 - (28)))) ^ (((a) >> (34)) | ((a) << (64 - (34)))) ^ (((a) >> (39)) | ((a) << (64 - (39))))) + (((a) & (b)) ^ ((a) & (c)) ^ ((b) & (c)));
+            
+            // update the state
+            h = g, g = f, f = e, e =  d + t1,
+            d = c, c = b, b = a, a = t1 + t2;
+        }
 
-    // iterate through the data
-    for (i = 0; i < 64; ++i)
-        
-        // calculate the transformation
-        t1 = h + ((((e) >> (6)) | ((e) << (32 - (6)))) ^ (((e) >> (11)) | ((e) << (32 - (11)))) ^ (((e) >> (25)) | ((e) << (32 - (25))))) + (((e) & (f)) ^ (~(e) & (g))) + k[i] + m[i],
-        t2 = ((((a) >> (2)) | ((a) << (32 - (2)))) ^ (((a) >> (13)) | ((a) << (32 - (13)))) ^ (((a) >> (22)) | ((a) << (32 - (22))))) + (((a) & (b)) ^ ((a) & (c)) ^ ((b) & (c))),
-        
         // update the state
-        h = g, g = f, f = e, e =  d + t1,
-        d = c, c = b, b = a, a = t1 + t2;
+        state[0] += a, state[1] += b,
+        state[2] += c, state[3] += d,
+        state[4] += e, state[5] += f,
+        state[6] += g, state[7] += h;
+    }
+
+    // done
+    return;
+}
+
+void sha512_blocks_scalar ( unsigned long long state[8], const unsigned char *p_data, size_t blocks )
+{
+
+    // expand the message a word at a time
+    sha512_blocks_schedule(state, p_data, blocks, sha512_schedule_scalar);
+
+    // done
+    return;
+}
+
+#ifdef SHA_X86
+
+// 4 rounds of SHA-256 with the Intel SHA extensions. m0 holds the message
+// words of group g, m1 the next group, and m3 the previous group
+#define SHA256_NI_ROUNDS(g, m0, m1, m2, m3)                                                 \
+    wk   = _mm_add_epi32(m0, _mm_loadu_si128((const __m128i *) &k[4 * (g)])),               \
+    cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk);                                           \
+    if ( (g) >= 3 && (g) <= 14 )                                                            \
+        m1 = _mm_sha256msg2_epu32(_mm_add_epi32(m1, _mm_alignr_epi8(m0, m3, 4)), m0);       \
+    wk   = _mm_shuffle_epi32(wk, 0x0e),                                                     \
+    abef = _mm_sha256rnds2_epu32(abef, cdgh, wk);                                           \
+    if ( (g) >= 1 && (g) <= 12 )                                                            \
+        m3 = _mm_sha256msg1_epu32(m3, m0);
+
+__attribute__((target("sha,sse4.1")))
+void sha256_blocks_sha_ni ( unsigned int state[8], const unsigned char *p_data, size_t blocks )
+{
+
+    // initialized data
+    const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i abef = _mm_loadu_si128((const __m128i *) &state[0]),
+            cdgh = _mm_loadu_si128((const __m128i *) &state[4]),
+            t    = _mm_shuffle_epi32(abef, 0xb1);
+
+    // the instructions keep the state as ABEF and CDGH
+    cdgh = _mm_shuffle_epi32(cdgh, 0x1b),
+    abef = _mm_alignr_epi8(t, cdgh, 8),
+    cdgh = _mm_blend_epi16(cdgh, t, 0xf0);
+
+    // each block
+    for (size_t n = 0; n < blocks; n++, p_data += 64)
+    {
+
+        // initialized data
+        __m128i abef_save = abef,
+                cdgh_save = cdgh,
+                m0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (p_data +  0)), byte_swap),
+                m1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (p_data + 16)), byte_swap),
+                m2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (p_data + 32)), byte_swap),
+                m3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (p_data + 48)), byte_swap),
+                wk;
+
+        // 64 rounds
+        SHA256_NI_ROUNDS( 0, m0, m1, m2, m3); SHA256_NI_ROUNDS( 1, m1, m2, m3, m0);
+        SHA256_NI_ROUNDS( 2, m2, m3, m0, m1); SHA256_NI_ROUNDS( 3, m3, m0, m1, m2);
+        SHA256_NI_ROUNDS( 4, m0, m1, m2, m3); SHA256_NI_ROUNDS( 5, m1, m2, m3, m0);
+        SHA256_NI_ROUNDS( 6, m2, m3, m0, m1); SHA256_NI_ROUNDS( 7, m3, m0, m1, m2);
+        SHA256_NI_ROUNDS( 8, m0, m1, m2, m3); SHA256_NI_ROUNDS( 9, m1, m2, m3, m0);
+        SHA256_NI_ROUNDS(10, m2, m3, m0, m1); SHA256_NI_ROUNDS(11, m3, m0, m1, m2);
+        SHA256_NI_ROUNDS(12, m0, m1, m2, m3); SHA256_NI_ROUNDS(13, m1, m2, m3, m0);
+        SHA256_NI_ROUNDS(14, m2, m3, m0, m1); SHA256_NI_ROUNDS(15, m3, m0, m1, m2);
+
+        // accumulate
+        abef = _mm_add_epi32(abef, abef_save),
+        cdgh = _mm_add_epi32(cdgh, cdgh_save);
+    }
+
+    // back to ABCD and EFGH
+    t    = _mm_shuffle_epi32(abef, 0x1b),
+    cdgh = _mm_shuffle_epi32(cdgh, 0xb1),
+    abef = _mm_blend_epi16(t, cdgh, 0xf0),
+    cdgh = _mm_alignr_epi8(cdgh, t, 8);
+
+    // store the state
+    _mm_storeu_si128((__m128i *) &state[0], abef);
+    _mm_storeu_si128((__m128i *) &state[4], cdgh);
+
+    // done
+    return;
+}
+
+#undef SHA256_NI_ROUNDS
+
+// rotate each 64 bit lane right
+#define SHA512_ROTATE(v, n) _mm_or_si128(_mm_srli_epi64(v, n), _mm_slli_epi64(v, 64 - (n)))
+
+// compute the next 2 words of the SHA-512 message schedule, into w[j]. the
+// window w[j..j+7] holds the last 16 words, 2 to a register
+#define SHA512_SCHEDULE(j)                                                                                 \
+{                                                                                                          \
+    __m128i w15 = _mm_alignr_epi8(w[((j) + 1) % 8], w[(j)], 8),                                            \
+            w7  = _mm_alignr_epi8(w[((j) + 5) % 8], w[((j) + 4) % 8], 8),                                  \
+            w2  = w[((j) + 7) % 8];                                                                        \
+    w[(j)] = _mm_add_epi64(_mm_add_epi64(w[(j)], w7),                                                      \
+             _mm_add_epi64(_mm_xor_si128(_mm_xor_si128(SHA512_ROTATE(w15,  1), SHA512_ROTATE(w15,  8)), _mm_srli_epi64(w15, 7)), \
+                           _mm_xor_si128(_mm_xor_si128(SHA512_ROTATE(w2 , 19), SHA512_ROTATE(w2 , 61)), _mm_srli_epi64(w2 , 6)))); \
+    _mm_storeu_si128((__m128i *) &m[i + 2 * (j)], _mm_add_epi64(w[(j)], _mm_loadu_si128((const __m128i *) &k512[i + 2 * (j)]))); \
+}
+
+__attribute__((target("avx2")))
+void sha512_schedule_avx2 ( unsigned long long m[80], const unsigned char *p_data )
+{
+
+    // initialized data
+    const __m128i byte_swap = _mm_set_epi64x(0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL);
+    __m128i w[8];
+    int i = 0;
+
+    // load the message, 2 words at a time
+    for ( int j = 0; j < 8; j++ )
+        w[j] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (p_data + 16 * j)), byte_swap),
+        _mm_storeu_si128((__m128i *) &m[2 * j], _mm_add_epi64(w[j], _mm_loadu_si128((const __m128i *) &k512[2 * j])));
+
+    // expand the message, 16 words at a time
+    for ( i = 16; i < 80; i += 16 )
+    {
+        SHA512_SCHEDULE(0); SHA512_SCHEDULE(1); SHA512_SCHEDULE(2); SHA512_SCHEDULE(3);
+        SHA512_SCHEDULE(4); SHA512_SCHEDULE(5); SHA512_SCHEDULE(6); SHA512_SCHEDULE(7);
+    }
+
+    // done
+    return;
+}
 
-    // update the state
-    p_sha256_state->_state[0] += a, p_sha256_state->_state[1] += b,
-    p_sha256_state->_state[2] += c, p_sha256_state->_state[3] += d,
-    p_sha256_state->_state[4] += e, p_sha256_state->_state[5] += f,
-    p_sha256_state->_state[6] += g, p_sha256_state->_state[7] += h;
+#undef SHA512_SCHEDULE
+#undef SHA512_ROTATE
+
+void sha512_blocks_avx2 ( unsigned long long state[8], const unsigned char *p_data, size_t blocks )
+{
+
+    // expand the message 2 words at a time
+    sha512_blocks_schedule(state, p_data, blocks, sha512_schedule_avx2);
+
+    // done
+    return;
+}
+
+#endif
+
+#ifdef SHA_ARM
+
+// 4 rounds of SHA-256 with the ARMv8 SHA-2 instructions. m0 holds the
+// message words of group g
+#define SHA256_ARM_ROUNDS(g, m0, m1, m2, m3)                      \
+    wk        = vaddq_u32(m0, vld1q_u32(&k[4 * (g)])),            \
+    abcd_prev = abcd;                                             \
+    if ( (g) < 12 ) m0 = vsha256su0q_u32(m0, m1);                 \
+    abcd = vsha256hq_u32(abcd, efgh, wk),                         \
+    efgh = vsha256h2q_u32(efgh, abcd_prev, wk);                   \
+    if ( (g) < 12 ) m0 = vsha256su1q_u32(m0, m2, m3);
+
+void sha256_blocks_arm ( unsigned int state[8], const unsigned char *p_data, size_t blocks )
+{
+
+    // initialized data
+    uint32x4_t abcd = vld1q_u32(&state[0]),
+               efgh = vld1q_u32(&state[4]);
+
+    // each block
+    for (size_t n = 0; n < blocks; n++, p_data += 64)
+    {
+
+        // initialized data
+        uint32x4_t abcd_save = abcd,
+                   efgh_save = efgh,
+                   m0 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(p_data +  0))),
+                   m1 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(p_data + 16))),
+                   m2 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(p_data + 32))),
+                   m3 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(p_data + 48))),
+                   wk, abcd_prev;
+
+        // 64 rounds
+        SHA256_ARM_ROUNDS( 0, m0, m1, m2, m3); SHA256_ARM_ROUNDS( 1, m1, m2, m3, m0);
+        SHA256_ARM_ROUNDS( 2, m2, m3, m0, m1); SHA256_ARM_ROUNDS( 3, m3, m0, m1, m2);
+        SHA256_ARM_ROUNDS( 4, m0, m1, m2, m3); SHA256_ARM_ROUNDS( 5, m1, m2, m3, m0);
+        SHA256_ARM_ROUNDS( 6, m2, m3, m0, m1); SHA256_ARM_ROUNDS( 7, m3, m0, m1, m2);
+        SHA256_ARM_ROUNDS( 8, m0, m1, m2, m3); SHA256_ARM_ROUNDS( 9, m1, m2, m3, m0);
+        SHA256_ARM_ROUNDS(10, m2, m3, m0, m1); SHA256_ARM_ROUNDS(11, m3, m0, m1, m2);
+        SHA256_ARM_ROUNDS(12, m0, m1, m2, m3); SHA256_ARM_ROUNDS(13, m1, m2, m3, m0);
+        SHA256_ARM_ROUNDS(14, m2, m3, m0, m1); SHA256_ARM_ROUNDS(15, m3, m0, m1, m2);
+
+        // accumulate
+        abcd = vaddq_u32(abcd, abcd_save),
+        efgh = vaddq_u32(efgh, efgh_save);
+    }
+
+    // store the state
+    vst1q_u32(&state[0], abcd);
+    vst1q_u32(&state[4], efgh);
+
+    // done
+    return;
+}
+
+#undef SHA256_ARM_ROUNDS
+
+#endif
+
+#ifdef SHA_MULTI
+
+// vector types
+typedef unsigned int       sha256_x4  __attribute__((vector_size(16)));
+typedef unsigned int       sha256_x8  __attribute__((vector_size(32)));
+typedef unsigned int       sha256_x16 __attribute__((vector_size(64)));
+typedef unsigned long long sha512_x4  __attribute__((vector_size(32)));
+typedef unsigned long long sha512_x8  __attribute__((vector_size(64)));
+
+// load big endian words
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    #define SHA_MULTI_BIG_ENDIAN_32(x) __builtin_bswap32(x)
+    #define SHA_MULTI_BIG_ENDIAN_64(x) __builtin_bswap64(x)
+#else
+    #define SHA_MULTI_BIG_ENDIAN_32(x) (x)
+    #define SHA_MULTI_BIG_ENDIAN_64(x) (x)
+#endif
+
+// rotate each lane right
+#define SHA_MULTI_ROTATE(x, n, bits) ( ( (x) >> (n) ) | ( (x) << ((bits) - (n)) ) )
+
+// compress a block of each of N messages, with vectors of type V
+#define SHA256_MULTI_KERNEL(V, N)                                                                              \
+{                                                                                                              \
+    V s[8], w[16], a, b, c, d, e, f, g, h, t1, t2;                                                             \
+                                                                                                               \
+    for ( int i = 0; i < 8; i++ ) __builtin_memcpy(&s[i], state[i], sizeof(V));                                \
+                                                                                                               \
+    for ( int i = 0; i < 16; i++ )                                                                             \
+        for ( int l = 0; l < (N); l++ )                                                                        \
+        {                                                                                                      \
+            unsigned int x = 0;                                                                                \
+            __builtin_memcpy(&x, pp_blocks[l] + 4 * i, sizeof(x));                                             \
+            w[i][l] = SHA_MULTI_BIG_ENDIAN_32(x);                                                              \
+        }                                                                                                      \
+                                                                                                               \
+    a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];                            \
+                                                                                                               \
+    for ( int i = 0; i < 64; i++ )                                                                             \
+    {                                                                                                          \
+        if ( i >= 16 )                                                                                         \
+            w[i & 15] += ( SHA_MULTI_ROTATE(w[(i - 2) & 15], 17, 32) ^ SHA_MULTI_ROTATE(w[(i - 2) & 15], 19, 32) ^ ( w[(i - 2) & 15] >> 10 ) ) \
+                       + w[(i - 7) & 15]                                                                       \
+                       + ( SHA_MULTI_ROTATE(w[(i - 15) & 15], 7, 32) ^ SHA_MULTI_ROTATE(w[(i - 15) & 15], 18, 32) ^ ( w[(i - 15) & 15] >> 3 ) ); \
+                                                                                                               \
+        t1 = h + ( SHA_MULTI_ROTATE(e, 6, 32) ^ SHA_MULTI_ROTATE(e, 11, 32) ^ SHA_MULTI_ROTATE(e, 25, 32) )    \
+               + ( ( e & f ) ^ ( ~e & g ) ) + k[i] + w[i & 15],                                                \
+        t2 = ( SHA_MULTI_ROTATE(a, 2, 32) ^ SHA_MULTI_ROTATE(a, 13, 32) ^ SHA_MULTI_ROTATE(a, 22, 32) )        \
+           + ( ( a & b ) ^ ( a & c ) ^ ( b & c ) ),                                                            \
+        h = g, g = f, f = e, e = d + t1,                                                                       \
+        d = c, c = b, b = a, a = t1 + t2;                                                                      \
+    }                                                                                                          \
+                                                                                                               \
+    s[0] += a, s[1] += b, s[2] += c, s[3] += d, s[4] += e, s[5] += f, s[6] += g, s[7] += h;                    \
+                                                                                                               \
+    for ( int i = 0; i < 8; i++ ) __builtin_memcpy(state[i], &s[i], sizeof(V));                                \
+}
+
+// compress a block of each of N messages, with vectors of type V
+#define SHA512_MULTI_KERNEL(V, N)                                                                              \
+{                                                                                                              \
+    V s[8], w[16], a, b, c, d, e, f, g, h, t1, t2;                                                             \
+                                                                                                               \
+    for ( int i = 0; i < 8; i++ ) __builtin_memcpy(&s[i], state[i], sizeof(V));                                \
+                                                                                                               \
+    for ( int i = 0; i < 16; i++ )                                                                             \
+        for ( int l = 0; l < (N); l++ )                                                                        \
+        {                                                                                                      \
+            unsigned long long x = 0;                                                                          \
+            __builtin_memcpy(&x, pp_blocks[l] + 8 * i, sizeof(x));                                             \
+            w[i][l] = SHA_MULTI_BIG_ENDIAN_64(x);                                                              \
+        }                                                                                                      \
+                                                                                                               \
+    a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];                            \
+                                                                                                               \
+    for ( int i = 0; i < 80; i++ )                                                                             \
+    {                                                                                                          \
+        if ( i >= 16 )                                                                                         \
+            w[i & 15] += ( SHA_MULTI_ROTATE(w[(i - 2) & 15], 19, 64) ^ SHA_MULTI_ROTATE(w[(i - 2) & 15], 61, 64) ^ ( w[(i - 2) & 15] >> 6 ) ) \
+                       + w[(i - 7) & 15]                                                                       \
+                       + ( SHA_MULTI_ROTATE(w[(i - 15) & 15], 1, 64) ^ SHA_MULTI_ROTATE(w[(i - 15) & 15], 8, 64) ^ ( w[(i - 15) & 15] >> 7 ) ); \
+                                                                                                               \
+        t1 = h + ( SHA_MULTI_ROTATE(e, 14, 64) ^ SHA_MULTI_ROTATE(e, 18, 64) ^ SHA_MULTI_ROTATE(e, 41, 64) )   \
+               + ( ( e & f ) ^ ( ~e & g ) ) + k512[i] + w[i & 15],                                             \
+        t2 = ( SHA_MULTI_ROTATE(a, 28, 64) ^ SHA_MULTI_ROTATE(a, 34, 64) ^ SHA_MULTI_ROTATE(a, 39, 64) )       \
+           + ( ( a & b ) ^ ( a & c ) ^ ( b & c ) ),                                                            \
+        h = g, g = f, f = e, e = d + t1,                                                                       \
+        d = c, c = b, b = a, a = t1 + t2;                                                                      \
+    }                                                                                                          \
+                                                                                                               \
+    s[0] += a, s[1] += b, s[2] += c, s[3] += d, s[4] += e, s[5] += f, s[6] += g, s[7] += h;                    \
+                                                                                                               \
+    for ( int i = 0; i < 8; i++ ) __builtin_memcpy(state[i], &s[i], sizeof(V));                                \
+}
+
+void sha256_multi_blocks_x4 ( unsigned int state[8][SHA_MULTI_LANES], const unsigned char *const pp_blocks[SHA_MULTI_LANES] )
+SHA256_MULTI_KERNEL(sha256_x4, 4)
+
+#ifdef SHA_X86
+
+__attribute__((target("avx2")))
+void sha256_multi_blocks_x8 ( unsigned int state[8][SHA_MULTI_LANES], const unsigned char *const pp_blocks[SHA_MULTI_LANES] )
+SHA256_MULTI_KERNEL(sha256_x8, 8)
+
+__attribute__((target("avx512f")))
+void sha256_multi_blocks_x16 ( unsigned int state[8][SHA_MULTI_LANES], const unsigned char *const pp_blocks[SHA_MULTI_LANES] )
+SHA256_MULTI_KERNEL(sha256_x16, 16)
+
+__attribute__((target("avx2")))
+void sha512_multi_blocks_x4 ( unsigned long long state[8][SHA_MULTI_LANES], const unsigned char *const pp_blocks[SHA_MULTI_LANES] )
+SHA512_MULTI_KERNEL(sha512_x4, 4)
+
+__attribute__((target("avx512f")))
+void sha512_multi_blocks_x8 ( unsigned long long state[8][SHA_MULTI_LANES], const unsigned char *const pp_blocks[SHA_MULTI_LANES] )
+SHA512_MULTI_KERNEL(sha512_x8, 8)
+
+#endif
+
+#undef SHA256_MULTI_KERNEL
+#undef SHA512_MULTI_KERNEL
+#undef SHA_MULTI_ROTATE
+#undef SHA_MULTI_BIG_ENDIAN_32
+#undef SHA_MULTI_BIG_ENDIAN_64
+
+#endif
+
+fn_sha256_blocks *sha256_blocks_select ( void )
+{
+
+    // platform dependent implementation
+    #if defined(SHA_ARM)
+
+        // the compiler was told the CPU has the SHA-2 instructions
+        return sha256_blocks_arm;
+    #elif defined(SHA_X86)
+
+        // detect CPU features
+        __builtin_cpu_init();
+
+        // Intel SHA extensions
+        if ( __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1") ) return sha256_blocks_sha_ni;
+    #endif
+
+    // portable
+    return sha256_blocks_scalar;
+}
+
+fn_sha512_blocks *sha512_blocks_select ( void )
+{
+
+    // platform dependent implementation
+    #ifdef SHA_X86
+
+        // detect CPU features
+        __builtin_cpu_init();
+
+        // vectorized message schedule
+        if ( __builtin_cpu_supports("avx2") ) return sha512_blocks_avx2;
+    #endif
+
+    // portable
+    return sha512_blocks_scalar;
+}
+
+fn_sha256_multi_blocks *sha256_multi_select ( size_t *p_lanes )
+{
+
+    // forced kernel
+    if ( sha256_multi_forced ) return *p_lanes = sha256_multi_lanes, pfn_sha256_multi;
+
+    // platform dependent implementation
+    #if defined(SHA_MULTI) && defined(SHA_X86)
+
+        // detect CPU features
+        __builtin_cpu_init();
+
+        // 16 lanes
+        if ( __builtin_cpu_supports("avx512f") ) return *p_lanes = 16, sha256_multi_blocks_x16;
+
+        // 8 lanes
+        if ( __builtin_cpu_supports("avx2") ) return *p_lanes = 8, sha256_multi_blocks_x8;
+
+        // the SHA extensions beat 4 lanes
+        if ( __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1") ) return NULL;
+
+        // 4 lanes
+        return *p_lanes = 4, sha256_multi_blocks_x4;
+    #elif defined(SHA_MULTI) && !defined(SHA_ARM)
+
+        // 4 lanes
+        return *p_lanes = 4, sha256_multi_blocks_x4;
+    #else
+
+        // one message at a time
+        return (void) p_lanes, NULL;
+    #endif
+}
+
+fn_sha512_multi_blocks *sha512_multi_select ( size_t *p_lanes )
+{
+
+    // forced kernel
+    if ( sha512_multi_forced ) return *p_lanes = sha512_multi_lanes, pfn_sha512_multi;
+
+    // platform dependent implementation
+    #if defined(SHA_MULTI) && defined(SHA_X86)
+
+        // detect CPU features
+        __builtin_cpu_init();
+
+        // 8 lanes
+        if ( __builtin_cpu_supports("avx512f") ) return *p_lanes = 8, sha512_multi_blocks_x8;
+
+        // 4 lanes
+        if ( __builtin_cpu_supports("avx2") ) return *p_lanes = 4, sha512_multi_blocks_x4;
+    #endif
+
+    // one message at a time
+    return (void) p_lanes, NULL;
+}
+
+void sha256_blocks ( unsigned int state[8], const unsigned char *p_data, size_t blocks )
+{
+
+    // initialized data
+    fn_sha256_blocks *pfn = __atomic_load_n(&pfn_sha256_blocks, __ATOMIC_RELAXED);
+
+    // choose a kernel, once
+    if ( NULL == pfn )
+        pfn = sha256_blocks_select(),
+        __atomic_store_n(&pfn_sha256_blocks, pfn, __ATOMIC_RELAXED);
+
+    // compress
+    pfn(state, p_data, blocks);
+
+    // done
+    return;
+}
+
+void sha512_blocks ( unsigned long long state[8], const unsigned char *p_data, size_t blocks )
+{
+
+    // initialized data
+    fn_sha512_blocks *pfn = __atomic_load_n(&pfn_sha512_blocks, __ATOMIC_RELAXED);
+
+    // choose a kernel, once
+    if ( NULL == pfn )
+        pfn = sha512_blocks_select(),
+        __atomic_store_n(&pfn_sha512_blocks, pfn, __ATOMIC_RELAXED);
+
+    // compress
+    pfn(state, p_data, blocks);
+
+    // done
+    return;
+}
+
+int sha_kernel_select ( const char *p_kernel )
+{
+
+    // initialized data
+    fn_sha256_blocks       *pfn_256       = sha256_blocks_scalar;
+    fn_sha512_blocks       *pfn_512       = sha512_blocks_scalar;
+    fn_sha256_multi_blocks *pfn_256_multi = NULL;
+    fn_sha512_multi_blocks *pfn_512_multi = NULL;
+    size_t                  lanes         = 0;
+
+    // choose the fastest kernels again
+    if ( NULL == p_kernel )
+    {
+
+        // forget every choice
+        __atomic_store_n(&pfn_sha256_blocks, NULL, __ATOMIC_RELAXED),
+        __atomic_store_n(&pfn_sha512_blocks, NULL, __ATOMIC_RELAXED);
+        sha256_multi_forced = false,
+        sha512_multi_forced = false;
+
+        // success
+        return 1;
+    }
+
+    // detect CPU features
+    #ifdef SHA_X86
+        __builtin_cpu_init();
+    #endif
+
+    // SHA-256 single buffer kernels
+    if ( 0 == strcmp(p_kernel, "sha256_portable") ) goto sha256;
+    #ifdef SHA_X86
+        if ( 0 == strcmp(p_kernel, "sha256_sha_ni") && __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1") ) { pfn_256 = sha256_blocks_sha_ni; goto sha256; }
+    #endif
+    #ifdef SHA_ARM
+        if ( 0 == strcmp(p_kernel, "sha256_arm") ) { pfn_256 = sha256_blocks_arm; goto sha256; }
+    #endif
+
+    // SHA-256 multi buffer kernels
+    #ifdef SHA_MULTI
+        if ( 0 == strcmp(p_kernel, "sha256_x4") ) { pfn_256_multi = sha256_multi_blocks_x4, lanes = 4; goto sha256; }
+    #endif
+    #if defined(SHA_MULTI) && defined(SHA_X86)
+        if ( 0 == strcmp(p_kernel, "sha256_x8" ) && __builtin_cpu_supports("avx2"   ) ) { pfn_256_multi = sha256_multi_blocks_x8 , lanes = 8 ; goto sha256; }
+        if ( 0 == strcmp(p_kernel, "sha256_x16") && __builtin_cpu_supports("avx512f") ) { pfn_256_multi = sha256_multi_blocks_x16, lanes = 16; goto sha256; }
+    #endif
+
+    // SHA-512 single buffer kernels
+    if ( 0 == strcmp(p_kernel, "sha512_portable") ) goto sha512;
+    #ifdef SHA_X86
+        if ( 0 == strcmp(p_kernel, "sha512_avx2") && __builtin_cpu_supports("avx2") ) { pfn_512 = sha512_blocks_avx2; goto sha512; }
+    #endif
+
+    // SHA-512 multi buffer kernels
+    #if defined(SHA_MULTI) && defined(SHA_X86)
+        if ( 0 == strcmp(p_kernel, "sha512_x4") && __builtin_cpu_supports("avx2"   ) ) { pfn_512_multi = sha512_multi_blocks_x4, lanes = 4; goto sha512; }
+        if ( 0 == strcmp(p_kernel, "sha512_x8") && __builtin_cpu_supports("avx512f") ) { pfn_512_multi = sha512_multi_blocks_x8, lanes = 8; goto sha512; }
+    #endif
+
+    // not compiled in, or not supported by this CPU
+    return 0;
+
+    // force the SHA-256 kernels
+    sha256:
+        __atomic_store_n(&pfn_sha256_blocks, pfn_256, __ATOMIC_RELAXED);
+        pfn_sha256_multi    = pfn_256_multi,
+        sha256_multi_lanes  = lanes,
+        sha256_multi_forced = true;
+
+        // success
+        return 1;
+
+    // force the SHA-512 kernels
+    sha512:
+        __atomic_store_n(&pfn_sha512_blocks, pfn_512, __ATOMIC_RELAXED);
+        pfn_sha512_multi    = pfn_512_multi,
+        sha512_multi_lanes  = lanes,
+        sha512_multi_forced = true;
+
+        // success
+        return 1;
+}
+
+int sha256_transform ( sha256_state *p_sha256_state, const unsigned char *p_data )
+{
+
+    // argument check
+    if ( NULL == p_sha256_state ) goto no_state;
+    if ( NULL ==         p_data ) goto no_data;
+
+    // compress the block
+    sha256_blocks(p_sha256_state->_state, p_data, 1);
 
     // success
     return 1;
@@ -161,67 +1106,8 @@ int sha512_transform ( sha512_state *p_sha512_state, const unsigned char *p_data
     if ( NULL == p_sha512_state ) goto no_state;
     if ( NULL ==         p_data ) goto no_data;
 
-    // initialized data
-    unsigned long long a = 0, b  = 0, c  = 0,
-                       d = 0, e  = 0, f  = 0,
-                       g = 0, h  = 0,
-                       t1 = 0, t2 = 0; 
-    unsigned long long m[80];
-    int i, j;
-
-    for 
-    (
-        i = 0, j = 0;
-        i < 16;
-        ++i, j += 8
-    )
-    {
-        m[i] = ( (unsigned long long)p_data[j + 0] << 56 )
-             | ( (unsigned long long)p_data[j + 1] << 48 )
-             | ( (unsigned long long)p_data[j + 2] << 40 )
-             | ( (unsigned long long)p_data[j + 3] << 32 )
-             | ( (unsigned long long)p_data[j + 4] << 24 )
-             | ( (unsigned long long)p_data[j + 5] << 16 )
-             | ( (unsigned long long)p_data[j + 6] <<  8 )
-             | ( (unsigned long long)p_data[j + 7] <<  0 );
-    }
-
-    for
-    (
-        ;
-        i < 80;
-        ++i
-    )
-        m[i] = ((((m[i - 2]) >> (19)) | ((m[i - 2]) << (64 - (19)))) ^ (((m[i - 2]) >> (61)) | ((m[i - 2]) << (64 - (61)))) ^ ((m[i - 2]) >> 6)) 
-             + m[i - 7] 
-             + ((((m[i - 15]) >> (1)) | ((m[i - 15]) << (64 - (1)))) ^ (((m[i - 15]) >> (8)) | ((m[i - 15]) << (64 - (8)))) ^ ((m[i - 15]) >> 7)) 
-             + m[i - 16];
-
-    // initialize the state
-    a = p_sha512_state->_state[0], b = p_sha512_state->_state[1],
-    c = p_sha512_state->_state[2], d = p_sha512_state->_state[3],
-    e = p_sha512_state->_state[4], f = p_sha512_state->_state[5],
-    g = p_sha512_state->_state[6], h = p_sha512_state->_state[7];
-
-    // iterate through the data
-    for (i = 0; i < 80; ++i)
-    {
-
-        // calculate the transformation
-        t1 = h + ((((e) >> (14)) | ((e) << (64 - (14)))) ^ (((e) >> (18)) | ((e) << (64 - (18)))) ^ (((e) >> (41)) | ((e) << (64 - (41))))) + (((e) & (f)) ^ (~(e) & (g))) + k512[i] + m[i],
-        
-        t2 = ((((a) >> (28)) | ((a) << (64 - (28)))) ^ (((a) >> (34)) | ((a) << (64 - (34)))) ^ (((a) >> (39)) | ((a) << (64 - (39))))) + (((a) & (b)) ^ ((a) & (c)) ^ ((b) & (c)));
-        
-        // update the state
-        h = g, g = f, f = e, e =  d + t1,
-        d = c, c = b, b = a, a = t1 + t2;
-    }
-
-    // update the state
-    p_sha512_state->_state[0] += a, p_sha512_state->_state[1] += b,
-    p_sha512_state->_state[2] += c, p_sha512_state->_state[3] += d,
-    p_sha512_state->_state[4] += e, p_sha512_state->_state[5] += f,
-    p_sha512_state->_state[6] += g, p_sha512_state->_state[7] += h;
+    // compress the block
+    sha512_blocks(p_sha512_state->_state, p_data, 1);
 
     // success
     return 1;
@@ -338,25 +1224,55 @@ int sha256_update ( sha256_state *p_sha256_state, const unsigned char *data, siz
     if ( NULL ==           data ) goto no_data;
     if ( 0    ==           len  ) goto no_length;
 
-    // iterate through the data
-    for (size_t i = 0; i < len; ++i)
+    // fill the partial block
+    if ( p_sha256_state->datalen )
     {
 
-        // store a byte
-        p_sha256_state->_data[p_sha256_state->datalen] = data[i],
-        p_sha256_state->datalen++;
+        // initialized data
+        size_t n = 64 - p_sha256_state->datalen;
+
+        // clamp
+        if ( n > len ) n = len;
+
+        // store the bytes
+        memcpy(&p_sha256_state->_data[p_sha256_state->datalen], data, n);
+
+        // update the counters
+        p_sha256_state->datalen += n,
+        data += n,
+        len  -= n;
 
         // keep reading until there are 64 bytes
-        if ( 64 != p_sha256_state->datalen ) continue;
-        
+        if ( 64 != p_sha256_state->datalen ) return 1;
+
         // transform the data
-        sha256_transform(p_sha256_state, p_sha256_state->_data);
+        sha256_blocks(p_sha256_state->_state, p_sha256_state->_data, 1);
 
         // update the counters
         p_sha256_state->bitlen += 512,
         p_sha256_state->datalen = 0;
     }
 
+    // transform whole blocks in place
+    if ( len >= 64 )
+    {
+
+        // initialized data
+        size_t blocks = len / 64;
+
+        // transform the data
+        sha256_blocks(p_sha256_state->_state, data, blocks);
+
+        // update the counters
+        p_sha256_state->bitlen += 512 * blocks,
+        data += 64 * blocks,
+        len  -= 64 * blocks;
+    }
+
+    // store the rest
+    memcpy(p_sha256_state->_data, data, len),
+    p_sha256_state->datalen = len;
+
     // success
     return 1;
 
@@ -400,25 +1316,55 @@ int sha512_update ( sha512_state *p_sha512_state, const unsigned char *data, siz
     if ( NULL ==           data ) goto no_data;
     if ( 0    ==           len  ) goto no_length;
 
-    // iterate through the data
-    for (size_t i = 0; i < len; ++i)
+    // fill the partial block
+    if ( p_sha512_state->datalen )
     {
 
-        // store a byte
-        p_sha512_state->_data[p_sha512_state->datalen] = data[i],
-        p_sha512_state->datalen++;
+        // initialized data
+        size_t n = 128 - p_sha512_state->datalen;
+
+        // clamp
+        if ( n > len ) n = len;
+
+        // store the bytes
+        memcpy(&p_sha512_state->_data[p_sha512_state->datalen], data, n);
+
+        // update the counters
+        p_sha512_state->datalen += n,
+        data += n,
+        len  -= n;
 
         // keep reading until there are 128 bytes
-        if ( 128 != p_sha512_state->datalen ) continue;
-        
+        if ( 128 != p_sha512_state->datalen ) return 1;
+
         // transform the data
-        sha512_transform(p_sha512_state, p_sha512_state->_data);
+        sha512_blocks(p_sha512_state->_state, p_sha512_state->_data, 1);
 
         // update the counters
         p_sha512_state->bitlen += 1024,
         p_sha512_state->datalen = 0;
     }
 
+    // transform whole blocks in place
+    if ( len >= 128 )
+    {
+
+        // initialized data
+        size_t blocks = len / 128;
+
+        // transform the data
+        sha512_blocks(p_sha512_state->_state, data, blocks);
+
+        // update the counters
+        p_sha512_state->bitlen += 1024 * blocks,
+        data += 128 * blocks,
+        len  -= 128 * blocks;
+    }
+
+    // store the rest
+    memcpy(p_sha512_state->_data, data, len),
+    p_sha512_state->datalen = len;
+
     // success
     return 1;
 
@@ -597,6 +1543,334 @@ int sha512_final ( sha512_state *p_sha512_state, unsigned char *hash)
     }
 }
 
+int sha256_multi ( sha256_hash *p_hashes, const unsigned char *const *pp_data, const size_t *p_lengths, size_t quantity )
+{
+
+    // argument check
+    if ( NULL == p_hashes  ) goto no_hashes;
+    if ( NULL == pp_data   ) goto no_data;
+    if ( NULL == p_lengths ) goto no_lengths;
+
+    // static data
+    static const unsigned char zero[64] = { 0 };
+    static const unsigned int iv[8] =
+    {
+        0x6a09e667, 0xbb67ae85,
+        0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c,
+        0x1f83d9ab, 0x5be0cd19
+    };
+
+    // initialized data
+    size_t lanes = 0, next = 0, busy = 0;
+    fn_sha256_multi_blocks *pfn_blocks = sha256_multi_select(&lanes);
+    unsigned int state[8][SHA_MULTI_LANES] = { 0 };
+    const unsigned char *p_blocks[SHA_MULTI_LANES] = { 0 };
+    struct sha_multi_lane_s _lanes[SHA_MULTI_LANES] = { 0 };
+
+    // one message at a time
+    if ( NULL == pfn_blocks )
+    {
+
+        // each message
+        for (size_t i = 0; i < quantity; i++)
+        {
+
+            // initialized data
+            sha256_state _sha256_state;
+
+            // hash the message
+            sha256_construct(&_sha256_state);
+            if ( p_lengths[i] ) sha256_update(&_sha256_state, pp_data[i], p_lengths[i]);
+            sha256_final(&_sha256_state, p_hashes[i]);
+        }
+
+        // success
+        return 1;
+    }
+
+    // until every message is hashed
+    while ( next < quantity || busy )
+    {
+
+        // choose a block for each lane
+        for (size_t l = 0; l < lanes; l++)
+        {
+
+            // initialized data
+            struct sha_multi_lane_s *p_lane = &_lanes[l];
+
+            // load the next message into an idle lane
+            if ( false == p_lane->active && next < quantity )
+            {
+
+                // initialized data
+                size_t len = p_lengths[next],
+                       rem = len % 64;
+
+                // populate the lane
+                p_lane->message = next++,
+                p_lane->offset  = 0,
+                p_lane->full    = len / 64,
+                p_lane->tail    = ( rem < 56 ) ? 1 : 2,
+                p_lane->active  = true,
+                busy++;
+
+                // pad the last bytes of the message
+                memset(p_lane->_tail, 0, sizeof(p_lane->_tail));
+                if ( rem ) memcpy(p_lane->_tail, pp_data[p_lane->message] + len - rem, rem);
+                p_lane->_tail[rem] = 0x80;
+
+                // append the length, in bits
+                for (int j = 0; j < 8; j++)
+                    p_lane->_tail[64 * p_lane->tail - 1 - j] = ( ( (unsigned long long) len << 3 ) >> ( 8 * j ) ) & 0xff;
+
+                // reset the state of the lane
+                for (int j = 0; j < 8; j++) state[j][l] = iv[j];
+            }
+
+            // idle lanes hash zeros
+            p_blocks[l] = ( false == p_lane->active ) ? zero
+                        : ( p_lane->full            ) ? pp_data[p_lane->message] + p_lane->offset
+                        :                               p_lane->_tail + p_lane->offset;
+        }
+
+        // transform the data
+        pfn_blocks(state, p_blocks);
+
+        // advance each lane
+        for (size_t l = 0; l < lanes; l++)
+        {
+
+            // initialized data
+            struct sha_multi_lane_s *p_lane = &_lanes[l];
+
+            // skip idle lanes
+            if ( false == p_lane->active ) continue;
+
+            // next block
+            p_lane->offset += 64;
+
+            // whole blocks of the message come first
+            if ( p_lane->full )
+            {
+                if ( 0 == --p_lane->full ) p_lane->offset = 0;
+                continue;
+            }
+
+            // keep going until the padding is done
+            if ( 0 != --p_lane->tail ) continue;
+
+            // store the hash
+            for (int j = 0; j < 8; j++)
+                for (int b = 0; b < 4; b++)
+                    p_hashes[p_lane->message][j * 4 + b] = ( state[j][l] >> ( 24 - b * 8 ) ) & 0xff;
+
+            // the lane is idle
+            p_lane->active = false,
+            busy--;
+        }
+    }
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_hashes:
+                #ifndef NDEBUG
+                    log_error("[sha] Null pointer provided for parameter \"p_hashes\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_data:
+                #ifndef NDEBUG
+                    log_error("[sha] Null pointer provided for parameter \"pp_data\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_lengths:
+                #ifndef NDEBUG
+                    log_error("[sha] Null pointer provided for parameter \"p_lengths\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int sha512_multi ( sha512_hash *p_hashes, const unsigned char *const *pp_data, const size_t *p_lengths, size_t quantity )
+{
+
+    // argument check
+    if ( NULL == p_hashes  ) goto no_hashes;
+    if ( NULL == pp_data   ) goto no_data;
+    if ( NULL == p_lengths ) goto no_lengths;
+
+    // static data
+    static const unsigned char zero[128] = { 0 };
+    static const unsigned long long iv[8] =
+    {
+        0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL,
+        0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+        0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
+        0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+    };
+
+    // initialized data
+    size_t lanes = 0, next = 0, busy = 0;
+    fn_sha512_multi_blocks *pfn_blocks = sha512_multi_select(&lanes);
+    unsigned long long state[8][SHA_MULTI_LANES] = { 0 };
+    const unsigned char *p_blocks[SHA_MULTI_LANES] = { 0 };
+    struct sha_multi_lane_s _lanes[SHA_MULTI_LANES] = { 0 };
+
+    // one message at a time
+    if ( NULL == pfn_blocks )
+    {
+
+        // each message
+        for (size_t i = 0; i < quantity; i++)
+        {
+
+            // initialized data
+            sha512_state _sha512_state;
+
+            // hash the message
+            sha512_construct(&_sha512_state);
+            if ( p_lengths[i] ) sha512_update(&_sha512_state, pp_data[i], p_lengths[i]);
+            sha512_final(&_sha512_state, p_hashes[i]);
+        }
+
+        // success
+        return 1;
+    }
+
+    // until every message is hashed
+    while ( next < quantity || busy )
+    {
+
+        // choose a block for each lane
+        for (size_t l = 0; l < lanes; l++)
+        {
+
+            // initialized data
+            struct sha_multi_lane_s *p_lane = &_lanes[l];
+
+            // load the next message into an idle lane
+            if ( false == p_lane->active && next < quantity )
+            {
+
+                // initialized data
+                size_t len = p_lengths[next],
+                       rem = len % 128;
+
+                // populate the lane
+                p_lane->message = next++,
+                p_lane->offset  = 0,
+                p_lane->full    = len / 128,
+                p_lane->tail    = ( rem < 112 ) ? 1 : 2,
+                p_lane->active  = true,
+                busy++;
+
+                // pad the last bytes of the message
+                memset(p_lane->_tail, 0, sizeof(p_lane->_tail));
+                if ( rem ) memcpy(p_lane->_tail, pp_data[p_lane->message] + len - rem, rem);
+                p_lane->_tail[rem] = 0x80;
+
+                // append the length, in bits
+                for (int j = 0; j < 8; j++)
+                    p_lane->_tail[128 * p_lane->tail - 1 - j] = ( ( (unsigned long long) len << 3 ) >> ( 8 * j ) ) & 0xff;
+
+                // reset the state of the lane
+                for (int j = 0; j < 8; j++) state[j][l] = iv[j];
+            }
+
+            // idle lanes hash zeros
+            p_blocks[l] = ( false == p_lane->active ) ? zero
+                        : ( p_lane->full            ) ? pp_data[p_lane->message] + p_lane->offset
+                        :                               p_lane->_tail + p_lane->offset;
+        }
+
+        // transform the data
+        pfn_blocks(state, p_blocks);
+
+        // advance each lane
+        for (size_t l = 0; l < lanes; l++)
+        {
+
+            // initialized data
+            struct sha_multi_lane_s *p_lane = &_lanes[l];
+
+            // skip idle lanes
+            if ( false == p_lane->active ) continue;
+
+            // next block
+            p_lane->offset += 128;
+
+            // whole blocks of the message come first
+            if ( p_lane->full )
+            {
+                if ( 0 == --p_lane->full ) p_lane->offset = 0;
+                continue;
+            }
+
+            // keep going until the padding is done
+            if ( 0 != --p_lane->tail ) continue;
+
+            // store the hash
+            for (int j = 0; j < 8; j++)
+                for (int b = 0; b < 8; b++)
+                    p_hashes[p_lane->message][j * 8 + b] = ( state[j][l] >> ( 56 - b * 8 ) ) & 0xff;
+
+            // the lane is idle
+            p_lane->active = false,
+            busy--;
+        }
+    }
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_hashes:
+                #ifndef NDEBUG
+                    log_error("[sha] Null pointer provided for parameter \"p_hashes\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_data:
+                #ifndef NDEBUG
+                    log_error("[sha] Null pointer provided for parameter \"pp_data\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_lengths:
+                #ifndef NDEBUG
+                    log_error("[sha] Null pointer provided for parameter \"p_lengths\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
 hash64 sha256_hash64 ( const void *const k, unsigned long long l )
 {
 
@@ -114,6 +114,50 @@ int sha256_final ( sha256_state *p_sha256_state, unsigned char *hash );
  */
 int sha512_final ( sha512_state *p_sha512_state, unsigned char *hash );
 
+/// multi
+/** !
+ * Hash many independent messages at once, one message to a SIMD lane.
+ * Faster than sha256_update for many short messages.
+ * 
+ * @param p_hashes  result, an array of quantity hashes
+ * @param pp_data   an array of quantity messages
+ * @param p_lengths an array of quantity message lengths. a message may be empty
+ * @param quantity  the quantity of messages
+ * 
+ * @return 1 on success, 0 on error
+ */
+int sha256_multi ( sha256_hash *p_hashes, const unsigned char *const *pp_data, const size_t *p_lengths, size_t quantity );
+
+/** !
+ * Hash many independent messages at once, one message to a SIMD lane.
+ * Faster than sha512_update for many short messages.
+ * 
+ * @param p_hashes  result, an array of quantity hashes
+ * @param pp_data   an array of quantity messages
+ * @param p_lengths an array of quantity message lengths. a message may be empty
+ * @param quantity  the quantity of messages
+ * 
+ * @return 1 on success, 0 on error
+ */
+int sha512_multi ( sha512_hash *p_hashes, const unsigned char *const *pp_data, const size_t *p_lengths, size_t quantity );
+
+/// kernels
+/** !
+ * Force one kernel, so a caller can compare every compiled kernel with
+ * the portable kernel, or benchmark one. Every other kernel of the same
+ * hash falls back to portable C; forcing a single buffer kernel makes the
+ * multi buffer API hash one message at a time. Not thread safe, so select
+ * kernels before hashing on other threads.
+ *
+ * @param p_kernel one of "sha256_portable", "sha256_sha_ni", "sha256_arm",
+ *                 "sha256_x4", "sha256_x8", "sha256_x16", "sha512_portable",
+ *                 "sha512_avx2", "sha512_x4", "sha512_x8", or null to choose
+ *                 the fastest kernels again
+ *
+ * @return 1 on success, 0 IF the kernel is not compiled in OR this CPU can not run it
+ */
+int sha_kernel_select ( const char *p_kernel );
+
 /// log
 /** !
  * Print a SHA256 hash to standard output
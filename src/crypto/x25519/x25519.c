@@ -9,46 +9,10 @@
 // header file
 #include <crypto/x25519.h>
 
-// type definitions
-typedef unsigned _BitInt(256) i256;
-typedef unsigned _BitInt(512) i512;
-
 // constant data
-static const i256 Q   = 0x7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEDWB;
-static const i256 A24 = 121665WB;
+static const unsigned int A24 = 121665;
 
 // function declarations
-/** !
- * Modular exponentiation by squaring
- * 
- * @param b the base
- * @param e the exponent
- * @param m the modulus
- * 
- * @return (b ^ e) mod m 
- */
-i256 expmod ( i256 b, i256 e, i256 m );
-
-/** !
- * Modular inverse 
- * 
- * @param x the number
- * 
- * @return the modular inverse of x mod 2^255-19
- */
-i256 inv ( i256 x );
-
-/** !
- * Conditional swap
- * 
- * @param b swap if b is 1
- * @param x first value
- * @param y second value
- * 
- * @return void
- */
-void cswap ( int b, i256 *x, i256 *y );
-
 /** !
  * Montgomery ladder for X25519
  * 
@@ -61,75 +25,23 @@ void cswap ( int b, i256 *x, i256 *y );
 void x25519_ladder ( const unsigned char *k, const unsigned char *u, unsigned char *out );
 
 // function definitions
-i256 add_mod ( i256 a, i256 b, i256 m ) { return (a + b) % m; }
-i256 sub_mod ( i256 a, i256 b, i256 m ) { return (a - b + m) % m; }
-i256 mul_mod ( i256 a, i256 b, i256 m ) { return (i256)(((i512)a * (i512)b) % (i512)m); }
-i256 sqr_mod ( i256 a, i256 m )         { return mul_mod(a, a, m); }
-i256 inv     ( i256 x )                 { return expmod(x, Q - 2, Q); }
-
-i256 expmod ( i256 b, i256 e, i256 m )
-{
-
-    // initialized data
-    i256 t = 1;
-
-    // process the exponent
-    while ( e > 0 )
-    {
-
-        // odd exponent 
-        if ( e % 2 == 1 ) t = mul_mod(t, b, m);
-
-        // square
-        b = sqr_mod(b, m);
-
-        // shift
-        e /= 2;
-    }
-    
-    // done
-    return t;
-}
-
-void cswap ( int b, i256 *x, i256 *y )
-{
-
-    // initialized data
-    i256 mask = (i256)(-(unsigned _BitInt(256))b); 
-    i256 diff = (*x ^ *y) & mask;
-
-    // swap
-    *x ^= diff;
-    *y ^= diff;
-}
-
 void x25519_ladder ( const unsigned char *k, const unsigned char *u, unsigned char *out )
 {
 
     // initialized data
-    i256 x_1 = 0;
-    i256 res = 0;
-    i256 x_2 = 1, z_2 = 0;
-    i256 x_3 = 0, z_3 = 1;
-    int swap = 0;
-    unsigned char u_copy[32] = { 0 };
+    fe25519 x_1, x_2, z_2, x_3, z_3;
+    unsigned int swap = 0;
     unsigned char k_copy[32] = { 0 };
 
-    // make a copy of u
-    memcpy(u_copy, u, 32);
-
     // make a copy of k
     memcpy(k_copy, k, 32);
 
-    // clamp u
-    u_copy[31] &= 127;
-
-    // swap the endianness of u
-    for (int i = 0; i < 32; i++) 
-        x_1 |= ((i256)u_copy[i]) << (i * 8);
+    // decode u, ignoring the top bit
+    fe25519_from_bytes(x_1, u);
 
-    // make a copy of x_1
-    x_3 = x_1;
+    // x_2 = 1, z_2 = 0, x_3 = u, z_3 = 1
+    fe25519_1(x_2), fe25519_0(z_2),
+    fe25519_copy(x_3, x_1), fe25519_1(z_3);
 
     // clamp k
     k_copy[0] &= 248;
@@ -141,101 +53,62 @@ void x25519_ladder ( const unsigned char *k, const unsigned char *u, unsigned ch
     {
 
         // initialized data
-        int k_t = (k_copy[t / 8] >> (t % 8)) & 1;
-        i256 A  = 0,
-             AA = 0,
-             B  = 0,
-             BB = 0,
-             E  = 0,
-             C  = 0,
-             D  = 0,
-             DA = 0,
-             CB = 0;
+        unsigned int k_t = (k_copy[t / 8] >> (t % 8)) & 1;
+        fe25519 A, AA, B, BB, E, C, D, DA, CB;
 
         // swap
         swap ^= k_t;
-        cswap(swap, &x_2, &x_3);
-        cswap(swap, &z_2, &z_3);
+        fe25519_cswap(x_2, x_3, swap);
+        fe25519_cswap(z_2, z_3, swap);
         swap = k_t;
 
-        // a = x_2 + z_2
-        A = add_mod(x_2, z_2, Q);
-
-        // aa = a^2
-        AA = sqr_mod(A, Q);
+        // a = x_2 + z_2, aa = a^2
+        fe25519_add(A, x_2, z_2);
+        fe25519_sq(AA, A);
 
-        // b = x_2 - z_2
-        B = sub_mod(x_2, z_2, Q);
-
-        // bb = b^2
-        BB = sqr_mod(B, Q);
+        // b = x_2 - z_2, bb = b^2
+        fe25519_sub(B, x_2, z_2);
+        fe25519_sq(BB, B);
 
         // e = a^2 - b^2
-        E = sub_mod(AA, BB, Q);
-
-        // c = x_3 + z_3
-        C = add_mod(x_3, z_3, Q);
-
-        // d = x_3 - z_3
-        D = sub_mod(x_3, z_3, Q);
+        fe25519_sub(E, AA, BB);
 
-        // da = d * a
-        DA = mul_mod(D, A, Q);
+        // c = x_3 + z_3, d = x_3 - z_3
+        fe25519_add(C, x_3, z_3);
+        fe25519_sub(D, x_3, z_3);
 
-        // cb = c * b
-        CB = mul_mod(C, B, Q);
+        // da = d * a, cb = c * b
+        fe25519_mul(DA, D, A);
+        fe25519_mul(CB, C, B);
 
         // x_3 = (da + cb)^2
-        x_3 = sqr_mod
-        (
-            add_mod(DA, CB, Q), 
-            Q
-        );
+        fe25519_add(x_3, DA, CB);
+        fe25519_sq(x_3, x_3);
 
         // z_3 = x_1 * (da - cb)^2
-        z_3 = mul_mod
-        (
-            x_1, 
-            sqr_mod(
-                sub_mod(DA, CB, Q),
-                Q
-            ),
-            Q
-        );
+        fe25519_sub(z_3, DA, CB);
+        fe25519_sq(z_3, z_3);
+        fe25519_mul(z_3, z_3, x_1);
 
         // x_2 = a^2 * b^2
-        x_2 = mul_mod(AA, BB, Q);
+        fe25519_mul(x_2, AA, BB);
 
         // z_2 = e * (a^2 + A24 * e)
-        z_2 = mul_mod
-        (
-            E, 
-            add_mod
-            (
-                AA, 
-                mul_mod(A24, E, Q),
-                Q
-            ),
-            Q
-        );
+        fe25519_mul_small(z_2, E, A24);
+        fe25519_add(z_2, z_2, AA);
+        fe25519_mul(z_2, z_2, E);
     }
 
     // final swap
-    cswap(swap, &x_2, &x_3);
-    cswap(swap, &z_2, &z_3);
+    fe25519_cswap(x_2, x_3, swap);
+    fe25519_cswap(z_2, z_3, swap);
 
     // compute the result
-    res = mul_mod
-    (
-        x_2, 
-        inv(z_2),
-        Q
-    );
+    fe25519_invert(z_2, z_2);
+    fe25519_mul(x_2, x_2, z_2);
 
-    // swap the endianness of the result
-    for (int i = 0; i < 32; i++)
-        out[i] = (unsigned char)(res & 0xFF),
-        res >>= 8;
+    // store the result
+    fe25519_to_bytes(out, x_2);
 
     // done
     return;
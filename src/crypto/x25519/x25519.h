@@ -21,6 +21,9 @@
 #include <core/interfaces.h>
 #include <core/pack.h>
 
+/// crypto
+#include <crypto/fe25519.h>
+
 // type definitions
 typedef unsigned char x25519_public_key    [32];
 typedef unsigned char x25519_private_key   [32];
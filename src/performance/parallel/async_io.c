@@ -0,0 +1,1265 @@
+/** !
+ * Asynchronous I/O implementation
+ *
+ * @file src/performance/parallel/async_io.c
+ *
+ * @author Jacob Smith
+ */
+
+// feature test macros, for io_uring, MAP_POPULATE and pread/pwrite
+#define _GNU_SOURCE
+
+// header file
+#include <performance/async_io.h>
+
+// platform dependent includes
+#ifdef __linux__
+    #include <errno.h>
+    #include <poll.h>
+    #include <pthread.h>
+    #include <unistd.h>
+    #include <sys/epoll.h>
+    #include <sys/eventfd.h>
+    #include <sys/mman.h>
+    #include <sys/socket.h>
+    #include <sys/stat.h>
+    #include <sys/syscall.h>
+    #include <linux/io_uring.h>
+#endif
+
+// preprocessor definitions
+#define ASYNC_IO_QUEUE_DEPTH_DEFAULT 256
+#define ASYNC_IO_EVENTS_MAX          64
+#define ASYNC_IO_WAIT_TIMEOUT        10
+
+// enumeration definitions
+enum async_io_operation_e
+{
+    ASYNC_IO_OPERATION_READ     = 0,
+    ASYNC_IO_OPERATION_WRITE    = 1,
+    ASYNC_IO_OPERATION_QUANTITY = 2
+};
+
+// structure declarations
+struct async_io_request_s;
+
+// type definitions
+typedef struct async_io_request_s async_io_request;
+typedef int (fn_async_io_submit) ( async_io *p_async_io, async_io_request *p_request );
+typedef int (fn_async_io_reap)   ( async_io *p_async_io, int timeout, async_io_request **pp_completed );
+typedef int (fn_async_io_close)  ( async_io *p_async_io );
+
+// structure definitions
+struct async_io_request_s
+{
+    async_io                  *p_async_io;
+    enum async_io_operation_e  operation;
+    int                        descriptor;
+    stream                    *p_stream;
+    void                      *p_data;
+    size_t                     size;
+    long                       offset;
+    int                        result;
+    fn_async_io_complete      *pfn_complete;
+    void                      *p_parameter;
+    async_io_request          *p_next;
+};
+
+struct async_io_s
+{
+    enum async_io_backend_e  backend;
+    mutex                    _lock;
+    thread_pool             *p_thread_pool;
+    size_t                   queue_depth;
+    size_t                   in_flight;
+    size_t                   pending;
+    async_io_request        *p_free;
+
+    fn_async_io_submit      *pfn_submit;
+    fn_async_io_reap        *pfn_reap;
+    fn_async_io_close       *pfn_close;
+
+    #ifdef __linux__
+        struct
+        {
+            int                  descriptor;
+            unsigned             to_submit;
+            void                *p_sq_ring, *p_cq_ring;
+            size_t               sq_ring_size, cq_ring_size, sqes_size;
+            unsigned            *p_sq_head, *p_sq_tail, *p_sq_mask, *p_sq_array;
+            unsigned            *p_cq_head, *p_cq_tail, *p_cq_mask;
+            struct io_uring_sqe *p_sqes;
+            struct io_uring_cqe *p_cqes;
+        } io_uring;
+
+        struct
+        {
+            int                 descriptor, event;
+            bool                running;
+            condition_variable  _work;
+            parallel_thread    *p_worker;
+            async_io_request   *p_waiting;
+            async_io_request   *p_work_head, *p_work_tail;
+            async_io_request   *p_completed;
+        } epoll;
+    #endif
+};
+
+// function declarations
+/** !
+ * Submit a read or a write
+ *
+ * @param p_async_io   the asynchronous I/O engine
+ * @param operation    read or write
+ * @param p_stream     the stream
+ * @param p_data       the buffer
+ * @param size         the size of the buffer in bytes
+ * @param offset       the offset, or -1 for the current position
+ * @param pfn_complete the completion callback
+ * @param p_parameter  the parameter of the completion callback
+ *
+ * @return 1 on success, 0 on error
+ */
+int async_io_submit ( async_io *p_async_io, enum async_io_operation_e operation, stream *p_stream, void *p_data, size_t size, long offset, fn_async_io_complete *pfn_complete, void *p_parameter );
+
+/** !
+ * Run the completion callback of a request, then recycle the request
+ *
+ * @param p_parameter the request
+ *
+ * @return null
+ */
+void *async_io_dispatch ( void *p_parameter );
+
+#ifdef __linux__
+
+    /** !
+     * Set up an io_uring instance
+     *
+     * @param p_async_io the asynchronous I/O engine
+     *
+     * @return 1 on success, 0 on error
+     */
+    int async_io_construct_io_uring ( async_io *p_async_io );
+
+    /** !
+     * Set up an epoll instance, and start the worker thread for regular files
+     *
+     * @param p_async_io the asynchronous I/O engine
+     *
+     * @return 1 on success, 0 on error
+     */
+    int async_io_construct_epoll ( async_io *p_async_io );
+
+    /** !
+     * Perform a non blocking socket transfer
+     *
+     * @param p_request the request
+     *
+     * @return true if the request finished, false if the socket is not ready
+     */
+    bool async_io_attempt_epoll ( async_io_request *p_request );
+
+    /** !
+     * Worker thread loop for requests that epoll can not wait on
+     *
+     * @param p_parameter the asynchronous I/O engine
+     *
+     * @return null
+     */
+    void *async_io_work_epoll ( void *p_parameter );
+
+    // backends
+    fn_async_io_submit async_io_submit_io_uring;
+    fn_async_io_submit async_io_submit_epoll;
+    fn_async_io_reap   async_io_reap_io_uring;
+    fn_async_io_reap   async_io_reap_epoll;
+    fn_async_io_close  async_io_close_io_uring;
+    fn_async_io_close  async_io_close_epoll;
+#endif
+
+// function definitions
+int async_io_construct ( async_io **pp_async_io, size_t queue_depth, thread_pool *p_thread_pool )
+{
+
+    // argument check
+    if ( pp_async_io == (void *) 0 ) goto no_async_io;
+
+    // initialized data
+    async_io *p_async_io = default_allocator(0, sizeof(async_io));
+
+    // error check
+    if ( p_async_io == (void *) 0 ) goto no_mem;
+
+    // zero set the struct
+    memset(p_async_io, 0, sizeof(async_io));
+
+    // populate the struct
+    p_async_io->p_thread_pool = p_thread_pool;
+    p_async_io->queue_depth   = ( queue_depth ) ? queue_depth : ASYNC_IO_QUEUE_DEPTH_DEFAULT;
+
+    // construct a lock
+    mutex_create(&p_async_io->_lock);
+
+    // platform dependent implementation
+    #ifdef __linux__
+
+        // prefer io_uring
+        if ( async_io_construct_io_uring(p_async_io) )
+        {
+            p_async_io->backend    = ASYNC_IO_BACKEND_IO_URING;
+            p_async_io->pfn_submit = async_io_submit_io_uring;
+            p_async_io->pfn_reap   = async_io_reap_io_uring;
+            p_async_io->pfn_close  = async_io_close_io_uring;
+        }
+
+        // fall back to epoll
+        else if ( async_io_construct_epoll(p_async_io) )
+        {
+            p_async_io->backend    = ASYNC_IO_BACKEND_EPOLL;
+            p_async_io->pfn_submit = async_io_submit_epoll;
+            p_async_io->pfn_reap   = async_io_reap_epoll;
+            p_async_io->pfn_close  = async_io_close_epoll;
+        }
+
+        // error
+        else goto failed_to_construct_backend;
+    #else
+
+        // io_uring and epoll are linux only
+        goto unsupported_platform;
+    #endif
+
+    // return a pointer to the caller
+    *pp_async_io = p_async_io;
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_async_io:
+                #ifndef NDEBUG
+                    log_error("[parallel] [async io] Null pointer provided for parameter \"pp_async_io\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // parallel errors
+        {
+            #ifdef __linux__
+            failed_to_construct_backend:
+                #ifndef NDEBUG
+                    log_error("[parallel] [async io] Failed to construct an I/O backend in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // release the lock
+                mutex_destroy(&p_async_io->_lock);
+
+                // release the engine
+                p_async_io = default_allocator(p_async_io, 0);
+
+                // error
+                return 0;
+            #else
+            unsupported_platform:
+                #ifndef NDEBUG
+                    log_error("[parallel] [async io] Asynchronous I/O is not supported on this platform in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // release the lock
+                mutex_destroy(&p_async_io->_lock);
+
+                // release the engine
+                p_async_io = default_allocator(p_async_io, 0);
+
+                // error
+                return 0;
+            #endif
+        }
+
+        // standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int async_io_read ( async_io *p_async_io, stream *p_stream, void *p_data, size_t size, long offset, fn_async_io_complete *pfn_complete, void *p_parameter )
+{
+
+    // success
+    return async_io_submit(p_async_io, ASYNC_IO_OPERATION_READ, p_stream, p_data, size, offset, pfn_complete, p_parameter);
+}
+
+int async_io_write ( async_io *p_async_io, stream *p_stream, void *p_data, size_t size, long offset, fn_async_io_complete *pfn_complete, void *p_parameter )
+{
+
+    // success
+    return async_io_submit(p_async_io, ASYNC_IO_OPERATION_WRITE, p_stream, p_data, size, offset, pfn_complete, p_parameter);
+}
+
+int async_io_submit ( async_io *p_async_io, enum async_io_operation_e operation, stream *p_stream, void *p_data, size_t size, long offset, fn_async_io_complete *pfn_complete, void *p_parameter )
+{
+
+    // argument check
+    if ( p_async_io   == (void *) 0 ) goto no_async_io;
+    if ( p_stream     == (void *) 0 ) goto no_stream;
+    if ( p_data       == (void *) 0 ) goto no_data;
+    if ( pfn_complete == (void *) 0 ) goto no_complete;
+
+    // initialized data
+    async_io_request *p_request  = (void *) 0;
+    int               descriptor = stream_descriptor(p_stream);
+
+    // error check
+    if ( descriptor == -1 ) goto no_descriptor;
+
+    // lock
+    mutex_lock(&p_async_io->_lock);
+
+    // error check
+    if ( p_async_io->in_flight >= p_async_io->queue_depth ) goto queue_full;
+
+    // recycle a request
+    if ( p_async_io->p_free )
+    {
+        p_request          = p_async_io->p_free;
+        p_async_io->p_free = p_request->p_next;
+    }
+
+    // allocate a request
+    else
+    {
+        p_request = default_allocator(0, sizeof(async_io_request));
+        if ( p_request == (void *) 0 ) goto no_mem;
+    }
+
+    // populate the request
+    *p_request = (async_io_request)
+    {
+        .p_async_io   = p_async_io,
+        .operation    = operation,
+        .descriptor   = descriptor,
+        .p_stream     = p_stream,
+        .p_data       = p_data,
+        .size         = size,
+        .offset       = offset,
+        .result       = -1,
+        .pfn_complete = pfn_complete,
+        .p_parameter  = p_parameter,
+        .p_next       = (void *) 0
+    };
+
+    // submit the request
+    if ( p_async_io->pfn_submit(p_async_io, p_request) == 0 ) goto failed_to_submit;
+
+    // increment the counters
+    p_async_io->in_flight++;
+    p_async_io->pending++;
+
+    // unlock
+    mutex_unlock(&p_async_io->_lock);
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_async_io:
+                #ifndef NDEBUG
+                    log_error("[parallel] [async io] Null pointer provided for parameter \"p_async_io\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_stream:
+                #ifndef NDEBUG
+                    log_error("[parallel] [async io] Null pointer provided for parameter \"p_stream\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_data:
+                #ifndef NDEBUG
+                    log_error("[parallel] [async io] Null pointer provided for parameter \"p_data\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_complete:
+                #ifndef NDEBUG
+                    log_error("[parallel] [async io] Null pointer provided for parameter \"pfn_complete\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_descriptor:
+                #ifndef NDEBUG
+                    log_error("[parallel] [async io] Parameter \"p_stream\" is not backed by a descriptor in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // parallel errors
+        {
+            queue_full:
+                #ifndef NDEBUG
+                    log_error("[parallel] [async io] Queue is full in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // unlock
+                mutex_unlock(&p_async_io->_lock);
+
+                // error
+                return 0;
+
+            failed_to_submit:
+                #ifndef NDEBUG
+                    log_error("[parallel] [async io] Failed to submit request in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // recycle the request
+                p_request->p_next  = p_async_io->p_free;
+                p_async_io->p_free = p_request;
+
+                // unlock
+                mutex_unlock(&p_async_io->_lock);
+
+                // error
+                return 0;
+        }
+
+        // standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // unlock
+                mutex_unlock(&p_async_io->_lock);
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int async_io_poll ( async_io *p_async_io, int timeout )
+{
+
+    // argument check
+    if ( p_async_io == (void *) 0 ) goto no_async_io;
+
+    // initialized data
+    async_io_request *p_completed = (void *) 0;
+    int               quantity    = p_async_io->pfn_reap(p_async_io, timeout, &p_completed);
+
+    // error check
+    if ( quantity == -1 ) goto failed_to_reap;
+
+    // dispatch each completion
+    while ( p_completed )
+    {
+
+        // initialized data
+        async_io_request *p_request = p_completed;
+
+        // advance before the request is recycled
+        p_completed = p_request->p_next;
+
+        // run the callback on the thread pool ...
+        if ( p_async_io->p_thread_pool && thread_pool_execute(p_async_io->p_thread_pool, async_io_dispatch, p_request) ) continue;
+
+        // ... or on this thread
+        async_io_dispatch(p_request);
+    }
+
+    // success
+    return quantity;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_async_io:
+                #ifndef NDEBUG
+                    log_error("[parallel] [async io] Null pointer provided for parameter \"p_async_io\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return -1;
+        }
+
+        // parallel errors
+        {
+            failed_to_reap:
+                #ifndef NDEBUG
+                    log_error("[parallel] [async io] Failed to reap completions in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return -1;
+        }
+    }
+}
+
+void *async_io_dispatch ( void *p_parameter )
+{
+
+    // initialized data
+    async_io_request *p_request  = p_parameter;
+    async_io         *p_async_io = p_request->p_async_io;
+
+    // run the callback
+    p_request->pfn_complete(p_request->p_stream, p_request->p_data, p_request->result, p_request->p_parameter);
+
+    // lock
+    mutex_lock(&p_async_io->_lock);
+
+    // recycle the request
+    p_request->p_next  = p_async_io->p_free;
+    p_async_io->p_free = p_request;
+
+    // decrement the counter
+    p_async_io->pending--;
+
+    // unlock
+    mutex_unlock(&p_async_io->_lock);
+
+    // done
+    return (void *) 0;
+}
+
+size_t async_io_pending ( async_io *p_async_io )
+{
+
+    // argument check
+    if ( p_async_io == (void *) 0 ) goto no_async_io;
+
+    // initialized data
+    size_t result = 0;
+
+    // lock
+    mutex_lock(&p_async_io->_lock);
+
+    // store the quantity of pending requests
+    result = p_async_io->pending;
+
+    // unlock
+    mutex_unlock(&p_async_io->_lock);
+
+    // success
+    return result;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_async_io:
+                #ifndef NDEBUG
+                    log_error("[parallel] [async io] Null pointer provided for parameter \"p_async_io\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+enum async_io_backend_e async_io_backend ( async_io *p_async_io )
+{
+
+    // argument check
+    if ( p_async_io == (void *) 0 ) goto no_async_io;
+
+    // success
+    return p_async_io->backend;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_async_io:
+                #ifndef NDEBUG
+                    log_error("[parallel] [async io] Null pointer provided for parameter \"p_async_io\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return ASYNC_IO_BACKEND_QUANTITY;
+        }
+    }
+}
+
+int async_io_wait_idle ( async_io *p_async_io )
+{
+
+    // argument check
+    if ( p_async_io == (void *) 0 ) goto no_async_io;
+
+    // until every callback has returned
+    while ( true )
+    {
+
+        // initialized data
+        size_t in_flight = 0,
+               pending   = 0;
+
+        // lock
+        mutex_lock(&p_async_io->_lock);
+
+        // store the counters
+        in_flight = p_async_io->in_flight;
+        pending   = p_async_io->pending;
+
+        // unlock
+        mutex_unlock(&p_async_io->_lock);
+
+        // done?
+        if ( pending == 0 ) break;
+
+        // reap completions. The timeout is bounded, because
+        // another thread may reap the last completion
+        if ( in_flight )
+        {
+            if ( async_io_poll(p_async_io, ASYNC_IO_WAIT_TIMEOUT) == -1 ) goto failed_to_poll;
+        }
+
+        // wait for callbacks on the thread pool
+        else sleep(0);
+    }
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_async_io:
+                #ifndef NDEBUG
+                    log_error("[parallel] [async io] Null pointer provided for parameter \"p_async_io\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // parallel errors
+        {
+            failed_to_poll:
+                #ifndef NDEBUG
+                    log_error("[parallel] [async io] Failed to poll in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int async_io_destroy ( async_io **pp_async_io )
+{
+
+    // argument check
+    if ( pp_async_io == (void *) 0 ) goto no_async_io;
+
+    // initialized data
+    async_io *p_async_io = *pp_async_io;
+
+    // fast exit
+    if ( p_async_io == (void *) 0 ) return 1;
+
+    // no more pointer for caller
+    *pp_async_io = (void *) 0;
+
+    // finish pending requests
+    async_io_wait_idle(p_async_io);
+
+    // release the backend
+    p_async_io->pfn_close(p_async_io);
+
+    // release recycled requests
+    while ( p_async_io->p_free )
+    {
+
+        // initialized data
+        async_io_request *p_request = p_async_io->p_free;
+
+        // advance
+        p_async_io->p_free = p_request->p_next;
+
+        // release the request
+        p_request = default_allocator(p_request, 0);
+    }
+
+    // release the lock
+    mutex_destroy(&p_async_io->_lock);
+
+    // release the engine
+    p_async_io = default_allocator(p_async_io, 0);
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_async_io:
+                #ifndef NDEBUG
+                    log_error("[parallel] [async io] Null pointer provided for parameter \"pp_async_io\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+#ifdef __linux__
+
+int async_io_construct_io_uring ( async_io *p_async_io )
+{
+
+    // initialized data
+    struct io_uring_params _params = { 0 };
+    int                    ring    = (int) syscall(__NR_io_uring_setup, (unsigned) p_async_io->queue_depth, &_params);
+    char                  *p_sq    = MAP_FAILED,
+                          *p_cq    = MAP_FAILED;
+    void                  *p_sqes  = MAP_FAILED;
+
+    // error check
+    if ( ring == -1 ) return 0;
+
+    // the kernel must support IORING_OP_READ and IORING_OP_WRITE
+    if ( 0 == ( _params.features & IORING_FEAT_RW_CUR_POS ) ) goto failed;
+
+    // compute the size of each ring
+    p_async_io->io_uring.sq_ring_size = _params.sq_off.array + _params.sq_entries * sizeof(unsigned);
+    p_async_io->io_uring.cq_ring_size = _params.cq_off.cqes  + _params.cq_entries * sizeof(struct io_uring_cqe);
+    p_async_io->io_uring.sqes_size    = _params.sq_entries * sizeof(struct io_uring_sqe);
+
+    // the rings may share one mapping
+    if ( _params.features & IORING_FEAT_SINGLE_MMAP )
+    {
+        if ( p_async_io->io_uring.cq_ring_size > p_async_io->io_uring.sq_ring_size )
+            p_async_io->io_uring.sq_ring_size = p_async_io->io_uring.cq_ring_size;
+
+        p_async_io->io_uring.cq_ring_size = p_async_io->io_uring.sq_ring_size;
+    }
+
+    // map the submission ring
+    p_sq = mmap(0, p_async_io->io_uring.sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQ_RING);
+    if ( p_sq == MAP_FAILED ) goto failed;
+
+    // map the completion ring
+    if ( _params.features & IORING_FEAT_SINGLE_MMAP ) p_cq = p_sq;
+    else
+    {
+        p_cq = mmap(0, p_async_io->io_uring.cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_CQ_RING);
+        if ( p_cq == MAP_FAILED ) goto failed;
+    }
+
+    // map the submission queue entries
+    p_sqes = mmap(0, p_async_io->io_uring.sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQES);
+    if ( p_sqes == MAP_FAILED ) goto failed;
+
+    // store the ring
+    p_async_io->io_uring.descriptor = ring;
+    p_async_io->io_uring.p_sq_ring  = p_sq;
+    p_async_io->io_uring.p_cq_ring  = p_cq;
+    p_async_io->io_uring.p_sq_head  = (unsigned *) ( p_sq + _params.sq_off.head );
+    p_async_io->io_uring.p_sq_tail  = (unsigned *) ( p_sq + _params.sq_off.tail );
+    p_async_io->io_uring.p_sq_mask  = (unsigned *) ( p_sq + _params.sq_off.ring_mask );
+    p_async_io->io_uring.p_sq_array = (unsigned *) ( p_sq + _params.sq_off.array );
+    p_async_io->io_uring.p_cq_head  = (unsigned *) ( p_cq + _params.cq_off.head );
+    p_async_io->io_uring.p_cq_tail  = (unsigned *) ( p_cq + _params.cq_off.tail );
+    p_async_io->io_uring.p_cq_mask  = (unsigned *) ( p_cq + _params.cq_off.ring_mask );
+    p_async_io->io_uring.p_cqes     = (struct io_uring_cqe *) ( p_cq + _params.cq_off.cqes );
+    p_async_io->io_uring.p_sqes     = p_sqes;
+
+    // the completion ring is twice the size of the submission ring, so
+    // capping in-flight requests at the submission ring never overflows it
+    if ( p_async_io->queue_depth > _params.sq_entries ) p_async_io->queue_depth = _params.sq_entries;
+
+    // success
+    return 1;
+
+    // error handling
+    failed:
+
+        // release the mappings
+        if ( p_sqes != MAP_FAILED ) munmap(p_sqes, p_async_io->io_uring.sqes_size);
+        if ( p_cq != MAP_FAILED && p_cq != p_sq ) munmap(p_cq, p_async_io->io_uring.cq_ring_size);
+        if ( p_sq != MAP_FAILED ) munmap(p_sq, p_async_io->io_uring.sq_ring_size);
+
+        // release the ring
+        close(ring);
+
+        // error
+        return 0;
+}
+
+int async_io_submit_io_uring ( async_io *p_async_io, async_io_request *p_request )
+{
+
+    // initialized data
+    unsigned             tail    = *p_async_io->io_uring.p_sq_tail,
+                         index   = tail & *p_async_io->io_uring.p_sq_mask;
+    struct io_uring_sqe *p_entry = &p_async_io->io_uring.p_sqes[index];
+    int                  result  = 0;
+
+    // populate the submission queue entry
+    memset(p_entry, 0, sizeof(struct io_uring_sqe));
+    p_entry->opcode    = ( p_request->operation == ASYNC_IO_OPERATION_READ ) ? IORING_OP_READ : IORING_OP_WRITE;
+    p_entry->fd        = p_request->descriptor;
+    p_entry->off       = ( p_request->offset < 0 ) ? (__u64) -1 : (__u64) p_request->offset;
+    p_entry->addr      = (__u64) (size_t) p_request->p_data;
+    p_entry->len       = (__u32) p_request->size;
+    p_entry->user_data = (__u64) (size_t) p_request;
+
+    // publish the entry
+    p_async_io->io_uring.p_sq_array[index] = index;
+    __atomic_store_n(p_async_io->io_uring.p_sq_tail, tail + 1, __ATOMIC_RELEASE);
+    p_async_io->io_uring.to_submit++;
+
+    // enter the kernel. Entries the kernel does not
+    // accept are submitted again by async_io_poll
+    result = (int) syscall(__NR_io_uring_enter, p_async_io->io_uring.descriptor, p_async_io->io_uring.to_submit, 0, 0, (void *) 0, 0);
+    if ( result > 0 ) p_async_io->io_uring.to_submit -= (unsigned) result;
+
+    // success
+    return 1;
+}
+
+int async_io_reap_io_uring ( async_io *p_async_io, int timeout, async_io_request **pp_completed )
+{
+
+    // initialized data
+    int      quantity = 0;
+    unsigned head     = 0,
+             tail     = 0;
+
+    // lock
+    mutex_lock(&p_async_io->_lock);
+
+    // submit entries the kernel did not accept
+    if ( p_async_io->io_uring.to_submit )
+    {
+
+        // initialized data
+        int result = (int) syscall(__NR_io_uring_enter, p_async_io->io_uring.descriptor, p_async_io->io_uring.to_submit, 0, 0, (void *) 0, 0);
+
+        // update the quantity of unsubmitted entries
+        if ( result > 0 ) p_async_io->io_uring.to_submit -= (unsigned) result;
+    }
+
+    // store the ring state
+    head = *p_async_io->io_uring.p_cq_head;
+    tail = __atomic_load_n(p_async_io->io_uring.p_cq_tail, __ATOMIC_ACQUIRE);
+
+    // unlock
+    mutex_unlock(&p_async_io->_lock);
+
+    // wait for a completion, without blocking submitters
+    if ( head == tail && timeout != 0 )
+    {
+
+        // initialized data
+        struct pollfd _poll = { .fd = p_async_io->io_uring.descriptor, .events = POLLIN };
+
+        // wait
+        if ( poll(&_poll, 1, timeout) == -1 && errno != EINTR ) return -1;
+    }
+
+    // lock
+    mutex_lock(&p_async_io->_lock);
+
+    // store the ring state
+    head = *p_async_io->io_uring.p_cq_head;
+    tail = __atomic_load_n(p_async_io->io_uring.p_cq_tail, __ATOMIC_ACQUIRE);
+
+    // reap each completion
+    for (; head != tail; head++, quantity++)
+    {
+
+        // initialized data
+        struct io_uring_cqe *p_entry   = &p_async_io->io_uring.p_cqes[head & *p_async_io->io_uring.p_cq_mask];
+        async_io_request    *p_request = (async_io_request *) (size_t) p_entry->user_data;
+
+        // store the result
+        p_request->result = ( p_entry->res < 0 ) ? -1 : p_entry->res;
+
+        // add the request to the completed list
+        p_request->p_next = *pp_completed;
+        *pp_completed     = p_request;
+    }
+
+    // release the entries to the kernel
+    __atomic_store_n(p_async_io->io_uring.p_cq_head, head, __ATOMIC_RELEASE);
+
+    // update the counter
+    p_async_io->in_flight -= (size_t) quantity;
+
+    // unlock
+    mutex_unlock(&p_async_io->_lock);
+
+    // success
+    return quantity;
+}
+
+int async_io_close_io_uring ( async_io *p_async_io )
+{
+
+    // release the mappings
+    munmap(p_async_io->io_uring.p_sqes, p_async_io->io_uring.sqes_size);
+    if ( p_async_io->io_uring.p_cq_ring != p_async_io->io_uring.p_sq_ring ) munmap(p_async_io->io_uring.p_cq_ring, p_async_io->io_uring.cq_ring_size);
+    munmap(p_async_io->io_uring.p_sq_ring, p_async_io->io_uring.sq_ring_size);
+
+    // success
+    return ( close(p_async_io->io_uring.descriptor) == 0 );
+}
+
+int async_io_construct_epoll ( async_io *p_async_io )
+{
+
+    // initialized data
+    struct epoll_event _event = { .events = EPOLLIN };
+
+    // construct an epoll instance
+    p_async_io->epoll.descriptor = epoll_create1(EPOLL_CLOEXEC);
+    if ( p_async_io->epoll.descriptor == -1 ) return 0;
+
+    // construct an event for waking the poller
+    p_async_io->epoll.event = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if ( p_async_io->epoll.event == -1 ) goto failed_to_create_event;
+
+    // watch the event
+    _event.data.fd = p_async_io->epoll.event;
+    if ( epoll_ctl(p_async_io->epoll.descriptor, EPOLL_CTL_ADD, p_async_io->epoll.event, &_event) == -1 ) goto failed_to_watch_event;
+
+    // start the worker thread
+    condition_variable_create(&p_async_io->epoll._work);
+    p_async_io->epoll.running = true;
+    if ( parallel_thread_start(&p_async_io->epoll.p_worker, async_io_work_epoll, p_async_io) == 0 ) goto failed_to_start_worker;
+
+    // success
+    return 1;
+
+    // error handling
+    failed_to_start_worker:
+        condition_variable_destroy(&p_async_io->epoll._work);
+
+    failed_to_watch_event:
+        close(p_async_io->epoll.event);
+
+    failed_to_create_event:
+        close(p_async_io->epoll.descriptor);
+
+        // error
+        return 0;
+}
+
+bool async_io_attempt_epoll ( async_io_request *p_request )
+{
+
+    // initialized data
+    ssize_t result = 0;
+
+    // transfer without blocking
+    do
+    {
+        result = ( p_request->operation == ASYNC_IO_OPERATION_READ )
+               ? recv(p_request->descriptor, p_request->p_data, p_request->size, MSG_DONTWAIT)
+               : send(p_request->descriptor, p_request->p_data, p_request->size, MSG_DONTWAIT | MSG_NOSIGNAL);
+    } while ( result == -1 && errno == EINTR );
+
+    // not ready
+    if ( result == -1 && ( errno == EAGAIN || errno == EWOULDBLOCK ) ) return false;
+
+    // store the result
+    p_request->result = ( result < 0 ) ? -1 : (int) result;
+
+    // done
+    return true;
+}
+
+int async_io_submit_epoll ( async_io *p_async_io, async_io_request *p_request )
+{
+
+    // initialized data
+    struct stat        _stat     = { 0 };
+    struct epoll_event _event    = { .events = EPOLLIN | EPOLLOUT | EPOLLET, .data.fd = p_request->descriptor };
+    unsigned long long increment = 1;
+
+    // error check
+    if ( fstat(p_request->descriptor, &_stat) == -1 ) return 0;
+
+    // epoll can not wait on regular files, so hand them to the worker thread
+    if ( !S_ISSOCK(_stat.st_mode) )
+    {
+
+        // append the request to the work queue
+        if ( p_async_io->epoll.p_work_tail ) p_async_io->epoll.p_work_tail->p_next = p_request;
+        else                                 p_async_io->epoll.p_work_head         = p_request;
+        p_async_io->epoll.p_work_tail = p_request;
+
+        // wake the worker thread
+        condition_variable_signal(&p_async_io->epoll._work);
+
+        // success
+        return 1;
+    }
+
+    // the socket may already be ready
+    if ( async_io_attempt_epoll(p_request) )
+    {
+
+        // add the request to the completed list
+        p_request->p_next              = p_async_io->epoll.p_completed;
+        p_async_io->epoll.p_completed = p_request;
+
+        // wake the poller
+        if ( write(p_async_io->epoll.event, &increment, sizeof(increment)) == -1 ) { }
+
+        // success
+        return 1;
+    }
+
+    // watch the socket. Edge triggered readiness is sufficient,
+    // because every waiting request is retried on each edge
+    if ( epoll_ctl(p_async_io->epoll.descriptor, EPOLL_CTL_ADD, p_request->descriptor, &_event) == -1 && errno != EEXIST ) return 0;
+
+    // add the request to the waiting list
+    p_request->p_next            = p_async_io->epoll.p_waiting;
+    p_async_io->epoll.p_waiting = p_request;
+
+    // success
+    return 1;
+}
+
+void *async_io_work_epoll ( void *p_parameter )
+{
+
+    // initialized data
+    async_io           *p_async_io = p_parameter;
+    unsigned long long  increment  = 1;
+
+    // lock
+    mutex_lock(&p_async_io->_lock);
+
+    // until stopped
+    while ( true )
+    {
+
+        // initialized data
+        async_io_request *p_request = (void *) 0;
+        ssize_t           result    = 0;
+
+        // wait for work
+        while ( p_async_io->epoll.running && p_async_io->epoll.p_work_head == (void *) 0 )
+            condition_variable_wait(&p_async_io->epoll._work, &p_async_io->_lock);
+
+        // stopped
+        if ( p_async_io->epoll.p_work_head == (void *) 0 ) break;
+
+        // dequeue a request
+        p_request                     = p_async_io->epoll.p_work_head;
+        p_async_io->epoll.p_work_head = p_request->p_next;
+        if ( p_async_io->epoll.p_work_head == (void *) 0 ) p_async_io->epoll.p_work_tail = (void *) 0;
+
+        // unlock
+        mutex_unlock(&p_async_io->_lock);
+
+        // transfer
+        do
+        {
+            if ( p_request->operation == ASYNC_IO_OPERATION_READ )
+                result = ( p_request->offset < 0 )
+                       ? read(p_request->descriptor, p_request->p_data, p_request->size)
+                       : pread(p_request->descriptor, p_request->p_data, p_request->size, p_request->offset);
+            else
+                result = ( p_request->offset < 0 )
+                       ? write(p_request->descriptor, p_request->p_data, p_request->size)
+                       : pwrite(p_request->descriptor, p_request->p_data, p_request->size, p_request->offset);
+        } while ( result == -1 && errno == EINTR );
+
+        // store the result
+        p_request->result = ( result < 0 ) ? -1 : (int) result;
+
+        // lock
+        mutex_lock(&p_async_io->_lock);
+
+        // add the request to the completed list
+        p_request->p_next              = p_async_io->epoll.p_completed;
+        p_async_io->epoll.p_completed = p_request;
+
+        // wake the poller
+        if ( write(p_async_io->epoll.event, &increment, sizeof(increment)) == -1 ) { }
+    }
+
+    // unlock
+    mutex_unlock(&p_async_io->_lock);
+
+    // done
+    return (void *) 0;
+}
+
+int async_io_reap_epoll ( async_io *p_async_io, int timeout, async_io_request **pp_completed )
+{
+
+    // initialized data
+    struct epoll_event _events[ASYNC_IO_EVENTS_MAX];
+    int                event_quantity = 0,
+                       quantity       = 0;
+    bool               ready          = false;
+
+    // lock
+    mutex_lock(&p_async_io->_lock);
+
+    // completions are already waiting?
+    ready = ( p_async_io->epoll.p_completed != (void *) 0 );
+
+    // unlock
+    mutex_unlock(&p_async_io->_lock);
+
+    // wait for readiness, without blocking submitters
+    event_quantity = epoll_wait(p_async_io->epoll.descriptor, _events, ASYNC_IO_EVENTS_MAX, ( ready ) ? 0 : timeout);
+
+    // error check
+    if ( event_quantity == -1 )
+    {
+        if ( errno != EINTR ) return -1;
+
+        event_quantity = 0;
+    }
+
+    // lock
+    mutex_lock(&p_async_io->_lock);
+
+    // handle each event
+    for (int i = 0; i < event_quantity; i++)
+    {
+
+        // initialized data
+        async_io_request **pp_request = &p_async_io->epoll.p_waiting;
+
+        // the poller was woken
+        if ( _events[i].data.fd == p_async_io->epoll.event )
+        {
+
+            // initialized data
+            unsigned long long counter = 0;
+
+            // reset the event
+            if ( read(p_async_io->epoll.event, &counter, sizeof(counter)) == -1 ) { }
+
+            // done
+            continue;
+        }
+
+        // retry each request waiting on this socket
+        while ( *pp_request )
+        {
+
+            // initialized data
+            async_io_request *p_request = *pp_request;
+
+            // not this socket, or not ready
+            if ( p_request->descriptor != _events[i].data.fd || !async_io_attempt_epoll(p_request) )
+            {
+                pp_request = &p_request->p_next;
+                continue;
+            }
+
+            // remove the request from the waiting list
+            *pp_request = p_request->p_next;
+
+            // add the request to the completed list
+            p_request->p_next              = p_async_io->epoll.p_completed;
+            p_async_io->epoll.p_completed = p_request;
+        }
+    }
+
+    // take every completed request
+    while ( p_async_io->epoll.p_completed )
+    {
+
+        // initialized data
+        async_io_request *p_request = p_async_io->epoll.p_completed;
+
+        // advance
+        p_async_io->epoll.p_completed = p_request->p_next;
+
+        // add the request to the caller's list
+        p_request->p_next = *pp_completed;
+        *pp_completed     = p_request;
+
+        // increment the counter
+        quantity++;
+    }
+
+    // update the counter
+    p_async_io->in_flight -= (size_t) quantity;
+
+    // unlock
+    mutex_unlock(&p_async_io->_lock);
+
+    // success
+    return quantity;
+}
+
+int async_io_close_epoll ( async_io *p_async_io )
+{
+
+    // lock
+    mutex_lock(&p_async_io->_lock);
+
+    // stop the worker thread
+    p_async_io->epoll.running = false;
+    condition_variable_broadcast(&p_async_io->epoll._work);
+
+    // unlock
+    mutex_unlock(&p_async_io->_lock);
+
+    // wait for the worker thread, and release it
+    parallel_thread_join(&p_async_io->epoll.p_worker);
+
+    // release the condition variable
+    condition_variable_destroy(&p_async_io->epoll._work);
+
+    // release the event
+    close(p_async_io->epoll.event);
+
+    // success
+    return ( close(p_async_io->epoll.descriptor) == 0 );
+}
+
+#endif
@@ -0,0 +1,150 @@
+/** !
+ * Asynchronous I/O interface
+ *
+ * @file src/performance/parallel/async_io.h
+ *
+ * @author Jacob Smith
+ */
+
+// header guard
+#pragma once
+
+// standard library
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+// gsdk
+/// core
+#include <core/log.h>
+#include <core/sync.h>
+#include <core/stream.h>
+
+/// performance
+#include <performance/parallel.h>
+#include <performance/thread.h>
+#include <performance/thread_pool.h>
+
+// enumeration definitions
+enum async_io_backend_e
+{
+    ASYNC_IO_BACKEND_IO_URING = 0,
+    ASYNC_IO_BACKEND_EPOLL    = 1,
+    ASYNC_IO_BACKEND_QUANTITY = 2
+};
+
+// structure declarations
+struct async_io_s;
+
+// type definitions
+typedef struct async_io_s async_io;
+
+/** !
+ * Called when an asynchronous read or write completes
+ *
+ * @param p_stream    the stream
+ * @param p_data      the buffer that was submitted
+ * @param result      the quantity of bytes transferred, or -1 on error
+ * @param p_parameter the parameter that was submitted
+ */
+typedef void (fn_async_io_complete) ( stream *p_stream, void *p_data, int result, void *p_parameter );
+
+// function declarations
+/// constructors
+/** !
+ * Construct an asynchronous I/O engine. The engine uses io_uring where
+ * the kernel supports it, and falls back to epoll with a worker thread
+ * for regular files. Construction fails on platforms other than linux.
+ *
+ * @param pp_async_io   result
+ * @param queue_depth   the maximum quantity of in-flight requests
+ * @param p_thread_pool the thread pool that runs completion callbacks, or null to run them in async_io_poll
+ *
+ * @return 1 on success, 0 on error
+ */
+int async_io_construct ( async_io **pp_async_io, size_t queue_depth, thread_pool *p_thread_pool );
+
+/// submit
+/** !
+ * Submit an asynchronous read. The buffer must remain valid until the
+ * completion callback runs. The stream cursor is not updated.
+ *
+ * @param p_async_io   the asynchronous I/O engine
+ * @param p_stream     a file stream, or an unbuffered socket stream
+ * @param p_data       the buffer
+ * @param size         the size of the buffer in bytes
+ * @param offset       the offset to read from, or -1 for the current position
+ * @param pfn_complete the completion callback
+ * @param p_parameter  the parameter of the completion callback
+ *
+ * @return 1 on success, 0 on error
+ */
+int async_io_read ( async_io *p_async_io, stream *p_stream, void *p_data, size_t size, long offset, fn_async_io_complete *pfn_complete, void *p_parameter );
+
+/** !
+ * Submit an asynchronous write. The buffer must remain valid until the
+ * completion callback runs. The stream cursor is not updated.
+ *
+ * @param p_async_io   the asynchronous I/O engine
+ * @param p_stream     a file stream, or an unbuffered socket stream
+ * @param p_data       the buffer
+ * @param size         the size of the buffer in bytes
+ * @param offset       the offset to write to, or -1 for the current position
+ * @param pfn_complete the completion callback
+ * @param p_parameter  the parameter of the completion callback
+ *
+ * @return 1 on success, 0 on error
+ */
+int async_io_write ( async_io *p_async_io, stream *p_stream, void *p_data, size_t size, long offset, fn_async_io_complete *pfn_complete, void *p_parameter );
+
+/// poll
+/** !
+ * Reap completed requests, and run their callbacks
+ *
+ * @param p_async_io the asynchronous I/O engine
+ * @param timeout    milliseconds to wait for a completion, 0 to return immediately, or -1 to wait indefinitely
+ *
+ * @return the quantity of completions on success, -1 on error
+ */
+int async_io_poll ( async_io *p_async_io, int timeout );
+
+/// accessors
+/** !
+ * Get the quantity of requests whose callbacks have not yet returned
+ *
+ * @param p_async_io the asynchronous I/O engine
+ *
+ * @return the quantity of pending requests
+ */
+size_t async_io_pending ( async_io *p_async_io );
+
+/** !
+ * Get the backend of an asynchronous I/O engine
+ *
+ * @param p_async_io the asynchronous I/O engine
+ *
+ * @return the backend on success, ASYNC_IO_BACKEND_QUANTITY on error
+ */
+enum async_io_backend_e async_io_backend ( async_io *p_async_io );
+
+/// blockers
+/** !
+ * Block until every submitted request has completed, and every
+ * completion callback has returned
+ *
+ * @param p_async_io the asynchronous I/O engine
+ *
+ * @return 1 on success, 0 on error
+ */
+int async_io_wait_idle ( async_io *p_async_io );
+
+/// destructors
+/** !
+ * Wait for pending requests, then destroy an asynchronous I/O engine
+ *
+ * @param pp_async_io pointer to asynchronous I/O engine pointer
+ *
+ * @return 1 on success, 0 on error
+ */
+int async_io_destroy ( async_io **pp_async_io );
@@ -0,0 +1,1194 @@
+/** !
+ * Socket reactor implementation
+ *
+ * @file src/performance/parallel/reactor.c
+ *
+ * @author Jacob Smith
+ */
+
+// feature test macros, for thread affinity
+#define _GNU_SOURCE
+
+// header file
+#include <performance/reactor.h>
+
+// platform dependent includes
+#ifdef __linux__
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <pthread.h>
+    #include <sched.h>
+    #include <unistd.h>
+    #include <sys/epoll.h>
+    #include <sys/socket.h>
+#endif
+
+// preprocessor definitions
+#define REACTOR_EVENTS_MAX    256
+#define REACTOR_SHARD_TIMEOUT 100
+#define REACTOR_CPUS_MAX      1024
+
+// structure declarations
+struct reactor_source_s;
+
+// type definitions
+typedef struct reactor_source_s reactor_source;
+
+// structure definitions
+struct reactor_source_s
+{
+    reactor              *p_reactor;
+    socket_tcp            _socket_tcp;
+    bool                  listener;
+    int                   ready;
+    fn_reactor_handler   *pfn_handler;
+    fn_socket_tcp_accept  pfn_accept;
+    void                 *p_parameter;
+    reactor_source       *p_prev, *p_next;
+};
+
+struct reactor_s
+{
+    mutex           _lock;
+    thread_pool    *p_thread_pool;
+    size_t          connections;
+    size_t          pending;
+    reactor_source *p_sources;
+
+    #ifdef __linux__
+        int descriptor;
+    #endif
+};
+
+struct reactor_shard_s
+{
+    reactor_shards  *p_reactor_shards;
+    reactor         *p_reactor;
+    int              _socket;
+    int              cpu;
+    parallel_thread *p_thread;
+};
+
+struct reactor_shards_s
+{
+    enum socket_protocol_e  protocol;
+    fn_reactor_handler     *pfn_handler;
+    void                   *p_parameter;
+    bool                    running;
+    size_t                  quantity;
+    struct reactor_shard_s  _shards[];
+};
+
+// function declarations
+/** !
+ * Register a source with the reactor
+ *
+ * @param p_reactor the reactor
+ * @param p_source  the source
+ * @param events    the events to wait for
+ *
+ * @return 1 on success, 0 on error
+ */
+int reactor_register ( reactor *p_reactor, reactor_source *p_source, int events );
+
+/** !
+ * Wait for the next events of a source
+ *
+ * @param p_source the source
+ * @param events   the events to wait for
+ *
+ * @return 1 on success, 0 on error
+ */
+int reactor_rearm ( reactor_source *p_source, int events );
+
+/** !
+ * Unregister a source, destroy its socket, and release it
+ *
+ * @param p_source the source
+ *
+ * @return void
+ */
+void reactor_release ( reactor_source *p_source );
+
+/** !
+ * Accept every pending connection on a listening socket
+ *
+ * @param p_source the listening source
+ *
+ * @return void
+ */
+void reactor_accept ( reactor_source *p_source );
+
+/** !
+ * Run the handler of a ready source, then wait for its next events
+ *
+ * @param p_parameter the source
+ *
+ * @return null
+ */
+void *reactor_dispatch ( void *p_parameter );
+
+/** !
+ * Add a connection accepted by a shard to the shard's reactor
+ *
+ * @param _socket_tcp the new socket
+ * @param ip_address  the IP address of the peer
+ * @param port_number the port number of the peer
+ * @param p_parameter the shard
+ *
+ * @return 1 on success, 0 on error
+ */
+int reactor_shard_accept ( socket_tcp _socket_tcp, socket_ip_address ip_address, socket_port port_number, void *const p_parameter );
+
+/** !
+ * Pin a shard to its core, then run its reactor until the shards stop
+ *
+ * @param p_parameter the shard
+ *
+ * @return null
+ */
+void *reactor_shard_work ( void *p_parameter );
+
+/** !
+ * Stop and release the first quantity shards, then release the group
+ *
+ * @param p_reactor_shards the reactor shards
+ * @param quantity         the quantity of constructed shards
+ *
+ * @return void
+ */
+void reactor_shards_release ( reactor_shards *p_reactor_shards, size_t quantity );
+
+// function definitions
+int reactor_construct ( reactor **pp_reactor, thread_pool *p_thread_pool )
+{
+
+    // argument check
+    if ( pp_reactor == (void *) 0 ) goto no_reactor;
+
+    // initialized data
+    reactor *p_reactor = default_allocator(0, sizeof(reactor));
+
+    // error check
+    if ( p_reactor == (void *) 0 ) goto no_mem;
+
+    // zero set the struct
+    memset(p_reactor, 0, sizeof(reactor));
+
+    // populate the struct
+    p_reactor->p_thread_pool = p_thread_pool;
+
+    // platform dependent implementation
+    #ifdef __linux__
+
+        // construct an epoll instance
+        p_reactor->descriptor = epoll_create1(EPOLL_CLOEXEC);
+        if ( p_reactor->descriptor == -1 ) goto failed_to_construct_backend;
+    #else
+
+        // epoll is linux only
+        goto unsupported_platform;
+    #endif
+
+    // construct a lock
+    mutex_create(&p_reactor->_lock);
+
+    // return a pointer to the caller
+    *pp_reactor = p_reactor;
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_reactor:
+                #ifndef NDEBUG
+                    log_error("[parallel] [reactor] Null pointer provided for parameter \"pp_reactor\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // parallel errors
+        {
+            #ifdef __linux__
+            failed_to_construct_backend:
+                #ifndef NDEBUG
+                    log_error("[parallel] [reactor] Failed to construct an event backend in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // release the reactor
+                p_reactor = default_allocator(p_reactor, 0);
+
+                // error
+                return 0;
+            #else
+            unsupported_platform:
+                #ifndef NDEBUG
+                    log_error("[parallel] [reactor] Reactors are not supported on this platform in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // release the reactor
+                p_reactor = default_allocator(p_reactor, 0);
+
+                // error
+                return 0;
+            #endif
+        }
+
+        // standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int reactor_shards_construct
+(
+    reactor_shards               **pp_reactor_shards,
+    size_t                         quantity,
+    enum socket_protocol_e         protocol,
+    enum socket_address_family_e   address_family,
+    socket_port                    port_number,
+    fn_reactor_handler            *pfn_handler,
+    void                          *p_parameter
+)
+{
+
+    // argument check
+    if ( pp_reactor_shards == (void *) 0 ) goto no_reactor_shards;
+    if ( pfn_handler       == (void *) 0 ) goto no_handler;
+    if ( protocol != socket_type_tcp && protocol != socket_type_udp ) goto wrong_protocol;
+
+    // initialized data
+    reactor_shards *p_reactor_shards = (void *) 0;
+    size_t          constructed      = 0;
+    int             cpus[REACTOR_CPUS_MAX];
+    int             cpu_quantity     = 0;
+
+    // platform dependent implementation
+    #ifdef __linux__
+    {
+
+        // initialized data
+        cpu_set_t _allowed;
+
+        // list the cores this process may run on
+        CPU_ZERO(&_allowed);
+        if ( sched_getaffinity(0, sizeof(_allowed), &_allowed) == 0 )
+            for (int i = 0; i < CPU_SETSIZE && cpu_quantity < REACTOR_CPUS_MAX; i++)
+                if ( CPU_ISSET(i, &_allowed) ) cpus[cpu_quantity++] = i;
+    }
+    #endif
+
+    // default to one shard per core
+    if ( quantity == 0 ) quantity = ( cpu_quantity ) ? (size_t) cpu_quantity : (size_t) sysconf(_SC_NPROCESSORS_ONLN);
+    if ( quantity == 0 ) quantity = 1;
+
+    // allocate memory for the shards
+    p_reactor_shards = default_allocator(0, sizeof(reactor_shards) + quantity * sizeof(struct reactor_shard_s));
+    if ( p_reactor_shards == (void *) 0 ) goto no_mem;
+
+    // zero set the struct
+    memset(p_reactor_shards, 0, sizeof(reactor_shards) + quantity * sizeof(struct reactor_shard_s));
+
+    // populate the struct
+    p_reactor_shards->protocol    = protocol;
+    p_reactor_shards->pfn_handler = pfn_handler;
+    p_reactor_shards->p_parameter = p_parameter;
+    p_reactor_shards->running     = true;
+
+    // construct each shard
+    for (constructed = 0; constructed < quantity; constructed++)
+    {
+
+        // initialized data
+        struct reactor_shard_s *p_shard = &p_reactor_shards->_shards[constructed];
+
+        // populate the shard
+        p_shard->p_reactor_shards = p_reactor_shards;
+        p_shard->cpu              = ( cpu_quantity ) ? cpus[constructed % (size_t) cpu_quantity] : -1;
+
+        // construct a reactor
+        if ( reactor_construct(&p_shard->p_reactor, (void *) 0) == 0 ) goto failed_to_construct_shard;
+
+        // accept connections on a socket that shares the port ...
+        if ( protocol == socket_type_tcp )
+        {
+            if ( socket_tcp_create_reuse_port(&p_shard->_socket, address_family, port_number) == 0 ) goto failed_to_construct_reactor;
+            if ( reactor_listen(p_shard->p_reactor, p_shard->_socket, reactor_shard_accept, p_shard) == 0 ) goto failed_to_listen;
+        }
+
+        // ... or receive datagrams on a socket that shares the port
+        else
+        {
+            if ( socket_udp_create_reuse_port(&p_shard->_socket, address_family, port_number) == 0 ) goto failed_to_construct_reactor;
+            if ( reactor_add(p_shard->p_reactor, p_shard->_socket, REACTOR_EVENT_READABLE, pfn_handler, p_parameter) == 0 ) goto failed_to_listen;
+        }
+
+        // the shard is constructed
+        p_reactor_shards->quantity++;
+
+        continue;
+
+        failed_to_listen:
+            socket_tcp_destroy(&p_shard->_socket);
+
+        failed_to_construct_reactor:
+            reactor_destroy(&p_shard->p_reactor);
+
+        failed_to_construct_shard:
+            goto failed_to_construct_shards;
+    }
+
+    // start each shard
+    for (size_t i = 0; i < quantity; i++)
+        if ( parallel_thread_start(&p_reactor_shards->_shards[i].p_thread, reactor_shard_work, &p_reactor_shards->_shards[i]) == 0 ) goto failed_to_start_shards;
+
+    // return a pointer to the caller
+    *pp_reactor_shards = p_reactor_shards;
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_reactor_shards:
+                #ifndef NDEBUG
+                    log_error("[parallel] [reactor] Null pointer provided for parameter \"pp_reactor_shards\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_handler:
+                #ifndef NDEBUG
+                    log_error("[parallel] [reactor] Null pointer provided for parameter \"pfn_handler\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            wrong_protocol:
+                #ifndef NDEBUG
+                    log_error("[parallel] [reactor] Parameter \"protocol\" must be socket_type_tcp or socket_type_udp in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // parallel errors
+        {
+            failed_to_construct_shards:
+                #ifndef NDEBUG
+                    log_error("[parallel] [reactor] Failed to construct shard %zu in call to function \"%s\"\n", constructed, __FUNCTION__);
+                #endif
+
+                // release the shards
+                reactor_shards_release(p_reactor_shards, p_reactor_shards->quantity);
+
+                // error
+                return 0;
+
+            failed_to_start_shards:
+                #ifndef NDEBUG
+                    log_error("[parallel] [reactor] Failed to start shards in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // release the shards
+                reactor_shards_release(p_reactor_shards, p_reactor_shards->quantity);
+
+                // error
+                return 0;
+        }
+
+        // standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int reactor_listen ( reactor *p_reactor, socket_tcp _socket_tcp, fn_socket_tcp_accept pfn_tcp_accept_callback, void *const p_parameter )
+{
+
+    // argument check
+    if ( p_reactor               == (void *) 0 ) goto no_reactor;
+    if ( pfn_tcp_accept_callback == (void *) 0 ) goto no_accept_callback;
+
+    // initialized data
+    reactor_source *p_source = (void *) 0;
+
+    // platform dependent implementation
+    #ifdef __linux__
+
+        // listen with a full backlog
+        if ( listen(_socket_tcp, SOMAXCONN) == -1 ) goto failed_to_listen;
+
+        // accept without blocking
+        if ( fcntl(_socket_tcp, F_SETFL, fcntl(_socket_tcp, F_GETFL, 0) | O_NONBLOCK) == -1 ) goto failed_to_listen;
+    #endif
+
+    // allocate memory for the source
+    p_source = default_allocator(0, sizeof(reactor_source));
+    if ( p_source == (void *) 0 ) goto no_mem;
+
+    // populate the source
+    *p_source = (reactor_source)
+    {
+        .p_reactor   = p_reactor,
+        ._socket_tcp = _socket_tcp,
+        .listener    = true,
+        .pfn_accept  = pfn_tcp_accept_callback,
+        .p_parameter = p_parameter
+    };
+
+    // register the source
+    if ( reactor_register(p_reactor, p_source, REACTOR_EVENT_READABLE) == 0 ) goto failed_to_register;
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_reactor:
+                #ifndef NDEBUG
+                    log_error("[parallel] [reactor] Null pointer provided for parameter \"p_reactor\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_accept_callback:
+                #ifndef NDEBUG
+                    log_error("[parallel] [reactor] Null pointer provided for parameter \"pfn_tcp_accept_callback\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // socket errors
+        {
+            #ifdef __linux__
+                failed_to_listen:
+                    #ifndef NDEBUG
+                        log_error("[parallel] [reactor] Call to function \"listen\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                    #endif
+
+                    // error
+                    return 0;
+            #endif
+
+            failed_to_register:
+                #ifndef NDEBUG
+                    log_error("[parallel] [reactor] Failed to register socket in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // release the source
+                p_source = default_allocator(p_source, 0);
+
+                // error
+                return 0;
+        }
+
+        // standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int reactor_add ( reactor *p_reactor, socket_tcp _socket_tcp, int events, fn_reactor_handler *pfn_handler, void *p_parameter )
+{
+
+    // argument check
+    if ( p_reactor   == (void *) 0 ) goto no_reactor;
+    if ( pfn_handler == (void *) 0 ) goto no_handler;
+
+    // initialized data
+    reactor_source *p_source = (void *) 0;
+
+    // platform dependent implementation
+    #ifdef __linux__
+
+        // make the socket non blocking
+        if ( fcntl(_socket_tcp, F_SETFL, fcntl(_socket_tcp, F_GETFL, 0) | O_NONBLOCK) == -1 ) goto failed_to_register;
+    #endif
+
+    // allocate memory for the source
+    p_source = default_allocator(0, sizeof(reactor_source));
+    if ( p_source == (void *) 0 ) goto no_mem;
+
+    // populate the source
+    *p_source = (reactor_source)
+    {
+        .p_reactor   = p_reactor,
+        ._socket_tcp = _socket_tcp,
+        .listener    = false,
+        .pfn_handler = pfn_handler,
+        .p_parameter = p_parameter
+    };
+
+    // register the source
+    if ( reactor_register(p_reactor, p_source, events) == 0 ) goto failed_to_register;
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_reactor:
+                #ifndef NDEBUG
+                    log_error("[parallel] [reactor] Null pointer provided for parameter \"p_reactor\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_handler:
+                #ifndef NDEBUG
+                    log_error("[parallel] [reactor] Null pointer provided for parameter \"pfn_handler\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // socket errors
+        {
+            failed_to_register:
+                #ifndef NDEBUG
+                    log_error("[parallel] [reactor] Failed to register socket in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // release the source
+                if ( p_source ) p_source = default_allocator(p_source, 0);
+
+                // error
+                return 0;
+        }
+
+        // standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int reactor_run ( reactor *p_reactor, int timeout )
+{
+
+    // argument check
+    if ( p_reactor == (void *) 0 ) goto no_reactor;
+
+    // initialized data
+    int quantity = 0;
+
+    // platform dependent implementation
+    #ifdef __linux__
+
+        // initialized data
+        struct epoll_event _events[REACTOR_EVENTS_MAX];
+
+        // wait for ready sockets
+        do quantity = epoll_wait(p_reactor->descriptor, _events, REACTOR_EVENTS_MAX, timeout);
+        while ( quantity == -1 && errno == EINTR );
+
+        // error check
+        if ( quantity == -1 ) goto failed_to_wait;
+
+        // count the handlers before any of them run
+        mutex_lock(&p_reactor->_lock);
+        p_reactor->pending += (size_t) quantity;
+        mutex_unlock(&p_reactor->_lock);
+
+        // dispatch each ready socket
+        for (int i = 0; i < quantity; i++)
+        {
+
+            // initialized data
+            reactor_source *p_source = _events[i].data.ptr;
+
+            // store the ready events. Sources are registered one shot,
+            // so no other thread touches this source until it is rearmed
+            p_source->ready = 0;
+            if ( _events[i].events & EPOLLIN )                                p_source->ready |= REACTOR_EVENT_READABLE;
+            if ( _events[i].events & EPOLLOUT )                               p_source->ready |= REACTOR_EVENT_WRITABLE;
+            if ( _events[i].events & ( EPOLLHUP | EPOLLRDHUP | EPOLLERR ) ) p_source->ready |= REACTOR_EVENT_HANGUP;
+
+            // run the handler on the thread pool ...
+            if ( p_reactor->p_thread_pool && thread_pool_execute(p_reactor->p_thread_pool, reactor_dispatch, p_source) ) continue;
+
+            // ... or on this thread
+            reactor_dispatch(p_source);
+        }
+    #else
+
+        // unused
+        (void) timeout;
+
+        // epoll is linux only
+        goto unsupported_platform;
+    #endif
+
+    // success
+    return quantity;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_reactor:
+                #ifndef NDEBUG
+                    log_error("[parallel] [reactor] Null pointer provided for parameter \"p_reactor\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return -1;
+        }
+
+        // parallel errors
+        {
+            #ifdef __linux__
+            failed_to_wait:
+                #ifndef NDEBUG
+                    log_error("[parallel] [reactor] Failed to wait for events in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return -1;
+            #else
+            unsupported_platform:
+                #ifndef NDEBUG
+                    log_error("[parallel] [reactor] Reactors are not supported on this platform in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return -1;
+            #endif
+        }
+    }
+}
+
+size_t reactor_connections ( reactor *p_reactor )
+{
+
+    // argument check
+    if ( p_reactor == (void *) 0 ) goto no_reactor;
+
+    // initialized data
+    size_t result = 0;
+
+    // lock
+    mutex_lock(&p_reactor->_lock);
+
+    // store the quantity of connections
+    result = p_reactor->connections;
+
+    // unlock
+    mutex_unlock(&p_reactor->_lock);
+
+    // success
+    return result;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_reactor:
+                #ifndef NDEBUG
+                    log_error("[parallel] [reactor] Null pointer provided for parameter \"p_reactor\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+size_t reactor_shards_connections ( reactor_shards *p_reactor_shards )
+{
+
+    // argument check
+    if ( p_reactor_shards == (void *) 0 ) goto no_reactor_shards;
+
+    // initialized data
+    size_t result = 0;
+
+    // datagram sockets are not connections
+    if ( p_reactor_shards->protocol == socket_type_udp ) return 0;
+
+    // sum the connections each shard accepted
+    for (size_t i = 0; i < p_reactor_shards->quantity; i++)
+        result += reactor_connections(p_reactor_shards->_shards[i].p_reactor);
+
+    // success
+    return result;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_reactor_shards:
+                #ifndef NDEBUG
+                    log_error("[parallel] [reactor] Null pointer provided for parameter \"p_reactor_shards\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int reactor_destroy ( reactor **pp_reactor )
+{
+
+    // argument check
+    if ( pp_reactor == (void *) 0 ) goto no_reactor;
+
+    // initialized data
+    reactor *p_reactor = *pp_reactor;
+
+    // fast exit
+    if ( p_reactor == (void *) 0 ) return 1;
+
+    // no more pointer for caller
+    *pp_reactor = (void *) 0;
+
+    // wait for running handlers
+    while ( true )
+    {
+
+        // initialized data
+        size_t pending = 0;
+
+        // lock
+        mutex_lock(&p_reactor->_lock);
+
+        // store the counter
+        pending = p_reactor->pending;
+
+        // unlock
+        mutex_unlock(&p_reactor->_lock);
+
+        // done?
+        if ( pending == 0 ) break;
+
+        // wait for handlers on the thread pool
+        sleep(0);
+    }
+
+    // release every source
+    while ( p_reactor->p_sources )
+    {
+
+        // initialized data
+        reactor_source *p_source = p_reactor->p_sources;
+
+        // listening sockets belong to the caller
+        if ( p_source->listener )
+        {
+            p_reactor->p_sources = p_source->p_next;
+            p_source = default_allocator(p_source, 0);
+            continue;
+        }
+
+        // release the source, and its socket
+        reactor_release(p_source);
+    }
+
+    // release the backend
+    #ifdef __linux__
+        close(p_reactor->descriptor);
+    #endif
+
+    // release the lock
+    mutex_destroy(&p_reactor->_lock);
+
+    // release the reactor
+    p_reactor = default_allocator(p_reactor, 0);
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_reactor:
+                #ifndef NDEBUG
+                    log_error("[parallel] [reactor] Null pointer provided for parameter \"pp_reactor\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int reactor_shards_destroy ( reactor_shards **pp_reactor_shards )
+{
+
+    // argument check
+    if ( pp_reactor_shards == (void *) 0 ) goto no_reactor_shards;
+
+    // initialized data
+    reactor_shards *p_reactor_shards = *pp_reactor_shards;
+
+    // fast exit
+    if ( p_reactor_shards == (void *) 0 ) return 1;
+
+    // no more pointer for caller
+    *pp_reactor_shards = (void *) 0;
+
+    // release the shards
+    reactor_shards_release(p_reactor_shards, p_reactor_shards->quantity);
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_reactor_shards:
+                #ifndef NDEBUG
+                    log_error("[parallel] [reactor] Null pointer provided for parameter \"pp_reactor_shards\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int reactor_register ( reactor *p_reactor, reactor_source *p_source, int events )
+{
+
+    // lock
+    mutex_lock(&p_reactor->_lock);
+
+    // link the source
+    p_source->p_prev = (void *) 0;
+    p_source->p_next = p_reactor->p_sources;
+    if ( p_reactor->p_sources ) p_reactor->p_sources->p_prev = p_source;
+    p_reactor->p_sources = p_source;
+
+    // count connections
+    if ( p_source->listener == false ) p_reactor->connections++;
+
+    // unlock
+    mutex_unlock(&p_reactor->_lock);
+
+    // wait for the first events
+    #ifdef __linux__
+    {
+
+        // initialized data
+        struct epoll_event _event = { .events = EPOLLRDHUP | EPOLLONESHOT, .data.ptr = p_source };
+
+        // translate the events
+        if ( events & REACTOR_EVENT_READABLE ) _event.events |= EPOLLIN;
+        if ( events & REACTOR_EVENT_WRITABLE ) _event.events |= EPOLLOUT;
+
+        // add the socket
+        if ( epoll_ctl(p_reactor->descriptor, EPOLL_CTL_ADD, p_source->_socket_tcp, &_event) == 0 ) return 1;
+    }
+    #else
+        (void) events;
+    #endif
+
+    // lock
+    mutex_lock(&p_reactor->_lock);
+
+    // unlink the source
+    if ( p_source->p_prev ) p_source->p_prev->p_next = p_source->p_next;
+    else                    p_reactor->p_sources     = p_source->p_next;
+    if ( p_source->p_next ) p_source->p_next->p_prev = p_source->p_prev;
+
+    // uncount connections
+    if ( p_source->listener == false ) p_reactor->connections--;
+
+    // unlock
+    mutex_unlock(&p_reactor->_lock);
+
+    // error
+    return 0;
+}
+
+int reactor_rearm ( reactor_source *p_source, int events )
+{
+
+    // platform dependent implementation
+    #ifdef __linux__
+
+        // initialized data
+        struct epoll_event _event = { .events = EPOLLRDHUP | EPOLLONESHOT, .data.ptr = p_source };
+
+        // translate the events
+        if ( events & REACTOR_EVENT_READABLE ) _event.events |= EPOLLIN;
+        if ( events & REACTOR_EVENT_WRITABLE ) _event.events |= EPOLLOUT;
+
+        // wait for the next events
+        return ( epoll_ctl(p_source->p_reactor->descriptor, EPOLL_CTL_MOD, p_source->_socket_tcp, &_event) == 0 );
+    #else
+
+        // unused
+        (void) p_source;
+        (void) events;
+
+        // error
+        return 0;
+    #endif
+}
+
+void reactor_release ( reactor_source *p_source )
+{
+
+    // initialized data
+    reactor *p_reactor = p_source->p_reactor;
+
+    // stop waiting on the socket
+    #ifdef __linux__
+        epoll_ctl(p_reactor->descriptor, EPOLL_CTL_DEL, p_source->_socket_tcp, (void *) 0);
+    #endif
+
+    // lock
+    mutex_lock(&p_reactor->_lock);
+
+    // unlink the source
+    if ( p_source->p_prev ) p_source->p_prev->p_next = p_source->p_next;
+    else                    p_reactor->p_sources     = p_source->p_next;
+    if ( p_source->p_next ) p_source->p_next->p_prev = p_source->p_prev;
+
+    // uncount the connection
+    p_reactor->connections--;
+
+    // unlock
+    mutex_unlock(&p_reactor->_lock);
+
+    // destroy the socket
+    socket_tcp_destroy(&p_source->_socket_tcp);
+
+    // release the source
+    p_source = default_allocator(p_source, 0);
+
+    // done
+    return;
+}
+
+void reactor_accept ( reactor_source *p_source )
+{
+
+    // platform dependent implementation
+    #ifdef __linux__
+
+        // accept until the backlog is empty
+        while ( true )
+        {
+
+            // initialized data
+            struct sockaddr_storage peer_addr  = { 0 };
+            socklen_t               addr_len   = sizeof(peer_addr);
+            socket_ip_address       ip_address = { 0 };
+            socket_port             port       = 0;
+            socket_tcp              new_socket = accept(p_source->_socket_tcp, (struct sockaddr *)&peer_addr, &addr_len);
+
+            // error check
+            if ( new_socket == -1 )
+            {
+
+                // the backlog is empty, or the process is out of descriptors
+                if ( errno != EINTR && errno != ECONNABORTED ) break;
+
+                // try again
+                continue;
+            }
+
+            // store the type
+            ip_address._type = (enum socket_address_family_e) peer_addr.ss_family;
+
+            // store the address, and the port
+            if ( peer_addr.ss_family == AF_INET )
+            {
+                struct sockaddr_in *s = (struct sockaddr_in *)&peer_addr;
+                ip_address._address.ipv4 = ntohl(s->sin_addr.s_addr);
+                port = ntohs(s->sin_port);
+            }
+            else if ( peer_addr.ss_family == AF_INET6 )
+            {
+                struct sockaddr_in6 *s = (struct sockaddr_in6 *)&peer_addr;
+                memcpy(ip_address._address.ipv6, s->sin6_addr.s6_addr, 16);
+                port = ntohs(s->sin6_port);
+            }
+
+            // callback
+            p_source->pfn_accept(new_socket, ip_address, port, p_source->p_parameter);
+        }
+    #else
+
+        // unused
+        (void) p_source;
+    #endif
+
+    // done
+    return;
+}
+
+void *reactor_dispatch ( void *p_parameter )
+{
+
+    // initialized data
+    reactor_source *p_source  = p_parameter;
+    reactor        *p_reactor = p_source->p_reactor;
+    int             events    = REACTOR_EVENT_READABLE;
+
+    // accept connections ...
+    if ( p_source->listener ) reactor_accept(p_source);
+
+    // ... or run the handler
+    else events = p_source->pfn_handler(p_reactor, p_source->_socket_tcp, p_source->ready, p_source->p_parameter);
+
+    // wait for the next events, or release the source
+    if ( events == 0 || reactor_rearm(p_source, events) == 0 )
+    {
+        if ( p_source->listener == false ) reactor_release(p_source);
+    }
+
+    // lock
+    mutex_lock(&p_reactor->_lock);
+
+    // decrement the counter
+    p_reactor->pending--;
+
+    // unlock
+    mutex_unlock(&p_reactor->_lock);
+
+    // done
+    return (void *) 0;
+}
+
+int reactor_shard_accept ( socket_tcp _socket_tcp, socket_ip_address ip_address, socket_port port_number, void *const p_parameter )
+{
+
+    // unused
+    (void) ip_address;
+    (void) port_number;
+
+    // initialized data
+    struct reactor_shard_s *p_shard          = p_parameter;
+    reactor_shards         *p_reactor_shards = p_shard->p_reactor_shards;
+
+    // wait for the connection on the shard that accepted it
+    if ( reactor_add(p_shard->p_reactor, _socket_tcp, REACTOR_EVENT_READABLE, p_reactor_shards->pfn_handler, p_reactor_shards->p_parameter) ) return 1;
+
+    // drop the connection
+    socket_tcp_destroy(&_socket_tcp);
+
+    // error
+    return 0;
+}
+
+void *reactor_shard_work ( void *p_parameter )
+{
+
+    // initialized data
+    struct reactor_shard_s *p_shard          = p_parameter;
+    reactor_shards         *p_reactor_shards = p_shard->p_reactor_shards;
+
+    // pin the shard to its core
+    #ifdef __linux__
+        if ( p_shard->cpu != -1 )
+        {
+
+            // initialized data
+            cpu_set_t _cpu;
+
+            // pin
+            CPU_ZERO(&_cpu);
+            CPU_SET(p_shard->cpu, &_cpu);
+            pthread_setaffinity_np(pthread_self(), sizeof(_cpu), &_cpu);
+        }
+    #endif
+
+    // run the reactor until the shards stop
+    while ( __atomic_load_n(&p_reactor_shards->running, __ATOMIC_ACQUIRE) )
+        if ( reactor_run(p_shard->p_reactor, REACTOR_SHARD_TIMEOUT) == -1 ) break;
+
+    // done
+    return (void *) 0;
+}
+
+void reactor_shards_release ( reactor_shards *p_reactor_shards, size_t quantity )
+{
+
+    // stop the shards
+    __atomic_store_n(&p_reactor_shards->running, false, __ATOMIC_RELEASE);
+
+    // release each shard
+    for (size_t i = 0; i < quantity; i++)
+    {
+
+        // initialized data
+        struct reactor_shard_s *p_shard = &p_reactor_shards->_shards[i];
+
+        // wait for the shard, and release its thread
+        if ( p_shard->p_thread ) parallel_thread_join(&p_shard->p_thread);
+
+        // release the reactor, and every connection
+        reactor_destroy(&p_shard->p_reactor);
+
+        // release the listening socket. Datagram sockets were released with the reactor
+        if ( p_reactor_shards->protocol == socket_type_tcp ) socket_tcp_destroy(&p_shard->_socket);
+    }
+
+    // release the shards
+    p_reactor_shards = default_allocator(p_reactor_shards, 0);
+
+    // done
+    return;
+}
@@ -0,0 +1,185 @@
+/** !
+ * Socket reactor interface
+ *
+ * @file src/performance/parallel/reactor.h
+ *
+ * @author Jacob Smith
+ */
+
+// header guard
+#pragma once
+
+// standard library
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+// gsdk
+/// core
+#include <core/log.h>
+#include <core/sync.h>
+#include <core/socket.h>
+#include <core/tcp.h>
+#include <core/udp.h>
+
+/// performance
+#include <performance/parallel.h>
+#include <performance/thread.h>
+#include <performance/thread_pool.h>
+
+// enumeration definitions
+enum reactor_event_e
+{
+    REACTOR_EVENT_READABLE = 1,
+    REACTOR_EVENT_WRITABLE = 2,
+    REACTOR_EVENT_HANGUP   = 4
+};
+
+// structure declarations
+struct reactor_s;
+struct reactor_shards_s;
+
+// type definitions
+typedef struct reactor_s        reactor;
+typedef struct reactor_shards_s reactor_shards;
+
+/** !
+ * Called when a socket that was added to a reactor is ready
+ *
+ * @param p_reactor   the reactor
+ * @param _socket_tcp the socket
+ * @param events      the ready events, a combination of enum reactor_event_e
+ * @param p_parameter the parameter that was added with the socket
+ *
+ * @return the events to wait for next, or 0 to remove and destroy the socket
+ */
+typedef int (fn_reactor_handler) ( reactor *p_reactor, socket_tcp _socket_tcp, int events, void *p_parameter );
+
+// function declarations
+/// constructors
+/** !
+ * Construct a reactor. A reactor waits on many non blocking sockets at
+ * once, and calls a handler for each socket that is ready. A socket is
+ * never handled by two threads at the same time. The reactor uses epoll,
+ * so construction fails on platforms other than linux.
+ *
+ * @param pp_reactor    result
+ * @param p_thread_pool the thread pool that runs handlers, or null to run them in reactor_run
+ *
+ * @return 1 on success, 0 on error
+ */
+int reactor_construct ( reactor **pp_reactor, thread_pool *p_thread_pool );
+
+/** !
+ * Construct a group of reactors that share a port. Each shard is a
+ * thread pinned to its own core, running its own reactor on its own
+ * SO_REUSEPORT socket, so the kernel balances connections or datagrams
+ * across the cores, and shards never contend with each other.
+ *
+ * TCP shards accept connections, and add them to the accepting shard's
+ * reactor, waiting for REACTOR_EVENT_READABLE. UDP shards add their
+ * datagram socket to their reactor, so the handler receives it. 
+ *
+ * @param pp_reactor_shards result
+ * @param quantity          the quantity of shards, or 0 for one per online core
+ * @param protocol          socket_type_tcp -or- socket_type_udp
+ * @param address_family    socket_address_family_ipv4 -or- socket_address_family_ipv6
+ * @param port_number       the port number
+ * @param pfn_handler       the handler
+ * @param p_parameter       the parameter of the handler
+ *
+ * @return 1 on success, 0 on error
+ */
+int reactor_shards_construct
+(
+    reactor_shards               **pp_reactor_shards,
+    size_t                         quantity,
+    enum socket_protocol_e         protocol,
+    enum socket_address_family_e   address_family,
+    socket_port                    port_number,
+    fn_reactor_handler            *pfn_handler,
+    void                          *p_parameter
+);
+
+/// sources
+/** !
+ * Listen on a TCP socket with a full backlog. Each time reactor_run
+ * finds the socket readable, every pending connection is accepted, and
+ * passed to pfn_tcp_accept_callback, which owns the new socket.
+ *
+ * @param p_reactor               the reactor
+ * @param _socket_tcp             the listening TCP socket
+ * @param pfn_tcp_accept_callback a callback function parameterized with the new socket, the IP address, and the port number
+ * @param p_parameter             the parameter of the callback
+ *
+ * @sa socket_tcp_listen
+ *
+ * @return 1 on success, 0 on error
+ */
+int reactor_listen ( reactor *p_reactor, socket_tcp _socket_tcp, fn_socket_tcp_accept pfn_tcp_accept_callback, void *const p_parameter );
+
+/** !
+ * Make a TCP socket non blocking, and add it to a reactor. The reactor
+ * owns the socket until the handler returns 0.
+ *
+ * @param p_reactor   the reactor
+ * @param _socket_tcp the TCP socket
+ * @param events      the events to wait for, a combination of enum reactor_event_e
+ * @param pfn_handler the handler
+ * @param p_parameter the parameter of the handler
+ *
+ * @return 1 on success, 0 on error
+ */
+int reactor_add ( reactor *p_reactor, socket_tcp _socket_tcp, int events, fn_reactor_handler *pfn_handler, void *p_parameter );
+
+/// run
+/** !
+ * Wait for ready sockets, and dispatch their handlers
+ *
+ * @param p_reactor the reactor
+ * @param timeout   milliseconds to wait for a ready socket, 0 to return immediately, or -1 to wait indefinitely
+ *
+ * @return the quantity of dispatched sockets on success, -1 on error
+ */
+int reactor_run ( reactor *p_reactor, int timeout );
+
+/// accessors
+/** !
+ * Get the quantity of sockets added to a reactor, excluding listeners
+ *
+ * @param p_reactor the reactor
+ *
+ * @return the quantity of sockets
+ */
+size_t reactor_connections ( reactor *p_reactor );
+
+/** !
+ * Get the quantity of connections accepted by every TCP shard. UDP
+ * shards have no connections, so this is always 0 for them.
+ *
+ * @param p_reactor_shards the reactor shards
+ *
+ * @return the quantity of connections
+ */
+size_t reactor_shards_connections ( reactor_shards *p_reactor_shards );
+
+/// destructors
+/** !
+ * Wait for running handlers, destroy every added socket, then destroy
+ * a reactor. Listening sockets are not destroyed.
+ *
+ * @param pp_reactor pointer to reactor pointer
+ *
+ * @return 1 on success, 0 on error
+ */
+int reactor_destroy ( reactor **pp_reactor );
+
+/** !
+ * Stop every shard, then destroy their reactors, and their sockets
+ *
+ * @param pp_reactor_shards pointer to reactor shards pointer
+ *
+ * @return 1 on success, 0 on error
+ */
+int reactor_shards_destroy ( reactor_shards **pp_reactor_shards );
@@ -0,0 +1,585 @@
+/** !
+ * Caching resolver implementation
+ *
+ * @file src/performance/parallel/resolver.c
+ *
+ * @author Jacob Smith
+ */
+
+// header file
+#include <performance/resolver.h>
+
+// structure definitions
+struct resolver_entry_s
+{
+    unsigned long long sequence;
+    unsigned long long hash;
+    timestamp          expires;
+    size_t             length;
+    int                quantity;
+    char               _hostname[RESOLVER_HOSTNAME_MAX];
+    socket_ip_address  _ip_addresses[RESOLVER_ADDRESSES_MAX];
+};
+
+struct resolver_job_s
+{
+    resolver             *p_resolver;
+    fn_resolver_callback *pfn_callback;
+    void                 *p_parameter;
+    char                  _hostname[RESOLVER_HOSTNAME_MAX];
+};
+
+struct resolver_s
+{
+    mutex                    _lock;
+    condition_variable       _idle;
+    thread_pool             *p_thread_pool;
+    timestamp                ttl, negative_ttl;
+    size_t                   pending;
+    size_t                   sets;
+    struct resolver_entry_s  _entries[];
+};
+
+// function declarations
+/** !
+ * Hash a hostname
+ *
+ * @param p_hostname the hostname
+ * @param length     the length of the hostname
+ *
+ * @return the hash
+ */
+unsigned long long resolver_hash ( const char *p_hostname, size_t length );
+
+/** !
+ * Search the cache for a hostname without taking the lock. Writers bump
+ * the sequence of an entry before and after they change it, so a reader
+ * retries until it copies an entry that did not change under it.
+ *
+ * @param p_resolver     the resolver
+ * @param p_hostname     the hostname
+ * @param length         the length of the hostname
+ * @param hash           the hash of the hostname
+ * @param p_ip_addresses result
+ * @param p_quantity     result
+ *
+ * @return true on hit, false on miss
+ */
+bool resolver_lookup ( resolver *p_resolver, const char *p_hostname, size_t length, unsigned long long hash, socket_ip_address *p_ip_addresses, int *p_quantity );
+
+/** !
+ * Store a hostname in the cache, replacing the same hostname, or the
+ * entry of its set that expires first
+ *
+ * @param p_resolver     the resolver
+ * @param p_hostname     the hostname
+ * @param length         the length of the hostname
+ * @param hash           the hash of the hostname
+ * @param p_ip_addresses the IP addresses
+ * @param quantity       the quantity of IP addresses
+ *
+ * @return void
+ */
+void resolver_store ( resolver *p_resolver, const char *p_hostname, size_t length, unsigned long long hash, socket_ip_address *p_ip_addresses, int quantity );
+
+/** !
+ * Resolve a hostname on the thread pool, then call the callback
+ *
+ * @param p_parameter the job
+ *
+ * @return null
+ */
+void *resolver_work ( void *p_parameter );
+
+// function definitions
+int resolver_construct ( resolver **pp_resolver, thread_pool *p_thread_pool, size_t capacity, size_t ttl, size_t negative_ttl )
+{
+
+    // argument check
+    if ( pp_resolver == (void *) 0 ) goto no_resolver;
+    if ( capacity    ==          0 ) goto no_capacity;
+
+    // initialized data
+    resolver *p_resolver = (void *) 0;
+    size_t    sets       = 1;
+
+    // round the quantity of sets up to a power of two
+    while ( sets * RESOLVER_WAYS < capacity ) sets <<= 1;
+
+    // allocate memory for the resolver
+    p_resolver = default_allocator(0, sizeof(resolver) + sets * RESOLVER_WAYS * sizeof(struct resolver_entry_s));
+
+    // error check
+    if ( p_resolver == (void *) 0 ) goto no_mem;
+
+    // zero set the struct
+    memset(p_resolver, 0, sizeof(resolver) + sets * RESOLVER_WAYS * sizeof(struct resolver_entry_s));
+
+    // populate the struct
+    p_resolver->p_thread_pool = p_thread_pool,
+    p_resolver->ttl           = (timestamp) ttl * timer_seconds_divisor() / 1000,
+    p_resolver->negative_ttl  = (timestamp) negative_ttl * timer_seconds_divisor() / 1000,
+    p_resolver->sets          = sets;
+
+    // construct a lock
+    if ( 0 == mutex_create(&p_resolver->_lock) ) goto failed_to_create_mutex;
+
+    // construct a condition variable
+    if ( 0 == condition_variable_create(&p_resolver->_idle) ) goto failed_to_create_condition_variable;
+
+    // return a pointer to the caller
+    *pp_resolver = p_resolver;
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_resolver:
+                #ifndef NDEBUG
+                    log_error("[parallel] [resolver] Null pointer provided for parameter \"pp_resolver\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_capacity:
+                #ifndef NDEBUG
+                    log_error("[parallel] [resolver] Parameter \"capacity\" must be greater than 0 in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // sync errors
+        {
+            failed_to_create_condition_variable:
+
+                // release the lock
+                mutex_destroy(&p_resolver->_lock);
+
+                // fall through
+
+            failed_to_create_mutex:
+                #ifndef NDEBUG
+                    log_error("[parallel] [resolver] Failed to construct synchronization primitives in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // release the resolver
+                default_allocator(p_resolver, 0);
+
+                // error
+                return 0;
+        }
+    }
+}
+
+unsigned long long resolver_hash ( const char *p_hostname, size_t length )
+{
+
+    // initialized data
+    unsigned long long h = 0xcbf29ce484222325ULL;
+
+    // FNV-1a
+    for (size_t i = 0; i < length; i++)
+        h = ( h ^ (unsigned char) p_hostname[i] ) * 0x100000001b3ULL;
+
+    // done
+    return h;
+}
+
+bool resolver_lookup ( resolver *p_resolver, const char *p_hostname, size_t length, unsigned long long hash, socket_ip_address *p_ip_addresses, int *p_quantity )
+{
+
+    // initialized data
+    struct resolver_entry_s *p_set = &p_resolver->_entries[( hash & ( p_resolver->sets - 1 ) ) * RESOLVER_WAYS];
+    timestamp                now   = timer_high_precision();
+
+    // search the set
+    for (size_t i = 0; i < RESOLVER_WAYS; i++)
+    {
+
+        // initialized data
+        struct resolver_entry_s *p_entry  = &p_set[i];
+        unsigned long long       before   = 0,
+                                 after    = 0;
+        timestamp                expires  = 0;
+        int                      quantity = 0;
+        bool                     match    = false;
+
+        // copy the entry until it is stable
+        do
+        {
+
+            // wait for the writer
+            while ( ( before = __atomic_load_n(&p_entry->sequence, __ATOMIC_ACQUIRE) ) & 1 ) ;
+
+            // compare the hostname
+            match = p_entry->hash   == hash   &&
+                    p_entry->length == length &&
+                    0 == memcmp(p_entry->_hostname, p_hostname, length);
+
+            // copy the result
+            if ( match )
+            {
+                expires  = p_entry->expires,
+                quantity = p_entry->quantity;
+                if ( quantity > 0 && quantity <= RESOLVER_ADDRESSES_MAX ) memcpy(p_ip_addresses, p_entry->_ip_addresses, (size_t) quantity * sizeof(socket_ip_address));
+            }
+
+            // order the copy before the second load
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+            // store the sequence
+            after = __atomic_load_n(&p_entry->sequence, __ATOMIC_RELAXED);
+
+        } while ( before != after );
+
+        // different hostname
+        if ( false == match ) continue;
+
+        // expired
+        if ( now >= expires ) return false;
+
+        // hit
+        *p_quantity = quantity;
+
+        // success
+        return true;
+    }
+
+    // miss
+    return false;
+}
+
+void resolver_store ( resolver *p_resolver, const char *p_hostname, size_t length, unsigned long long hash, socket_ip_address *p_ip_addresses, int quantity )
+{
+
+    // initialized data
+    struct resolver_entry_s *p_set   = &p_resolver->_entries[( hash & ( p_resolver->sets - 1 ) ) * RESOLVER_WAYS];
+    struct resolver_entry_s *p_entry = &p_set[0];
+    timestamp                now     = timer_high_precision();
+
+    // lock
+    mutex_lock(&p_resolver->_lock);
+
+    // find the same hostname, else the entry that expires first
+    for (size_t i = 0; i < RESOLVER_WAYS; i++)
+    {
+
+        // same hostname
+        if ( p_set[i].hash == hash && p_set[i].length == length && 0 == memcmp(p_set[i]._hostname, p_hostname, length) ) { p_entry = &p_set[i]; break; }
+
+        // expires first
+        if ( p_set[i].expires < p_entry->expires ) p_entry = &p_set[i];
+    }
+
+    // begin writing
+    __atomic_store_n(&p_entry->sequence, p_entry->sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    // write the entry
+    p_entry->hash     = hash,
+    p_entry->length   = length,
+    p_entry->quantity = quantity,
+    p_entry->expires  = now + ( ( quantity > 0 ) ? p_resolver->ttl : p_resolver->negative_ttl );
+    memcpy(p_entry->_hostname, p_hostname, length);
+    if ( quantity > 0 ) memcpy(p_entry->_ip_addresses, p_ip_addresses, (size_t) quantity * sizeof(socket_ip_address));
+
+    // end writing
+    __atomic_store_n(&p_entry->sequence, p_entry->sequence + 1, __ATOMIC_RELEASE);
+
+    // unlock
+    mutex_unlock(&p_resolver->_lock);
+
+    // done
+    return;
+}
+
+int resolver_resolve ( resolver *p_resolver, socket_ip_address *p_ip_addresses, size_t limit, const char *restrict p_hostname )
+{
+
+    // argument check
+    if ( p_resolver     == (void *) 0 ) goto no_resolver;
+    if ( p_ip_addresses == (void *) 0 ) goto no_ip_addresses;
+    if ( p_hostname     == (void *) 0 ) goto no_hostname;
+
+    // initialized data
+    socket_ip_address  _ip_addresses[RESOLVER_ADDRESSES_MAX] = { 0 };
+    size_t             length                                = strlen(p_hostname);
+    unsigned long long hash                                  = 0;
+    int                quantity                              = 0;
+
+    // the hostname can not be cached
+    if ( length >= RESOLVER_HOSTNAME_MAX ) return socket_resolve_host(p_ip_addresses, limit, p_hostname);
+
+    // hash the hostname
+    hash = resolver_hash(p_hostname, length);
+
+    // miss
+    if ( false == resolver_lookup(p_resolver, p_hostname, length, hash, _ip_addresses, &quantity) )
+    {
+
+        // resolve the hostname
+        quantity = socket_resolve_host(_ip_addresses, RESOLVER_ADDRESSES_MAX, p_hostname);
+
+        // cache the result
+        resolver_store(p_resolver, p_hostname, length, hash, _ip_addresses, quantity);
+    }
+
+    // clamp the quantity
+    if ( (size_t) quantity > limit ) quantity = (int) limit;
+
+    // copy the result
+    memcpy(p_ip_addresses, _ip_addresses, (size_t) quantity * sizeof(socket_ip_address));
+
+    // success
+    return quantity;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_resolver:
+                #ifndef NDEBUG
+                    log_error("[parallel] [resolver] Null pointer provided for parameter \"p_resolver\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_ip_addresses:
+                #ifndef NDEBUG
+                    log_error("[parallel] [resolver] Null pointer provided for parameter \"p_ip_addresses\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_hostname:
+                #ifndef NDEBUG
+                    log_error("[parallel] [resolver] Null pointer provided for parameter \"p_hostname\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+void *resolver_work ( void *p_parameter )
+{
+
+    // initialized data
+    struct resolver_job_s *p_job                                 = p_parameter;
+    resolver              *p_resolver                            = p_job->p_resolver;
+    socket_ip_address      _ip_addresses[RESOLVER_ADDRESSES_MAX] = { 0 };
+    int                    quantity                              = 0;
+
+    // resolve the hostname
+    quantity = resolver_resolve(p_resolver, _ip_addresses, RESOLVER_ADDRESSES_MAX, p_job->_hostname);
+
+    // callback
+    p_job->pfn_callback(p_job->_hostname, _ip_addresses, quantity, p_job->p_parameter);
+
+    // release the job
+    default_allocator(p_job, 0);
+
+    // lock
+    mutex_lock(&p_resolver->_lock);
+
+    // the job is done. Wake resolver_destroy after the last job
+    if ( 0 == --p_resolver->pending ) condition_variable_broadcast(&p_resolver->_idle);
+
+    // unlock
+    mutex_unlock(&p_resolver->_lock);
+
+    // done
+    return (void *) 0;
+}
+
+int resolver_resolve_async ( resolver *p_resolver, const char *restrict p_hostname, fn_resolver_callback *pfn_callback, void *p_parameter )
+{
+
+    // argument check
+    if ( p_resolver   == (void *) 0 ) goto no_resolver;
+    if ( p_hostname   == (void *) 0 ) goto no_hostname;
+    if ( pfn_callback == (void *) 0 ) goto no_callback;
+
+    // initialized data
+    socket_ip_address      _ip_addresses[RESOLVER_ADDRESSES_MAX] = { 0 };
+    size_t                 length                                = strlen(p_hostname);
+    int                    quantity                              = 0;
+    struct resolver_job_s *p_job                                 = (void *) 0;
+
+    // the hostname can not be resolved on the thread pool
+    if ( length >= RESOLVER_HOSTNAME_MAX ) goto hostname_too_long;
+
+    // hit, or no thread pool
+    if ( p_resolver->p_thread_pool == (void *) 0 || resolver_lookup(p_resolver, p_hostname, length, resolver_hash(p_hostname, length), _ip_addresses, &quantity) )
+    {
+
+        // resolve in the caller
+        if ( p_resolver->p_thread_pool == (void *) 0 ) quantity = resolver_resolve(p_resolver, _ip_addresses, RESOLVER_ADDRESSES_MAX, p_hostname);
+
+        // callback
+        pfn_callback(p_hostname, _ip_addresses, quantity, p_parameter);
+
+        // success
+        return 1;
+    }
+
+    // allocate a job
+    p_job = default_allocator(0, sizeof(struct resolver_job_s));
+
+    // error check
+    if ( p_job == (void *) 0 ) goto no_mem;
+
+    // populate the job
+    p_job->p_resolver   = p_resolver,
+    p_job->pfn_callback = pfn_callback,
+    p_job->p_parameter  = p_parameter;
+    memcpy(p_job->_hostname, p_hostname, length + 1);
+
+    // the job is pending
+    mutex_lock(&p_resolver->_lock);
+    p_resolver->pending++;
+    mutex_unlock(&p_resolver->_lock);
+
+    // resolve on the thread pool
+    if ( 0 == thread_pool_execute(p_resolver->p_thread_pool, resolver_work, p_job) ) goto failed_to_execute;
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_resolver:
+                #ifndef NDEBUG
+                    log_error("[parallel] [resolver] Null pointer provided for parameter \"p_resolver\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_hostname:
+                #ifndef NDEBUG
+                    log_error("[parallel] [resolver] Null pointer provided for parameter \"p_hostname\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            no_callback:
+                #ifndef NDEBUG
+                    log_error("[parallel] [resolver] Null pointer provided for parameter \"pfn_callback\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+
+            hostname_too_long:
+                #ifndef NDEBUG
+                    log_error("[parallel] [resolver] Parameter \"p_hostname\" is longer than %d characters in call to function \"%s\"\n", RESOLVER_HOSTNAME_MAX - 1, __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+
+        // parallel errors
+        {
+            failed_to_execute:
+                #ifndef NDEBUG
+                    log_error("[parallel] [resolver] Failed to execute job in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // the job is not pending
+                mutex_lock(&p_resolver->_lock);
+                if ( 0 == --p_resolver->pending ) condition_variable_broadcast(&p_resolver->_idle);
+                mutex_unlock(&p_resolver->_lock);
+
+                // release the job
+                default_allocator(p_job, 0);
+
+                // error
+                return 0;
+        }
+
+        // standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    log_error("[standard library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
+int resolver_destroy ( resolver **pp_resolver )
+{
+
+    // argument check
+    if ( pp_resolver == (void *) 0 ) goto no_resolver;
+
+    // initialized data
+    resolver *p_resolver = *pp_resolver;
+
+    // fast exit
+    if ( p_resolver == (void *) 0 ) return 1;
+
+    // no more pointer for caller
+    *pp_resolver = (void *) 0;
+
+    // wait for asynchronous resolves
+    mutex_lock(&p_resolver->_lock);
+    while ( p_resolver->pending ) condition_variable_wait(&p_resolver->_idle, &p_resolver->_lock);
+    mutex_unlock(&p_resolver->_lock);
+
+    // release the synchronization primitives
+    condition_variable_destroy(&p_resolver->_idle),
+    mutex_destroy(&p_resolver->_lock);
+
+    // release the resolver
+    default_allocator(p_resolver, 0);
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_resolver:
+                #ifndef NDEBUG
+                    log_error("[parallel] [resolver] Null pointer provided for parameter \"pp_resolver\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
@@ -0,0 +1,105 @@
+/** !
+ * Caching resolver interface
+ *
+ * @file src/performance/parallel/resolver.h
+ *
+ * @author Jacob Smith
+ */
+
+// header guard
+#pragma once
+
+// standard library
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+// gsdk
+/// core
+#include <core/log.h>
+#include <core/sync.h>
+#include <core/socket.h>
+
+/// performance
+#include <performance/parallel.h>
+#include <performance/thread_pool.h>
+
+// preprocessor definitions
+#define RESOLVER_HOSTNAME_MAX  256
+#define RESOLVER_ADDRESSES_MAX 8
+#define RESOLVER_WAYS          4
+
+// structure declarations
+struct resolver_s;
+
+// type definitions
+typedef struct resolver_s resolver;
+
+/** !
+ * Called when an asynchronous resolve finishes
+ *
+ * @param p_hostname     the hostname
+ * @param p_ip_addresses the IP addresses of the host
+ * @param quantity       the quantity of IP addresses, or 0 if the host was not found
+ * @param p_parameter    the parameter of the resolve
+ *
+ * @return void
+ */
+typedef void (fn_resolver_callback) ( const char *p_hostname, socket_ip_address *p_ip_addresses, int quantity, void *p_parameter );
+
+// function declarations
+/// constructors
+/** !
+ * Construct a caching resolver. Found hosts are cached for ttl
+ * milliseconds, and hosts that were not found for negative_ttl
+ * milliseconds. Cache hits never take a lock.
+ *
+ * @param pp_resolver   result
+ * @param p_thread_pool the thread pool that runs asynchronous resolves, or null to run them in the caller
+ * @param capacity      the quantity of cached hosts
+ * @param ttl           milliseconds to cache a found host
+ * @param negative_ttl  milliseconds to cache a host that was not found
+ *
+ * @return 1 on success, 0 on error
+ */
+int resolver_construct ( resolver **pp_resolver, thread_pool *p_thread_pool, size_t capacity, size_t ttl, size_t negative_ttl );
+
+/// resolve
+/** !
+ * Resolve a hostname, from the cache if possible
+ *
+ * @param p_resolver     the resolver
+ * @param p_ip_addresses result
+ * @param limit          the maximum quantity of IP addresses to store
+ * @param p_hostname     the hostname
+ *
+ * @sa socket_resolve_host
+ *
+ * @return the quantity of IP addresses stored, or 0 if the host was not found
+ */
+int resolver_resolve ( resolver *p_resolver, socket_ip_address *p_ip_addresses, size_t limit, const char *restrict p_hostname );
+
+/** !
+ * Resolve a hostname without blocking. A cache hit calls pfn_callback
+ * before returning, else the hostname is resolved on the thread pool,
+ * which then calls pfn_callback.
+ *
+ * @param p_resolver   the resolver
+ * @param p_hostname   the hostname
+ * @param pfn_callback the callback
+ * @param p_parameter  the parameter of the callback
+ *
+ * @return 1 on success, 0 on error
+ */
+int resolver_resolve_async ( resolver *p_resolver, const char *restrict p_hostname, fn_resolver_callback *pfn_callback, void *p_parameter );
+
+/// destructors
+/** !
+ * Wait for asynchronous resolves, then destroy a resolver
+ *
+ * @param pp_resolver pointer to resolver pointer
+ *
+ * @return 1 on success, 0 on error
+ */
+int resolver_destroy ( resolver **pp_resolver );
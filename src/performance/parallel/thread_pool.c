@@ -28,6 +28,7 @@ typedef struct thread_pool_work_parameter_s thread_pool_work_parameter;
 struct thread_pool_thread_s
 {
     bool              running;
+    bool              stop;
     monitor           _montior;
     void             *ret;
     void             *p_parameter;
@@ -187,6 +188,9 @@ int thread_pool_construct ( thread_pool **pp_thread_pool, size_t thread_quantity
     // Construct a monitor
     monitor_create(&p_thread_pool->_montior);
 
+    // Construct a lock
+    mutex_create(&p_thread_pool->_lock);
+
     // Construct threads
     for (size_t i = 0; i < thread_quantity; i++)
     {
@@ -316,16 +320,20 @@ int thread_pool_execute ( thread_pool *p_thread_pool, fn_parallel_task *pfn_para
 
     found_thread:
  
+    // lock the thread
+    mutex_lock(&p_thread_pool->_threads[i]._thread._montior._mutex);
+
     // Set up the task
     p_thread_pool->_threads[i]._thread.pfn_parallel_task = pfn_parallel_task;
     p_thread_pool->_threads[i]._thread.p_parameter       = p_parameter;
     p_thread_pool->_threads[i]._thread.running           = true;
 
-    sleep(0);
-
     // Signal the thread
     monitor_notify(&p_thread_pool->_threads[i]._thread._montior);
 
+    // unlock the thread
+    mutex_unlock(&p_thread_pool->_threads[i]._thread._montior._mutex);
+
     // unlock
     mutex_unlock(&p_thread_pool->_lock);
     
@@ -371,11 +379,17 @@ int thread_pool_wait_idle ( thread_pool *p_thread_pool )
 
         is_running = false;
 
+        // lock
+        mutex_lock(&p_thread_pool->_lock);
+
         // For all threads in the thread pool ...
         for (size_t i = 0; i < p_thread_pool->thread_quantity; i++)
         
             // ... if a thread is running set the flag ...
             is_running |= p_thread_pool->_threads[i]._thread.running;
+
+        // unlock
+        mutex_unlock(&p_thread_pool->_lock);
         
         // ... defer to other threads 
         sleep(0);
@@ -400,6 +414,72 @@ int thread_pool_wait_idle ( thread_pool *p_thread_pool )
     }
 }
 
+int thread_pool_destroy ( thread_pool **pp_thread_pool )
+{
+
+    // argument check
+    if ( pp_thread_pool == (void *) 0 ) goto no_thread_pool;
+
+    // initialized data
+    thread_pool *p_thread_pool = *pp_thread_pool;
+
+    // Fast exit
+    if ( p_thread_pool == (void *) 0 ) return 1;
+
+    // No more pointer for caller
+    *pp_thread_pool = (void *) 0;
+
+    // Let the running tasks finish
+    thread_pool_wait_idle(p_thread_pool);
+
+    // Stop each worker thread
+    for (size_t i = 0; i < p_thread_pool->thread_quantity; i++)
+    {
+
+        // lock the thread
+        mutex_lock(&p_thread_pool->_threads[i]._thread._montior._mutex);
+
+        // Set the flag
+        p_thread_pool->_threads[i]._thread.stop = true;
+
+        // Signal the thread
+        monitor_notify(&p_thread_pool->_threads[i]._thread._montior);
+
+        // unlock the thread
+        mutex_unlock(&p_thread_pool->_threads[i]._thread._montior._mutex);
+    }
+
+    // Wait for each worker thread to return, then release it
+    for (size_t i = 0; i < p_thread_pool->thread_quantity; i++)
+        parallel_thread_join(&p_thread_pool->_threads[i]._thread.p_parallel_thread),
+        monitor_destroy(&p_thread_pool->_threads[i]._thread._montior);
+
+    // Release the monitor and the lock
+    monitor_destroy(&p_thread_pool->_montior),
+    mutex_destroy(&p_thread_pool->_lock);
+
+    // Release the thread pool
+    p_thread_pool = default_allocator(p_thread_pool, 0);
+
+    // success
+    return 1;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            no_thread_pool:
+                #ifndef NDEBUG
+                    log_error("[parallel] [thread pool] Null pointer provided for parameter \"pp_thread_pool\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // error
+                return 0;
+        }
+    }
+}
+
 void *thread_pool_work ( thread_pool_work_parameter *p_parameter )
 {
 
@@ -418,23 +498,44 @@ void *thread_pool_work ( thread_pool_work_parameter *p_parameter )
     // unlock
     mutex_unlock(&p_thread_pool->_lock);
 
-    // Wait for the thread pool to start
-    monitor_wait(&p_thread_pool->_montior);
-
     wait_for_next_task:
 
-    p_parameter->_thread.running = false;
+    // lock
+    mutex_lock(&p_parameter->_thread._montior._mutex);
 
-    // Wait for a task to be assigned
-    monitor_wait(&p_parameter->_thread._montior);
+    // Wait for a task to be assigned. The flag is tested under the 
+    // monitor's lock, so a task assigned before this thread waits is not lost
+    while ( p_parameter->_thread.running == false && p_parameter->_thread.stop == false )
+        condition_variable_wait(&p_parameter->_thread._montior._cond, &p_parameter->_thread._montior._mutex);
 
-    p_parameter->_thread.running = true;
+    // The thread pool is being destroyed
+    if ( p_parameter->_thread.running == false )
+    {
+
+        // unlock
+        mutex_unlock(&p_parameter->_thread._montior._mutex);
+
+        // done
+        return (void *) 1;
+    }
+
+    // unlock
+    mutex_unlock(&p_parameter->_thread._montior._mutex);
 
     // Run the user's task
     p_parameter->_thread.ret = p_parameter->_thread.pfn_parallel_task(p_parameter->_thread.p_parameter);
 
+    // lock the thread pool, then the thread, in the same order as thread_pool_execute
+    mutex_lock(&p_thread_pool->_lock);
+    mutex_lock(&p_parameter->_thread._montior._mutex);
+
+    // The flag is cleared under the thread pool's lock, where it is read
     p_parameter->_thread.running = false;
 
+    // unlock
+    mutex_unlock(&p_parameter->_thread._montior._mutex);
+    mutex_unlock(&p_thread_pool->_lock);
+
     sleep(0);
 
     monitor_notify(&p_thread_pool->_montior);
@@ -0,0 +1,695 @@
+/** !
+ * Tester for aead module
+ *
+ * @file aead_test.c
+ *
+ * @author Jacob Smith
+ */
+
+// gsdk
+/// core
+#include <core/log.h>
+#include <core/sync.h>
+
+/// crypto
+#include <crypto/chacha20.h>
+#include <crypto/poly1305.h>
+#include <crypto/aead.h>
+
+// preprocessor definitions
+#define AEAD_TEST_MAX 10240
+
+// global variables
+int total_tests      = 0,
+    total_passes     = 0,
+    total_fails      = 0,
+    ephemeral_tests  = 0,
+    ephemeral_passes = 0,
+    ephemeral_fails  = 0;
+
+// RFC 8439 section 2.4.2 and 2.8.2 plaintext
+const char _sunscreen[] = "Ladies and Gentlemen of the class of '99: If I could offer you only one tip for the future, sunscreen would be it.";
+
+// pseudo random test data
+unsigned char _data[AEAD_TEST_MAX] = { 0 };
+
+// lengths around the 4, 8, and 16 block kernels, and the 4096 byte aead chunk
+const size_t _lengths[] = { 0, 1, 15, 16, 17, 63, 64, 65, 255, 256, 257, 511, 512, 513, 1023, 1024, 1025, 1087, 4095, 4096, 4097, 4159, 8191, 8192, 8193, 10000 };
+
+// forward declarations
+/** !
+ * Print the time formatted in days, hours, minutes, seconds, miliseconds, microseconds
+ *
+ * @param seconds the time in seconds
+ *
+ * @return void
+ */
+void print_time_pretty ( double seconds );
+
+/** !
+ * Run all the tests
+ *
+ * @param name void
+ *
+ * @return void
+ */
+void run_tests ( void );
+
+/** !
+ * Print a summary of the test scenario
+ *
+ * @param void
+ *
+ * @return void
+ */
+void print_final_summary ( void );
+
+/** !
+ * Print the result of a single test
+ *
+ * @param scenario_name the name of the scenario
+ * @param test_name     the name of the test
+ * @param passed        true if test passes, false if test fails
+ *
+ * @return void
+ */
+void print_test ( const char *scenario_name, const char *test_name, bool passed );
+
+void chacha20_test ( const char *scenario_name );
+void poly1305_test ( const char *scenario_name );
+void aead_test     ( const char *scenario_name );
+
+bool test_chacha20        ( const unsigned char *key, const unsigned char *nonce, int block, const void *p_plaintext, size_t len, const unsigned char *expected );
+bool test_chacha20_blocks ( void );
+bool test_poly1305        ( const unsigned char *key, const void *p_message, size_t len, const unsigned char *expected );
+bool test_poly1305_stream ( void );
+bool test_aead            ( const unsigned char *key, const unsigned char *nonce, const void *p_aad, size_t aad_len, const void *p_plaintext, size_t len, const unsigned char *expected, const unsigned char *expected_tag );
+bool test_aead_lengths    ( bool in_place );
+bool test_aead_forgery    ( void );
+
+/** !
+ * Encrypt a message 64 bytes at a time, so every block runs through the scalar kernel
+ *
+ * @param p_out the ciphertext
+ * @param key   the key
+ * @param nonce the nonce
+ * @param block the first block counter
+ * @param p_in  the plaintext
+ * @param len   the quantity of bytes
+ *
+ * @return 1 on success, 0 on error
+ */
+int chacha20_reference ( void *p_out, chacha20_key key, chacha20_nonce nonce, int block, const void *p_in, size_t len );
+
+/** !
+ * Compute the RFC 8439 AEAD construction from its parts
+ *
+ * @param p_out    the ciphertext
+ * @param tag      result
+ * @param key      the key
+ * @param nonce    the nonce
+ * @param sequence the sequence number
+ * @param p_aad    the aad
+ * @param aad_len  the quantity of bytes of aad
+ * @param p_in     the plaintext
+ * @param len      the quantity of bytes of plaintext
+ *
+ * @return 1 on success, 0 on error
+ */
+int aead_reference ( void *p_out, poly1305_tag tag, chacha20_key key, chacha20_nonce nonce, size_t sequence, const void *p_aad, size_t aad_len, const void *p_in, size_t len );
+
+// entry point
+int main ( int argc, const char* argv[] )
+{
+
+    // unused
+    (void) argc;
+    (void) argv;
+
+    // initialized data
+    timestamp t0 = 0,
+              t1 = 0;
+
+    // Formatting
+    printf(
+        "╭─────────────╮\n"\
+        "│ aead tester │\n"\
+        "╰─────────────╯\n\n"
+    );
+
+    // fill the test data
+    {
+
+        // initialized data
+        unsigned long long x = 0x9e3779b97f4a7c15ULL;
+
+        // xorshift
+        for (size_t i = 0; i < sizeof(_data); i++)
+            x ^= x << 13, x ^= x >> 7, x ^= x << 17,
+            _data[i] = (unsigned char) x;
+    }
+
+    // Start
+    t0 = timer_high_precision();
+
+    // Run tests
+    run_tests();
+
+    // Stop
+    t1 = timer_high_precision();
+
+    // Report the time it took to run the tests
+    log_info("aead tests took ");
+    print_time_pretty ( (double) ( t1 - t0 ) / (double) timer_seconds_divisor() );
+    log_info(" to test\n");
+
+    // exit
+    return ( total_passes == total_tests ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void print_time_pretty ( double seconds )
+{
+
+    // initialized data
+    double _seconds     = seconds;
+    size_t days         = 0,
+           hours        = 0,
+           minutes      = 0,
+           __seconds    = 0,
+           milliseconds = 0,
+           microseconds = 0;
+
+    // Days
+    while ( _seconds > 86400.0 ) { days++;_seconds-=286400.0; };
+
+    // Hours
+    while ( _seconds > 3600.0 ) { hours++;_seconds-=3600.0; };
+
+    // Minutes
+    while ( _seconds > 60.0 ) { minutes++;_seconds-=60.0; };
+
+    // Seconds
+    while ( _seconds > 1.0 ) { __seconds++;_seconds-=1.0; };
+
+    // milliseconds
+    while ( _seconds > 0.001 ) { milliseconds++;_seconds-=0.001; };
+
+    // Microseconds
+    while ( _seconds > 0.000001 ) { microseconds++;_seconds-=0.000001; };
+
+    // Print days
+    if ( days ) log_info("%zu D, ", days);
+
+    // Print hours
+    if ( hours ) log_info("%zu h, ", hours);
+
+    // Print minutes
+    if ( minutes ) log_info("%zu m, ", minutes);
+
+    // Print seconds
+    if ( __seconds ) log_info("%zu s, ", __seconds);
+
+    // Print milliseconds
+    if ( milliseconds ) log_info("%3zu ms, ", milliseconds);
+
+    // Print microseconds
+    if ( microseconds ) log_info("%03zu us", microseconds);
+
+    // done
+    return;
+}
+
+void run_tests ( void )
+{
+
+    // test chacha20
+    chacha20_test("chacha20");
+
+    // test poly1305
+    poly1305_test("poly1305");
+
+    // test aead
+    aead_test("aead");
+
+    // done
+    return;
+}
+
+void chacha20_test ( const char *name )
+{
+
+    // initialized data
+    const unsigned char key[32] =
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+    };
+    const unsigned char block_nonce[12] = { 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x4a, 0x00, 0x00, 0x00, 0x00 };
+    const unsigned char encrypt_nonce[12] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4a, 0x00, 0x00, 0x00, 0x00 };
+    const unsigned char zeros[64] = { 0 };
+    const unsigned char block[64] =
+    {
+        0x10, 0xf1, 0xe7, 0xe4, 0xd1, 0x3b, 0x59, 0x15, 0x50, 0x0f, 0xdd, 0x1f, 0xa3, 0x20, 0x71, 0xc4,
+        0xc7, 0xd1, 0xf4, 0xc7, 0x33, 0xc0, 0x68, 0x03, 0x04, 0x22, 0xaa, 0x9a, 0xc3, 0xd4, 0x6c, 0x4e,
+        0xd2, 0x82, 0x64, 0x46, 0x07, 0x9f, 0xaa, 0x09, 0x14, 0xc2, 0xd7, 0x05, 0xd9, 0x8b, 0x02, 0xa2,
+        0xb5, 0x12, 0x9c, 0xd1, 0xde, 0x16, 0x4e, 0xb9, 0xcb, 0xd0, 0x83, 0xe8, 0xa2, 0x50, 0x3c, 0x4e
+    };
+    const unsigned char ciphertext[114] =
+    {
+        0x6e, 0x2e, 0x35, 0x9a, 0x25, 0x68, 0xf9, 0x80, 0x41, 0xba, 0x07, 0x28, 0xdd, 0x0d, 0x69, 0x81,
+        0xe9, 0x7e, 0x7a, 0xec, 0x1d, 0x43, 0x60, 0xc2, 0x0a, 0x27, 0xaf, 0xcc, 0xfd, 0x9f, 0xae, 0x0b,
+        0xf9, 0x1b, 0x65, 0xc5, 0x52, 0x47, 0x33, 0xab, 0x8f, 0x59, 0x3d, 0xab, 0xcd, 0x62, 0xb3, 0x57,
+        0x16, 0x39, 0xd6, 0x24, 0xe6, 0x51, 0x52, 0xab, 0x8f, 0x53, 0x0c, 0x35, 0x9f, 0x08, 0x61, 0xd8,
+        0x07, 0xca, 0x0d, 0xbf, 0x50, 0x0d, 0x6a, 0x61, 0x56, 0xa3, 0x8e, 0x08, 0x8a, 0x22, 0xb6, 0x5e,
+        0x52, 0xbc, 0x51, 0x4d, 0x16, 0xcc, 0xf8, 0x06, 0x81, 0x8c, 0xe9, 0x1a, 0xb7, 0x79, 0x37, 0x36,
+        0x5a, 0xf9, 0x0b, 0xbf, 0x74, 0xa3, 0x5b, 0xe6, 0xb4, 0x0b, 0x8e, 0xed, 0xf2, 0x78, 0x5e, 0x42,
+        0x87, 0x4d
+    };
+
+    // test chacha20
+    print_test(name, "RFC 8439 2.3.2 block function", test_chacha20(key, block_nonce, 1, zeros, sizeof(zeros), block));
+    print_test(name, "RFC 8439 2.4.2 encryption"    , test_chacha20(key, encrypt_nonce, 1, _sunscreen, sizeof(_sunscreen) - 1, ciphertext));
+    print_test(name, "kernels match scalar"         , test_chacha20_blocks());
+
+    // print the summary of this test
+    print_final_summary();
+}
+
+void poly1305_test ( const char *name )
+{
+
+    // initialized data
+    const unsigned char key[32] =
+    {
+        0x85, 0xd6, 0xbe, 0x78, 0x57, 0x55, 0x6d, 0x33, 0x7f, 0x44, 0x52, 0xfe, 0x42, 0xd5, 0x06, 0xa8,
+        0x01, 0x03, 0x80, 0x8a, 0xfb, 0x0d, 0xb2, 0xfd, 0x4a, 0xbf, 0xf6, 0xaf, 0x41, 0x49, 0xf5, 0x1b
+    };
+    const unsigned char tag[16] = { 0xa8, 0x06, 0x1d, 0xc1, 0x30, 0x51, 0x36, 0xc6, 0xc2, 0x2b, 0x8b, 0xaf, 0x0c, 0x01, 0x27, 0xa9 };
+    const char message[] = "Cryptographic Forum Research Group";
+
+    // test poly1305
+    print_test(name, "RFC 8439 2.5.2"      , test_poly1305(key, message, sizeof(message) - 1, tag));
+    print_test(name, "stream matches whole", test_poly1305_stream());
+
+    // print the summary of this test
+    print_final_summary();
+}
+
+void aead_test ( const char *name )
+{
+
+    // initialized data
+    const unsigned char key[32] =
+    {
+        0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f,
+        0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d, 0x9e, 0x9f
+    };
+    const unsigned char nonce[12] = { 0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47 };
+    const unsigned char aad[12] = { 0x50, 0x51, 0x52, 0x53, 0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7 };
+    const unsigned char ciphertext[114] =
+    {
+        0xd3, 0x1a, 0x8d, 0x34, 0x64, 0x8e, 0x60, 0xdb, 0x7b, 0x86, 0xaf, 0xbc, 0x53, 0xef, 0x7e, 0xc2,
+        0xa4, 0xad, 0xed, 0x51, 0x29, 0x6e, 0x08, 0xfe, 0xa9, 0xe2, 0xb5, 0xa7, 0x36, 0xee, 0x62, 0xd6,
+        0x3d, 0xbe, 0xa4, 0x5e, 0x8c, 0xa9, 0x67, 0x12, 0x82, 0xfa, 0xfb, 0x69, 0xda, 0x92, 0x72, 0x8b,
+        0x1a, 0x71, 0xde, 0x0a, 0x9e, 0x06, 0x0b, 0x29, 0x05, 0xd6, 0xa5, 0xb6, 0x7e, 0xcd, 0x3b, 0x36,
+        0x92, 0xdd, 0xbd, 0x7f, 0x2d, 0x77, 0x8b, 0x8c, 0x98, 0x03, 0xae, 0xe3, 0x28, 0x09, 0x1b, 0x58,
+        0xfa, 0xb3, 0x24, 0xe4, 0xfa, 0xd6, 0x75, 0x94, 0x55, 0x85, 0x80, 0x8b, 0x48, 0x31, 0xd7, 0xbc,
+        0x3f, 0xf4, 0xde, 0xf0, 0x8e, 0x4b, 0x7a, 0x9d, 0xe5, 0x76, 0xd2, 0x65, 0x86, 0xce, 0xc6, 0x4b,
+        0x61, 0x16
+    };
+    const unsigned char tag[16] = { 0x1a, 0xe1, 0x0b, 0x59, 0x4f, 0x09, 0xe2, 0x6a, 0x7e, 0x90, 0x2e, 0xcb, 0xd0, 0x60, 0x06, 0x91 };
+
+    // test aead
+    print_test(name, "RFC 8439 2.8.2"                 , test_aead(key, nonce, aad, sizeof(aad), _sunscreen, sizeof(_sunscreen) - 1, ciphertext, tag));
+    print_test(name, "lengths match reference"        , test_aead_lengths(false));
+    print_test(name, "lengths match reference in place", test_aead_lengths(true));
+    print_test(name, "forgery rejected"               , test_aead_forgery());
+
+    // print the summary of this test
+    print_final_summary();
+}
+
+bool test_chacha20 ( const unsigned char *key, const unsigned char *nonce, int block, const void *p_plaintext, size_t len, const unsigned char *expected )
+{
+
+    // initialized data
+    chacha20       *p_chacha20 = NULL;
+    chacha20_key    _key       = { 0 };
+    chacha20_nonce  _nonce     = { 0 };
+    unsigned char   result[AEAD_TEST_MAX] = { 0 };
+    bool            ret = false;
+
+    // copy the key and the nonce
+    memcpy(_key, key, sizeof(chacha20_key)),
+    memcpy(_nonce, nonce, sizeof(chacha20_nonce));
+
+    // encrypt the plaintext
+    if ( 0 == chacha20_construct(&p_chacha20, _key, _nonce, block) ) return false;
+    chacha20_encrypt(result, p_chacha20, (void *) p_plaintext, len);
+    chacha20_destroy(&p_chacha20);
+
+    // check the ciphertext
+    ret = ( 0 == memcmp(result, expected, len) );
+
+    // decrypt the ciphertext
+    if ( 0 == chacha20_construct(&p_chacha20, _key, _nonce, block) ) return false;
+    chacha20_decrypt(result, p_chacha20, (void *) expected, len);
+    chacha20_destroy(&p_chacha20);
+
+    // check the plaintext
+    ret = ret && ( 0 == memcmp(result, p_plaintext, len) );
+
+    // done
+    return ret;
+}
+
+bool test_chacha20_blocks ( void )
+{
+
+    // initialized data
+    chacha20       *p_chacha20 = NULL;
+    chacha20_key    key        = { 0 };
+    chacha20_nonce  nonce      = { 0 };
+    unsigned char   expected[AEAD_TEST_MAX] = { 0 };
+    unsigned char   result[AEAD_TEST_MAX] = { 0 };
+
+    // use the test data as the key and the nonce
+    memcpy(key, _data, sizeof(chacha20_key)),
+    memcpy(nonce, _data + sizeof(chacha20_key), sizeof(chacha20_nonce));
+
+    // every length, out of place and in place
+    for (size_t i = 0; i < sizeof(_lengths) / sizeof(*_lengths); i++)
+    {
+
+        // initialized data
+        size_t len = _lengths[i];
+
+        // compute the expected ciphertext
+        if ( 0 == chacha20_reference(expected, key, nonce, 7, _data, len) ) return false;
+
+        // encrypt the plaintext in one call
+        if ( 0 == chacha20_construct(&p_chacha20, key, nonce, 7) ) return false;
+        chacha20_encrypt(result, p_chacha20, _data, len);
+        chacha20_destroy(&p_chacha20);
+
+        // check
+        if ( memcmp(result, expected, len) ) return false;
+
+        // encrypt the plaintext in place
+        memcpy(result, _data, len);
+        if ( 0 == chacha20_construct(&p_chacha20, key, nonce, 7) ) return false;
+        chacha20_encrypt(result, p_chacha20, result, len);
+        chacha20_destroy(&p_chacha20);
+
+        // check
+        if ( memcmp(result, expected, len) ) return false;
+    }
+
+    // success
+    return true;
+}
+
+bool test_poly1305 ( const unsigned char *key, const void *p_message, size_t len, const unsigned char *expected )
+{
+
+    // initialized data
+    poly1305_one_time_key _key   = { 0 };
+    poly1305_tag          result = { 0 };
+
+    // copy the key
+    memcpy(_key, key, sizeof(poly1305_one_time_key));
+
+    // compute the tag
+    if ( 0 == poly1305_mac(p_message, len, result, _key) ) return false;
+
+    // check
+    return ( 0 == memcmp(result, expected, sizeof(poly1305_tag)) );
+}
+
+bool test_poly1305_stream ( void )
+{
+
+    // initialized data
+    poly1305_one_time_key key = { 0 };
+
+    // use the test data as the key
+    memcpy(key, _data + 1, sizeof(poly1305_one_time_key));
+
+    // every length
+    for (size_t i = 0; i < sizeof(_lengths) / sizeof(*_lengths); i++)
+    {
+
+        // initialized data
+        size_t        len      = _lengths[i];
+        poly1305_tag  expected = { 0 },
+                      result   = { 0 };
+        poly1305      _poly1305 = { 0 };
+
+        // compute the tag in one call
+        if ( 0 == poly1305_mac(_data, len, expected, key) ) return false;
+
+        // compute the tag in uneven pieces
+        poly1305_init(&_poly1305, key);
+        for (size_t off = 0, step = 1; off < len; off += step, step = step % 37 + 1)
+            poly1305_update(&_poly1305, _data + off, ( len - off ) < step ? ( len - off ) : step);
+        poly1305_final(&_poly1305, result);
+
+        // check
+        if ( memcmp(result, expected, sizeof(poly1305_tag)) ) return false;
+    }
+
+    // success
+    return true;
+}
+
+bool test_aead ( const unsigned char *key, const unsigned char *nonce, const void *p_aad, size_t aad_len, const void *p_plaintext, size_t len, const unsigned char *expected, const unsigned char *expected_tag )
+{
+
+    // initialized data
+    aead           *p_aead = NULL;
+    chacha20_key    _key   = { 0 };
+    chacha20_nonce  _nonce = { 0 };
+    poly1305_tag    tag    = { 0 };
+    unsigned char   result[AEAD_TEST_MAX] = { 0 };
+    bool            ret = false;
+
+    // copy the key and the nonce
+    memcpy(_key, key, sizeof(chacha20_key)),
+    memcpy(_nonce, nonce, sizeof(chacha20_nonce));
+
+    // construct an aead
+    if ( 0 == aead_construct(&p_aead, _key, _nonce) ) return false;
+
+    // encrypt the plaintext
+    aead_encrypt(result, p_aead, tag, p_aad, aad_len, p_plaintext, len);
+
+    // check the ciphertext and the tag
+    ret = ( 0 == memcmp(result, expected, len) ) && ( 0 == memcmp(tag, expected_tag, sizeof(poly1305_tag)) );
+
+    // decrypt the ciphertext
+    aead_sequence_set(p_aead, 0);
+    ret = ret && aead_decrypt(result, p_aead, tag, (void *) p_aad, aad_len, (void *) expected, len);
+
+    // check the plaintext
+    ret = ret && ( 0 == memcmp(result, p_plaintext, len) );
+
+    // release the aead
+    aead_destroy(&p_aead);
+
+    // done
+    return ret;
+}
+
+bool test_aead_lengths ( bool in_place )
+{
+
+    // initialized data
+    aead           *p_aead = NULL;
+    chacha20_key    key    = { 0 };
+    chacha20_nonce  nonce  = { 0 };
+    unsigned char   expected[AEAD_TEST_MAX] = { 0 };
+    unsigned char   result[AEAD_TEST_MAX] = { 0 };
+    bool            ret = true;
+
+    // use the test data as the key and the nonce
+    memcpy(key, _data + 2, sizeof(chacha20_key)),
+    memcpy(nonce, _data + 2 + sizeof(chacha20_key), sizeof(chacha20_nonce));
+
+    // construct an aead
+    if ( 0 == aead_construct(&p_aead, key, nonce) ) return false;
+
+    // every length, with a different quantity of aad and a different sequence number
+    for (size_t i = 0; ret && i < sizeof(_lengths) / sizeof(*_lengths); i++)
+    {
+
+        // initialized data
+        size_t        len          = _lengths[i],
+                      aad_len      = i % 19;
+        const void   *p_aad        = _data + AEAD_TEST_MAX - aad_len;
+        poly1305_tag  expected_tag = { 0 },
+                      tag          = { 0 };
+
+        // compute the expected ciphertext and tag
+        if ( 0 == aead_reference(expected, expected_tag, key, nonce, i, p_aad, aad_len, _data, len) ) { ret = false; break; }
+
+        // encrypt
+        aead_sequence_set(p_aead, i);
+        if ( in_place )
+            memcpy(result, _data, len),
+            aead_encrypt_in_place(p_aead, tag, p_aad, aad_len, result, len);
+        else
+            aead_encrypt(result, p_aead, tag, p_aad, aad_len, _data, len);
+
+        // check the ciphertext and the tag
+        ret = ( 0 == memcmp(result, expected, len) ) && ( 0 == memcmp(tag, expected_tag, sizeof(poly1305_tag)) );
+
+        // decrypt
+        aead_sequence_set(p_aead, i);
+        if ( in_place )
+            ret = ret && aead_decrypt_in_place(p_aead, tag, (void *) p_aad, aad_len, result, len);
+        else
+            ret = ret && aead_decrypt(result, p_aead, tag, (void *) p_aad, aad_len, expected, len);
+
+        // check the plaintext
+        ret = ret && ( 0 == memcmp(result, _data, len) );
+    }
+
+    // release the aead
+    aead_destroy(&p_aead);
+
+    // done
+    return ret;
+}
+
+bool test_aead_forgery ( void )
+{
+
+    // initialized data
+    aead           *p_aead = NULL;
+    chacha20_key    key    = { 0 };
+    chacha20_nonce  nonce  = { 0 };
+    poly1305_tag    tag    = { 0 };
+    unsigned char   ciphertext[4097] = { 0 };
+    unsigned char   result[4097] = { 0 };
+    bool            ret = true;
+
+    // use the test data as the key and the nonce
+    memcpy(key, _data + 3, sizeof(chacha20_key)),
+    memcpy(nonce, _data + 3 + sizeof(chacha20_key), sizeof(chacha20_nonce));
+
+    // construct an aead
+    if ( 0 == aead_construct(&p_aead, key, nonce) ) return false;
+
+    // encrypt
+    aead_encrypt(ciphertext, p_aead, tag, _data, 13, _data, sizeof(ciphertext));
+
+    // flip a bit after the first chunk
+    ciphertext[4096] ^= 1;
+
+    // the decryption must fail, and release no plaintext
+    memset(result, 0xff, sizeof(result));
+    aead_sequence_set(p_aead, 0);
+    ret = ( 0 == aead_decrypt(result, p_aead, tag, _data, 13, ciphertext, sizeof(ciphertext)) );
+    for (size_t i = 0; i < sizeof(result); i++) ret = ret && ( 0 == result[i] );
+
+    // release the aead
+    aead_destroy(&p_aead);
+
+    // done
+    return ret;
+}
+
+int chacha20_reference ( void *p_out, chacha20_key key, chacha20_nonce nonce, int block, const void *p_in, size_t len )
+{
+
+    // initialized data
+    chacha20 *p_chacha20 = NULL;
+
+    // construct a chacha20
+    if ( 0 == chacha20_construct(&p_chacha20, key, nonce, block) ) return 0;
+
+    // one block at a time
+    for (size_t off = 0; off < len; off += 64)
+        chacha20_encrypt((unsigned char *) p_out + off, p_chacha20, (unsigned char *) p_in + off, ( len - off ) < 64 ? ( len - off ) : 64);
+
+    // release the chacha20
+    chacha20_destroy(&p_chacha20);
+
+    // success
+    return 1;
+}
+
+int aead_reference ( void *p_out, poly1305_tag tag, chacha20_key key, chacha20_nonce nonce, size_t sequence, const void *p_aad, size_t aad_len, const void *p_in, size_t len )
+{
+
+    // initialized data
+    static unsigned char  mac_data[AEAD_TEST_MAX + 64] = { 0 };
+    chacha20_nonce        current_nonce = { 0 };
+    poly1305_one_time_key one_time_key  = { 0 };
+    unsigned long long    seq           = 0;
+    size_t                i             = 0;
+
+    // xor the sequence number into the last 8 bytes of the nonce
+    memcpy(current_nonce, nonce, sizeof(chacha20_nonce)),
+    memcpy(&seq, &current_nonce[1], sizeof(seq)),
+    seq ^= sequence,
+    memcpy(&current_nonce[1], &seq, sizeof(seq));
+
+    // the one time key is block 0
+    if ( 0 == poly1305_key_generate(&one_time_key, key, current_nonce, 0) ) return 0;
+
+    // the ciphertext starts at block 1
+    if ( 0 == chacha20_reference(p_out, key, current_nonce, 1, p_in, len) ) return 0;
+
+    // aad | pad | ciphertext | pad | aad length | ciphertext length
+    memset(mac_data, 0, sizeof(mac_data));
+    memcpy(mac_data, p_aad, aad_len), i = ( aad_len + 15 ) / 16 * 16;
+    memcpy(mac_data + i, p_out, len), i += ( len + 15 ) / 16 * 16;
+    pack_pack(mac_data + i, "%i64%i64", (unsigned long long) aad_len, (unsigned long long) len), i += 16;
+
+    // compute the tag
+    return poly1305_mac(mac_data, i, tag, one_time_key);
+}
+
+void print_test ( const char *scenario_name, const char *test_name, bool passed )
+{
+
+    // initialized data
+    if ( passed )
+        log_pass("%s %s\n", scenario_name, test_name);
+    else
+        log_fail("%s %s\n", scenario_name, test_name);
+
+    // Increment the pass/fail counter
+    if (passed)
+        ephemeral_passes++;
+    else
+        ephemeral_fails++;
+
+    // Increment the test counter
+    ephemeral_tests++;
+
+    // done
+    return;
+}
+
+void print_final_summary ( void )
+{
+
+    // Accumulate
+    total_tests  += ephemeral_tests,
+    total_passes += ephemeral_passes,
+    total_fails  += ephemeral_fails;
+
+    // Print
+    log_info("\nTests: %d, Passed: %d, Failed: %d (%%%.3f)\n",  ephemeral_tests, ephemeral_passes, ephemeral_fails, ((float)ephemeral_passes/(float)ephemeral_tests*100.f));
+    log_info("Total: %d, Passed: %d, Failed: %d (%%%.3f)\n\n",  total_tests, total_passes, total_fails, ((float)total_passes/(float)total_tests*100.f));
+
+    // Clear test counters for this test
+    ephemeral_tests  = 0;
+    ephemeral_passes = 0;
+    ephemeral_fails  = 0;
+
+    // done
+    return;
+}
@@ -91,8 +91,38 @@ void test_sign ( char *name );
  */
 void test_verify ( char *name );
 
+/** !
+ * Test ed25519 batch verify
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_verify_batch ( char *name );
+
+/** !
+ * Test ed25519 verify with an expanded public key
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_verify_expanded ( char *name );
+
+/** !
+ * Test that every verify function agrees on signatures whose R or A has a
+ * small order component
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_verify_small_order ( char *name );
+
+bool test_ed25519_verify_agree ( const ed25519_signature *p_signature, const unsigned char *p_message, size_t len, const ed25519_public_key *p_public_key, int expected );
 bool test_ed25519_sign ( ed25519_test_vector *p_ed25519_test_vector );
 bool test_ed25519_verify ( ed25519_test_vector *p_ed25519_test_vector );
+bool test_ed25519_verify_expanded ( ed25519_test_vector *p_ed25519_test_vector );
 
 // entry point
 int main ( int argc, const char* argv[] )
@@ -219,6 +249,37 @@ void run_tests ( void )
     log_info("verify tests took: "),
     print_time_pretty ( (double)(verify_t1-verify_t0)/(double)timer_seconds_divisor() ),
     log_info(" to test\n");
+
+    // start
+    verify_t0 = timer_high_precision();
+
+    // test the batch verify function
+    test_verify_batch("verify batch");
+
+    // stop 
+    verify_t1 = timer_high_precision();
+
+    // report the time it took to run the batch verify tests
+    log_info("verify batch tests took: "),
+    print_time_pretty ( (double)(verify_t1-verify_t0)/(double)timer_seconds_divisor() ),
+    log_info(" to test\n");
+
+    // start
+    verify_t0 = timer_high_precision();
+
+    // test the expanded key verify function
+    test_verify_expanded("verify expanded");
+
+    // stop 
+    verify_t1 = timer_high_precision();
+
+    // report the time it took to run the expanded key verify tests
+    log_info("verify expanded tests took: "),
+    print_time_pretty ( (double)(verify_t1-verify_t0)/(double)timer_seconds_divisor() ),
+    log_info(" to test\n");
+
+    // test that the verify functions agree on small order components
+    test_verify_small_order("verify small order");
    
     // done
     return;
@@ -280,6 +341,163 @@ void test_verify ( char *name )
     return;
 }
 
+void test_verify_expanded ( char *name )
+{
+
+    // formatting
+    log_scenario("%s\n", name);
+
+    // test vectors
+    for (int i = 0; i < (int)(sizeof(_ed25519_test_vectors)/sizeof(*_ed25519_test_vectors)); i++)
+    {
+
+        // initialized data
+        ed25519_test_vector *p_test_vector = &_ed25519_test_vectors[i];
+        char _test_name[64] = { 0 };
+
+        // construct the test name
+        snprintf(_test_name, sizeof(_test_name), "test #%d", i);
+        
+        // run the test
+        print_test(name, _test_name, test_ed25519_verify_expanded(p_test_vector));
+    }
+
+    // print the summary of this test
+    print_final_summary();
+
+    // done
+    return;
+}
+
+void test_verify_batch ( char *name )
+{
+
+    // initialized data
+    static const ed25519_signature  *_signatures[sizeof(_ed25519_test_vectors)/sizeof(*_ed25519_test_vectors)];
+    static const unsigned char      *_messages[sizeof(_ed25519_test_vectors)/sizeof(*_ed25519_test_vectors)];
+    static size_t                    _lens[sizeof(_ed25519_test_vectors)/sizeof(*_ed25519_test_vectors)];
+    static const ed25519_public_key *_public_keys[sizeof(_ed25519_test_vectors)/sizeof(*_ed25519_test_vectors)];
+    size_t quantity = sizeof(_ed25519_test_vectors)/sizeof(*_ed25519_test_vectors);
+    ed25519_signature bad = { 0 };
+
+    // formatting
+    log_scenario("%s\n", name);
+
+    // gather the test vectors
+    for (size_t i = 0; i < quantity; i++)
+        _signatures[i]  = &_ed25519_test_vectors[i].signature,
+        _messages[i]    = (const unsigned char *)_ed25519_test_vectors[i]._input,
+        _lens[i]        = _ed25519_test_vectors[i].len,
+        _public_keys[i] = &_ed25519_test_vectors[i].public_key;
+
+    // run the tests
+    print_test(name, "empty", 1 == ed25519_verify_batch(_signatures, _messages, _lens, _public_keys, 0));
+    print_test(name, "one", 1 == ed25519_verify_batch(_signatures, _messages, _lens, _public_keys, 1));
+    print_test(name, "all", 1 == ed25519_verify_batch(_signatures, _messages, _lens, _public_keys, quantity));
+
+    // corrupt the last signature
+    memcpy(bad, _ed25519_test_vectors[quantity - 1].signature, sizeof(ed25519_signature));
+    bad[40] ^= 1;
+    _signatures[quantity - 1] = (const ed25519_signature *) &bad;
+
+    // run the tests
+    print_test(name, "bad signature", 0 == ed25519_verify_batch(_signatures, _messages, _lens, _public_keys, quantity));
+
+    // swap two messages
+    _signatures[quantity - 1] = &_ed25519_test_vectors[quantity - 1].signature;
+    _messages[1] = (const unsigned char *)_ed25519_test_vectors[2]._input,
+    _lens[1]     = _ed25519_test_vectors[2].len;
+
+    // run the tests
+    print_test(name, "bad message", 0 == ed25519_verify_batch(_signatures, _messages, _lens, _public_keys, quantity));
+
+    // print the summary of this test
+    print_final_summary();
+
+    // done
+    return;
+}
+
+void test_verify_small_order ( char *name )
+{
+
+    // initialized data
+    const unsigned char message[] = "small order";
+    const ed25519_public_key public_key =
+    {
+        0xd7, 0x5a, 0x98, 0x01, 0x82, 0xb1, 0x0a, 0xb7, 0xd5, 0x4b, 0xfe, 0xd3, 0xc9, 0x64, 0x07, 0x3a,
+        0x0e, 0xe1, 0x72, 0xf3, 0xda, 0xa6, 0x23, 0x25, 0xaf, 0x02, 0x1a, 0x68, 0xf7, 0x07, 0x51, 0x1a
+    };
+
+    // the public key, plus a point of order 8
+    const ed25519_public_key public_key_torsion =
+    {
+        0x3b, 0x5b, 0x47, 0x5c, 0x4b, 0x82, 0xdd, 0x15, 0x72, 0x79, 0x9f, 0xc5, 0x46, 0xf4, 0xc6, 0xc0,
+        0x3e, 0x47, 0x8c, 0x66, 0x54, 0xaa, 0x4c, 0x7f, 0x94, 0x5b, 0x34, 0x7e, 0xa3, 0x2a, 0xf6, 0x0d
+    };
+
+    // R = [r]B plus a point of order 8, signed by the private key of public_key
+    ed25519_signature r_torsion =
+    {
+        0x24, 0x72, 0x1b, 0xa9, 0x93, 0x58, 0x0d, 0xd8, 0x02, 0x2f, 0x55, 0x17, 0xff, 0x58, 0x86, 0x71,
+        0x48, 0xe8, 0x9d, 0x2e, 0x5f, 0xd7, 0xa5, 0x99, 0x37, 0xb6, 0x8c, 0x7d, 0x96, 0x90, 0xd4, 0x88,
+        0x7a, 0x49, 0x79, 0x5b, 0x9b, 0x18, 0x22, 0x8b, 0xeb, 0xe4, 0x36, 0x2e, 0xbc, 0x98, 0xe8, 0x54,
+        0xfe, 0x25, 0x35, 0x41, 0x35, 0x87, 0xf4, 0xdd, 0x5d, 0x33, 0xaf, 0x6f, 0x02, 0xf9, 0x27, 0x08
+    };
+
+    // signed by the private key of public_key, with k = H(R || public_key_torsion || M)
+    const ed25519_signature a_torsion =
+    {
+        0x3b, 0xa5, 0x92, 0x63, 0xe2, 0xbc, 0xdf, 0x81, 0x23, 0x80, 0x86, 0x1b, 0xef, 0x72, 0xd6, 0xea,
+        0x60, 0x76, 0x7f, 0xfc, 0xe6, 0x45, 0x5a, 0xf2, 0xdc, 0x61, 0x06, 0x57, 0x0e, 0xc3, 0xb6, 0xb9,
+        0xf0, 0x47, 0x00, 0x9a, 0x9a, 0x79, 0x18, 0x1b, 0xc3, 0x5d, 0x46, 0x4c, 0x9f, 0xbc, 0x65, 0x23,
+        0x13, 0x92, 0x97, 0x3c, 0x3e, 0x4c, 0x3c, 0x21, 0x35, 0xad, 0x63, 0x17, 0xa5, 0xa4, 0x3a, 0x06
+    };
+
+    // formatting
+    log_scenario("%s\n", name);
+
+    // only the cofactored equation accepts these, so every function must accept them
+    print_test(name, "R with a small order component", test_ed25519_verify_agree(&r_torsion, message, sizeof(message) - 1, &public_key, 1));
+    print_test(name, "A with a small order component", test_ed25519_verify_agree(&a_torsion, message, sizeof(message) - 1, &public_key_torsion, 1));
+
+    // corrupt S
+    r_torsion[40] ^= 1;
+
+    // every function must reject it
+    print_test(name, "corrupt S", test_ed25519_verify_agree(&r_torsion, message, sizeof(message) - 1, &public_key, 0));
+
+    // print the summary of this test
+    print_final_summary();
+
+    // done
+    return;
+}
+
+bool test_ed25519_verify_agree ( const ed25519_signature *p_signature, const unsigned char *p_message, size_t len, const ed25519_public_key *p_public_key, int expected )
+{
+
+    // initialized data
+    ed25519_expanded_key *p_expanded_key = NULL;
+    int single   = 0,
+        expanded = 0,
+        batch    = 0;
+
+    // verify
+    single = ed25519_verify(p_signature, p_message, len, p_public_key);
+
+    // verify with an expanded public key
+    if ( 0 == ed25519_expanded_key_construct(&p_expanded_key, p_public_key) ) return 0;
+    expanded = ed25519_verify_expanded(p_signature, p_message, len, p_expanded_key);
+    ed25519_expanded_key_destroy(&p_expanded_key);
+
+    // verify a batch of one
+    batch = ed25519_verify_batch(&p_signature, &p_message, &len, &p_public_key, 1);
+
+    // done
+    return ( expected == single ) && ( expected == expanded ) && ( expected == batch );
+}
+
 bool test_ed25519_sign ( ed25519_test_vector *p_ed25519_test_vector )
 {
     
@@ -326,6 +544,37 @@ bool test_ed25519_verify ( ed25519_test_vector *p_ed25519_test_vector )
     return result;
 }
 
+bool test_ed25519_verify_expanded ( ed25519_test_vector *p_ed25519_test_vector )
+{
+    
+    // initialized data
+    ed25519_expanded_key *p_expanded_key = NULL;
+    ed25519_signature     bad            = { 0 };
+    int result = 0;
+
+    // expand the public key
+    if ( 0 == ed25519_expanded_key_construct(&p_expanded_key, &p_ed25519_test_vector->public_key) ) return 0;
+
+    // verify the message
+    result = ed25519_verify_expanded(
+        &p_ed25519_test_vector->signature, 
+        (const unsigned char *)p_ed25519_test_vector->_input,
+        p_ed25519_test_vector->len, 
+        p_expanded_key
+    );
+
+    // a corrupt signature must fail
+    memcpy(bad, p_ed25519_test_vector->signature, sizeof(ed25519_signature));
+    bad[33] ^= 1;
+    if ( 1 == ed25519_verify_expanded(&bad, (const unsigned char *)p_ed25519_test_vector->_input, p_ed25519_test_vector->len, p_expanded_key) ) result = 0;
+
+    // release the expanded key
+    ed25519_expanded_key_destroy(&p_expanded_key);
+
+    // done
+    return result;
+}
+
 void print_test ( const char *scenario_name, const char *test_name, bool passed )
 {
 
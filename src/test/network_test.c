@@ -0,0 +1,1043 @@
+/** !
+ * network tester
+ *
+ * @file src/test/network_test.c
+ *
+ * @author Jacob Smith
+*/
+
+// standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+// gsdk
+/// core
+#include <core/log.h>
+#include <core/sync.h>
+#include <core/test.h>
+#include <core/socket.h>
+#include <core/tcp.h>
+#include <core/udp.h>
+#include <core/connection_pool.h>
+
+/// performance
+#include <performance/reactor.h>
+#include <performance/resolver.h>
+#include <performance/thread_pool.h>
+
+// preprocessor definitions
+#define NETWORK_TEST_LOOPBACK 0x7f000001
+#define NETWORK_TEST_ATTEMPTS 50
+#define NETWORK_TEST_PORT     47310
+#define NETWORK_TEST_SHARDS   2
+#define NETWORK_TEST_TTL      50
+
+// structure definitions
+struct network_test_resolve_s
+{
+    pthread_t thread;
+    int       quantity;
+    bool      done;
+};
+
+// function declarations
+/// scenario constructors
+fn_scenario_constructor construct_reactor;
+fn_scenario_constructor construct_tcp_shards;
+fn_scenario_constructor construct_udp_shards;
+fn_scenario_constructor construct_connection_pool;
+fn_scenario_constructor construct_udp_sockets;
+fn_scenario_constructor construct_resolver;
+fn_scenario_constructor construct_tcp_pair;
+
+/// test cases
+fn_test_case test_reactor_echo;
+fn_test_case test_reactor_hangup;
+fn_test_case test_reactor_shards_accept;
+fn_test_case test_reactor_shards_datagram;
+fn_test_case test_connection_pool_checkout_checkin;
+fn_test_case test_connection_pool_per_host;
+fn_test_case test_udp_batch_round_trip;
+fn_test_case test_udp_batch_partial;
+fn_test_case test_udp_segmented;
+fn_test_case test_resolver_hit_miss;
+fn_test_case test_resolver_ttl;
+fn_test_case test_zerocopy_send_reap;
+fn_test_case test_zerocopy_fallback;
+
+/// allocators
+fn_allocator destruct_reactor;
+fn_allocator destruct_reactor_shards;
+fn_allocator destruct_connection_pool;
+fn_allocator destruct_udp_sockets;
+fn_allocator destruct_resolver;
+fn_allocator destruct_tcp_pair;
+
+/// helpers
+socket_port network_test_port ( int _socket );
+int network_test_listen ( reactor *p_reactor, socket_tcp *p_listener, socket_tcp *p_client );
+int network_test_accept ( socket_tcp _socket_tcp, socket_ip_address ip_address, socket_port port_number, void *const p_parameter );
+int network_test_echo ( reactor *p_reactor, socket_tcp _socket_tcp, int events, void *p_parameter );
+int network_test_echo_once ( reactor *p_reactor, socket_tcp _socket_tcp, int events, void *p_parameter );
+int network_test_receive ( int _socket, void *p_buffer, size_t len );
+void network_test_resolved ( const char *p_hostname, socket_ip_address *p_ip_addresses, int quantity, void *p_parameter );
+bool network_test_resolve_async ( resolver *p_resolver, struct network_test_resolve_s *p_resolve );
+
+// data
+static const socket_ip_address _loopback = { ._type = socket_address_family_ipv4, ._address.ipv4 = NETWORK_TEST_LOOPBACK };
+static socket_tcp _listeners[2] = { -1, -1 };
+static socket_udp _udp_sockets[2] = { -1, -1 };
+static char       _oversized[SOCKET_UDP_PAYLOAD_MAX + 1] = { 0 };
+static thread_pool *_p_thread_pool = NULL;
+static socket_tcp  _tcp_pair[2] = { -1, -1 };
+static char        _payload[SOCKET_TCP_ZEROCOPY_MIN * 2] = { 0 };
+
+// test
+/// cases
+test_case _reactor_test_cases[] =
+{
+    TEST_CASE("echo"  , test_reactor_echo  , NULL, TEST_RESULT_ONE),
+    TEST_CASE("hangup", test_reactor_hangup, NULL, TEST_RESULT_ONE),
+};
+
+test_case _tcp_shards_test_cases[] =
+{
+    TEST_CASE("accept", test_reactor_shards_accept, NULL, TEST_RESULT_ONE),
+};
+
+test_case _udp_shards_test_cases[] =
+{
+    TEST_CASE("datagram", test_reactor_shards_datagram, NULL, TEST_RESULT_ONE),
+};
+
+test_case _connection_pool_test_cases[] =
+{
+    TEST_CASE("checkout/checkin", test_connection_pool_checkout_checkin, NULL, TEST_RESULT_ONE),
+    TEST_CASE("per host"        , test_connection_pool_per_host        , NULL, TEST_RESULT_ONE),
+};
+
+test_case _udp_test_cases[] =
+{
+    TEST_CASE("batch round trip", test_udp_batch_round_trip, NULL, TEST_RESULT_ONE),
+    TEST_CASE("partial batch"   , test_udp_batch_partial   , NULL, TEST_RESULT_ONE),
+    TEST_CASE("segmented"       , test_udp_segmented       , NULL, TEST_RESULT_ONE),
+};
+
+test_case _resolver_test_cases[] =
+{
+    TEST_CASE("hit/miss"  , test_resolver_hit_miss, NULL, TEST_RESULT_ONE),
+    TEST_CASE("ttl expiry", test_resolver_ttl     , NULL, TEST_RESULT_ONE),
+};
+
+test_case _zerocopy_test_cases[] =
+{
+    TEST_CASE("send/reap", test_zerocopy_send_reap, NULL, TEST_RESULT_ONE),
+    TEST_CASE("fallback" , test_zerocopy_fallback , NULL, TEST_RESULT_ONE),
+};
+
+/// scenarios
+test_scenario _scenarios[] =
+{
+    TEST_SCENARIO("reactor"           , NULL, _reactor_test_cases   , construct_reactor   , destruct_reactor),
+    TEST_SCENARIO("TCP reactor shards", NULL, _tcp_shards_test_cases, construct_tcp_shards, destruct_reactor_shards),
+    TEST_SCENARIO("UDP reactor shards", NULL, _udp_shards_test_cases, construct_udp_shards, destruct_reactor_shards),
+    TEST_SCENARIO("connection pool"   , NULL, _connection_pool_test_cases, construct_connection_pool, destruct_connection_pool),
+    TEST_SCENARIO("UDP"               , NULL, _udp_test_cases            , construct_udp_sockets    , destruct_udp_sockets),
+    TEST_SCENARIO("resolver"          , NULL, _resolver_test_cases       , construct_resolver       , destruct_resolver),
+    TEST_SCENARIO("zero copy"         , NULL, _zerocopy_test_cases       , construct_tcp_pair       , destruct_tcp_pair),
+};
+
+/// suites
+test_suite _suite = TEST_SUITE("network", _scenarios);
+
+// entry point
+int main ( int argc, const char *argv[] )
+{
+
+    // unused
+    (void) argc;
+    (void) argv;
+
+    // run the tests
+    test_suite_test(&_suite);
+
+    // done
+    return (_suite.counters.total.fails == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+socket_port network_test_port ( int _socket )
+{
+
+    // initialized data
+    struct sockaddr_in _address = { 0 };
+    socklen_t          len      = sizeof(_address);
+
+    // get the port the kernel chose
+    if ( -1 == getsockname(_socket, (struct sockaddr *)&_address, &len) ) return 0;
+
+    // success
+    return ntohs(_address.sin_port);
+}
+
+int network_test_listen ( reactor *p_reactor, socket_tcp *p_listener, socket_tcp *p_client )
+{
+
+    // listen on an ephemeral loopback port
+    if ( 0 == socket_tcp_create(p_listener, socket_address_family_ipv4, 0) ) return 0;
+    if ( 0 == reactor_listen(p_reactor, *p_listener, network_test_accept, p_reactor) ) return 0;
+
+    // connect. The kernel completes the handshake before the reactor accepts
+    return socket_tcp_connect(p_client, socket_address_family_ipv4, _loopback, network_test_port(*p_listener));
+}
+
+int network_test_accept ( socket_tcp _socket_tcp, socket_ip_address ip_address, socket_port port_number, void *const p_parameter )
+{
+
+    // unused
+    (void) ip_address;
+    (void) port_number;
+
+    // echo the connection
+    return reactor_add((reactor *)p_parameter, _socket_tcp, REACTOR_EVENT_READABLE, network_test_echo, NULL);
+}
+
+int network_test_echo ( reactor *p_reactor, socket_tcp _socket_tcp, int events, void *p_parameter )
+{
+
+    // unused
+    (void) p_reactor;
+    (void) events;
+    (void) p_parameter;
+
+    // initialized data
+    char    buf[64] = { 0 };
+    ssize_t r       = recv(_socket_tcp, buf, sizeof(buf), 0);
+
+    // remove the socket when the peer hangs up
+    if ( r <= 0 ) return 0;
+
+    // echo
+    if ( r != send(_socket_tcp, buf, (size_t) r, 0) ) return 0;
+
+    // wait for more
+    return REACTOR_EVENT_READABLE;
+}
+
+int network_test_echo_once ( reactor *p_reactor, socket_tcp _socket_tcp, int events, void *p_parameter )
+{
+
+    // unused
+    (void) p_reactor;
+    (void) events;
+    (void) p_parameter;
+
+    // initialized data
+    char               buf[64]  = { 0 };
+    struct sockaddr_in _peer    = { 0 };
+    socklen_t          peer_len = sizeof(_peer);
+    ssize_t            r        = recvfrom(_socket_tcp, buf, sizeof(buf), 0, (struct sockaddr *)&_peer, &peer_len);
+
+    // echo the datagram
+    if ( r > 0 ) sendto(_socket_tcp, buf, (size_t) r, 0, (struct sockaddr *)&_peer, peer_len);
+
+    // remove the datagram socket
+    return 0;
+}
+
+int network_test_receive ( int _socket, void *p_buffer, size_t len )
+{
+
+    // initialized data
+    ssize_t r = -1;
+
+    // poll the socket
+    for (int i = 0; i < NETWORK_TEST_ATTEMPTS && r <= 0; i++)
+        if ( 0 >= ( r = recv(_socket, p_buffer, len, MSG_DONTWAIT) ) ) usleep(10000);
+
+    // done
+    return (int) r;
+}
+
+int construct_reactor ( void **pp_result )
+{
+
+    // construct a reactor that runs handlers in reactor_run
+    return reactor_construct((reactor **)pp_result, NULL);
+}
+
+void *test_reactor_echo ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    reactor    *p_reactor = (reactor *)p_subject;
+    socket_tcp  listener  = -1,
+                client    = -1;
+    char        buf[8]    = { 0 };
+    ssize_t     r         = -1;
+    void       *p_result  = NULL;
+
+    // listen, and connect
+    if ( 0 == network_test_listen(p_reactor, &listener, &client) ) goto done;
+
+    // send
+    if ( 4 != send(client, "ping", 4, 0) ) goto done;
+
+    // run the reactor until the echo arrives
+    for (int i = 0; i < NETWORK_TEST_ATTEMPTS && r <= 0; i++)
+    {
+        if ( -1 == reactor_run(p_reactor, 100) ) goto done;
+        r = recv(client, buf, sizeof(buf), MSG_DONTWAIT);
+    }
+
+    // verify
+    if ( 4 != r || strncmp(buf, "ping", 4) ) goto done;
+
+    // the accepted socket is the only connection
+    if ( 1 != reactor_connections(p_reactor) ) goto done;
+
+    // success
+    p_result = (void *)1;
+
+    done:
+
+    // release the sockets
+    if ( client   != -1 ) socket_tcp_destroy(&client);
+    if ( listener != -1 ) socket_tcp_destroy(&listener);
+
+    // done
+    return p_result;
+}
+
+void *test_reactor_hangup ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    reactor    *p_reactor = (reactor *)p_subject;
+    socket_tcp  listener  = -1,
+                client    = -1;
+    void       *p_result  = NULL;
+
+    // listen, and connect
+    if ( 0 == network_test_listen(p_reactor, &listener, &client) ) goto done;
+
+    // run the reactor until the connection is accepted
+    for (int i = 0; i < NETWORK_TEST_ATTEMPTS && 0 == reactor_connections(p_reactor); i++)
+        if ( -1 == reactor_run(p_reactor, 100) ) goto done;
+
+    // verify
+    if ( 1 != reactor_connections(p_reactor) ) goto done;
+
+    // hang up
+    socket_tcp_destroy(&client), client = -1;
+
+    // run the reactor until the handler removes the socket
+    for (int i = 0; i < NETWORK_TEST_ATTEMPTS && 0 != reactor_connections(p_reactor); i++)
+        if ( -1 == reactor_run(p_reactor, 100) ) goto done;
+
+    // verify
+    if ( 0 != reactor_connections(p_reactor) ) goto done;
+
+    // success
+    p_result = (void *)1;
+
+    done:
+
+    // release the sockets
+    if ( client   != -1 ) socket_tcp_destroy(&client);
+    if ( listener != -1 ) socket_tcp_destroy(&listener);
+
+    // done
+    return p_result;
+}
+
+int construct_tcp_shards ( void **pp_result )
+{
+
+    // construct TCP shards that echo
+    return reactor_shards_construct((reactor_shards **)pp_result, NETWORK_TEST_SHARDS, socket_type_tcp, socket_address_family_ipv4, NETWORK_TEST_PORT, network_test_echo, NULL);
+}
+
+int construct_udp_shards ( void **pp_result )
+{
+
+    // construct UDP shards that echo one datagram
+    return reactor_shards_construct((reactor_shards **)pp_result, NETWORK_TEST_SHARDS, socket_type_udp, socket_address_family_ipv4, NETWORK_TEST_PORT, network_test_echo_once, NULL);
+}
+
+void *test_reactor_shards_accept ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    reactor_shards *p_reactor_shards = (reactor_shards *)p_subject;
+    socket_tcp      client           = -1;
+    char            buf[8]           = { 0 };
+    void           *p_result         = NULL;
+
+    // no connections yet
+    if ( 0 != reactor_shards_connections(p_reactor_shards) ) goto done;
+
+    // connect, and send
+    if ( 0 == socket_tcp_connect(&client, socket_address_family_ipv4, _loopback, NETWORK_TEST_PORT) ) goto done;
+    if ( 4 != send(client, "ping", 4, 0) ) goto done;
+
+    // one of the shards echoes
+    if ( 4 != network_test_receive(client, buf, sizeof(buf)) || strncmp(buf, "ping", 4) ) goto done;
+
+    // the accepted socket is the only connection
+    if ( 1 != reactor_shards_connections(p_reactor_shards) ) goto done;
+
+    // hang up
+    socket_tcp_destroy(&client), client = -1;
+
+    // wait for the shard to remove the socket
+    for (int i = 0; i < NETWORK_TEST_ATTEMPTS && 0 != reactor_shards_connections(p_reactor_shards); i++)
+        usleep(10000);
+
+    // verify
+    if ( 0 != reactor_shards_connections(p_reactor_shards) ) goto done;
+
+    // success
+    p_result = (void *)1;
+
+    done:
+
+    // release the socket
+    if ( client != -1 ) socket_tcp_destroy(&client);
+
+    // done
+    return p_result;
+}
+
+void *test_reactor_shards_datagram ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    reactor_shards *p_reactor_shards = (reactor_shards *)p_subject;
+    socket_udp      client           = -1;
+    char            buf[8]           = { 0 };
+    void           *p_result         = NULL;
+
+    // datagram sockets are not connections
+    if ( 0 != reactor_shards_connections(p_reactor_shards) ) goto done;
+
+    // send a datagram
+    if ( 0 == socket_udp_create(&client, socket_address_family_ipv4, 0) ) goto done;
+    if ( 0 == socket_udp_send_to(client, "ping", 4, _loopback, NETWORK_TEST_PORT) ) goto done;
+
+    // one of the shards echoes, then removes its datagram socket
+    if ( 4 != network_test_receive(client, buf, sizeof(buf)) || strncmp(buf, "ping", 4) ) goto done;
+
+    // removing a datagram socket does not underflow the count
+    if ( 0 != reactor_shards_connections(p_reactor_shards) ) goto done;
+
+    // success
+    p_result = (void *)1;
+
+    done:
+
+    // release the socket
+    if ( client != -1 ) socket_udp_destroy(&client);
+
+    // done
+    return p_result;
+}
+
+int construct_connection_pool ( void **pp_result )
+{
+
+    // listen on two loopback ports. The kernel completes each handshake,
+    // so the hosts never need to accept
+    for (size_t i = 0; i < 2; i++)
+    {
+        if ( 0 == socket_tcp_create(&_listeners[i], socket_address_family_ipv4, 0) ) return 0;
+        if ( -1 == listen(_listeners[i], SOMAXCONN) ) return 0;
+    }
+
+    // construct a pool of at most 2 connections to each host, that waits 50 ms for a checkin
+    return connection_pool_construct((connection_pool **)pp_result, 2, 2, 50, 0);
+}
+
+void *test_connection_pool_checkout_checkin ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    connection_pool            *p_connection_pool = (connection_pool *)p_subject;
+    connection_pool_connection *p_connection      = NULL;
+    socket_tcp                  _socket_tcp       = -1;
+    int                         keepalive         = 0;
+    socklen_t                   len               = sizeof(keepalive);
+
+    // check out a new connection
+    if ( 0 == connection_pool_checkout(p_connection_pool, &p_connection, _loopback, network_test_port(_listeners[0])) ) return NULL;
+    if ( 1 != connection_pool_active(p_connection_pool) || 0 != connection_pool_idle(p_connection_pool) ) return NULL;
+
+    // pooled sockets are kept alive
+    if ( -1 == getsockopt(p_connection->_socket_tcp, SOL_SOCKET, SO_KEEPALIVE, &keepalive, &len) || 0 == keepalive ) return NULL;
+
+    // check it in
+    _socket_tcp = p_connection->_socket_tcp;
+    if ( 0 == connection_pool_checkin(p_connection_pool, &p_connection, true) ) return NULL;
+    if ( NULL != p_connection ) return NULL;
+    if ( 0 != connection_pool_active(p_connection_pool) || 1 != connection_pool_idle(p_connection_pool) ) return NULL;
+
+    // the idle connection is reused
+    if ( 0 == connection_pool_checkout(p_connection_pool, &p_connection, _loopback, network_test_port(_listeners[0])) ) return NULL;
+    if ( _socket_tcp != p_connection->_socket_tcp ) return NULL;
+    if ( 1 != connection_pool_active(p_connection_pool) || 0 != connection_pool_idle(p_connection_pool) ) return NULL;
+
+    // a connection that is not reusable is closed
+    if ( 0 == connection_pool_checkin(p_connection_pool, &p_connection, false) ) return NULL;
+    if ( 0 != connection_pool_active(p_connection_pool) || 0 != connection_pool_idle(p_connection_pool) ) return NULL;
+
+    // success
+    return (void *)1;
+}
+
+void *test_connection_pool_per_host ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    connection_pool            *p_connection_pool = (connection_pool *)p_subject;
+    connection_pool_connection *p_connections[4]  = { NULL };
+    socket_port                 a                 = network_test_port(_listeners[0]),
+                                b                 = network_test_port(_listeners[1]);
+    void                       *p_result          = NULL;
+
+    // check out every connection to the first host
+    if ( 0 == connection_pool_checkout(p_connection_pool, &p_connections[0], _loopback, a) ) goto done;
+    if ( 0 == connection_pool_checkout(p_connection_pool, &p_connections[1], _loopback, a) ) goto done;
+
+    // the first host is full, so the checkout times out
+    if ( 0 != connection_pool_checkout(p_connection_pool, &p_connections[2], _loopback, a) ) goto done;
+
+    // the second host is counted separately
+    if ( 0 == connection_pool_checkout(p_connection_pool, &p_connections[3], _loopback, b) ) goto done;
+    if ( 3 != connection_pool_active(p_connection_pool) ) goto done;
+
+    // a checkin makes room on the first host
+    if ( 0 == connection_pool_checkin(p_connection_pool, &p_connections[0], true) ) goto done;
+    if ( 0 == connection_pool_checkout(p_connection_pool, &p_connections[2], _loopback, a) ) goto done;
+    if ( 3 != connection_pool_active(p_connection_pool) || 0 != connection_pool_idle(p_connection_pool) ) goto done;
+
+    // success
+    p_result = (void *)1;
+
+    done:
+
+    // check in every connection
+    for (size_t i = 0; i < 4; i++)
+        if ( p_connections[i] ) connection_pool_checkin(p_connection_pool, &p_connections[i], false);
+
+    // done
+    return p_result;
+}
+
+int construct_udp_sockets ( void **pp_result )
+{
+
+    // initialized data
+    struct timeval _timeout = { .tv_sec = 1 };
+
+    // construct a receiver, and a sender, on ephemeral ports
+    if ( 0 == socket_udp_create(&_udp_sockets[0], socket_address_family_ipv4, 0) ) return 0;
+    if ( 0 == socket_udp_create(&_udp_sockets[1], socket_address_family_ipv4, 0) ) return 0;
+
+    // fail instead of blocking on a missing datagram
+    if ( -1 == setsockopt(_udp_sockets[0], SOL_SOCKET, SO_RCVTIMEO, &_timeout, sizeof(_timeout)) ) return 0;
+
+    // the subject is the pair of sockets
+    *pp_result = _udp_sockets;
+
+    // success
+    return 1;
+}
+
+void *test_udp_batch_round_trip ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    socket_udp         *p_sockets    = (socket_udp *)p_subject;
+    socket_port         port         = network_test_port(p_sockets[0]);
+    char                _data[3][8]  = { "one", "two", "three" };
+    char                _bufs[3][16] = { { 0 } };
+    socket_udp_message  _sent[3]     = { 0 },
+                        _received[3] = { 0 };
+
+    // describe each datagram
+    for (size_t i = 0; i < 3; i++)
+    {
+        _sent[i]     = (socket_udp_message) { .p_buffer = _data[i], .buffer_len = strlen(_data[i]), .ip_address = _loopback, .port = port };
+        _received[i] = (socket_udp_message) { .p_buffer = _bufs[i], .buffer_len = sizeof(_bufs[i]) };
+    }
+
+    // send every datagram
+    if ( 3 != socket_udp_send_batch(p_sockets[1], _sent, 3) ) return NULL;
+
+    // receive every datagram
+    if ( 3 != socket_udp_receive_batch(p_sockets[0], _received, 3) ) return NULL;
+
+    // verify
+    for (size_t i = 0; i < 3; i++)
+    {
+        if ( _received[i].size != _sent[i].buffer_len || memcmp(_bufs[i], _data[i], _received[i].size) ) return NULL;
+        if ( _received[i].port != network_test_port(p_sockets[1]) ) return NULL;
+        if ( _received[i].ip_address._address.ipv4 != NETWORK_TEST_LOOPBACK ) return NULL;
+    }
+
+    // success
+    return (void *)1;
+}
+
+void *test_udp_batch_partial ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    socket_udp         *p_sockets    = (socket_udp *)p_subject;
+    socket_port         port         = network_test_port(p_sockets[0]);
+    char                _bufs[2][16] = { { 0 } };
+    socket_udp_message  _sent[3]     =
+    {
+        { .p_buffer = "first", .buffer_len = 5                 , .ip_address = _loopback, .port = port },
+        { .p_buffer = _oversized, .buffer_len = sizeof(_oversized), .ip_address = _loopback, .port = port },
+        { .p_buffer = "third", .buffer_len = 5                 , .ip_address = _loopback, .port = port },
+    };
+    socket_udp_message  _received[2] =
+    {
+        { .p_buffer = _bufs[0], .buffer_len = sizeof(_bufs[0]) },
+        { .p_buffer = _bufs[1], .buffer_len = sizeof(_bufs[1]) },
+    };
+
+    // the oversized datagram stops the send after the first datagram
+    if ( 1 != socket_udp_send_batch(p_sockets[1], _sent, 3) ) return NULL;
+
+    // only the first datagram arrives
+    if ( 1 != socket_udp_receive_batch(p_sockets[0], _received, 2) ) return NULL;
+    if ( 5 != _received[0].size || memcmp(_bufs[0], "first", 5) ) return NULL;
+
+    // nothing else was sent
+    if ( -1 != recv(p_sockets[0], _bufs[1], sizeof(_bufs[1]), MSG_DONTWAIT) ) return NULL;
+
+    // success
+    return (void *)1;
+}
+
+void *test_udp_segmented ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    socket_udp         *p_sockets     = (socket_udp *)p_subject;
+    char                _data[1000]   = { 0 };
+    char                _bufs[4][512] = { { 0 } };
+    socket_udp_message  _received[4]  = { 0 };
+    size_t              received      = 0;
+
+    // fill the data
+    for (size_t i = 0; i < sizeof(_data); i++) _data[i] = (char) i;
+
+    // describe each receive buffer
+    for (size_t i = 0; i < 4; i++)
+        _received[i] = (socket_udp_message) { .p_buffer = _bufs[i], .buffer_len = sizeof(_bufs[i]) };
+
+    // send the data as datagrams of 300 bytes
+    if ( (int) sizeof(_data) != socket_udp_send_segmented(p_sockets[1], _data, sizeof(_data), 300, _loopback, network_test_port(p_sockets[0])) ) return NULL;
+
+    // receive 4 datagrams
+    while ( received < 4 )
+    {
+
+        // initialized data
+        int r = socket_udp_receive_batch(p_sockets[0], &_received[received], 4 - received);
+
+        // error check
+        if ( r < 1 ) return NULL;
+
+        // update the counter
+        received += (size_t) r;
+    }
+
+    // verify
+    for (size_t i = 0; i < 4; i++)
+    {
+        if ( _received[i].size != ( ( i < 3 ) ? 300 : 100 ) ) return NULL;
+        if ( memcmp(_bufs[i], &_data[i * 300], _received[i].size) ) return NULL;
+    }
+
+    // success
+    return (void *)1;
+}
+
+void network_test_resolved ( const char *p_hostname, socket_ip_address *p_ip_addresses, int quantity, void *p_parameter )
+{
+
+    // unused
+    (void) p_hostname;
+    (void) p_ip_addresses;
+
+    // initialized data
+    struct network_test_resolve_s *p_resolve = p_parameter;
+
+    // store the thread that ran the callback, and the result
+    p_resolve->thread   = pthread_self(),
+    p_resolve->quantity = quantity;
+
+    // done
+    __atomic_store_n(&p_resolve->done, true, __ATOMIC_RELEASE);
+}
+
+bool network_test_resolve_async ( resolver *p_resolver, struct network_test_resolve_s *p_resolve )
+{
+
+    // reset the result
+    *p_resolve = (struct network_test_resolve_s) { 0 };
+
+    // resolve
+    if ( 0 == resolver_resolve_async(p_resolver, "localhost", network_test_resolved, p_resolve) ) return false;
+
+    // wait for a miss to resolve on the thread pool
+    for (int i = 0; i < NETWORK_TEST_ATTEMPTS * 10 && false == __atomic_load_n(&p_resolve->done, __ATOMIC_ACQUIRE); i++)
+        usleep(10000);
+
+    // a hit calls back on this thread
+    return __atomic_load_n(&p_resolve->done, __ATOMIC_ACQUIRE) && pthread_equal(p_resolve->thread, pthread_self());
+}
+
+int construct_resolver ( void **pp_result )
+{
+
+    // construct a thread pool for asynchronous resolves
+    if ( 0 == thread_pool_construct(&_p_thread_pool, 1) ) return 0;
+
+    // construct a resolver that caches hosts for 50 ms
+    return resolver_construct((resolver **)pp_result, _p_thread_pool, 16, NETWORK_TEST_TTL, NETWORK_TEST_TTL);
+}
+
+void *test_resolver_hit_miss ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    resolver                      *p_resolver = (resolver *)p_subject;
+    struct network_test_resolve_s  _resolve   = { 0 };
+
+    // the first resolve misses, and runs on the thread pool
+    if ( true == network_test_resolve_async(p_resolver, &_resolve) ) return NULL;
+    if ( false == _resolve.done || _resolve.quantity < 1 ) return NULL;
+
+    // the second resolve hits, and runs on this thread
+    if ( false == network_test_resolve_async(p_resolver, &_resolve) ) return NULL;
+    if ( _resolve.quantity < 1 ) return NULL;
+
+    // success
+    return (void *)1;
+}
+
+void *test_resolver_ttl ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    resolver                      *p_resolver       = (resolver *)p_subject;
+    struct network_test_resolve_s  _resolve         = { 0 };
+    socket_ip_address              _ip_addresses[4] = { 0 };
+
+    // cache the host
+    if ( 1 > resolver_resolve(p_resolver, _ip_addresses, 4, "localhost") ) return NULL;
+
+    // hit
+    if ( false == network_test_resolve_async(p_resolver, &_resolve) ) return NULL;
+
+    // wait for the entry to expire
+    usleep(NETWORK_TEST_TTL * 2 * 1000);
+
+    // miss
+    if ( true == network_test_resolve_async(p_resolver, &_resolve) ) return NULL;
+    if ( false == _resolve.done || _resolve.quantity < 1 ) return NULL;
+
+    // hit again
+    if ( false == network_test_resolve_async(p_resolver, &_resolve) ) return NULL;
+
+    // success
+    return (void *)1;
+}
+
+int construct_tcp_pair ( void **pp_result )
+{
+
+    // initialized data
+    socket_tcp listener = -1;
+    int        result   = 0;
+
+    // listen on an ephemeral loopback port, and connect
+    if ( 0 == socket_tcp_create(&listener, socket_address_family_ipv4, 0) ) return 0;
+    if ( -1 == listen(listener, 1) ) goto done;
+    if ( 0 == socket_tcp_connect(&_tcp_pair[0], socket_address_family_ipv4, _loopback, network_test_port(listener)) ) goto done;
+
+    // accept the peer
+    if ( -1 == ( _tcp_pair[1] = accept(listener, NULL, NULL) ) ) goto done;
+
+    // the subject is the pair of sockets
+    *pp_result = _tcp_pair;
+
+    // success
+    result = 1;
+
+    done:
+
+    // release the listener
+    socket_tcp_destroy(&listener);
+
+    // done
+    return result;
+}
+
+void *test_zerocopy_send_reap ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    socket_tcp          *p_sockets = (socket_tcp *)p_subject;
+    socket_tcp_zerocopy  _zerocopy = { 0 };
+    unsigned int         ticket    = 0;
+    char                 buf[4096] = { 0 };
+    size_t               received  = 0;
+
+    // fill the payload
+    for (size_t i = 0; i < sizeof(_payload); i++) _payload[i] = (char) i;
+
+    // enable zero copy sends, if the kernel can
+    if ( 0 == socket_tcp_zerocopy_enable(&_zerocopy, p_sockets[0]) ) return NULL;
+
+    // send a buffer large enough to pin
+    if ( (int) sizeof(_payload) != socket_tcp_send_zerocopy(&_zerocopy, _payload, sizeof(_payload), &ticket) ) return NULL;
+
+    // the peer receives every byte
+    while ( received < sizeof(_payload) )
+    {
+
+        // initialized data
+        ssize_t r = recv(p_sockets[1], buf, sizeof(buf), 0);
+
+        // error check
+        if ( r <= 0 ) return NULL;
+
+        // verify
+        if ( memcmp(buf, &_payload[received], (size_t) r) ) return NULL;
+
+        // update the counter
+        received += (size_t) r;
+    }
+
+    // wait for the kernel to release the buffer
+    if ( 0 == socket_tcp_zerocopy_flush(&_zerocopy) ) return NULL;
+    if ( false == socket_tcp_zerocopy_done(&_zerocopy, ticket) ) return NULL;
+
+    // every send completed
+    if ( _zerocopy.sent != _zerocopy.completed ) return NULL;
+
+    // reaping with nothing in flight returns at once
+    if ( 0 == socket_tcp_zerocopy_reap(&_zerocopy, true) ) return NULL;
+
+    // success
+    return (void *)1;
+}
+
+void *test_zerocopy_fallback ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+    (void) p_subject;
+
+    // initialized data
+    int                  _sockets[2] = { -1, -1 };
+    socket_tcp_zerocopy  _zerocopy   = { 0 };
+    unsigned int         ticket      = 0;
+    char                 buf[4096]   = { 0 };
+    size_t               received    = 0;
+    void                *p_result    = NULL;
+
+    // unix sockets do not support SO_ZEROCOPY
+    if ( -1 == socketpair(AF_UNIX, SOCK_STREAM, 0, _sockets) ) return NULL;
+
+    // enabling succeeds, but sends copy
+    if ( 0 == socket_tcp_zerocopy_enable(&_zerocopy, _sockets[0]) ) goto done;
+    if ( true == _zerocopy.enabled ) goto done;
+
+    // a large send copies, so its ticket is done at once
+    if ( (int) sizeof(_payload) != socket_tcp_send_zerocopy(&_zerocopy, _payload, sizeof(_payload), &ticket) ) goto done;
+    if ( false == socket_tcp_zerocopy_done(&_zerocopy, ticket) ) goto done;
+
+    // nothing to reap, or flush
+    if ( 0 == socket_tcp_zerocopy_reap(&_zerocopy, true) ) goto done;
+    if ( 0 == socket_tcp_zerocopy_flush(&_zerocopy) ) goto done;
+
+    // the peer receives every byte
+    while ( received < sizeof(_payload) )
+    {
+
+        // initialized data
+        ssize_t r = recv(_sockets[1], buf, sizeof(buf), 0);
+
+        // error check
+        if ( r <= 0 ) goto done;
+
+        // update the counter
+        received += (size_t) r;
+    }
+
+    // success
+    p_result = (void *)1;
+
+    done:
+
+    // close both ends
+    close(_sockets[0]), close(_sockets[1]);
+
+    // done
+    return p_result;
+}
+
+void *destruct_reactor ( void *p_pointer, unsigned long long size )
+{
+
+    // unused
+    (void) size;
+
+    // initialized data
+    reactor *p_reactor = (reactor *)p_pointer;
+
+    // release the reactor, and every accepted socket
+    if ( p_reactor )
+        reactor_destroy(&p_reactor);
+
+    // success
+    return NULL;
+}
+
+void *destruct_reactor_shards ( void *p_pointer, unsigned long long size )
+{
+
+    // unused
+    (void) size;
+
+    // initialized data
+    reactor_shards *p_reactor_shards = (reactor_shards *)p_pointer;
+
+    // stop the shards, and release their sockets
+    if ( p_reactor_shards )
+        reactor_shards_destroy(&p_reactor_shards);
+
+    // success
+    return NULL;
+}
+
+void *destruct_connection_pool ( void *p_pointer, unsigned long long size )
+{
+
+    // unused
+    (void) size;
+
+    // initialized data
+    connection_pool *p_connection_pool = (connection_pool *)p_pointer;
+
+    // release the pool, and every idle connection
+    if ( p_connection_pool )
+        connection_pool_destroy(&p_connection_pool);
+
+    // close both hosts
+    for (size_t i = 0; i < 2; i++)
+        if ( _listeners[i] != -1 ) socket_tcp_destroy(&_listeners[i]), _listeners[i] = -1;
+
+    // success
+    return NULL;
+}
+
+void *destruct_udp_sockets ( void *p_pointer, unsigned long long size )
+{
+
+    // unused
+    (void) p_pointer;
+    (void) size;
+
+    // close both sockets
+    for (size_t i = 0; i < 2; i++)
+        if ( _udp_sockets[i] != -1 ) socket_udp_destroy(&_udp_sockets[i]), _udp_sockets[i] = -1;
+
+    // success
+    return NULL;
+}
+
+void *destruct_resolver ( void *p_pointer, unsigned long long size )
+{
+
+    // unused
+    (void) size;
+
+    // initialized data
+    resolver *p_resolver = (resolver *)p_pointer;
+
+    // release the resolver, after its asynchronous resolves
+    if ( p_resolver )
+        resolver_destroy(&p_resolver);
+
+    // release the thread pool
+    if ( _p_thread_pool )
+        thread_pool_destroy(&_p_thread_pool);
+
+    // success
+    return NULL;
+}
+
+void *destruct_tcp_pair ( void *p_pointer, unsigned long long size )
+{
+
+    // unused
+    (void) p_pointer;
+    (void) size;
+
+    // close both ends
+    for (size_t i = 0; i < 2; i++)
+        if ( _tcp_pair[i] != -1 ) socket_tcp_destroy(&_tcp_pair[i]), _tcp_pair[i] = -1;
+
+    // success
+    return NULL;
+}
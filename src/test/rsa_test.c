@@ -0,0 +1,413 @@
+/** !
+ * Tester for rsa module
+ *
+ * @file rsa_test.c
+ *
+ * @author Jacob Smith
+ */
+
+// gsdk
+/// core
+#include <core/log.h>
+#include <core/sync.h>
+
+/// crypto
+#include <crypto/rsa.h>
+
+// preprocessor definitions
+#define RSA_TEST_MESSAGES 16
+
+// global variables
+int total_tests      = 0,
+    total_passes     = 0,
+    total_fails      = 0,
+    ephemeral_tests  = 0,
+    ephemeral_passes = 0,
+    ephemeral_fails  = 0;
+
+// messages, filled for each key
+i2048 _messages[RSA_TEST_MESSAGES] = { 0 };
+
+// forward declarations
+/** !
+ * Print the time formatted in days, hours, minutes, seconds, miliseconds, microseconds
+ *
+ * @param seconds the time in seconds
+ *
+ * @return void
+ */
+void print_time_pretty ( double seconds );
+
+/** !
+ * Run all the tests
+ *
+ * @param name void
+ *
+ * @return void
+ */
+void run_tests ( void );
+
+/** !
+ * Print a summary of the test scenario
+ *
+ * @param void
+ *
+ * @return void
+ */
+void print_final_summary ( void );
+
+/** !
+ * Print the result of a single test
+ *
+ * @param scenario_name the name of the scenario
+ * @param test_name     the name of the test
+ * @param passed        true if test passes, false if test fails
+ *
+ * @return void
+ */
+void print_test ( const char *scenario_name, const char *test_name, bool passed );
+
+void key_test ( const char *scenario_name, public_key *p_public_key, private_key *p_private_key );
+
+bool test_modulus          ( public_key *p_public_key, private_key *p_private_key );
+bool test_round_trip       ( public_key *p_public_key, private_key *p_private_key );
+bool test_crt              ( public_key *p_public_key, private_key *p_private_key );
+bool test_public_key_pack  ( public_key *p_public_key );
+bool test_private_key_pack ( private_key *p_private_key );
+
+/** !
+ * Fill the messages with 0, 1, 2, n - 1, and pseudo random values less than n
+ *
+ * @param p_public_key the public key
+ *
+ * @return void
+ */
+void messages_construct ( public_key *p_public_key );
+
+/** !
+ * Multiply two integers. Internal to rsa.c
+ *
+ * @param r result
+ * @param a the multiplicand
+ * @param b the multiplier
+ *
+ * @return void
+ */
+void bn_mul ( i2048 r, const i2048 a, const i2048 b );
+
+// entry point
+int main ( int argc, const char* argv[] )
+{
+
+    // unused
+    (void) argc;
+    (void) argv;
+
+    // initialized data
+    timestamp t0 = 0,
+              t1 = 0;
+
+    // Formatting
+    printf(
+        "╭────────────╮\n"\
+        "│ rsa tester │\n"\
+        "╰────────────╯\n\n"
+    );
+
+    // Start
+    t0 = timer_high_precision();
+
+    // Run tests
+    run_tests();
+
+    // Stop
+    t1 = timer_high_precision();
+
+    // Report the time it took to run the tests
+    log_info("rsa tests took ");
+    print_time_pretty ( (double) ( t1 - t0 ) / (double) timer_seconds_divisor() );
+    log_info(" to test\n");
+
+    // exit
+    return ( total_passes == total_tests ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void print_time_pretty ( double seconds )
+{
+
+    // initialized data
+    double _seconds     = seconds;
+    size_t days         = 0,
+           hours        = 0,
+           minutes      = 0,
+           __seconds    = 0,
+           milliseconds = 0,
+           microseconds = 0;
+
+    // Days
+    while ( _seconds > 86400.0 ) { days++;_seconds-=286400.0; };
+
+    // Hours
+    while ( _seconds > 3600.0 ) { hours++;_seconds-=3600.0; };
+
+    // Minutes
+    while ( _seconds > 60.0 ) { minutes++;_seconds-=60.0; };
+
+    // Seconds
+    while ( _seconds > 1.0 ) { __seconds++;_seconds-=1.0; };
+
+    // milliseconds
+    while ( _seconds > 0.001 ) { milliseconds++;_seconds-=0.001; };
+
+    // Microseconds
+    while ( _seconds > 0.000001 ) { microseconds++;_seconds-=0.000001; };
+
+    // Print days
+    if ( days ) log_info("%zu D, ", days);
+
+    // Print hours
+    if ( hours ) log_info("%zu h, ", hours);
+
+    // Print minutes
+    if ( minutes ) log_info("%zu m, ", minutes);
+
+    // Print seconds
+    if ( __seconds ) log_info("%zu s, ", __seconds);
+
+    // Print milliseconds
+    if ( milliseconds ) log_info("%3zu ms, ", milliseconds);
+
+    // Print microseconds
+    if ( microseconds ) log_info("%03zu us", microseconds);
+
+    // done
+    return;
+}
+
+void run_tests ( void )
+{
+
+    // initialized data
+    public_key  *p_public_key  = NULL;
+    private_key *p_private_key = NULL;
+    thread_pool *p_thread_pool = NULL;
+
+    // test a fresh key pair
+    if ( key_pair_construct(&p_public_key, &p_private_key) )
+    {
+        key_test("fresh key", p_public_key, p_private_key);
+        p_public_key  = default_allocator(p_public_key, 0),
+        p_private_key = default_allocator(p_private_key, 0);
+    }
+    else
+        print_test("fresh key", "construct", false), print_final_summary();
+
+    // test a key pair from a thread pool
+    if ( thread_pool_construct(&p_thread_pool, 4) && key_pair_construct_parallel(&p_public_key, &p_private_key, p_thread_pool) )
+    {
+        print_test("pooled key", "thread pool destroy", thread_pool_destroy(&p_thread_pool) && NULL == p_thread_pool);
+        key_test("pooled key", p_public_key, p_private_key);
+        p_public_key  = default_allocator(p_public_key, 0),
+        p_private_key = default_allocator(p_private_key, 0);
+    }
+    else
+        thread_pool_destroy(&p_thread_pool), print_test("pooled key", "construct", false), print_final_summary();
+
+    // test the committed key pair
+    if ( key_pair_from_files(&p_public_key, &p_private_key, "resources/core/public.key", "resources/core/private.key") )
+    {
+        key_test("file key", p_public_key, p_private_key);
+        p_public_key  = default_allocator(p_public_key, 0),
+        p_private_key = default_allocator(p_private_key, 0);
+    }
+    else
+        print_test("file key", "load", false), print_final_summary();
+
+    // done
+    return;
+}
+
+void key_test ( const char *name, public_key *p_public_key, private_key *p_private_key )
+{
+
+    // fill the messages
+    messages_construct(p_public_key);
+
+    // test the key
+    print_test(name, "n = p * q"            , test_modulus(p_public_key, p_private_key));
+    print_test(name, "decrypt(encrypt(x))"  , test_round_trip(p_public_key, p_private_key));
+    print_test(name, "CRT matches y^b mod n", test_crt(p_public_key, p_private_key));
+    print_test(name, "public key pack"      , test_public_key_pack(p_public_key));
+    print_test(name, "private key pack"     , test_private_key_pack(p_private_key));
+
+    // print the summary of this test
+    print_final_summary();
+}
+
+bool test_modulus ( public_key *p_public_key, private_key *p_private_key )
+{
+
+    // initialized data
+    i2048 n = { 0 };
+
+    // n = p * q
+    bn_mul(n, p_private_key->p, p_private_key->q);
+
+    // done
+    return ( 0 == memcmp(n, p_public_key->n, sizeof(i2048)) );
+}
+
+bool test_round_trip ( public_key *p_public_key, private_key *p_private_key )
+{
+
+    // every message
+    for (size_t i = 0; i < RSA_TEST_MESSAGES; i++)
+    {
+
+        // initialized data
+        i2048 y = { 0 },
+              z = { 0 };
+
+        // z = (x^a)^b mod n
+        if ( 0 == rsa_encrypt(_messages[i], y, p_public_key) ) return false;
+        if ( 0 == rsa_decrypt(y, z, p_public_key, p_private_key) ) return false;
+
+        // check
+        if ( memcmp(z, _messages[i], sizeof(i2048)) ) return false;
+    }
+
+    // success
+    return true;
+}
+
+bool test_crt ( public_key *p_public_key, private_key *p_private_key )
+{
+
+    // initialized data
+    public_key exponent_b = { 0 };
+
+    // a public key with exponent b computes y^b mod n without the CRT
+    memcpy(exponent_b.n, p_public_key->n, sizeof(i2048)),
+    memcpy(exponent_b.a, p_private_key->b, sizeof(i2048));
+
+    // every message is a ciphertext
+    for (size_t i = 0; i < RSA_TEST_MESSAGES; i++)
+    {
+
+        // initialized data
+        i2048 expected = { 0 },
+              z        = { 0 };
+
+        // y^b mod n, with and without the CRT
+        if ( 0 == rsa_encrypt(_messages[i], expected, &exponent_b) ) return false;
+        if ( 0 == rsa_decrypt(_messages[i], z, p_public_key, p_private_key) ) return false;
+
+        // check
+        if ( memcmp(z, expected, sizeof(i2048)) ) return false;
+    }
+
+    // success
+    return true;
+}
+
+bool test_public_key_pack ( public_key *p_public_key )
+{
+
+    // initialized data
+    char       buffer[4096] = { 0 };
+    public_key result       = { 0 };
+
+    // pack, then unpack
+    if ( 0 == public_key_pack(buffer, p_public_key) ) return false;
+    if ( 0 == public_key_unpack(&result, buffer) ) return false;
+
+    // check
+    return ( 0 == memcmp(&result, p_public_key, sizeof(public_key)) );
+}
+
+bool test_private_key_pack ( private_key *p_private_key )
+{
+
+    // initialized data
+    char        buffer[4096] = { 0 };
+    private_key result       = { 0 };
+
+    // pack, then unpack. dp, dq, and q_inv are derived by the unpacker
+    if ( 0 == private_key_pack(buffer, p_private_key) ) return false;
+    if ( 0 == private_key_unpack(&result, buffer) ) return false;
+
+    // check
+    return ( 0 == memcmp(&result, p_private_key, sizeof(private_key)) );
+}
+
+void messages_construct ( public_key *p_public_key )
+{
+
+    // initialized data
+    unsigned long long x     = 0x9e3779b97f4a7c15ULL;
+    size_t             limbs = RSA_LIMBS;
+
+    // the quantity of limbs in n
+    while ( limbs && 0 == p_public_key->n[limbs - 1] ) limbs--;
+
+    // clear the messages
+    memset(_messages, 0, sizeof(_messages));
+
+    // 0, 1, 2, and n - 1. n is odd
+    _messages[1][0] = 1,
+    _messages[2][0] = 2,
+    memcpy(_messages[3], p_public_key->n, sizeof(i2048)),
+    _messages[3][0] -= 1;
+
+    // pseudo random values one limb shorter than n
+    for (size_t i = 4; i < RSA_TEST_MESSAGES; i++)
+        for (size_t j = 0; j + 1 < limbs; j++)
+            x ^= x << 13, x ^= x >> 7, x ^= x << 17,
+            _messages[i][j] = x;
+
+    // done
+    return;
+}
+
+void print_test ( const char *scenario_name, const char *test_name, bool passed )
+{
+
+    // initialized data
+    if ( passed )
+        log_pass("%s %s\n", scenario_name, test_name);
+    else
+        log_fail("%s %s\n", scenario_name, test_name);
+
+    // Increment the pass/fail counter
+    if (passed)
+        ephemeral_passes++;
+    else
+        ephemeral_fails++;
+
+    // Increment the test counter
+    ephemeral_tests++;
+
+    // done
+    return;
+}
+
+void print_final_summary ( void )
+{
+
+    // Accumulate
+    total_tests  += ephemeral_tests,
+    total_passes += ephemeral_passes,
+    total_fails  += ephemeral_fails;
+
+    // Print
+    log_info("\nTests: %d, Passed: %d, Failed: %d (%%%.3f)\n",  ephemeral_tests, ephemeral_passes, ephemeral_fails, ((float)ephemeral_passes/(float)ephemeral_tests*100.f));
+    log_info("Total: %d, Passed: %d, Failed: %d (%%%.3f)\n\n",  total_tests, total_passes, total_fails, ((float)total_passes/(float)total_tests*100.f));
+
+    // Clear test counters for this test
+    ephemeral_tests  = 0;
+    ephemeral_passes = 0;
+    ephemeral_fails  = 0;
+
+    // done
+    return;
+}
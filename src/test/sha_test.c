@@ -80,6 +80,13 @@ void sha512_test ( const char *scenario_name );
 bool test_sha256 ( void *k, size_t len, sha256_hash *p_expected );
 bool test_sha512 ( void *k, size_t len, sha512_hash *p_expected );
 
+bool test_sha256_multi ( sha256_hash *p_expected );
+bool test_sha512_multi ( sha512_hash *p_expected );
+
+void kernel_test ( const char *scenario_name );
+
+bool test_kernel ( const char *kernel );
+
 // entry point
 int main ( int argc, const char* argv[] )
 {
@@ -187,6 +194,9 @@ void run_tests ( void )
     // test sha512
     sha512_test("sha512");
 
+    // test each kernel against the portable kernel
+    kernel_test("kernel");
+
     // done
     return;
 }
@@ -212,6 +222,7 @@ void sha256_test ( const char *name )
     print_test(name, "c"            , test_sha256("c"            , 1 , &_expected[3]));
     print_test(name, "Hello, World!", test_sha256("Hello, World!", 13, &_expected[4]));
     print_test(name, "Hegel Logic"  , test_sha256(_hegel_logic, sizeof(_hegel_logic), &_expected[5]));
+    print_test(name, "multi"        , test_sha256_multi(_expected));
 
     // print the summary of this test
     print_final_summary();
@@ -239,6 +250,7 @@ void sha512_test ( const char *name )
     print_test(name, "c"            , test_sha512("c"            , 1 , &_expected[3]));
     print_test(name, "Hello, World!", test_sha512("Hello, World!", 13, &_expected[4]));
     print_test(name, "Hegel Logic"  , test_sha512(_hegel_logic, sizeof(_hegel_logic), &_expected[5]));
+    print_test(name, "multi"        , test_sha512_multi(_expected));
 
     // print the summary of this test
     print_final_summary();
@@ -312,6 +324,165 @@ bool test_sha512 ( void *k, size_t len, sha512_hash *p_expected )
     return 0;
 }
 
+bool test_sha256_multi ( sha256_hash *p_expected )
+{
+
+    // initialized data
+    const unsigned char *inputs[] = { (const unsigned char *) "", (const unsigned char *) "a", (const unsigned char *) "b", (const unsigned char *) "c", (const unsigned char *) "Hello, World!", (const unsigned char *) _hegel_logic };
+    size_t lengths[] = { 0, 1, 1, 1, 13, sizeof(_hegel_logic) };
+    const unsigned char *p_data[18] = { 0 };
+    size_t p_lengths[18] = { 0 };
+    sha256_hash results[18] = { 0 };
+
+    // more messages than lanes
+    for (size_t i = 0; i < 18; i++)
+        p_data[i] = inputs[i % 6],
+        p_lengths[i] = lengths[i % 6];
+
+    // hash every message at once
+    if ( 0 == sha256_multi(results, p_data, p_lengths, 18) ) return 0;
+
+    // check each hash
+    for (size_t i = 0; i < 18; i++)
+        if ( memcmp(results[i], p_expected[i % 6], sizeof(sha256_hash)) ) return 0;
+
+    // success
+    return 1;
+}
+
+bool test_sha512_multi ( sha512_hash *p_expected )
+{
+
+    // initialized data
+    const unsigned char *inputs[] = { (const unsigned char *) "", (const unsigned char *) "a", (const unsigned char *) "b", (const unsigned char *) "c", (const unsigned char *) "Hello, World!", (const unsigned char *) _hegel_logic };
+    size_t lengths[] = { 0, 1, 1, 1, 13, sizeof(_hegel_logic) };
+    const unsigned char *p_data[18] = { 0 };
+    size_t p_lengths[18] = { 0 };
+    sha512_hash results[18] = { 0 };
+
+    // more messages than lanes
+    for (size_t i = 0; i < 18; i++)
+        p_data[i] = inputs[i % 6],
+        p_lengths[i] = lengths[i % 6];
+
+    // hash every message at once
+    if ( 0 == sha512_multi(results, p_data, p_lengths, 18) ) return 0;
+
+    // check each hash
+    for (size_t i = 0; i < 18; i++)
+        if ( memcmp(results[i], p_expected[i % 6], sizeof(sha512_hash)) ) return 0;
+
+    // success
+    return 1;
+}
+
+void kernel_test ( const char *name )
+{
+
+    // initialized data
+    const char *kernels[] =
+    {
+        "sha256_sha_ni", "sha256_arm", "sha256_x4", "sha256_x8", "sha256_x16",
+        "sha512_avx2", "sha512_x4", "sha512_x8"
+    };
+
+    // test each kernel this CPU can run
+    for (size_t i = 0; i < sizeof(kernels) / sizeof(*kernels); i++)
+    {
+
+        // skip kernels that are not compiled in, or that this CPU can not run
+        if ( 0 == sha_kernel_select(kernels[i]) )
+        {
+            log_info("%s %s unavailable\n", name, kernels[i]);
+            continue;
+        }
+
+        // compare with the portable kernel
+        print_test(name, kernels[i], test_kernel(kernels[i]));
+    }
+
+    // choose the fastest kernels again
+    sha_kernel_select(NULL);
+
+    // print the summary of this test
+    print_final_summary();
+}
+
+bool test_kernel ( const char *kernel )
+{
+
+    // initialized data
+    static const size_t lengths[] = { 0, 1, 55, 56, 63, 64, 65, 111, 112, 127, 128, 129, 255, 1000, 4097, sizeof(_hegel_logic) };
+    const size_t quantity = sizeof(lengths) / sizeof(*lengths);
+    const unsigned char *p_data[sizeof(lengths) / sizeof(*lengths)] = { 0 };
+    sha256_hash expected_256[sizeof(lengths) / sizeof(*lengths)] = { 0 },
+                result_256  [sizeof(lengths) / sizeof(*lengths)] = { 0 };
+    sha512_hash expected_512[sizeof(lengths) / sizeof(*lengths)] = { 0 },
+                result_512  [sizeof(lengths) / sizeof(*lengths)] = { 0 };
+
+    // every message starts at a different offset
+    for (size_t i = 0; i < quantity; i++)
+        p_data[i] = (const unsigned char *) _hegel_logic + ( ( lengths[i] == sizeof(_hegel_logic) ) ? 0 : i );
+
+    // hash with the portable kernels
+    sha_kernel_select("sha256_portable"),
+    sha_kernel_select("sha512_portable");
+    for (size_t i = 0; i < quantity; i++)
+    {
+
+        // initialized data
+        sha256_state _sha256_state = { 0 };
+        sha512_state _sha512_state = { 0 };
+
+        // SHA-256
+        sha256_construct(&_sha256_state);
+        if ( lengths[i] ) sha256_update(&_sha256_state, p_data[i], lengths[i]);
+        sha256_final(&_sha256_state, expected_256[i]);
+
+        // SHA-512
+        sha512_construct(&_sha512_state);
+        if ( lengths[i] ) sha512_update(&_sha512_state, p_data[i], lengths[i]);
+        sha512_final(&_sha512_state, expected_512[i]);
+    }
+
+    // hash with the kernel
+    sha_kernel_select(kernel);
+    for (size_t i = 0; i < quantity; i++)
+    {
+
+        // initialized data
+        sha256_state _sha256_state = { 0 };
+        sha512_state _sha512_state = { 0 };
+
+        // SHA-256
+        sha256_construct(&_sha256_state);
+        if ( lengths[i] ) sha256_update(&_sha256_state, p_data[i], lengths[i]);
+        sha256_final(&_sha256_state, result_256[i]);
+
+        // SHA-512
+        sha512_construct(&_sha512_state);
+        if ( lengths[i] ) sha512_update(&_sha512_state, p_data[i], lengths[i]);
+        sha512_final(&_sha512_state, result_512[i]);
+    }
+
+    // check the single buffer hashes
+    if ( memcmp(result_256, expected_256, sizeof(expected_256)) ) return 0;
+    if ( memcmp(result_512, expected_512, sizeof(expected_512)) ) return 0;
+
+    // hash every message at once
+    memset(result_256, 0, sizeof(result_256)),
+    memset(result_512, 0, sizeof(result_512));
+    if ( 0 == sha256_multi(result_256, p_data, lengths, quantity) ) return 0;
+    if ( 0 == sha512_multi(result_512, p_data, lengths, quantity) ) return 0;
+
+    // check the multi buffer hashes
+    if ( memcmp(result_256, expected_256, sizeof(expected_256)) ) return 0;
+    if ( memcmp(result_512, expected_512, sizeof(expected_512)) ) return 0;
+
+    // success
+    return 1;
+}
+
 void print_test ( const char *scenario_name, const char *test_name, bool passed )
 {
 
@@ -11,6 +11,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <pthread.h>
 
 // gsdk
 /// core
@@ -25,6 +26,11 @@ fn_scenario_constructor construct_buffer_stream;
 fn_scenario_constructor construct_file_stream;
 fn_scenario_constructor construct_file_ptr_stream;
 fn_scenario_constructor construct_dynamic_stream;
+fn_scenario_constructor construct_buffered_socket_stream;
+fn_scenario_constructor construct_compressed_stream;
+fn_scenario_constructor construct_segmented_stream;
+fn_scenario_constructor construct_stats_stream;
+fn_scenario_constructor construct_pipe_stream;
 
 /// test cases
 fn_test_case test_stream_write_read;
@@ -43,12 +49,36 @@ fn_test_case test_stream_interleaved;
 fn_test_case test_stream_overlapping;
 fn_test_case test_stream_realloc_stress;
 fn_test_case test_stream_underflow_check;
+fn_test_case test_stream_vectored;
+fn_test_case test_stream_socket_coalesce;
+fn_test_case test_stream_socket_vectored;
+fn_test_case test_stream_socket_read_ahead;
+fn_test_case test_stream_compressed_ratio;
+fn_test_case test_stream_compressed_incompressible;
+fn_test_case test_stream_compressed_large;
+fn_test_case test_stream_compressed_frame;
+fn_test_case test_stream_compressed_corrupt;
+fn_test_case test_stream_compressed_truncated;
+fn_test_case test_stream_segmented_segments;
+fn_test_case test_stream_segmented_flatten;
+fn_test_case test_stream_stats_counters;
+fn_test_case test_stream_stats_latency;
+fn_test_case test_stream_stats_json;
+fn_test_case test_stream_pipe_threaded;
+fn_test_case test_stream_pipe_eof;
+fn_test_case test_stream_pipe_non_blocking;
 
 /// allocators
 fn_allocator destruct_stream;
+fn_allocator destruct_buffered_socket_stream;
+fn_allocator destruct_compressed_stream;
+fn_allocator destruct_pipe_stream;
 
 // data
 static char _buffer[4096] = { 0 };
+static int  _sockets[2]    = { -1, -1 };
+static stream *_p_underlying = NULL;
+static stream *_p_pipe_writer = NULL;
 #define TEST_FILE_PATH "test_stream.bin"
 
 // test
@@ -71,6 +101,44 @@ test_case _stream_test_cases[] =
     TEST_CASE("overlapping"    , test_stream_overlapping    , NULL, TEST_RESULT_ONE),
     TEST_CASE("realloc stress" , test_stream_realloc_stress , NULL, TEST_RESULT_ONE),
     TEST_CASE("underflow check", test_stream_underflow_check, NULL, TEST_RESULT_ONE),
+    TEST_CASE("vectored"       , test_stream_vectored       , NULL, TEST_RESULT_ONE),
+};
+
+test_case _stream_socket_test_cases[] = 
+{
+    TEST_CASE("write coalescing", test_stream_socket_coalesce  , NULL, TEST_RESULT_ONE),
+    TEST_CASE("read ahead"      , test_stream_socket_read_ahead, NULL, TEST_RESULT_ONE),
+    TEST_CASE("vectored"        , test_stream_socket_vectored  , NULL, TEST_RESULT_ONE),
+};
+
+test_case _stream_compressed_test_cases[] = 
+{
+    TEST_CASE("ratio"         , test_stream_compressed_ratio         , NULL, TEST_RESULT_ONE),
+    TEST_CASE("incompressible", test_stream_compressed_incompressible, NULL, TEST_RESULT_ONE),
+    TEST_CASE("large data"    , test_stream_compressed_large         , NULL, TEST_RESULT_ONE),
+    TEST_CASE("frame"         , test_stream_compressed_frame         , NULL, TEST_RESULT_ONE),
+    TEST_CASE("corrupt"       , test_stream_compressed_corrupt       , NULL, TEST_RESULT_ONE),
+    TEST_CASE("truncated"     , test_stream_compressed_truncated     , NULL, TEST_RESULT_ONE),
+};
+
+test_case _stream_segmented_test_cases[] = 
+{
+    TEST_CASE("segments", test_stream_segmented_segments, NULL, TEST_RESULT_ONE),
+    TEST_CASE("flatten" , test_stream_segmented_flatten , NULL, TEST_RESULT_ONE),
+};
+
+test_case _stream_stats_test_cases[] = 
+{
+    TEST_CASE("counters", test_stream_stats_counters, NULL, TEST_RESULT_ONE),
+    TEST_CASE("latency" , test_stream_stats_latency , NULL, TEST_RESULT_ONE),
+    TEST_CASE("json"    , test_stream_stats_json    , NULL, TEST_RESULT_ONE),
+};
+
+test_case _stream_pipe_test_cases[] = 
+{
+    TEST_CASE("threaded"    , test_stream_pipe_threaded    , NULL, TEST_RESULT_ONE),
+    TEST_CASE("eof"         , test_stream_pipe_eof         , NULL, TEST_RESULT_ONE),
+    TEST_CASE("non blocking", test_stream_pipe_non_blocking, NULL, TEST_RESULT_ONE),
 };
 
 /// scenarios
@@ -80,6 +148,12 @@ test_scenario _scenarios[] =
     TEST_SCENARIO("file path stream", TEST_FILE_PATH, _stream_test_cases, construct_file_stream    , destruct_stream),
     TEST_SCENARIO("file ptr stream" , TEST_FILE_PATH, _stream_test_cases, construct_file_ptr_stream, destruct_stream),
     TEST_SCENARIO("dynamic stream"  , NULL          , _stream_test_cases, construct_dynamic_stream , destruct_stream),
+    TEST_SCENARIO("segmented stream", NULL          , _stream_test_cases, construct_segmented_stream, destruct_stream),
+    TEST_SCENARIO("segmented stream", NULL          , _stream_segmented_test_cases, construct_segmented_stream, destruct_stream),
+    TEST_SCENARIO("buffered socket stream", NULL    , _stream_socket_test_cases, construct_buffered_socket_stream, destruct_buffered_socket_stream),
+    TEST_SCENARIO("compressed stream", NULL         , _stream_compressed_test_cases, construct_compressed_stream, destruct_compressed_stream),
+    TEST_SCENARIO("stats stream"     , NULL         , _stream_stats_test_cases, construct_stats_stream, destruct_stream),
+    TEST_SCENARIO("pipe stream"      , NULL         , _stream_pipe_test_cases, construct_pipe_stream, destruct_pipe_stream),
 };
 
 /// suites
@@ -137,6 +211,50 @@ int construct_dynamic_stream ( void **pp_result )
     return stream_from_dynamic_buffer((stream **)pp_result);
 }
 
+int construct_segmented_stream ( void **pp_result )
+{
+
+    // construct a segmented buffer stream with small segments
+    return stream_from_segmented_buffer((stream **)pp_result, 64);
+}
+
+int construct_stats_stream ( void **pp_result )
+{
+
+    // construct a segmented buffer stream, whose size is what was written
+    if ( 0 == stream_from_segmented_buffer((stream **)pp_result, 0) ) return 0;
+
+    // collect statistics
+    return stream_stats_enable(*(stream **)pp_result, true);
+}
+
+int construct_pipe_stream ( void **pp_result )
+{
+
+    // construct a blocking pipe with a small ring, so the ends wait on each other
+    return stream_from_pipe((stream **)pp_result, &_p_pipe_writer, 256, true);
+}
+
+int construct_buffered_socket_stream ( void **pp_result )
+{
+
+    // construct a connected pair of sockets
+    if ( -1 == socketpair(AF_UNIX, SOCK_STREAM, 0, _sockets) ) return 0;
+
+    // construct a buffered socket stream with a small buffer
+    return stream_from_tcp_socket_buffered((stream **)pp_result, _sockets[0], 64);
+}
+
+int construct_compressed_stream ( void **pp_result )
+{
+
+    // construct the underlying stream
+    if ( 0 == stream_from_dynamic_buffer(&_p_underlying) ) return 0;
+
+    // construct a compressed stream with small blocks
+    return stream_from_compressed((stream **)pp_result, _p_underlying, 1024);
+}
+
 void *test_stream_write_read ( test_case *p_test_case, void *p_subject ) 
 { 
 
@@ -830,6 +948,59 @@ void *test_stream_underflow_check ( test_case *p_test_case, void *p_subject )
     return (void *)1;
 }
 
+void *test_stream_vectored ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    stream *p_stream  = (stream *)p_subject;
+    char    head[4]   = { 0 },
+            tail[8]   = { 0 };
+
+    // write three segments
+    if 
+    ( 
+        11 != stream_writev
+        (
+            p_stream, 
+            (struct iovec[])
+            {
+                { .iov_base = "HDR" , .iov_len = 3 },
+                { .iov_base = "BODY", .iov_len = 4 },
+                { .iov_base = "TAGS", .iov_len = 4 }
+            },
+            3
+        )
+    ) return NULL;
+
+    // seek start
+    stream_seek(p_stream, 0, STREAM_SEEK_SET);
+
+    // read two segments
+    if 
+    ( 
+        11 != stream_readv
+        (
+            p_stream, 
+            (struct iovec[])
+            {
+                { .iov_base = head, .iov_len = 3 },
+                { .iov_base = tail, .iov_len = 8 }
+            },
+            2
+        )
+    ) return NULL;
+
+    // verify
+    if ( strncmp(head, "HDR", 3) ) return NULL;
+    if ( strncmp(tail, "BODYTAGS", 8) ) return NULL;
+
+    // success
+    return (void *)1;
+}
+
 void *destruct_stream ( void *p_pointer, unsigned long long size )
 {
 
@@ -846,3 +1017,779 @@ void *destruct_stream ( void *p_pointer, unsigned long long size )
     // success
     return NULL;
 }
+
+void *test_stream_socket_coalesce ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    stream *p_stream  = (stream *)p_subject;
+    char    buf[64]   = { 0 };
+    char    large[80] = { 0 };
+
+    // write a few small messages
+    if ( 4 != stream_write(p_stream, "HEAD", 4) ) return NULL;
+    if ( 4 != stream_write(p_stream, "BODY", 4) ) return NULL;
+
+    // nothing is sent before a flush
+    if ( -1 != recv(_sockets[1], buf, sizeof(buf), MSG_DONTWAIT) ) return NULL;
+
+    // flush
+    if ( 1 != stream_flush(p_stream) ) return NULL;
+
+    // the peer receives both messages in one read
+    if ( 8 != recv(_sockets[1], buf, sizeof(buf), 0) ) return NULL;
+
+    // verify
+    if ( strncmp(buf, "HEADBODY", 8) ) return NULL;
+
+    // writes larger than the buffer are sent immediately
+    memset(large, 'L', sizeof(large));
+    if ( (int)sizeof(large) != stream_write(p_stream, large, sizeof(large)) ) return NULL;
+
+    // the peer receives the large write without a flush
+    for (size_t received = 0; received < sizeof(large); )
+    {
+
+        // initialized data
+        int r = recv(_sockets[1], buf, sizeof(buf), 0);
+
+        // error check
+        if ( r <= 0 ) return NULL;
+
+        // update received bytes
+        received += (size_t) r;
+    }
+
+    // success
+    return (void *)1;
+}
+
+void *test_stream_socket_read_ahead ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    stream *p_stream   = (stream *)p_subject;
+    char    header[8]  = { 0 };
+    char    body[24]   = { 0 };
+    char    leftover   = 0;
+
+    // the peer sends a header, a body, and a final byte in one write
+    if ( 33 != send(_sockets[1], "12345678abcdefghijklmnopqrstuvwxZ", 33, 0) ) return NULL;
+
+    // read the header
+    if ( 8 != stream_read(p_stream, header, sizeof(header)) ) return NULL;
+
+    // the rest of the message was read ahead
+    if ( -1 != recv(_sockets[0], &leftover, 1, MSG_DONTWAIT | MSG_PEEK) ) return NULL;
+
+    // read the body
+    if ( 24 != stream_read(p_stream, body, sizeof(body)) ) return NULL;
+
+    // read the final byte
+    if ( 1 != stream_read(p_stream, &leftover, 1) ) return NULL;
+
+    // verify
+    if ( strncmp(header, "12345678", 8) ) return NULL;
+    if ( strncmp(body, "abcdefghijklmnopqrstuvwx", 24) ) return NULL;
+    if ( 'Z' != leftover ) return NULL;
+
+    // success
+    return (void *)1;
+}
+
+void *test_stream_socket_vectored ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    stream *p_stream    = (stream *)p_subject;
+    char    body[96]    = { 0 };
+    char    result[128] = { 0 };
+    size_t  received    = 0;
+
+    // populate the body
+    memset(body, 'B', sizeof(body));
+
+    // leave a pending write in the buffer
+    if ( 4 != stream_write(p_stream, "LEN:", 4) ) return NULL;
+
+    // gather the pending write, a header, and a body larger than the buffer
+    if 
+    ( 
+        100 != stream_writev
+        (
+            p_stream, 
+            (struct iovec[])
+            {
+                { .iov_base = "HEAD", .iov_len = 4            },
+                { .iov_base = body  , .iov_len = sizeof(body) }
+            },
+            2
+        )
+    ) return NULL;
+
+    // receive everything
+    while ( received < 104 )
+    {
+
+        // initialized data
+        int r = recv(_sockets[1], result + received, sizeof(result) - received, 0);
+
+        // error check
+        if ( r <= 0 ) return NULL;
+
+        // update received bytes
+        received += (size_t) r;
+    }
+
+    // verify
+    if ( strncmp(result, "LEN:HEAD", 8) ) return NULL;
+    if ( memcmp(result + 8, body, sizeof(body)) ) return NULL;
+
+    // success
+    return (void *)1;
+}
+
+void *destruct_buffered_socket_stream ( void *p_pointer, unsigned long long size )
+{
+
+    // unused
+    (void) size;
+
+    // initialized data
+    stream *p_stream = (stream *)p_pointer;
+
+    // release the stream
+    if ( p_stream ) 
+        stream_destroy(&p_stream);
+
+    // close both ends
+    close(_sockets[0]), _sockets[0] = -1;
+    close(_sockets[1]), _sockets[1] = -1;
+
+    // success
+    return NULL;
+}
+
+void *test_stream_compressed_ratio ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    stream *p_stream   = (stream *)p_subject;
+    char    record[64] = { 0 };
+    char    result[64] = { 0 };
+    int     compressed = 0;
+
+    // write a log of similar records
+    for (int i = 0; i < 256; i++)
+    {
+        snprintf(record, sizeof(record), "[info] [stream] record %08d written\n", i);
+        if ( 40 != stream_write(p_stream, record, 40) ) return NULL;
+    }
+
+    // flush
+    if ( 1 != stream_flush(p_stream) ) return NULL;
+
+    // the compressed size is less than a third of the input
+    compressed = stream_tell(_p_underlying);
+    if ( compressed <= 0 || compressed * 3 > 256 * 40 ) return NULL;
+
+    // read the records back
+    if ( 1 != stream_seek(_p_underlying, 0, STREAM_SEEK_SET) ) return NULL;
+    for (int i = 0; i < 256; i++)
+    {
+        snprintf(record, sizeof(record), "[info] [stream] record %08d written\n", i);
+        if ( 40 != stream_read(p_stream, result, 40) ) return NULL;
+        if ( memcmp(record, result, 40) ) return NULL;
+    }
+
+    // success
+    return (void *)1;
+}
+
+void *test_stream_compressed_incompressible ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    stream        *p_stream     = (stream *)p_subject;
+    unsigned char  data[3000]   = { 0 };
+    unsigned char  result[3000] = { 0 };
+    unsigned int   state        = 0x12345678;
+
+    // populate the data with noise
+    for (size_t i = 0; i < sizeof(data); i++)
+        state = state * 1103515245 + 12345,
+        data[i] = (unsigned char) ( state >> 24 );
+
+    // write
+    if ( (int)sizeof(data) != stream_write(p_stream, data, sizeof(data)) ) return NULL;
+    if ( 1 != stream_flush(p_stream) ) return NULL;
+
+    // stored blocks add only a small header
+    if ( stream_tell(_p_underlying) > (int)sizeof(data) + 32 ) return NULL;
+
+    // read back
+    if ( 1 != stream_seek(_p_underlying, 0, STREAM_SEEK_SET) ) return NULL;
+    if ( (int)sizeof(result) != stream_read(p_stream, result, sizeof(result)) ) return NULL;
+
+    // verify
+    if ( memcmp(data, result, sizeof(data)) ) return NULL;
+
+    // success
+    return (void *)1;
+}
+
+void *test_stream_compressed_large ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    stream        *p_stream = (stream *)p_subject;
+    size_t         size     = 1 << 18;
+    unsigned char *p_data   = malloc(size);
+    unsigned char *p_result = malloc(size);
+    void          *ret      = NULL;
+
+    // error check
+    if ( NULL == p_data || NULL == p_result ) goto done;
+
+    // populate the data with runs, repeats, and noise
+    for (size_t i = 0; i < size; i++)
+        p_data[i] = ( i % 4096 < 1024 ) ? 'A' : ( i % 4096 < 3072 ) ? (unsigned char) ( i % 251 ) : (unsigned char) ( ( i * 2654435761U ) >> 13 );
+
+    // write in uneven pieces
+    for (size_t i = 0; i < size; i += 777)
+    {
+        size_t n = ( size - i < 777 ) ? size - i : 777;
+        if ( (int) n != stream_write(p_stream, p_data + i, n) ) goto done;
+    }
+    if ( 1 != stream_flush(p_stream) ) goto done;
+
+    // read back in uneven pieces
+    if ( 1 != stream_seek(_p_underlying, 0, STREAM_SEEK_SET) ) goto done;
+    for (size_t i = 0; i < size; i += 1000)
+    {
+        size_t n = ( size - i < 1000 ) ? size - i : 1000;
+        if ( (int) n != stream_read(p_stream, p_result + i, n) ) goto done;
+    }
+
+    // verify
+    if ( memcmp(p_data, p_result, size) ) goto done;
+
+    // success
+    ret = (void *)1;
+
+    done:
+
+    // release
+    free(p_data);
+    free(p_result);
+
+    // done
+    return ret;
+}
+
+void *test_stream_compressed_frame ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    stream *p_stream   = (stream *)p_subject;
+    stream *p_writer   = NULL;
+    char    result[32] = { 0 };
+
+    // write a whole frame
+    if ( 1 != stream_from_compressed(&p_writer, _p_underlying, 0) ) return NULL;
+    if ( 12 != stream_write(p_writer, "hello, world", 12) ) return NULL;
+
+    // destroying the writer finishes the frame
+    if ( 1 != stream_destroy(&p_writer) ) return NULL;
+
+    // read the frame
+    if ( 1 != stream_seek(_p_underlying, 0, STREAM_SEEK_SET) ) return NULL;
+    if ( 12 != stream_read(p_stream, result, sizeof(result)) ) return NULL;
+
+    // verify
+    if ( strncmp(result, "hello, world", 12) ) return NULL;
+
+    // the end of the frame is the end of the stream
+    if ( false == stream_eof(p_stream) ) return NULL;
+
+    // success
+    return (void *)1;
+}
+
+void *test_stream_compressed_corrupt ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    stream        *p_stream   = (stream *)p_subject;
+    unsigned char  frame[]    = { 'G', 'S', 'Z', '1', 6, 0, 0, 0, 0x10, 'a', 0xff, 0xff, 0x00, 0x00 };
+    char           result[32] = { 0 };
+
+    // a match that reaches before the start of the block is rejected
+    if ( (int)sizeof(frame) != stream_write(_p_underlying, frame, sizeof(frame)) ) return NULL;
+    if ( 1 != stream_seek(_p_underlying, 0, STREAM_SEEK_SET) ) return NULL;
+    if ( -1 != stream_read(p_stream, result, sizeof(result)) ) return NULL;
+
+    // a corrupt frame is not the end of the stream, and every later read fails
+    if ( true == stream_eof(p_stream) ) return NULL;
+    if ( -1 != stream_read(p_stream, result, sizeof(result)) ) return NULL;
+
+    // success
+    return (void *)1;
+}
+
+void *test_stream_compressed_truncated ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    stream        *p_stream   = (stream *)p_subject;
+    unsigned char  frame[]    = { 'G', 'S', 'Z', '1', 5, 0, 0, 0x80, 'h', 'e', 'l', 'l', 'o' };
+    char           result[32] = { 0 };
+
+    // a stored block without the end of frame marker after it
+    if ( (int)sizeof(frame) != stream_write(_p_underlying, frame, sizeof(frame)) ) return NULL;
+    if ( 1 != stream_seek(_p_underlying, 0, STREAM_SEEK_SET) ) return NULL;
+
+    // the block reads back ...
+    if ( 5 != stream_read(p_stream, result, 5) ) return NULL;
+    if ( strncmp(result, "hello", 5) ) return NULL;
+
+    // ... but the missing marker is an error, not the end of the stream
+    if ( -1 != stream_read(p_stream, result, sizeof(result)) ) return NULL;
+    if ( true == stream_eof(p_stream) ) return NULL;
+
+    // success
+    return (void *)1;
+}
+
+void *destruct_compressed_stream ( void *p_pointer, unsigned long long size )
+{
+
+    // unused
+    (void) size;
+
+    // initialized data
+    stream *p_stream = (stream *)p_pointer;
+
+    // release the compressed stream
+    if ( p_stream ) 
+        stream_destroy(&p_stream);
+
+    // release the underlying stream
+    stream_destroy(&_p_underlying);
+
+    // success
+    return NULL;
+}
+
+void *destruct_pipe_stream ( void *p_pointer, unsigned long long size )
+{
+
+    // unused
+    (void) size;
+
+    // initialized data
+    stream *p_stream = (stream *)p_pointer;
+
+    // release the reading end
+    if ( p_stream ) 
+        stream_destroy(&p_stream);
+
+    // release the writing end
+    stream_destroy(&_p_pipe_writer);
+
+    // success
+    return NULL;
+}
+
+void *test_stream_segmented_segments ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    stream       *p_stream     = (stream *)p_subject;
+    char          data[200]    = { 0 };
+    struct iovec  _segments[8] = { 0 };
+    size_t        offset       = 0;
+
+    // populate the data
+    for (size_t i = 0; i < sizeof(data); i++) data[i] = (char) i;
+
+    // an empty stream has no segments
+    if ( 0 != stream_segments(p_stream, NULL, 0) ) return NULL;
+
+    // write across several segments
+    if ( (int)sizeof(data) != stream_write(p_stream, data, sizeof(data)) ) return NULL;
+
+    // 200 bytes in 64 byte segments
+    if ( 4 != stream_segments(p_stream, _segments, 8) ) return NULL;
+    if ( 64 != _segments[0].iov_len || 8 != _segments[3].iov_len ) return NULL;
+
+    // the segments hold the data in order
+    for (size_t i = 0; i < 4; i++)
+    {
+        if ( memcmp(_segments[i].iov_base, data + offset, _segments[i].iov_len) ) return NULL;
+        offset += _segments[i].iov_len;
+    }
+
+    // growing the stream does not move existing segments
+    if ( (int)sizeof(data) != stream_write(p_stream, data, sizeof(data)) ) return NULL;
+    if ( 7 != stream_segments(p_stream, &_segments[4], 0) ) return NULL;
+    if ( 7 != stream_segments(p_stream, &_segments[1], 1) ) return NULL;
+    if ( _segments[0].iov_base != _segments[1].iov_base ) return NULL;
+
+    // success
+    return (void *)1;
+}
+
+void *test_stream_segmented_flatten ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    stream *p_stream  = (stream *)p_subject;
+    char    data[150] = { 0 };
+    char    tail[10]  = { 0 };
+    void   *p_flat    = NULL;
+    size_t  size      = 0;
+
+    // populate the data
+    for (size_t i = 0; i < sizeof(data); i++) data[i] = (char) ( 'a' + i % 26 );
+
+    // write, then overwrite across a segment boundary
+    if ( (int)sizeof(data) != stream_write(p_stream, data, sizeof(data)) ) return NULL;
+    if ( 1 != stream_seek(p_stream, 60, STREAM_SEEK_SET) ) return NULL;
+    if ( 8 != stream_write(p_stream, "OVERLAPS", 8) ) return NULL;
+    memcpy(data + 60, "OVERLAPS", 8);
+
+    // reading past the end returns what is left
+    if ( 1 != stream_seek(p_stream, -5, STREAM_SEEK_END) ) return NULL;
+    if ( 5 != stream_read(p_stream, tail, sizeof(tail)) ) return NULL;
+    if ( memcmp(tail, data + 145, 5) ) return NULL;
+
+    // flatten
+    if ( 1 != stream_flatten(p_stream, &p_flat, &size) ) return NULL;
+
+    // verify
+    if ( sizeof(data) != size || memcmp(p_flat, data, size) ) return NULL;
+
+    // release
+    p_flat = default_allocator(p_flat, 0);
+
+    // success
+    return (void *)1;
+}
+
+void *test_stream_stats_counters ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    stream       *p_stream = (stream *)p_subject;
+    stream_stats  _stats   = { 0 };
+    char          data[64] = { 0 };
+    struct iovec  segments[2] = 
+    {
+        { .iov_base = data     , .iov_len = 16 },
+        { .iov_base = data + 16, .iov_len = 16 }
+    };
+
+    // write, flush, rewind, then read past the end
+    if ( 64 != stream_write(p_stream, data, sizeof(data)) ) return NULL;
+    if ( 32 != stream_writev(p_stream, segments, 2) ) return NULL;
+    if ( 1  != stream_flush(p_stream) ) return NULL;
+    if ( 1  != stream_seek(p_stream, 0, STREAM_SEEK_SET) ) return NULL;
+    if ( 64 != stream_read(p_stream, data, sizeof(data)) ) return NULL;
+    if ( 32 != stream_read(p_stream, data, sizeof(data)) ) return NULL;
+
+    // get the statistics
+    if ( 1 != stream_stats_get(p_stream, &_stats) ) return NULL;
+
+    // verify
+    if ( 96 != _stats.write.bytes || 2 != _stats.write.operations || 0 != _stats.write.short_operations ) return NULL;
+    if ( 96 != _stats.read.bytes  || 2 != _stats.read.operations  || 1 != _stats.read.short_operations  ) return NULL;
+    if ( 1  != _stats.flushes     || 1 != _stats.seeks ) return NULL;
+
+    // reset
+    if ( 1 != stream_stats_reset(p_stream) ) return NULL;
+    if ( 1 != stream_stats_get(p_stream, &_stats) ) return NULL;
+    if ( 0 != _stats.read.operations || 0 != _stats.write.bytes ) return NULL;
+
+    // disable
+    if ( 1 != stream_stats_enable(p_stream, false) ) return NULL;
+    if ( 0 != stream_stats_get(p_stream, &_stats) ) return NULL;
+
+    // success
+    return (void *)1;
+}
+
+void *test_stream_stats_latency ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    stream             *p_stream = (stream *)p_subject;
+    stream_stats        _stats   = { 0 };
+    char                data[16] = { 0 };
+    unsigned long long  reads    = 0,
+                        writes   = 0;
+
+    // write, then read
+    for (size_t i = 0; i < 100; i++)
+        if ( 16 != stream_write(p_stream, data, sizeof(data)) ) return NULL;
+
+    if ( 1 != stream_seek(p_stream, 0, STREAM_SEEK_SET) ) return NULL;
+
+    for (size_t i = 0; i < 100; i++)
+        if ( 16 != stream_read(p_stream, data, sizeof(data)) ) return NULL;
+
+    // get the statistics
+    if ( 1 != stream_stats_get(p_stream, &_stats) ) return NULL;
+
+    // every operation lands in exactly one bucket
+    for (size_t i = 0; i < STREAM_STATS_LATENCY_BUCKETS; i++)
+    {
+        reads  += _stats.read.latency[i];
+        writes += _stats.write.latency[i];
+    }
+
+    // verify
+    if ( 100 != reads || 100 != writes ) return NULL;
+
+    // success
+    return (void *)1;
+}
+
+void *test_stream_stats_json ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    stream *p_stream = (stream *)p_subject;
+    stream *p_json   = NULL;
+    char    data[8]  = { 0 };
+    char    text[4096] = { 0 };
+    int     len      = 0;
+    void   *ret      = NULL;
+
+    // write, then read
+    if ( 8 != stream_write(p_stream, data, sizeof(data)) ) return NULL;
+    if ( 1 != stream_seek(p_stream, 0, STREAM_SEEK_SET) ) return NULL;
+    if ( 8 != stream_read(p_stream, data, sizeof(data)) ) return NULL;
+
+    // dump the statistics
+    if ( 0 == stream_from_dynamic_buffer(&p_json) ) return NULL;
+    len = stream_stats_json(p_stream, p_json);
+    if ( len <= 0 || len >= (int) sizeof(text) ) goto done;
+
+    // read the text back
+    if ( 1 != stream_seek(p_json, 0, STREAM_SEEK_SET) ) goto done;
+    if ( len != stream_read(p_json, text, (size_t) len) ) goto done;
+
+    // verify
+    if ( '{' != text[0] || '}' != text[len - 1] ) goto done;
+    if ( NULL == strstr(text, "\"read\":{\"bytes\":8,\"operations\":1,\"short_operations\":0,\"latency_ns\":[") ) goto done;
+    if ( NULL == strstr(text, "\"write\":{\"bytes\":8,\"operations\":1,") ) goto done;
+    if ( NULL == strstr(text, "\"flushes\":0,\"seeks\":1}") ) goto done;
+
+    // success
+    ret = (void *)1;
+
+    done:
+
+    // release
+    stream_destroy(&p_json);
+
+    // done
+    return ret;
+}
+
+void *stream_pipe_producer ( void *p_parameter )
+{
+
+    // initialized data
+    stream        *p_writer = (stream *)p_parameter;
+    unsigned char  chunk[1000];
+    size_t         written  = 0;
+
+    // write a counting pattern in chunks of varying size
+    for (size_t n = 1; written < (1 << 20); n = n % sizeof(chunk) + 1)
+    {
+
+        // clamp the last chunk
+        if ( n > (1 << 20) - written ) n = (1 << 20) - written;
+
+        // populate the chunk
+        for (size_t i = 0; i < n; i++) chunk[i] = (unsigned char) ( written + i );
+
+        // write the chunk
+        if ( (int) n != stream_write(p_writer, chunk, n) ) return NULL;
+
+        // update the count
+        written += n;
+    }
+
+    // close the writing end
+    stream_destroy(&p_writer);
+
+    // success
+    return (void *)1;
+}
+
+void *test_stream_pipe_threaded ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    stream        *p_reader = (stream *)p_subject;
+    pthread_t      producer;
+    unsigned char  chunk[777];
+    size_t         read     = 0;
+    int            r        = 0;
+    void          *p_ret    = NULL;
+
+    // start the producer, which owns the writing end from here on
+    if ( pthread_create(&producer, NULL, stream_pipe_producer, _p_pipe_writer) ) return NULL;
+    _p_pipe_writer = NULL;
+
+    // read until the producer closes
+    while ( ( r = stream_read(p_reader, chunk, sizeof(chunk)) ) > 0 )
+    {
+
+        // verify the pattern
+        for (int i = 0; i < r; i++)
+            if ( (unsigned char) ( read + i ) != chunk[i] ) goto done;
+
+        // update the count
+        read += r;
+    }
+
+    // verify
+    if ( (1 << 20) != read ) goto done;
+    if ( false == stream_eof(p_reader) ) goto done;
+
+    done:
+
+    // wait for the producer
+    pthread_join(producer, &p_ret);
+
+    // done
+    return ( (1 << 20) == read && p_ret ) ? (void *)1 : NULL;
+}
+
+void *test_stream_pipe_eof ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+
+    // initialized data
+    stream *p_reader = (stream *)p_subject;
+    char    data[16] = { 0 };
+
+    // the reading end can not write, and the writing end can not read
+    if ( 0 != stream_write(p_reader, "x", 1) ) return NULL;
+    if ( 0 != stream_read(_p_pipe_writer, data, 1) ) return NULL;
+
+    // write, then close the writing end
+    if ( 10 != stream_write(_p_pipe_writer, "0123456789", 10) ) return NULL;
+    if ( 10 != stream_size(p_reader) ) return NULL;
+    if ( 1 != stream_destroy(&_p_pipe_writer) ) return NULL;
+
+    // a blocking read returns what is left, instead of waiting
+    if ( 10 != stream_read(p_reader, data, sizeof(data)) ) return NULL;
+    if ( memcmp(data, "0123456789", 10) ) return NULL;
+
+    // the pipe is drained
+    if ( 0 != stream_read(p_reader, data, sizeof(data)) ) return NULL;
+    if ( false == stream_eof(p_reader) ) return NULL;
+
+    // success
+    return (void *)1;
+}
+
+void *test_stream_pipe_non_blocking ( test_case *p_test_case, void *p_subject )
+{
+
+    // unused
+    (void) p_test_case;
+    (void) p_subject;
+
+    // initialized data
+    stream *p_reader  = NULL,
+           *p_writer  = NULL;
+    char    data[100] = { 0 };
+    char    out[100]  = { 0 };
+    void   *ret       = NULL;
+
+    // populate the data
+    for (size_t i = 0; i < sizeof(data); i++) data[i] = (char) i;
+
+    // construct a non blocking pipe, rounded up to 64 bytes
+    if ( 0 == stream_from_pipe(&p_reader, &p_writer, 50, false) ) return NULL;
+
+    // an empty pipe reads nothing
+    if ( 0 != stream_read(p_reader, out, sizeof(out)) ) goto done;
+
+    // a full pipe takes what fits
+    if ( 64 != stream_write(p_writer, data, sizeof(data)) ) goto done;
+    if ( 0  != stream_write(p_writer, data, sizeof(data)) ) goto done;
+
+    // drain part of the ring, then wrap around its end
+    if ( 40 != stream_read(p_reader, out, 40) ) goto done;
+    if ( 36 != stream_write(p_writer, data + 64, 36) ) goto done;
+    if ( 60 != stream_read(p_reader, out + 40, sizeof(out)) ) goto done;
+
+    // verify
+    if ( memcmp(data, out, sizeof(data)) ) goto done;
+
+    // success
+    ret = (void *)1;
+
+    done:
+
+    // release
+    stream_destroy(&p_writer);
+    stream_destroy(&p_reader);
+
+    // done
+    return ret;
+}
@@ -0,0 +1,572 @@
+/** !
+ * Tester for x25519 and fe25519 modules
+ *
+ * @file x25519_test.c
+ *
+ * @author Jacob Smith
+ */
+
+// gsdk
+/// core
+#include <core/log.h>
+#include <core/sync.h>
+
+/// crypto
+#include <crypto/fe25519.h>
+#include <crypto/x25519.h>
+
+// global variables
+int total_tests      = 0,
+    total_passes     = 0,
+    total_fails      = 0,
+    ephemeral_tests  = 0,
+    ephemeral_passes = 0,
+    ephemeral_fails  = 0;
+
+// forward declarations
+/** !
+ * Print the time formatted in days, hours, minutes, seconds, miliseconds, microseconds
+ *
+ * @param seconds the time in seconds
+ *
+ * @return void
+ */
+void print_time_pretty ( double seconds );
+
+/** !
+ * Run all the tests
+ *
+ * @param name void
+ *
+ * @return void
+ */
+void run_tests ( void );
+
+/** !
+ * Print a summary of the test scenario
+ *
+ * @param void
+ *
+ * @return void
+ */
+void print_final_summary ( void );
+
+/** !
+ * Print the result of a single test
+ *
+ * @param scenario_name the name of the scenario
+ * @param test_name     the name of the test
+ * @param passed        true if test passes, false if test fails
+ *
+ * @return void
+ */
+void print_test ( const char *scenario_name, const char *test_name, bool passed );
+
+void fe25519_test ( const char *scenario_name );
+void x25519_test  ( const char *scenario_name );
+
+bool test_fe25519_encoding ( const unsigned char *s, const unsigned char *expected );
+bool test_fe25519_mul      ( const unsigned char *f, const unsigned char *g, const unsigned char *expected );
+bool test_fe25519_invert   ( const unsigned char *f, const unsigned char *expected );
+bool test_fe25519_inverses ( void );
+bool test_fe25519_reduce   ( void );
+
+bool test_x25519            ( const unsigned char *k, const unsigned char *u, const unsigned char *expected );
+bool test_x25519_iterations ( size_t iterations, const unsigned char *expected );
+bool test_x25519_exchange   ( const unsigned char *a_private, const unsigned char *a_public, const unsigned char *b_private, const unsigned char *b_public, const unsigned char *expected );
+
+// entry point
+int main ( int argc, const char* argv[] )
+{
+
+    // unused
+    (void) argc;
+    (void) argv;
+
+    // initialized data
+    timestamp t0 = 0,
+              t1 = 0;
+
+    // Formatting
+    printf(
+        "╭───────────────╮\n"\
+        "│ x25519 tester │\n"\
+        "╰───────────────╯\n\n"
+    );
+
+    // Start
+    t0 = timer_high_precision();
+
+    // Run tests
+    run_tests();
+
+    // Stop
+    t1 = timer_high_precision();
+
+    // Report the time it took to run the tests
+    log_info("x25519 tests took ");
+    print_time_pretty ( (double) ( t1 - t0 ) / (double) timer_seconds_divisor() );
+    log_info(" to test\n");
+
+    // exit
+    return ( total_passes == total_tests ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void print_time_pretty ( double seconds )
+{
+
+    // initialized data
+    double _seconds     = seconds;
+    size_t days         = 0,
+           hours        = 0,
+           minutes      = 0,
+           __seconds    = 0,
+           milliseconds = 0,
+           microseconds = 0;
+
+    // Days
+    while ( _seconds > 86400.0 ) { days++;_seconds-=286400.0; };
+
+    // Hours
+    while ( _seconds > 3600.0 ) { hours++;_seconds-=3600.0; };
+
+    // Minutes
+    while ( _seconds > 60.0 ) { minutes++;_seconds-=60.0; };
+
+    // Seconds
+    while ( _seconds > 1.0 ) { __seconds++;_seconds-=1.0; };
+
+    // milliseconds
+    while ( _seconds > 0.001 ) { milliseconds++;_seconds-=0.001; };
+
+    // Microseconds
+    while ( _seconds > 0.000001 ) { microseconds++;_seconds-=0.000001; };
+
+    // Print days
+    if ( days ) log_info("%zu D, ", days);
+
+    // Print hours
+    if ( hours ) log_info("%zu h, ", hours);
+
+    // Print minutes
+    if ( minutes ) log_info("%zu m, ", minutes);
+
+    // Print seconds
+    if ( __seconds ) log_info("%zu s, ", __seconds);
+
+    // Print milliseconds
+    if ( milliseconds ) log_info("%3zu ms, ", milliseconds);
+
+    // Print microseconds
+    if ( microseconds ) log_info("%03zu us", microseconds);
+
+    // done
+    return;
+}
+
+void run_tests ( void )
+{
+
+    // test the field
+    fe25519_test("fe25519");
+
+    // test the key exchange
+    x25519_test("x25519");
+
+    // done
+    return;
+}
+
+void fe25519_test ( const char *name )
+{
+
+    // initialized data
+    const unsigned char zero[32] = { 0 };
+    const unsigned char one[32] = { 0x01 };
+    const unsigned char two[32] = { 0x02 };
+    const unsigned char eighteen[32] = { 0x12 };
+    const unsigned char p[32] =
+    {
+        0xed, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f
+    };
+    const unsigned char p_plus_1[32] =
+    {
+        0xee, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f
+    };
+    const unsigned char p_less_1[32] =
+    {
+        0xec, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f
+    };
+    const unsigned char max[32] =
+    {
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f
+    };
+    const unsigned char top_bit[32] =
+    {
+        0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80
+    };
+    const unsigned char a[32] =
+    {
+        0x6a, 0xad, 0x39, 0xf4, 0xc2, 0xaa, 0xed, 0x1a, 0x8a, 0x27, 0xe5, 0x34, 0xce, 0x4a, 0xa7, 0x42,
+        0x60, 0x78, 0xfe, 0x43, 0xc2, 0x7a, 0x88, 0xb4, 0xad, 0xa9, 0xdd, 0x74, 0x48, 0x2b, 0x84, 0x10
+    };
+    const unsigned char b[32] =
+    {
+        0x23, 0x2c, 0xae, 0x48, 0xc8, 0x8f, 0xff, 0x9b, 0x50, 0x0f, 0x0b, 0x4c, 0xca, 0x8e, 0x9f, 0x33,
+        0xa7, 0x29, 0x71, 0xaa, 0x44, 0x12, 0x5c, 0x72, 0x94, 0xd1, 0x1b, 0xb5, 0xc8, 0x2d, 0xf8, 0x18
+    };
+    const unsigned char a_times_b[32] =
+    {
+        0x4d, 0x9c, 0x89, 0xb1, 0x3b, 0x70, 0xb9, 0x5c, 0xd6, 0x57, 0xe3, 0x83, 0x40, 0x59, 0xcf, 0x68,
+        0xe2, 0x4c, 0xe2, 0x19, 0x19, 0xe0, 0x3c, 0x3a, 0x40, 0xf7, 0x0b, 0x9a, 0x3d, 0x6b, 0xf2, 0x58
+    };
+    const unsigned char a_inverse[32] =
+    {
+        0x3e, 0xb7, 0xb9, 0xb0, 0x6d, 0xbd, 0x9f, 0x24, 0xdf, 0x52, 0x0e, 0x8f, 0x63, 0xba, 0x87, 0x95,
+        0x4d, 0xd9, 0x4f, 0x0f, 0xa3, 0xa0, 0x43, 0x49, 0x6e, 0x36, 0xaf, 0xc2, 0xa4, 0xd8, 0xb3, 0x6e
+    };
+    const unsigned char two_inverse[32] =
+    {
+        0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f
+    };
+
+    // canonical encoding
+    print_test(name, "encode 0"            , test_fe25519_encoding(zero, zero));
+    print_test(name, "encode p - 1"        , test_fe25519_encoding(p_less_1, p_less_1));
+    print_test(name, "encode p"            , test_fe25519_encoding(p, zero));
+    print_test(name, "encode p + 1"        , test_fe25519_encoding(p_plus_1, one));
+    print_test(name, "encode 2^255 - 1"    , test_fe25519_encoding(max, eighteen));
+    print_test(name, "ignore the top bit"  , test_fe25519_encoding(top_bit, two));
+    print_test(name, "reduce wide limbs"   , test_fe25519_reduce());
+
+    // arithmetic
+    print_test(name, "a * b"               , test_fe25519_mul(a, b, a_times_b));
+    print_test(name, "(p - 1) * (p - 1)"   , test_fe25519_mul(p_less_1, p_less_1, one));
+    print_test(name, "invert 0"            , test_fe25519_invert(zero, zero));
+    print_test(name, "invert 1"            , test_fe25519_invert(one, one));
+    print_test(name, "invert 2"            , test_fe25519_invert(two, two_inverse));
+    print_test(name, "invert p - 1"        , test_fe25519_invert(p_less_1, p_less_1));
+    print_test(name, "invert a"            , test_fe25519_invert(a, a_inverse));
+    print_test(name, "f * 1/f = 1"         , test_fe25519_inverses());
+
+    // print the summary of this test
+    print_final_summary();
+}
+
+void x25519_test ( const char *name )
+{
+
+    // initialized data
+    const unsigned char k1[32] =
+    {
+        0xa5, 0x46, 0xe3, 0x6b, 0xf0, 0x52, 0x7c, 0x9d, 0x3b, 0x16, 0x15, 0x4b, 0x82, 0x46, 0x5e, 0xdd,
+        0x62, 0x14, 0x4c, 0x0a, 0xc1, 0xfc, 0x5a, 0x18, 0x50, 0x6a, 0x22, 0x44, 0xba, 0x44, 0x9a, 0xc4
+    };
+    const unsigned char u1[32] =
+    {
+        0xe6, 0xdb, 0x68, 0x67, 0x58, 0x30, 0x30, 0xdb, 0x35, 0x94, 0xc1, 0xa4, 0x24, 0xb1, 0x5f, 0x7c,
+        0x72, 0x66, 0x24, 0xec, 0x26, 0xb3, 0x35, 0x3b, 0x10, 0xa9, 0x03, 0xa6, 0xd0, 0xab, 0x1c, 0x4c
+    };
+    const unsigned char out1[32] =
+    {
+        0xc3, 0xda, 0x55, 0x37, 0x9d, 0xe9, 0xc6, 0x90, 0x8e, 0x94, 0xea, 0x4d, 0xf2, 0x8d, 0x08, 0x4f,
+        0x32, 0xec, 0xcf, 0x03, 0x49, 0x1c, 0x71, 0xf7, 0x54, 0xb4, 0x07, 0x55, 0x77, 0xa2, 0x85, 0x52
+    };
+    const unsigned char k2[32] =
+    {
+        0x4b, 0x66, 0xe9, 0xd4, 0xd1, 0xb4, 0x67, 0x3c, 0x5a, 0xd2, 0x26, 0x91, 0x95, 0x7d, 0x6a, 0xf5,
+        0xc1, 0x1b, 0x64, 0x21, 0xe0, 0xea, 0x01, 0xd4, 0x2c, 0xa4, 0x16, 0x9e, 0x79, 0x18, 0xba, 0x0d
+    };
+    const unsigned char u2[32] =
+    {
+        0xe5, 0x21, 0x0f, 0x12, 0x78, 0x68, 0x11, 0xd3, 0xf4, 0xb7, 0x95, 0x9d, 0x05, 0x38, 0xae, 0x2c,
+        0x31, 0xdb, 0xe7, 0x10, 0x6f, 0xc0, 0x3c, 0x3e, 0xfc, 0x4c, 0xd5, 0x49, 0xc7, 0x15, 0xa4, 0x93
+    };
+    const unsigned char out2[32] =
+    {
+        0x95, 0xcb, 0xde, 0x94, 0x76, 0xe8, 0x90, 0x7d, 0x7a, 0xad, 0xe4, 0x5c, 0xb4, 0xb8, 0x73, 0xf8,
+        0x8b, 0x59, 0x5a, 0x68, 0x79, 0x9f, 0xa1, 0x52, 0xe6, 0xf8, 0xf7, 0x64, 0x7a, 0xac, 0x79, 0x57
+    };
+    const unsigned char iteration_1[32] =
+    {
+        0x42, 0x2c, 0x8e, 0x7a, 0x62, 0x27, 0xd7, 0xbc, 0xa1, 0x35, 0x0b, 0x3e, 0x2b, 0xb7, 0x27, 0x9f,
+        0x78, 0x97, 0xb8, 0x7b, 0xb6, 0x85, 0x4b, 0x78, 0x3c, 0x60, 0xe8, 0x03, 0x11, 0xae, 0x30, 0x79
+    };
+    const unsigned char iteration_1000[32] =
+    {
+        0x68, 0x4c, 0xf5, 0x9b, 0xa8, 0x33, 0x09, 0x55, 0x28, 0x00, 0xef, 0x56, 0x6f, 0x2f, 0x4d, 0x3c,
+        0x1c, 0x38, 0x87, 0xc4, 0x93, 0x60, 0xe3, 0x87, 0x5f, 0x2e, 0xb9, 0x4d, 0x99, 0x53, 0x2c, 0x51
+    };
+    const unsigned char alice_private[32] =
+    {
+        0x77, 0x07, 0x6d, 0x0a, 0x73, 0x18, 0xa5, 0x7d, 0x3c, 0x16, 0xc1, 0x72, 0x51, 0xb2, 0x66, 0x45,
+        0xdf, 0x4c, 0x2f, 0x87, 0xeb, 0xc0, 0x99, 0x2a, 0xb1, 0x77, 0xfb, 0xa5, 0x1d, 0xb9, 0x2c, 0x2a
+    };
+    const unsigned char alice_public[32] =
+    {
+        0x85, 0x20, 0xf0, 0x09, 0x89, 0x30, 0xa7, 0x54, 0x74, 0x8b, 0x7d, 0xdc, 0xb4, 0x3e, 0xf7, 0x5a,
+        0x0d, 0xbf, 0x3a, 0x0d, 0x26, 0x38, 0x1a, 0xf4, 0xeb, 0xa4, 0xa9, 0x8e, 0xaa, 0x9b, 0x4e, 0x6a
+    };
+    const unsigned char bob_private[32] =
+    {
+        0x5d, 0xab, 0x08, 0x7e, 0x62, 0x4a, 0x8a, 0x4b, 0x79, 0xe1, 0x7f, 0x8b, 0x83, 0x80, 0x0e, 0xe6,
+        0x6f, 0x3b, 0xb1, 0x29, 0x26, 0x18, 0xb6, 0xfd, 0x1c, 0x2f, 0x8b, 0x27, 0xff, 0x88, 0xe0, 0xeb
+    };
+    const unsigned char bob_public[32] =
+    {
+        0xde, 0x9e, 0xdb, 0x7d, 0x7b, 0x7d, 0xc1, 0xb4, 0xd3, 0x5b, 0x61, 0xc2, 0xec, 0xe4, 0x35, 0x37,
+        0x3f, 0x83, 0x43, 0xc8, 0x5b, 0x78, 0x67, 0x4d, 0xad, 0xfc, 0x7e, 0x14, 0x6f, 0x88, 0x2b, 0x4f
+    };
+    const unsigned char shared_secret[32] =
+    {
+        0x4a, 0x5d, 0x9d, 0x5b, 0xa4, 0xce, 0x2d, 0xe1, 0x72, 0x8e, 0x3b, 0xf4, 0x80, 0x35, 0x0f, 0x25,
+        0xe0, 0x7e, 0x21, 0xc9, 0x47, 0xd1, 0x9e, 0x33, 0x76, 0xf0, 0x9b, 0x3c, 0x1e, 0x16, 0x17, 0x42
+    };
+
+    // RFC 7748 section 5.2
+    print_test(name, "RFC 7748 5.2 vector 1"       , test_x25519(k1, u1, out1));
+    print_test(name, "RFC 7748 5.2 vector 2"       , test_x25519(k2, u2, out2));
+    print_test(name, "RFC 7748 5.2 1 iteration"    , test_x25519_iterations(1, iteration_1));
+    print_test(name, "RFC 7748 5.2 1000 iterations", test_x25519_iterations(1000, iteration_1000));
+
+    // RFC 7748 section 6.1
+    print_test(name, "RFC 7748 6.1 key exchange"   , test_x25519_exchange(alice_private, alice_public, bob_private, bob_public, shared_secret));
+
+    // print the summary of this test
+    print_final_summary();
+}
+
+bool test_fe25519_encoding ( const unsigned char *s, const unsigned char *expected )
+{
+
+    // initialized data
+    fe25519       f         = { 0 };
+    unsigned char result[32] = { 0 };
+
+    // decode, then encode
+    fe25519_from_bytes(f, s);
+    fe25519_to_bytes(result, f);
+
+    // check
+    return ( 0 == memcmp(result, expected, sizeof(result)) );
+}
+
+bool test_fe25519_reduce ( void )
+{
+
+    // initialized data
+    const unsigned char expected[32] = { 0x12 };
+    fe25519       f         = { 0 };
+    unsigned char result[32] = { 0 };
+
+    // every limb full, which is 2^255 - 1, or 18
+    for (int i = 0; i < 5; i++) f[i] = ( 1ULL << 51 ) - 1;
+
+    // encode
+    fe25519_to_bytes(result, f);
+
+    // check
+    return ( 0 == memcmp(result, expected, sizeof(result)) );
+}
+
+bool test_fe25519_mul ( const unsigned char *f, const unsigned char *g, const unsigned char *expected )
+{
+
+    // initialized data
+    fe25519       _f        = { 0 },
+                  _g        = { 0 },
+                  h         = { 0 };
+    unsigned char result[32] = { 0 };
+
+    // decode
+    fe25519_from_bytes(_f, f),
+    fe25519_from_bytes(_g, g);
+
+    // multiply
+    fe25519_mul(h, _f, _g);
+    fe25519_to_bytes(result, h);
+    if ( memcmp(result, expected, sizeof(result)) ) return false;
+
+    // squaring agrees with multiplying by itself
+    fe25519_mul(h, _f, _f);
+    fe25519_sq(_g, _f);
+
+    // check
+    return fe25519_equal(h, _g);
+}
+
+bool test_fe25519_invert ( const unsigned char *f, const unsigned char *expected )
+{
+
+    // initialized data
+    fe25519       _f        = { 0 },
+                  h         = { 0 };
+    unsigned char result[32] = { 0 };
+
+    // decode
+    fe25519_from_bytes(_f, f);
+
+    // invert
+    fe25519_invert(h, _f);
+    fe25519_to_bytes(result, h);
+
+    // check
+    return ( 0 == memcmp(result, expected, sizeof(result)) );
+}
+
+bool test_fe25519_inverses ( void )
+{
+
+    // initialized data
+    fe25519 f   = { 0 },
+            one = { 0 };
+    unsigned char s[32] = { 0 };
+
+    // 1
+    fe25519_1(one);
+
+    // many values
+    for (int i = 0; i < 256; i++)
+    {
+
+        // initialized data
+        fe25519 h = { 0 };
+
+        // a different value with every byte set
+        for (int j = 0; j < 32; j++) s[j] = (unsigned char) ( ( i + 1 ) * 37 + j * 101 );
+        s[31] &= 0x7f;
+        fe25519_from_bytes(f, s);
+
+        // skip zero
+        if ( fe25519_is_zero(f) ) continue;
+
+        // f * 1/f
+        fe25519_invert(h, f);
+        fe25519_mul(h, h, f);
+
+        // check
+        if ( false == fe25519_equal(h, one) ) return false;
+    }
+
+    // success
+    return true;
+}
+
+bool test_x25519 ( const unsigned char *k, const unsigned char *u, const unsigned char *expected )
+{
+
+    // initialized data
+    x25519_private_key   _k     = { 0 };
+    x25519_public_key    _u     = { 0 };
+    x25519_shared_secret result = { 0 };
+
+    // copy the scalar and the u coordinate
+    memcpy(_k, k, sizeof(_k)),
+    memcpy(_u, u, sizeof(_u));
+
+    // k * u
+    if ( 0 == x25519_shared_secret_derive(&_k, &_u, &result) ) return false;
+
+    // check
+    return ( 0 == memcmp(result, expected, sizeof(result)) );
+}
+
+bool test_x25519_iterations ( size_t iterations, const unsigned char *expected )
+{
+
+    // initialized data
+    x25519_private_key   k      = { 9 };
+    x25519_public_key    u      = { 9 };
+    x25519_shared_secret result = { 0 };
+
+    // k, u = x25519(k, u), k
+    for (size_t i = 0; i < iterations; i++)
+    {
+        if ( 0 == x25519_shared_secret_derive(&k, &u, &result) ) return false;
+        memcpy(u, k, sizeof(u)),
+        memcpy(k, result, sizeof(k));
+    }
+
+    // check
+    return ( 0 == memcmp(k, expected, sizeof(k)) );
+}
+
+bool test_x25519_exchange ( const unsigned char *a_private, const unsigned char *a_public, const unsigned char *b_private, const unsigned char *b_public, const unsigned char *expected )
+{
+
+    // initialized data
+    x25519_private_key   a       = { 0 },
+                         b       = { 0 };
+    x25519_public_key    A       = { 0 },
+                         B       = { 0 };
+    x25519_shared_secret a_b     = { 0 },
+                         b_a     = { 0 };
+
+    // copy the private keys
+    memcpy(a, a_private, sizeof(a)),
+    memcpy(b, b_private, sizeof(b));
+
+    // derive the public keys
+    if ( 0 == x25519_public_key_derive(&a, &A) ) return false;
+    if ( 0 == x25519_public_key_derive(&b, &B) ) return false;
+
+    // check the public keys
+    if ( memcmp(A, a_public, sizeof(A)) ) return false;
+    if ( memcmp(B, b_public, sizeof(B)) ) return false;
+
+    // derive the shared secrets
+    if ( 0 == x25519_shared_secret_derive(&a, &B, &a_b) ) return false;
+    if ( 0 == x25519_shared_secret_derive(&b, &A, &b_a) ) return false;
+
+    // check
+    return ( 0 == memcmp(a_b, expected, sizeof(a_b)) ) && ( 0 == memcmp(b_a, expected, sizeof(b_a)) );
+}
+
+void print_test ( const char *scenario_name, const char *test_name, bool passed )
+{
+
+    // initialized data
+    if ( passed )
+        log_pass("%s %s\n", scenario_name, test_name);
+    else
+        log_fail("%s %s\n", scenario_name, test_name);
+
+    // Increment the pass/fail counter
+    if (passed)
+        ephemeral_passes++;
+    else
+        ephemeral_fails++;
+
+    // Increment the test counter
+    ephemeral_tests++;
+
+    // done
+    return;
+}
+
+void print_final_summary ( void )
+{
+
+    // Accumulate
+    total_tests  += ephemeral_tests,
+    total_passes += ephemeral_passes,
+    total_fails  += ephemeral_fails;
+
+    // Print
+    log_info("\nTests: %d, Passed: %d, Failed: %d (%%%.3f)\n",  ephemeral_tests, ephemeral_passes, ephemeral_fails, ((float)ephemeral_passes/(float)ephemeral_tests*100.f));
+    log_info("Total: %d, Passed: %d, Failed: %d (%%%.3f)\n\n",  total_tests, total_passes, total_fails, ((float)total_passes/(float)total_tests*100.f));
+
+    // Clear test counters for this test
+    ephemeral_tests  = 0;
+    ephemeral_passes = 0;
+    ephemeral_fails  = 0;
+
+    // done
+    return;
+}
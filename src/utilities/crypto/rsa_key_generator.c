@@ -12,6 +12,7 @@
 #include <string.h>
 #include <limits.h>
 #include <time.h>
+#include <unistd.h>
 
 // gsdk
 /// core
@@ -27,6 +28,12 @@
 #include <reflection/base64.h>
 #include <reflection/json.h>
 
+/// performance
+#include <performance/thread_pool.h>
+
+// preprocessor definitions
+#define RSA_KEY_GENERATOR_MAX_THREADS 64
+
 // entry point
 int main ( int argc, const char *argv[] )
 {
@@ -36,17 +43,30 @@ int main ( int argc, const char *argv[] )
     (void) argv;
 
     // initialized data
-    public_key  *p_public_key  = NULL;
-    private_key *p_private_key = NULL;
-    int          result        = 0;
+    public_key  *p_public_key    = NULL;
+    private_key *p_private_key   = NULL;
+    thread_pool *p_thread_pool   = NULL;
+    long         cpu_quantity    = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t       thread_quantity = ( cpu_quantity > 0 ) ? (size_t) cpu_quantity : 1;
+    int          result          = 0;
+
+    // clamp the quantity of threads
+    if ( thread_quantity > RSA_KEY_GENERATOR_MAX_THREADS ) thread_quantity = RSA_KEY_GENERATOR_MAX_THREADS;
+
+    // test prime candidates on each processor. without a thread pool, the caller tests them
+    if ( 0 == thread_pool_construct(&p_thread_pool, thread_quantity) ) p_thread_pool = NULL;
 
     // construct a key pair
-    result = key_pair_construct
+    result = key_pair_construct_parallel
     (
-        &p_public_key, // pointer to public key pointer
-        &p_private_key // pointer to private key pointer
+        &p_public_key,  // pointer to public key pointer
+        &p_private_key, // pointer to private key pointer
+        p_thread_pool   // the thread pool
     );
 
+    // release the thread pool
+    thread_pool_destroy(&p_thread_pool);
+
     // error check
     if ( 0 == result ) goto failed_to_create_key_pair;
 
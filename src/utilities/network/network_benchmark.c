@@ -0,0 +1,914 @@
+/** !
+ * Loopback network benchmark
+ *
+ * @file src/utilities/network/network_benchmark.c
+ *
+ * @author Jacob Smith
+ */
+
+// standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+
+// posix
+#include <pthread.h>
+#include <sys/time.h>
+
+// gsdk
+/// core
+#include <core/log.h>
+#include <core/sync.h>
+#include <core/socket.h>
+#include <core/tcp.h>
+#include <core/udp.h>
+
+/// crypto
+#include <crypto/secure_socket.h>
+
+// preprocessor definitions
+#define NETWORK_BENCHMARK_UDP_TIMEOUT 200
+
+// enumeration definitions
+enum transport_e
+{
+    TRANSPORT_TCP    = 0,
+    TRANSPORT_UDP    = 1,
+    TRANSPORT_SECURE = 2
+};
+
+// structure definitions
+struct client_s
+{
+    pthread_t  thread;
+    timestamp *p_latencies;
+    size_t     received;
+    size_t     lost;
+    size_t     depth;
+    bool       failed;
+};
+
+// type definitions
+typedef struct client_s client;
+
+// forward declarations
+/** !
+ * Print a usage message to standard out
+ *
+ * @param argv0 the name of the program
+ *
+ * @return void
+ */
+void print_usage ( const char *argv0 );
+
+/** !
+ * Parse command line arguments
+ *
+ * @param argc the argc parameter of the entry point
+ * @param argv the argv parameter of the entry point
+ *
+ * @return void on success, program abort on failure
+ */
+void parse_command_line_arguments ( int argc, const char *argv[] );
+
+/** !
+ * Load the certificates, and the key of the secure server
+ *
+ * @param void
+ *
+ * @return 1 on success, 0 on error
+ */
+int load_certificates ( void );
+
+/** !
+ * Start an echo server for the transport on a thread
+ *
+ * @param void
+ *
+ * @return 1 on success, 0 on error
+ */
+int server_start ( void );
+
+/** !
+ * Echo every message from a TCP connection
+ *
+ * @param p_parameter the TCP socket
+ *
+ * @return null
+ */
+void *tcp_echo ( void *p_parameter );
+
+/** !
+ * Accept TCP connections, and echo each of them on its own thread
+ *
+ * @param p_parameter the listening TCP socket
+ *
+ * @return null
+ */
+void *tcp_server ( void *p_parameter );
+
+/** !
+ * Echo batches of datagrams
+ *
+ * @param p_parameter the UDP socket
+ *
+ * @return null
+ */
+void *udp_server ( void *p_parameter );
+
+/** !
+ * Echo every message from a secure connection
+ *
+ * @param p_parameter the secure socket
+ *
+ * @return null
+ */
+void *secure_echo ( void *p_parameter );
+
+/** !
+ * Accept secure connections, and echo each of them on its own thread
+ *
+ * @param p_parameter the listening TCP socket
+ *
+ * @return null
+ */
+void *secure_server ( void *p_parameter );
+
+/** !
+ * Run one connection of the benchmark
+ *
+ * @param p_parameter the client
+ *
+ * @return null
+ */
+void *client_run ( void *p_parameter );
+
+/** !
+ * Limit the pipeline of a stream connection, so every reply in flight fits
+ * in the receive buffer. Otherwise, the client blocks sending requests while
+ * the server blocks sending replies that the client is not reading
+ *
+ * @param _socket_tcp the connected TCP socket
+ *
+ * @return the pipeline depth, at least 1
+ */
+size_t pipeline_depth ( socket_tcp _socket_tcp );
+
+/** !
+ * Compare two latencies for qsort
+ *
+ * @param p_a the first latency
+ * @param p_b the second latency
+ *
+ * @return negative, zero, or positive
+ */
+int latency_compare ( const void *p_a, const void *p_b );
+
+// data
+enum transport_e     transport      = TRANSPORT_TCP;
+const char          *p_transport    = "tcp";
+size_t               message_size   = 64;
+size_t               connections    = 1;
+size_t               depth          = 1;
+size_t               messages       = 100000;
+socket_port          port_number    = 3030;
+socket_ip_address    server_ip      = { ._type = socket_address_family_ipv4, ._address.ipv4 = 0x7f000001 };
+certificate         *p_trust        = NULL;
+certificate         *p_leaf         = NULL;
+ed25519_private_key  private_key    = { 0 };
+
+// entry point
+int main ( int argc, const char *argv[] )
+{
+
+    // initialized data
+    client    *p_clients   = NULL;
+    timestamp *p_latencies = NULL;
+    size_t     received    = 0,
+               lost        = 0,
+               effective   = 0;
+    timestamp  start       = 0,
+               end         = 0;
+    double     seconds     = 0,
+               divisor     = (double) timer_seconds_divisor();
+
+    // parse command line arguments
+    parse_command_line_arguments(argc, argv);
+
+    // no client runs a deeper pipeline than requested
+    effective = depth;
+
+    // load certificates
+    if ( transport == TRANSPORT_SECURE && 0 == load_certificates() ) goto failed_to_load_certificates;
+
+    // start the server
+    if ( 0 == server_start() ) goto failed_to_start_server;
+
+    // allocate the clients
+    p_clients = calloc(connections, sizeof(client));
+    if ( NULL == p_clients ) goto no_mem;
+
+    // allocate the latencies
+    for (size_t i = 0; i < connections; i++)
+    {
+        p_clients[i].p_latencies = malloc(messages * sizeof(timestamp));
+        if ( NULL == p_clients[i].p_latencies ) goto no_mem;
+    }
+
+    // start the clock
+    start = timer_high_precision();
+
+    // start each client
+    for (size_t i = 0; i < connections; i++)
+        if ( pthread_create(&p_clients[i].thread, NULL, client_run, &p_clients[i]) ) goto failed_to_start_client;
+
+    // wait for each client
+    for (size_t i = 0; i < connections; i++)
+        pthread_join(p_clients[i].thread, NULL);
+
+    // stop the clock
+    end     = timer_high_precision(),
+    seconds = (double) ( end - start ) / divisor;
+
+    // merge the latencies
+    p_latencies = malloc(connections * messages * sizeof(timestamp));
+    if ( NULL == p_latencies ) goto no_mem;
+
+    // iterate through each client
+    for (size_t i = 0; i < connections; i++)
+    {
+
+        // error check
+        if ( p_clients[i].failed ) goto failed_to_run_client;
+
+        // copy the latencies
+        memcpy(&p_latencies[received], p_clients[i].p_latencies, p_clients[i].received * sizeof(timestamp));
+
+        // accumulate
+        received += p_clients[i].received,
+        lost     += p_clients[i].lost;
+
+        // the smallest pipeline that ran
+        if ( p_clients[i].depth < effective ) effective = p_clients[i].depth;
+
+        // release the latencies
+        free(p_clients[i].p_latencies);
+    }
+
+    // sort the latencies
+    qsort(p_latencies, received, sizeof(timestamp), latency_compare);
+
+    // print the report
+    printf(
+        "{\"transport\":\"%s\",\"message_size\":%zu,\"connections\":%zu,\"depth\":%zu,\"effective_depth\":%zu,"
+        "\"messages\":%zu,\"lost\":%zu,\"seconds\":%.6f,"
+        "\"messages_per_second\":%.1f,\"megabytes_per_second\":%.3f,"
+        "\"latency_us\":{\"p50\":%.3f,\"p99\":%.3f,\"p999\":%.3f}}\n",
+        p_transport, message_size, connections, depth, effective,
+        received, lost, seconds,
+        (double) received / seconds,
+        (double) ( received * message_size ) / seconds / 1000000.0,
+        ( received ) ? (double) p_latencies[received *  50 / 100 ] * 1000000.0 / divisor : 0.0,
+        ( received ) ? (double) p_latencies[received *  99 / 100 ] * 1000000.0 / divisor : 0.0,
+        ( received ) ? (double) p_latencies[received * 999 / 1000] * 1000000.0 / divisor : 0.0
+    );
+
+    // release the latencies
+    free(p_latencies);
+    free(p_clients);
+
+    // success
+    return EXIT_SUCCESS;
+
+    // error handling
+    {
+
+        // certificate errors
+        {
+            failed_to_load_certificates:
+
+                // log the error
+                log_error("Error: Failed to load root.cer, inter.cer, leaf.cer, and leaf.key!\n");
+
+                // error
+                return EXIT_FAILURE;
+        }
+
+        // socket errors
+        {
+            failed_to_start_server:
+
+                // log the error
+                log_error("Error: Failed to start %s server on port %hu!\n", p_transport, port_number);
+
+                // error
+                return EXIT_FAILURE;
+
+            failed_to_run_client:
+
+                // log the error
+                log_error("Error: A %s connection failed!\n", p_transport);
+
+                // error
+                return EXIT_FAILURE;
+        }
+
+        // standard library errors
+        {
+            no_mem:
+
+                // log the error
+                log_error("Error: Failed to allocate memory!\n");
+
+                // error
+                return EXIT_FAILURE;
+
+            failed_to_start_client:
+
+                // log the error
+                log_error("Error: Failed to start client thread!\n");
+
+                // error
+                return EXIT_FAILURE;
+        }
+    }
+}
+
+void print_usage ( const char *argv0 )
+{
+
+    // argument check
+    if ( NULL == argv0 ) exit(EXIT_FAILURE);
+
+    // print a usage message to standard out
+    printf("Usage: %s [tcp | udp | secure] [-s message_size] [-c connections] [-d depth] [-n messages] [-p port]\n", argv0);
+
+    // done
+    return;
+}
+
+void parse_command_line_arguments ( int argc, const char *argv[] )
+{
+
+    // iterate through each command line argument
+    for (size_t i = 1; i < (size_t) argc; i++)
+    {
+
+        // transport
+        if ( 0 == strcmp(argv[i], "tcp") )
+            transport = TRANSPORT_TCP, p_transport = argv[i];
+        else if ( 0 == strcmp(argv[i], "udp") )
+            transport = TRANSPORT_UDP, p_transport = argv[i];
+        else if ( 0 == strcmp(argv[i], "secure") )
+            transport = TRANSPORT_SECURE, p_transport = argv[i];
+
+        // options with a value
+        else if ( i + 1 < (size_t) argc )
+        {
+
+            // message size
+            if ( 0 == strcmp(argv[i], "-s") )
+
+                // set the message size
+                message_size = strtoull(argv[++i], NULL, 10);
+
+            // connections
+            else if ( 0 == strcmp(argv[i], "-c") )
+
+                // set the quantity of connections
+                connections = strtoull(argv[++i], NULL, 10);
+
+            // pipelining depth
+            else if ( 0 == strcmp(argv[i], "-d") )
+
+                // set the quantity of messages in flight on each connection
+                depth = strtoull(argv[++i], NULL, 10);
+
+            // messages
+            else if ( 0 == strcmp(argv[i], "-n") )
+
+                // set the quantity of messages on each connection
+                messages = strtoull(argv[++i], NULL, 10);
+
+            // port
+            else if ( 0 == strcmp(argv[i], "-p") )
+
+                // set the port number
+                port_number = (socket_port) strtoul(argv[++i], NULL, 10);
+
+            // default
+            else goto invalid_arguments;
+        }
+
+        // default
+        else goto invalid_arguments;
+    }
+
+    // each message carries its send time
+    if ( message_size < sizeof(timestamp) ) goto invalid_arguments;
+
+    // datagrams are limited
+    if ( transport == TRANSPORT_UDP && message_size > SOCKET_UDP_PAYLOAD_MAX ) goto invalid_arguments;
+
+    // at least one of each
+    if ( connections == 0 || depth == 0 || messages == 0 ) goto invalid_arguments;
+
+    // success
+    return;
+
+    // error handling
+    {
+
+        // argument errors
+        {
+            invalid_arguments:
+
+                // print a usage message to standard out
+                print_usage(argv[0]);
+
+                // abort
+                exit(EXIT_FAILURE);
+        }
+    }
+}
+
+int load_certificates ( void )
+{
+
+    // initialized data
+    FILE               *p_f             = NULL;
+    certificate        *p_root          = NULL;
+    ed25519_public_key  public_key      = { 0 };
+    char                _buffer[1024]   = { 0 };
+    const char         *_paths[]        = { "root.cer", "inter.cer", "leaf.cer" };
+    certificate       **_pp_results[]   = { &p_root, &p_trust, &p_leaf };
+
+    // load each certificate
+    for (size_t i = 0; i < 3; i++)
+    {
+
+        // open the file
+        p_f = fopen(_paths[i], "rb");
+        if ( NULL == p_f ) return 0;
+
+        // read the certificate
+        fread(_buffer, 1, sizeof(_buffer), p_f);
+        certificate_unpack(_pp_results[i], _buffer);
+        fclose(p_f);
+    }
+
+    // the clients trust the intermediate
+    if ( 0 == certificate_verify(p_trust, p_root) ) return 0;
+
+    // destroy the root
+    certificate_destroy(&p_root);
+
+    // open the key file
+    p_f = fopen("leaf.key", "rb");
+    if ( NULL == p_f ) return 0;
+
+    // read the key pair
+    fread(_buffer, 1, 64, p_f);
+    ed25519_key_pair_unpack(&public_key, &private_key, _buffer);
+    fclose(p_f);
+
+    // success
+    return 1;
+}
+
+int server_start ( void )
+{
+
+    // initialized data
+    pthread_t thread  = { 0 };
+    int       _socket = 0;
+
+    // strategy
+    switch ( transport )
+    {
+        case TRANSPORT_TCP:
+        case TRANSPORT_SECURE:
+
+            // create a TCP socket
+            if ( 0 == socket_tcp_create(&_socket, socket_address_family_ipv4, port_number) ) return 0;
+
+            // accept connections on a thread
+            if ( pthread_create(&thread, NULL, ( transport == TRANSPORT_TCP ) ? tcp_server : secure_server, (void *) (size_t) _socket) ) return 0;
+
+            // done
+            break;
+
+        case TRANSPORT_UDP:
+
+            // create a UDP socket
+            if ( 0 == socket_udp_create(&_socket, socket_address_family_ipv4, port_number) ) return 0;
+
+            // echo datagrams on a thread
+            if ( pthread_create(&thread, NULL, udp_server, (void *) (size_t) _socket) ) return 0;
+
+            // done
+            break;
+    }
+
+    // the server runs until the program exits
+    pthread_detach(thread);
+
+    // success
+    return 1;
+}
+
+void *tcp_echo ( void *p_parameter )
+{
+
+    // initialized data
+    socket_tcp  _socket_tcp = (socket_tcp) (size_t) p_parameter;
+    char       *p_buffer    = malloc(65536);
+    int         r           = 0;
+
+    // error check
+    if ( NULL == p_buffer ) goto done;
+
+    // echo until the peer closes
+    while ( ( r = socket_tcp_receive(_socket_tcp, p_buffer, 65536) ) > 0 )
+        if ( 0 == socket_tcp_send(_socket_tcp, p_buffer, (size_t) r) ) break;
+
+    // release the buffer
+    free(p_buffer);
+
+    done:
+
+    // close the connection
+    socket_tcp_destroy(&_socket_tcp);
+
+    // done
+    return NULL;
+}
+
+void *tcp_server ( void *p_parameter )
+{
+
+    // initialized data
+    socket_tcp _socket_tcp = (socket_tcp) (size_t) p_parameter;
+
+    // listen for connections
+    listen(_socket_tcp, SOMAXCONN);
+
+    // accept connections
+    while ( true )
+    {
+
+        // initialized data
+        socket_tcp _connection = accept(_socket_tcp, NULL, NULL);
+        pthread_t  thread      = { 0 };
+
+        // error check
+        if ( _connection == -1 ) continue;
+
+        // echo the connection on its own thread
+        if ( pthread_create(&thread, NULL, tcp_echo, (void *) (size_t) _connection) ) socket_tcp_destroy(&_connection);
+        else                                                                           pthread_detach(thread);
+    }
+
+    // done
+    return NULL;
+}
+
+void *udp_server ( void *p_parameter )
+{
+
+    // initialized data
+    socket_udp          _socket_udp = (socket_udp) (size_t) p_parameter;
+    socket_udp_message  _messages[SOCKET_UDP_BATCH_MAX];
+    char               *p_buffers   = malloc(SOCKET_UDP_BATCH_MAX * message_size);
+
+    // error check
+    if ( NULL == p_buffers ) return NULL;
+
+    // echo batches of datagrams
+    while ( true )
+    {
+
+        // initialized data
+        int quantity = 0;
+
+        // describe each buffer
+        for (size_t i = 0; i < SOCKET_UDP_BATCH_MAX; i++)
+            _messages[i] = (socket_udp_message) { .p_buffer = &p_buffers[i * message_size], .buffer_len = message_size };
+
+        // receive a batch
+        quantity = socket_udp_receive_batch(_socket_udp, _messages, SOCKET_UDP_BATCH_MAX);
+
+        // error check
+        if ( quantity < 1 ) continue;
+
+        // send back what was received
+        for (int i = 0; i < quantity; i++)
+            _messages[i].buffer_len = _messages[i].size;
+
+        // echo the batch
+        socket_udp_send_batch(_socket_udp, _messages, (size_t) quantity);
+    }
+
+    // done
+    return NULL;
+}
+
+void *secure_echo ( void *p_parameter )
+{
+
+    // initialized data
+    secure_socket *p_secure_socket = p_parameter;
+    char          *p_buffer        = malloc(message_size);
+    int            r               = 0;
+
+    // error check
+    if ( NULL == p_buffer ) goto done;
+
+    // echo until the peer closes
+    while ( ( r = secure_socket_receive(p_secure_socket, p_buffer, message_size) ) > 0 )
+        if ( 0 == secure_socket_send(p_secure_socket, p_buffer, (size_t) r) ) break;
+
+    // release the buffer
+    free(p_buffer);
+
+    done:
+
+    // close the connection
+    secure_socket_destroy(&p_secure_socket);
+
+    // done
+    return NULL;
+}
+
+void *secure_server ( void *p_parameter )
+{
+
+    // initialized data
+    socket_tcp _socket_tcp = (socket_tcp) (size_t) p_parameter;
+
+    // listen for connections
+    listen(_socket_tcp, SOMAXCONN);
+
+    // accept connections
+    while ( true )
+    {
+
+        // initialized data
+        socket_tcp     _connection     = accept(_socket_tcp, NULL, NULL);
+        secure_socket *p_secure_socket = NULL;
+        pthread_t      thread          = { 0 };
+
+        // error check
+        if ( _connection == -1 ) continue;
+
+        // handshake
+        if ( 0 == secure_socket_construct(&p_secure_socket, _connection, true, p_leaf, &private_key) ) { socket_tcp_destroy(&_connection); continue; }
+
+        // echo the connection on its own thread
+        if ( pthread_create(&thread, NULL, secure_echo, p_secure_socket) ) secure_socket_destroy(&p_secure_socket);
+        else                                                               pthread_detach(thread);
+    }
+
+    // done
+    return NULL;
+}
+
+void *client_run ( void *p_parameter )
+{
+
+    // initialized data
+    client        *p_client        = p_parameter;
+    size_t         sent            = 0,
+                   in_flight       = 0,
+                   pending         = 0,
+                   capacity        = message_size * depth;
+    char          *p_buffer        = malloc(capacity),
+                  *p_message       = calloc(1, message_size);
+    socket_tcp     _socket_tcp     = -1;
+    socket_udp     _socket_udp     = -1;
+    secure_socket *p_secure_socket = NULL;
+
+    // error check
+    if ( NULL == p_buffer || NULL == p_message ) goto failed;
+
+    // connect
+    switch ( transport )
+    {
+        case TRANSPORT_TCP:
+            if ( 0 == socket_tcp_connect(&_socket_tcp, socket_address_family_ipv4, server_ip, port_number) ) goto failed;
+            break;
+
+        case TRANSPORT_UDP:
+        {
+
+            // initialized data
+            struct timeval timeout = { .tv_sec = 0, .tv_usec = NETWORK_BENCHMARK_UDP_TIMEOUT * 1000 };
+
+            // create a socket
+            if ( 0 == socket_udp_create(&_socket_udp, socket_address_family_ipv4, 0) ) goto failed;
+
+            // give up on lost datagrams
+            setsockopt(_socket_udp, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+            // done
+            break;
+        }
+
+        case TRANSPORT_SECURE:
+            if ( 0 == socket_tcp_connect(&_socket_tcp, socket_address_family_ipv4, server_ip, port_number) ) goto failed;
+            if ( 0 == secure_socket_construct(&p_secure_socket, _socket_tcp, false, p_trust, NULL) ) goto failed;
+            break;
+    }
+
+    // stream transports can deadlock if the replies in flight overflow the receive buffer
+    p_client->depth = ( transport == TRANSPORT_UDP ) ? depth : pipeline_depth(_socket_tcp);
+
+    // run until every message is answered, or lost
+    while ( p_client->received + p_client->lost < messages )
+    {
+
+        // fill the pipeline
+        while ( in_flight < p_client->depth && sent < messages )
+        {
+
+            // initialized data
+            timestamp now = timer_high_precision();
+
+            // stamp the message
+            memcpy(p_message, &now, sizeof(timestamp));
+
+            // send the message
+            switch ( transport )
+            {
+                case TRANSPORT_TCP:
+                    if ( 0 == socket_tcp_send(_socket_tcp, p_message, message_size) ) goto failed;
+                    break;
+
+                case TRANSPORT_UDP:
+                    if ( 0 == socket_udp_send_to(_socket_udp, p_message, message_size, server_ip, port_number) ) goto failed;
+                    break;
+
+                case TRANSPORT_SECURE:
+                    if ( 0 == secure_socket_send(p_secure_socket, p_message, message_size) ) goto failed;
+                    break;
+            }
+
+            // update the counters
+            sent++,
+            in_flight++;
+        }
+
+        // receive responses
+        switch ( transport )
+        {
+            case TRANSPORT_TCP:
+            {
+
+                // initialized data
+                int r = socket_tcp_receive(_socket_tcp, p_buffer + pending, capacity - pending);
+
+                // error check
+                if ( r < 1 ) goto failed;
+
+                // update the counter
+                pending += (size_t) r;
+
+                // done
+                break;
+            }
+
+            case TRANSPORT_UDP:
+            {
+
+                // initialized data
+                socket_udp_message _messages[SOCKET_UDP_BATCH_MAX];
+                size_t             quantity = ( depth < SOCKET_UDP_BATCH_MAX ) ? depth : SOCKET_UDP_BATCH_MAX;
+                int                r        = 0;
+
+                // describe each buffer
+                for (size_t i = 0; i < quantity; i++)
+                    _messages[i] = (socket_udp_message) { .p_buffer = p_buffer + i * message_size, .buffer_len = message_size };
+
+                // receive a batch
+                r = socket_udp_receive_batch(_socket_udp, _messages, quantity);
+
+                // the rest of the pipeline was lost
+                if ( r < 1 )
+                {
+                    if ( errno != EAGAIN && errno != EWOULDBLOCK ) goto failed;
+                    p_client->lost += in_flight, in_flight = 0;
+                    break;
+                }
+
+                // each datagram is a whole message
+                pending = (size_t) r * message_size;
+
+                // done
+                break;
+            }
+
+            case TRANSPORT_SECURE:
+            {
+
+                // initialized data
+                int r = secure_socket_receive(p_secure_socket, p_buffer, message_size);
+
+                // error check
+                if ( r != (int) message_size ) goto failed;
+
+                // one message
+                pending = message_size;
+
+                // done
+                break;
+            }
+        }
+
+        // record each whole message
+        {
+
+            // initialized data
+            timestamp now      = timer_high_precision();
+            size_t    consumed = 0;
+
+            // iterate through each whole message
+            for (; pending - consumed >= message_size && in_flight; consumed += message_size)
+            {
+
+                // initialized data
+                timestamp stamp = 0;
+
+                // load the send time
+                memcpy(&stamp, p_buffer + consumed, sizeof(timestamp));
+
+                // record the latency
+                p_client->p_latencies[p_client->received++] = now - stamp,
+                in_flight--;
+            }
+
+            // keep a partial message
+            memmove(p_buffer, p_buffer + consumed, pending - consumed),
+            pending -= consumed;
+        }
+    }
+
+    done:
+
+    // close the connection
+    if ( p_secure_socket   ) secure_socket_destroy(&p_secure_socket);
+    if ( _socket_tcp != -1 ) socket_tcp_destroy(&_socket_tcp);
+    if ( _socket_udp != -1 ) socket_udp_destroy(&_socket_udp);
+
+    // release the buffers
+    free(p_buffer),
+    free(p_message);
+
+    // done
+    return NULL;
+
+    failed:
+
+    // the connection failed
+    p_client->failed = true;
+
+    // clean up
+    goto done;
+}
+
+size_t pipeline_depth ( socket_tcp _socket_tcp )
+{
+
+    // initialized data
+    int       receive_buffer = 0;
+    socklen_t length         = sizeof(receive_buffer);
+    size_t    wire_size      = message_size,
+              fit            = 0;
+
+    // secure messages carry a length prefix and a tag
+    if ( transport == TRANSPORT_SECURE ) wire_size += sizeof(uint64_t) + sizeof(poly1305_tag);
+
+    // query the receive buffer. keep the requested depth if it can't be queried
+    if ( -1 == getsockopt(_socket_tcp, SOL_SOCKET, SO_RCVBUF, &receive_buffer, &length) || receive_buffer <= 0 ) return depth;
+
+    // linux reports twice the space that holds data
+    fit = (size_t) receive_buffer / 2 / wire_size;
+
+    // one message in flight can't deadlock
+    if ( fit < 1 ) fit = 1;
+
+    // done
+    return ( depth < fit ) ? depth : fit;
+}
+
+int latency_compare ( const void *p_a, const void *p_b )
+{
+
+    // initialized data
+    timestamp a = *(const timestamp *) p_a,
+              b = *(const timestamp *) p_b;
+
+    // done
+    return ( a > b ) - ( a < b );
+}
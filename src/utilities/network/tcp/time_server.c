@@ -21,6 +21,9 @@
 #include <core/sync.h> 
 #include <core/tcp.h>
 
+/// performance
+#include <performance/reactor.h>
+
 int connection_callback ( socket_tcp socket, socket_ip_address ip, socket_port port, void *const p_parameter )
 {
 
@@ -73,17 +76,26 @@ int main ( int argc, const char *argv[] )
     (void)argv;
 
     // initialized data
-    socket_tcp server_socket = 0;
+    socket_tcp  server_socket = 0;
+    reactor    *p_reactor     = NULL;
 
     // create a tcp socket on port 3000
     socket_tcp_create(&server_socket, socket_address_family_ipv4, 3000);
 
+    // construct a reactor
+    if ( 0 == reactor_construct(&p_reactor, NULL) ) return EXIT_FAILURE;
+
+    // accept connections as they arrive
+    if ( 0 == reactor_listen(p_reactor, server_socket, connection_callback, NULL) ) return EXIT_FAILURE;
+
     // logs
     log_info("Server listening on port %hu\n", 3000);
 
-    // listen for connections
-    while ( true )
-        socket_tcp_listen(server_socket, connection_callback, NULL);
+    // dispatch connections
+    while ( reactor_run(p_reactor, -1) != -1 );
+
+    // destroy the reactor
+    reactor_destroy(&p_reactor);
 
     // logs
     log_info("Shutting down server...\n");